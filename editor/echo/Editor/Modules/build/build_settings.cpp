@@ -1,6 +1,10 @@
 #include "build_settings.h"
 #include <engine/core/util/PathUtil.h>
 #include <engine/core/io/archive/FilePackage.h>
+#include <engine/core/base/object_cooker.h>
+#include <engine/core/render/base/texture/texture_streamer.h>
+#include <engine/core/render/base/glslcc/shader_cache.h>
+#include <engine/modules/ui/font/font_library.h>
 
 namespace Echo
 {
@@ -11,12 +15,20 @@ namespace Echo
 
     void BuildSettings::packageRes(const String& rootFolder)
     {
+        // shaders of the project are compiled once here, the device compiles only what is missing
+        ui32 shaderCount = ShaderCache::precompile(rootFolder + "ShaderCache/");
+        log("Precompiled shaders of %d materials", shaderCount);
+
         StringArray subFolers;
         PathUtil::EnumFilesInDir(subFolers, rootFolder, true, false, true);
         for (const String& folder : subFolers)
         {
             if (!PathUtil::IsFile(folder))
             {
+                // scenes, resources and textures are shipped cooked, fonts with their baked glyphs, xml and source images are only for editing
+                ObjectCooker::cookFolder(folder);
+                TextureStreamer::cookFolder(folder);
+                FontLibrary::instance()->bakeFolder(folder);
                 FilePackage::compressFolder(folder.c_str());
                 PathUtil::DelPath(folder);
             }
@@ -194,6 +194,11 @@ __GNUC_PATCHLEVEL__)
 #	define ECHO_ARCHITECTURE        ECHO_ARCH_32BIT
 #endif
 
+// SIMD instruction set, code using intrinsics must provide a scalar fallback
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define ECHO_SIMD_SSE
+#endif
+
 // Disable MSVC warning
 #if (ECHO_COMPILER == ECHO_COMPILER_MSVC)
 #	pragma warning(disable:4251 4275 4819)
@@ -0,0 +1,619 @@
+#include "object_cooker.h"
+#include "engine/core/scene/node.h"
+#include "engine/core/resource/Res.h"
+#include "engine/core/io/memory_reader.h"
+#include "engine/core/util/PathUtil.h"
+#include "engine/core/log/Log.h"
+#include <thirdparty/pugixml/pugixml.hpp>
+#include <thirdparty/pugixml/pugiconfig.hpp>
+
+namespace Echo
+{
+	// Record layout, all integers are little endian
+	//   object   : ui32 class, ui32 propertyCount, property[], ui32 signalCount, signal[], ui32 channelCount, channel[]
+	//   property : ui32 name, ui32 owner class, ui16 index in owner, ui8 ValueKind, ui8 Variant::Type, value
+	//   signal   : ui32 name, ui32 connectCount, (ui32 target, ui32 method)[]
+	//   channel  : ui32 name, ui32 expression
+	//   node     : ui32 link path, object, ui32 childCount, node[]
+	// Strings are string table indices, InvalidIndex is an empty string. Properties with an
+	// invalid owner are resolved on the instance by name, these are dynamic properties and
+	// the overrides of linked nodes.
+	class CookedWriter
+	{
+	public:
+		// write raw value
+		template<typename T> void write(const T& value)
+		{
+			size_t offset = m_data.size();
+			m_data.resize(offset + sizeof(T));
+			std::memcpy(m_data.data() + offset, &value, sizeof(T));
+		}
+
+		// write string as table index
+		void writeString(const String& str)
+		{
+			write<ui32>(str.empty() ? ObjectCooker::InvalidIndex : addString(str));
+		}
+
+		// node record
+		void writeNode(const pugi::xml_node& xmlNode)
+		{
+			String path = xmlNode.attribute("path").value();
+			writeString(path);
+			writeObject(xmlNode, !path.empty());
+
+			size_t countOffset = m_data.size();
+			ui32 childCount = 0;
+			write<ui32>(childCount);
+			for (pugi::xml_node child = xmlNode.child("node"); child; child = child.next_sibling("node"))
+			{
+				writeNode(child);
+				childCount++;
+			}
+			std::memcpy(m_data.data() + countOffset, &childCount, sizeof(ui32));
+		}
+
+		// object record, classes of links are only known when the link is loaded
+		void writeObject(const pugi::xml_node& xmlNode, bool isLink)
+		{
+			String className = isLink ? String() : String(xmlNode.attribute("class").value());
+			writeString(className);
+
+			size_t countOffset = m_data.size();
+			ui32 propertyCount = 0;
+			write<ui32>(propertyCount);
+
+			// static properties, parent classes first like the xml loader
+			set<String>::type loaded;
+			StringArray classes;
+			for (String name = className; !name.empty() && Class::getClassInfo(name);)
+			{
+				classes.emplace_back(name);
+
+				String parentName;
+				if (!Class::getParentClass(parentName, name) || parentName == "Object")
+					break;
+
+				name = parentName;
+			}
+
+			for (auto it = classes.rbegin(); it != classes.rend(); it++)
+			{
+				ui32 owner = addString(*it);
+				const PropertyInfos& propertys = Class::getClassInfo(*it)->m_propertyInfos;
+				for (size_t i = 0; i < propertys.size(); i++)
+				{
+					const PropertyInfo* prop = propertys[i];
+					if (!loaded.count(prop->m_name) && writeProperty(xmlNode, prop, owner, static_cast<ui16>(i)))
+					{
+						loaded.insert(prop->m_name);
+						propertyCount++;
+					}
+				}
+			}
+
+			// the rest is resolved by name on the instance
+			for (pugi::xml_attribute attribute : xmlNode.attributes())
+			{
+				String name = attribute.name();
+				String value = attribute.value();
+				if (name != "class" && name != "path" && !value.empty() && !loaded.count(name))
+				{
+					writePropertyHead(name, ObjectCooker::InvalidIndex, 0, ObjectCooker::ValueKind::Text, Variant::Type::Unknown);
+					writeString(value);
+					propertyCount++;
+				}
+			}
+
+			for (pugi::xml_node propertyNode = xmlNode.child("property"); propertyNode; propertyNode = propertyNode.next_sibling("property"))
+			{
+				String name = propertyNode.attribute("name").as_string();
+				if (!loaded.count(name) && writeChildProperty(propertyNode, name, ObjectCooker::InvalidIndex, 0, Variant::Type::Unknown))
+				{
+					loaded.insert(name);
+					propertyCount++;
+				}
+			}
+			std::memcpy(m_data.data() + countOffset, &propertyCount, sizeof(ui32));
+
+			// signals
+			countOffset = m_data.size();
+			ui32 signalCount = 0;
+			write<ui32>(signalCount);
+			for (pugi::xml_node signalNode = xmlNode.child("signal"); signalNode; signalNode = signalNode.next_sibling("signal"))
+			{
+				writeString(signalNode.attribute("name").as_string());
+
+				size_t connectOffset = m_data.size();
+				ui32 connectCount = 0;
+				write<ui32>(connectCount);
+				for (pugi::xml_node connectNode = signalNode.child("connect"); connectNode; connectNode = connectNode.next_sibling("connect"))
+				{
+					writeString(connectNode.attribute("target").as_string());
+					writeString(connectNode.attribute("method").as_string());
+					connectCount++;
+				}
+				std::memcpy(m_data.data() + connectOffset, &connectCount, sizeof(ui32));
+				signalCount++;
+			}
+			std::memcpy(m_data.data() + countOffset, &signalCount, sizeof(ui32));
+
+			// channels
+			countOffset = m_data.size();
+			ui32 channelCount = 0;
+			write<ui32>(channelCount);
+			for (pugi::xml_node channelNode = xmlNode.child("channel"); channelNode; channelNode = channelNode.next_sibling("channel"))
+			{
+				writeString(channelNode.attribute("name").as_string());
+				writeString(channelNode.attribute("expression").as_string());
+				channelCount++;
+			}
+			std::memcpy(m_data.data() + countOffset, &channelCount, sizeof(ui32));
+		}
+
+		// blob of header, string table and records
+		void finish(ObjectCooker::Root root, ByteArray& cooked)
+		{
+			ObjectCooker::Header header;
+			header.m_magic = ObjectCooker::Magic;
+			header.m_version = ObjectCooker::Version;
+			header.m_root = ui32(root);
+			header.m_realSize = sizeof(Real);
+			header.m_stringCount = ui32(m_strings.size());
+
+			size_t stringsSize = 0;
+			for (const String& str : m_strings)
+				stringsSize += sizeof(ui32) + str.size();
+
+			cooked.clear();
+			cooked.reserve(sizeof(header) + stringsSize + m_data.size());
+
+			const Byte* headerData = reinterpret_cast<const Byte*>(&header);
+			cooked.insert(cooked.end(), headerData, headerData + sizeof(header));
+			for (const String& str : m_strings)
+			{
+				ui32 length = ui32(str.size());
+				const Byte* lengthData = reinterpret_cast<const Byte*>(&length);
+				cooked.insert(cooked.end(), lengthData, lengthData + sizeof(ui32));
+				cooked.insert(cooked.end(), str.begin(), str.end());
+			}
+			cooked.insert(cooked.end(), m_data.begin(), m_data.end());
+		}
+
+	private:
+		// add string to the table
+		ui32 addString(const String& str)
+		{
+			auto it = m_stringIndices.find(str);
+			if (it != m_stringIndices.end())
+				return it->second;
+
+			ui32 index = ui32(m_strings.size());
+			m_strings.emplace_back(str);
+			m_stringIndices[str] = index;
+
+			return index;
+		}
+
+		// property head
+		void writePropertyHead(const String& name, ui32 owner, ui16 index, ObjectCooker::ValueKind kind, Variant::Type type)
+		{
+			writeString(name);
+			write<ui32>(owner);
+			write<ui16>(index);
+			write<ui8>(ui8(kind));
+			write<ui8>(ui8(type));
+		}
+
+		// static property, false if the document has no value for it
+		bool writeProperty(const pugi::xml_node& xmlNode, const PropertyInfo* prop, ui32 owner, ui16 index)
+		{
+			if (prop->m_type == Variant::Type::Object || (prop->m_type == Variant::Type::String && prop->IsHaveHint(PropertyHintType::XmlCData)))
+			{
+				for (pugi::xml_node propertyNode = xmlNode.child("property"); propertyNode; propertyNode = propertyNode.next_sibling("property"))
+				{
+					if (prop->m_name == propertyNode.attribute("name").as_string())
+						return writeChildProperty(propertyNode, prop->m_name, owner, index, prop->m_type);
+				}
+
+				return false;
+			}
+
+			String valueStr = xmlNode.attribute(prop->m_name.c_str()).value();
+			if (valueStr.empty())
+				return false;
+
+			switch (prop->m_type)
+			{
+			case Variant::Type::Bool:		writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<ui8>(StringUtil::ParseBool(valueStr) ? 1 : 0);	break;
+			case Variant::Type::Int:		writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<i32>(StringUtil::ParseI32(valueStr));			break;
+			case Variant::Type::Real:		writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<double>(StringUtil::ParseDouble(valueStr));		break;
+			case Variant::Type::Vector2:	writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<Vector2>(StringUtil::ParseVec2(valueStr));		break;
+			case Variant::Type::Vector3:	writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<Vector3>(StringUtil::ParseVec3(valueStr));		break;
+			case Variant::Type::Vector4:	writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<Vector4>(StringUtil::ParseVec4(valueStr));		break;
+			case Variant::Type::Quaternion:	writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<Quaternion>(StringUtil::ParseQuaternion(valueStr));	break;
+			case Variant::Type::Color:		writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Binary, prop->m_type); write<Color>(StringUtil::ParseColor(valueStr));		break;
+			default:						writePropertyHead(prop->m_name, owner, index, ObjectCooker::ValueKind::Text, prop->m_type); writeString(valueStr);								break;
+			}
+
+			return true;
+		}
+
+		// property stored as child element, resource path, inline object or cdata string
+		bool writeChildProperty(const pugi::xml_node& propertyNode, const String& name, ui32 owner, ui16 index, Variant::Type type)
+		{
+			String path = propertyNode.attribute("path").as_string();
+			pugi::xml_node objNode = propertyNode.child("obj");
+			if (!path.empty())
+			{
+				writePropertyHead(name, owner, index, ObjectCooker::ValueKind::ResPath, type);
+				writeString(path);
+			}
+			else if (objNode || type == Variant::Type::Object)
+			{
+				writePropertyHead(name, owner, index, ObjectCooker::ValueKind::Object, type);
+				writeObject(objNode, false);
+			}
+			else
+			{
+				String valueStr = propertyNode.child_value();
+				if (valueStr.empty())
+					return false;
+
+				writePropertyHead(name, owner, index, ObjectCooker::ValueKind::Text, type);
+				writeString(valueStr);
+			}
+
+			return true;
+		}
+
+	private:
+		ByteArray					m_data;
+		StringArray					m_strings;
+		map<String, ui32>::type		m_stringIndices;
+	};
+
+	// reads records in one pass, class infos are looked up once per document
+	class CookedReader
+	{
+	public:
+		CookedReader(const void* data, size_t size)
+			: m_pos(static_cast<const Byte*>(data)), m_end(static_cast<const Byte*>(data) + size)
+		{}
+
+		// check header and load the string table
+		bool begin(ObjectCooker::Root root)
+		{
+			ObjectCooker::Header header = read<ObjectCooker::Header>();
+			if (m_error || header.m_magic != ObjectCooker::Magic || header.m_version != ObjectCooker::Version || header.m_root != ui32(root) || header.m_realSize != sizeof(Real))
+				return false;
+
+			m_strings.resize(header.m_stringCount);
+			for (String& str : m_strings)
+			{
+				ui32 length = read<ui32>();
+				if (m_error || length > ui32(m_end - m_pos))
+				{
+					m_error = true;
+					return false;
+				}
+
+				str.assign(reinterpret_cast<const char*>(m_pos), length);
+				m_pos += length;
+			}
+
+			m_classInfos.assign(m_strings.size(), nullptr);
+			m_classLookedUp.assign(m_strings.size(), false);
+
+			return true;
+		}
+
+		// read raw value
+		template<typename T> T read()
+		{
+			T value;
+			if (m_pos + sizeof(T) <= m_end)
+			{
+				std::memcpy(&value, m_pos, sizeof(T));
+				m_pos += sizeof(T);
+			}
+			else
+			{
+				std::memset(&value, 0, sizeof(T));
+				m_error = true;
+			}
+
+			return value;
+		}
+
+		// read string table index
+		const String& readString()
+		{
+			ui32 index = read<ui32>();
+			if (index < m_strings.size())
+				return m_strings[index];
+
+			if (index != ObjectCooker::InvalidIndex)
+				m_error = true;
+
+			return StringUtil::BLANK;
+		}
+
+		// node record
+		Node* readNode(Node* parent)
+		{
+			const String& linkPath = readString();
+			const String& className = readString();
+
+			Node* node = !linkPath.empty() ? Node::loadLink(linkPath, true) : ECHO_DOWN_CAST<Node*>(createObject(className));
+			bool isPlaceholder = !node;
+			if (isPlaceholder)
+			{
+				//  if class not exist, create a empty node as placeholder
+				node = Class::create<Node*>("Node");
+			}
+
+			readContent(isPlaceholder && linkPath.empty() ? nullptr : node);
+
+			if (parent)
+				parent->addChild(node);
+
+			ui32 childCount = read<ui32>();
+			for (ui32 i = 0; i < childCount && !m_error; i++)
+				readNode(node);
+
+			return node;
+		}
+
+		// object record, skipped when not instanced
+		Object* readObject(bool instance)
+		{
+			const String& className = readString();
+			Object* obj = instance ? createObject(className) : nullptr;
+			readContent(obj);
+
+			return obj;
+		}
+
+		// create object of class
+		Object* createObject(const String& className)
+		{
+			Object* obj = className.empty() ? nullptr : Class::create(className);
+			if (!obj)
+				EchoLogError("Class::create failed. Class [%s] not exist", className.c_str());
+
+			return obj;
+		}
+
+		// properties, signals and channels, only consumed if obj is null
+		void readContent(Object* obj)
+		{
+			ui32 propertyCount = read<ui32>();
+			for (ui32 i = 0; i < propertyCount && !m_error; i++)
+				readProperty(obj);
+
+			ui32 signalCount = read<ui32>();
+			for (ui32 i = 0; i < signalCount && !m_error; i++)
+			{
+				const String& name = readString();
+				Signal* signal = obj ? Class::getSignal(obj, name) : nullptr;
+
+				ui32 connectCount = read<ui32>();
+				for (ui32 j = 0; j < connectCount && !m_error; j++)
+				{
+					const String& target = readString();
+					const String& method = readString();
+					if (signal)
+						signal->connectLuaMethod(target, method);
+				}
+			}
+
+			ui32 channelCount = read<ui32>();
+			for (ui32 i = 0; i < channelCount && !m_error; i++)
+			{
+				const String& name = readString();
+				const String& expression = readString();
+				if (obj)
+					obj->registerChannel(name, expression);
+			}
+		}
+
+		// has error
+		bool isError() const { return m_error; }
+
+	private:
+		// property record
+		void readProperty(Object* obj)
+		{
+			const String& name = readString();
+			ui32 owner = read<ui32>();
+			ui16 index = read<ui16>();
+			ObjectCooker::ValueKind kind = ObjectCooker::ValueKind(read<ui8>());
+			Variant::Type type = Variant::Type(read<ui8>());
+
+			PropertyInfo* prop = obj && !m_error ? resolveProperty(obj, name, owner, index, kind, type) : nullptr;
+
+			Variant value;
+			switch (kind)
+			{
+			case ObjectCooker::ValueKind::Binary:
+				switch (type)
+				{
+				case Variant::Type::Bool:		value = Variant(read<ui8>() != 0);	break;
+				case Variant::Type::Int:		value = Variant(read<i32>());		break;
+				case Variant::Type::Real:		value = Variant(read<double>());	break;
+				case Variant::Type::Vector2:	value = Variant(read<Vector2>());	break;
+				case Variant::Type::Vector3:	value = Variant(read<Vector3>());	break;
+				case Variant::Type::Vector4:	value = Variant(read<Vector4>());	break;
+				case Variant::Type::Quaternion:	value = Variant(read<Quaternion>());break;
+				case Variant::Type::Color:		value = Variant(read<Color>());		break;
+				default:						m_error = true;						break;
+				}
+				break;
+			case ObjectCooker::ValueKind::Text:
+				{
+					const String& text = readString();
+					if (prop)
+						value.fromString(prop->m_type, text);
+				}
+				break;
+			case ObjectCooker::ValueKind::ResPath:
+				{
+					const String& path = readString();
+					if (prop)
+						value = Variant(static_cast<Object*>(Res::get(path)));
+				}
+				break;
+			case ObjectCooker::ValueKind::Object:
+				value = Variant(readObject(prop != nullptr));
+				break;
+			default:
+				m_error = true;
+				break;
+			}
+
+			if (prop && !m_error)
+				prop->setPropertyValue(obj, prop->m_name, value);
+		}
+
+		// property by cooked index, falls back to name lookup for dynamic properties and stale indices
+		PropertyInfo* resolveProperty(Object* obj, const String& name, ui32 owner, ui16 index, ObjectCooker::ValueKind kind, Variant::Type type)
+		{
+			if (owner < m_strings.size())
+			{
+				if (!m_classLookedUp[owner])
+				{
+					m_classInfos[owner] = Class::getClassInfo(m_strings[owner]);
+					m_classLookedUp[owner] = true;
+				}
+
+				ClassInfo* classInfo = m_classInfos[owner];
+				if (classInfo && index < classInfo->m_propertyInfos.size())
+				{
+					PropertyInfo* prop = classInfo->m_propertyInfos[index];
+					if (prop->m_type == type && prop->m_name == name)
+						return prop;
+				}
+			}
+
+			PropertyInfo* prop = Class::getProperty(obj, name);
+			if (prop && kind == ObjectCooker::ValueKind::Binary && prop->m_type != type)
+				return nullptr;
+
+			return prop;
+		}
+
+	private:
+		const Byte*					m_pos;
+		const Byte*					m_end;
+		bool						m_error = false;
+		StringArray					m_strings;
+		vector<ClassInfo*>::type	m_classInfos;
+		vector<bool>::type			m_classLookedUp;
+	};
+
+	bool ObjectCooker::isCooked(const void* data, size_t size)
+	{
+		ui32 magic = 0;
+		if (data && size >= sizeof(Header))
+			std::memcpy(&magic, data, sizeof(ui32));
+
+		return magic == Magic;
+	}
+
+	bool ObjectCooker::cook(const char* xml, size_t size, ByteArray& cooked)
+	{
+		pugi::xml_document doc;
+		if (xml && size && doc.load_buffer(xml, size))
+		{
+			CookedWriter writer;
+			pugi::xml_node root = doc.child("node");
+			if (root)
+			{
+				writer.writeNode(root);
+				writer.finish(Root::Node, cooked);
+				return true;
+			}
+
+			root = doc.child("res");
+			if (root)
+			{
+				writer.writeObject(root, false);
+				writer.finish(Root::Res, cooked);
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ObjectCooker::cookFolder(const String& folderPath)
+	{
+		StringArray allFiles;
+		PathUtil::EnumFilesInDir(allFiles, folderPath, false, true, true);
+		for (const String& file : allFiles)
+		{
+			// scenes and resources loaded by Res::load
+			String ext = PathUtil::GetFileExt(file, true);
+			StringUtil::LowerCase(ext);
+			const Res::ResFun* resFun = Res::getResFunByExtension(ext);
+			if (ext != ".scene" && !(resFun && resFun->m_lfun == &Res::load))
+				continue;
+
+			ByteArray cooked;
+			{
+				MemoryReader reader(file);
+				if (!reader.getSize() || isCooked(reader.getData<const char*>(), reader.getSize()) || !cook(reader.getData<const char*>(), reader.getSize(), cooked))
+					continue;
+			}
+
+			FILE* cookedFile = fopen(file.c_str(), "wb");
+			if (cookedFile)
+			{
+				fwrite(cooked.data(), 1, cooked.size(), cookedFile);
+				fclose(cookedFile);
+			}
+			else
+			{
+				EchoLogError("ObjectCooker::cookFolder can't write file [%s]", file.c_str());
+			}
+		}
+	}
+
+	Node* ObjectCooker::instanceNodeTree(const void* data, size_t size)
+	{
+		CookedReader reader(data, size);
+		if (reader.begin(Root::Node))
+		{
+			Node* rootNode = reader.readNode(nullptr);
+			if (!reader.isError())
+				return rootNode;
+
+			rootNode->queueFree();
+		}
+
+		EchoLogError("ObjectCooker::instanceNodeTree failed. invalid cooked data");
+		return nullptr;
+	}
+
+	Res* ObjectCooker::instanceRes(const void* data, size_t size, const ResourcePath& path)
+	{
+		CookedReader reader(data, size);
+		if (reader.begin(Root::Res))
+		{
+			Res* res = ECHO_DOWN_CAST<Res*>(reader.createObject(reader.readString()));
+			if (res)
+				res->setPath(path.getPath());
+
+			reader.readContent(res);
+			if (!reader.isError())
+				return res;
+
+			if (res)
+				res->queueFree();
+		}
+
+		EchoLogError("ObjectCooker::instanceRes failed. invalid cooked data [%s]", path.getPath().c_str());
+		return nullptr;
+	}
+}
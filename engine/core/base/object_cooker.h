@@ -0,0 +1,62 @@
+#pragma once
+
+#include "object.h"
+
+namespace Echo
+{
+	class Node;
+	class Res;
+	class ResourcePath;
+
+	// Cooked node tree and resource documents. Xml stays the source format for editing,
+	// cooking converts a document into a binary blob of a string table, class and property
+	// references resolved at cook time and binary property values. Instancing a cooked
+	// document walks the blob once, without xml parsing or property lookups by name.
+	class ObjectCooker
+	{
+	public:
+		static constexpr ui32 Magic = 0x444b4345;		// "ECKD"
+		static constexpr ui32 Version = 1;
+		static constexpr ui32 InvalidIndex = 0xffffffff;
+
+		// root of the document
+		enum class Root : ui32
+		{
+			Node = 0,
+			Res,
+		};
+
+		// how a property value is stored
+		enum class ValueKind : ui8
+		{
+			Binary = 0,				// raw value of the property type
+			Text,					// string table index, parsed by Variant::fromString
+			ResPath,				// string table index of a resource
+			Object,					// inline object record
+		};
+
+		// file header, followed by the string table and the root record
+		struct Header
+		{
+			ui32	m_magic;
+			ui32	m_version;
+			ui32	m_root;
+			ui32	m_realSize;			// sizeof(Real) of the cooker, binary values depend on it
+			ui32	m_stringCount;		// each string is ui32 length + chars
+		};
+
+	public:
+		// is data a cooked document
+		static bool isCooked(const void* data, size_t size);
+
+		// cook a xml document which root is "node" or "res"
+		static bool cook(const char* xml, size_t size, ByteArray& cooked);
+
+		// cook xml documents of a folder in place, other files are left untouched
+		static void cookFolder(const String& folderPath);
+
+		// instance
+		static Node* instanceNodeTree(const void* data, size_t size);
+		static Res* instanceRes(const void* data, size_t size, const ResourcePath& path);
+	};
+}
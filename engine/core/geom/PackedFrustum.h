@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Frustum.h"
+
+#ifdef ECHO_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+namespace Echo
+{
+	// Frustum planes in SoA layout, an AABB is tested against four planes at once.
+	// The plane mask tracks planes a box still straddles, children of a box fully
+	// inside some planes can skip them.
+	struct PackedFrustum
+	{
+		static constexpr ui32 AllPlaneMask = 0x3f;
+
+		// padding planes 6 and 7 contain everything
+		alignas(16) float m_nx[8];
+		alignas(16) float m_ny[8];
+		alignas(16) float m_nz[8];
+		alignas(16) float m_d[8];
+		alignas(16) float m_absNx[8];
+		alignas(16) float m_absNy[8];
+		alignas(16) float m_absNz[8];
+
+		PackedFrustum() {}
+		explicit PackedFrustum(const Frustum& frustum) { set(frustum); }
+
+		// set, planes are normalized and face outward
+		void set(const Frustum& frustum)
+		{
+			const array<Plane, 6>& planes = frustum.getPlanes();
+			for (i32 i = 0; i < 8; i++)
+			{
+				m_nx[i] = i < 6 ? planes[i].n.x : 0.f;
+				m_ny[i] = i < 6 ? planes[i].n.y : 0.f;
+				m_nz[i] = i < 6 ? planes[i].n.z : 0.f;
+				m_d[i] = i < 6 ? planes[i].d : -1.f;
+				m_absNx[i] = std::abs(m_nx[i]);
+				m_absNy[i] = std::abs(m_ny[i]);
+				m_absNz[i] = std::abs(m_nz[i]);
+			}
+		}
+
+		// false if the box is outside, otherwise planes the box is fully inside are removed from mask
+		bool isAABBIn(const Vector3& vMin, const Vector3& vMax, ui32& planeMask) const
+		{
+			const float cx = (vMin.x + vMax.x) * 0.5f;
+			const float cy = (vMin.y + vMax.y) * 0.5f;
+			const float cz = (vMin.z + vMax.z) * 0.5f;
+			const float ex = (vMax.x - vMin.x) * 0.5f;
+			const float ey = (vMax.y - vMin.y) * 0.5f;
+			const float ez = (vMax.z - vMin.z) * 0.5f;
+
+#ifdef ECHO_SIMD_SSE
+			const __m128 centerX = _mm_set1_ps(cx);
+			const __m128 centerY = _mm_set1_ps(cy);
+			const __m128 centerZ = _mm_set1_ps(cz);
+			const __m128 extentX = _mm_set1_ps(ex);
+			const __m128 extentY = _mm_set1_ps(ey);
+			const __m128 extentZ = _mm_set1_ps(ez);
+			const __m128 signMask = _mm_set1_ps(-0.f);
+
+			ui32 straddle = 0;
+			for (i32 group = 0; group < 2; group++)
+			{
+				const i32 offset = group * 4;
+
+				// signed distance of box center, and projected radius of box extent
+				__m128 dist = _mm_add_ps(_mm_load_ps(m_d + offset), _mm_add_ps(_mm_mul_ps(_mm_load_ps(m_nx + offset), centerX),
+					_mm_add_ps(_mm_mul_ps(_mm_load_ps(m_ny + offset), centerY), _mm_mul_ps(_mm_load_ps(m_nz + offset), centerZ))));
+				__m128 radius = _mm_add_ps(_mm_mul_ps(_mm_load_ps(m_absNx + offset), extentX),
+					_mm_add_ps(_mm_mul_ps(_mm_load_ps(m_absNy + offset), extentY), _mm_mul_ps(_mm_load_ps(m_absNz + offset), extentZ)));
+
+				ui32 groupMask = (planeMask >> offset) & 0xf;
+				ui32 outside = ui32(_mm_movemask_ps(_mm_cmpgt_ps(dist, radius)));
+				if (outside & groupMask)
+					return false;
+
+				straddle |= (ui32(_mm_movemask_ps(_mm_cmpgt_ps(dist, _mm_xor_ps(radius, signMask)))) & groupMask) << offset;
+			}
+
+			planeMask = straddle;
+			return true;
+#else
+			ui32 straddle = 0;
+			for (i32 i = 0; i < 6; i++)
+			{
+				if (planeMask & (1 << i))
+				{
+					float dist = m_nx[i] * cx + m_ny[i] * cy + m_nz[i] * cz + m_d[i];
+					float radius = m_absNx[i] * ex + m_absNy[i] * ey + m_absNz[i] * ez;
+					if (dist > radius)
+						return false;
+
+					if (dist > -radius)
+						straddle |= 1 << i;
+				}
+			}
+
+			planeMask = straddle;
+			return true;
+#endif
+		}
+	};
+}
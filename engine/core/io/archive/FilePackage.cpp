@@ -2,7 +2,9 @@
 #include "engine/core/util/PathUtil.h"
 #include "engine/core/io/memory_reader.h"
 #include "engine/core/io/stream/MemoryDataStream.h"
+#include "engine/core/log/Log.h"
 #include "zlib/zlib.h"
+#include <algorithm>
 
 namespace Echo
 {
@@ -16,15 +18,102 @@ namespace Echo
 		EchoSafeFree(ptr);
 	}
 
+	// reads a compressed entry, inflating one chunk at a time
+	class PackageChunkDataStream : public DataStream
+	{
+	public:
+		PackageChunkDataStream(const ui8* data, const ui64* chunks, size_t size)
+			: m_data(data), m_chunks(chunks)
+		{
+			m_size = size;
+			m_chunk = (ui8*)EchoMalloc(FilePackage::ChunkSize);
+		}
+
+		~PackageChunkDataStream()
+		{
+			EchoSafeFree(m_chunk);
+		}
+
+		// read
+		virtual size_t read(void* buf, size_t count) override
+		{
+			size_t total = 0;
+			ui8* dest = static_cast<ui8*>(buf);
+			while (total < count && m_pos < m_size)
+			{
+				i32 chunkIdx = i32(m_pos / FilePackage::ChunkSize);
+				if (chunkIdx != m_chunkIdx && !decodeChunk(chunkIdx))
+					break;
+
+				size_t chunkPos = m_pos - size_t(chunkIdx) * FilePackage::ChunkSize;
+				size_t copySize = std::min<size_t>(count - total, m_chunkSize - chunkPos);
+				std::memcpy(dest + total, m_chunk + chunkPos, copySize);
+
+				total += copySize;
+				m_pos += copySize;
+			}
+
+			return total;
+		}
+
+		virtual void skip(long count) override
+		{
+			m_pos = std::min<size_t>(size_t(std::max<long>(long(m_pos) + count, 0)), m_size);
+		}
+
+		virtual void seek(size_t pos, int origin = SEEK_SET) override
+		{
+			switch (origin)
+			{
+			case SEEK_SET: m_pos = std::min<size_t>(pos, m_size); break;
+			case SEEK_CUR: skip(long(pos)); break;
+			case SEEK_END: m_pos = pos < m_size ? m_size - pos : 0; break;
+			default: break;
+			}
+		}
+
+		virtual size_t tell(void) const override { return m_pos; }
+		virtual bool eof(void) const override { return m_pos >= m_size; }
+
+	private:
+		// inflate chunk
+		bool decodeChunk(i32 chunkIdx)
+		{
+			unsigned int destLen = static_cast<unsigned int>(std::min<size_t>(FilePackage::ChunkSize, m_size - size_t(chunkIdx) * FilePackage::ChunkSize));
+			const ui8* source = m_data + m_chunks[chunkIdx];
+			unsigned int sourceLen = static_cast<unsigned int>(m_chunks[chunkIdx + 1] - m_chunks[chunkIdx]);
+			if (FilePackage::uncompress(m_chunk, &destLen, source, sourceLen) != Z_OK)
+			{
+				EchoLogError("FilePackage chunk %d is corrupted", chunkIdx);
+				m_chunkIdx = -1;
+				return false;
+			}
+
+			m_chunkIdx = chunkIdx;
+			m_chunkSize = destLen;
+			return true;
+		}
+
+	private:
+		const ui8*		m_data;
+		const ui64*		m_chunks;
+		ui8*			m_chunk = nullptr;
+		i32				m_chunkIdx = -1;
+		size_t			m_chunkSize = 0;
+		size_t			m_pos = 0;
+	};
+
 	FilePackage::FilePackage(const char* packageFile)
 	{
         m_packageFile = packageFile;
         String packageName = PathUtil::GetPureFilename(m_packageFile, false);
-        if(m_reader.load(m_packageFile.c_str()))
+		m_prefix = "Res://" + packageName + "/";
+
+		if (!loadIndexed() && m_reader.load(m_packageFile.c_str()))
         {
             for(const String& name : m_reader.getBinaryNames())
             {
-                m_files["Res://" + packageName + "/" + name] = name;
+                m_files[m_prefix + name] = name;
             }
         }
 	}
@@ -34,8 +123,157 @@ namespace Echo
 
 	}
 
+	bool FilePackage::loadIndexed()
+	{
+		if (!m_file.open(m_packageFile))
+			return false;
+
+		const ui8* data = m_file.getData();
+		size_t size = m_file.getSize();
+		const Header* header = reinterpret_cast<const Header*>(data);
+		if (size < sizeof(Header) || header->m_magic != Magic)
+		{
+			m_file.close();
+			return false;
+		}
+
+		bool isValid = header->m_version == Version &&
+			header->m_bucketsOffset + (size_t(header->m_bucketCount) + 1) * sizeof(ui32) <= size &&
+			header->m_entriesOffset + size_t(header->m_entryCount) * sizeof(Entry) <= size &&
+			header->m_chunksOffset + size_t(header->m_chunkCount) * sizeof(ui64) <= size &&
+			header->m_namesOffset + size_t(header->m_namesSize) <= size &&
+			header->m_bucketCount && !(header->m_bucketCount & (header->m_bucketCount - 1));
+		if (!isValid)
+		{
+			EchoLogError("FilePackage [%s] is invalid or of an unsupported version", m_packageFile.c_str());
+			m_file.close();
+			return true;
+		}
+
+		m_header = header;
+		m_buckets = reinterpret_cast<const ui32*>(data + header->m_bucketsOffset);
+		m_entries = reinterpret_cast<const Entry*>(data + header->m_entriesOffset);
+		m_chunks = reinterpret_cast<const ui64*>(data + header->m_chunksOffset);
+		m_names = reinterpret_cast<const char*>(data + header->m_namesOffset);
+
+		// a corrupted table would send reads outside the mapping
+		if (!isTableValid(size))
+		{
+			EchoLogError("FilePackage [%s] has a corrupted table of contents", m_packageFile.c_str());
+			m_header = nullptr;
+			m_buckets = nullptr;
+			m_entries = nullptr;
+			m_chunks = nullptr;
+			m_names = nullptr;
+			m_file.close();
+		}
+
+		return true;
+	}
+
+	bool FilePackage::isTableValid(size_t fileSize) const
+	{
+		// buckets are ascending ranges of the entry table
+		for (ui32 i = 0; i < m_header->m_bucketCount; i++)
+		{
+			if (m_buckets[i] > m_buckets[i + 1])
+				return false;
+		}
+
+		if (m_buckets[m_header->m_bucketCount] > m_header->m_entryCount)
+			return false;
+
+		for (ui32 i = 0; i < m_header->m_entryCount; i++)
+		{
+			const Entry& entry = m_entries[i];
+			if (entry.m_offset > fileSize || entry.m_storedSize > fileSize - entry.m_offset)
+				return false;
+
+			if (ui64(entry.m_nameOffset) + entry.m_nameLength > m_header->m_namesSize)
+				return false;
+
+			if (Codec(entry.m_codec) == Codec::None)
+			{
+				// read in place
+				if (entry.m_size > entry.m_storedSize)
+					return false;
+			}
+			else if (Codec(entry.m_codec) == Codec::Zlib)
+			{
+				ui64 chunkCount = (entry.m_size + ChunkSize - 1) / ChunkSize + 1;
+				if (entry.m_firstChunk > m_header->m_chunkCount || chunkCount > m_header->m_chunkCount - entry.m_firstChunk)
+					return false;
+
+				// chunk offsets ascend inside the stored data
+				const ui64* chunks = m_chunks + entry.m_firstChunk;
+				for (ui64 chunk = 0; chunk + 1 < chunkCount; chunk++)
+				{
+					if (chunks[chunk] > chunks[chunk + 1])
+						return false;
+				}
+
+				if (chunks[chunkCount - 1] > entry.m_storedSize)
+					return false;
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	ui64 FilePackage::hashName(const char* name, size_t length)
+	{
+		// FNV-1a
+		ui64 hash = 14695981039346656037ULL;
+		for (size_t i = 0; i < length; i++)
+		{
+			hash ^= ui8(name[i]);
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	const FilePackage::Entry* FilePackage::findEntry(const char* fileName) const
+	{
+		if (m_header && std::strncmp(fileName, m_prefix.c_str(), m_prefix.size()) == 0)
+		{
+			const char* name = fileName + m_prefix.size();
+			size_t length = std::strlen(name);
+			ui64 hash = hashName(name, length);
+
+			ui32 bucket = ui32(hash & (m_header->m_bucketCount - 1));
+			for (ui32 i = m_buckets[bucket]; i < m_buckets[bucket + 1]; i++)
+			{
+				const Entry& entry = m_entries[i];
+				if (entry.m_hash == hash && entry.m_nameLength == length && std::memcmp(m_names + entry.m_nameOffset, name, length) == 0)
+					return &entry;
+			}
+		}
+
+		return nullptr;
+	}
+
 	DataStream* FilePackage::open(const char* fileName)
 	{
+		if (m_header)
+		{
+			const Entry* entry = findEntry(fileName);
+			if (entry)
+			{
+				const ui8* data = m_file.getData() + entry->m_offset;
+				if (Codec(entry->m_codec) == Codec::None)
+					return EchoNew(MemoryDataStream(const_cast<ui8*>(data), size_t(entry->m_size), false, true));
+				else if (Codec(entry->m_codec) == Codec::Zlib)
+					return EchoNew(PackageChunkDataStream(data, m_chunks + entry->m_firstChunk, size_t(entry->m_size)));
+			}
+
+			return nullptr;
+		}
+
         auto it = m_files.find(fileName);
         if(it!=m_files.end())
         {
@@ -54,15 +292,25 @@ namespace Echo
 
     bool FilePackage::isExist(const String& filename)
     {
+		if (m_header)
+			return findEntry(filename.c_str()) != nullptr;
+
         return m_files.find(filename) != m_files.end();
     }
 
-	void FilePackage::compressFolder(const char* inFolderPath)
+	void FilePackage::compressFolder(const char* inFolderPath, Codec codec)
 	{
 		String folderPath = inFolderPath;
 		PathUtil::FormatPath(folderPath, false);
 
-		XmlBinaryWriter	writer;
+		struct PackEntry
+		{
+			String				m_name;
+			Entry				m_entry;
+			ByteArray			m_data;
+			vector<ui64>::type	m_chunks;
+		};
+		vector<PackEntry>::type packEntries;
 
 		StringArray allFiles;
 		PathUtil::EnumFilesInDir(allFiles, folderPath, false, true, true);
@@ -71,14 +319,144 @@ namespace Echo
 			MemoryReader fileReader(file);
 			if (fileReader.getSize())
 			{
-				file = StringUtil::Replace(file, folderPath, "");
-				writer.addData(file.c_str(), "Uncompress", fileReader.getData<void*>(), fileReader.getSize());
+				PackEntry packEntry;
+				packEntry.m_name = StringUtil::Replace(file, folderPath, "");
+
+				Entry& entry = packEntry.m_entry;
+				std::memset(&entry, 0, sizeof(Entry));
+				entry.m_hash = hashName(packEntry.m_name.c_str(), packEntry.m_name.size());
+				entry.m_size = fileReader.getSize();
+				entry.m_codec = ui32(Codec::None);
+
+				const ui8* source = fileReader.getData<const ui8*>();
+				if (codec == Codec::Zlib)
+				{
+					// compress chunk by chunk, keep raw data when it doesn't pay off
+					ByteArray compressed;
+					packEntry.m_chunks.emplace_back(0);
+					for (ui32 pos = 0; pos < fileReader.getSize(); pos += ChunkSize)
+					{
+						unsigned int sourceLen = std::min<ui32>(ChunkSize, fileReader.getSize() - pos);
+						unsigned int destLen = static_cast<unsigned int>(compressBound(sourceLen));
+						size_t offset = compressed.size();
+						compressed.resize(offset + destLen);
+						if (FilePackage::compress(compressed.data() + offset, &destLen, source + pos, sourceLen) != Z_OK)
+						{
+							compressed.clear();
+							break;
+						}
+
+						compressed.resize(offset + destLen);
+						packEntry.m_chunks.emplace_back(compressed.size());
+					}
+
+					if (!compressed.empty() && compressed.size() < entry.m_size * 9 / 10)
+					{
+						entry.m_codec = ui32(Codec::Zlib);
+						packEntry.m_data.swap(compressed);
+					}
+					else
+					{
+						packEntry.m_chunks.clear();
+					}
+				}
+
+				if (Codec(entry.m_codec) == Codec::None)
+					packEntry.m_data.assign(source, source + fileReader.getSize());
+
+				entry.m_storedSize = packEntry.m_data.size();
+				packEntries.emplace_back(std::move(packEntry));
 			}
 		}
 
+		// buckets
+		ui32 bucketCount = 1;
+		while (bucketCount < packEntries.size())
+			bucketCount <<= 1;
+
+		std::stable_sort(packEntries.begin(), packEntries.end(), [bucketCount](const PackEntry& a, const PackEntry& b)
+		{
+			return (a.m_entry.m_hash & (bucketCount - 1)) < (b.m_entry.m_hash & (bucketCount - 1));
+		});
+
+		vector<ui32>::type buckets(bucketCount + 1, 0);
+		for (const PackEntry& packEntry : packEntries)
+			buckets[(packEntry.m_entry.m_hash & (bucketCount - 1)) + 1]++;
+
+		for (ui32 i = 0; i < bucketCount; i++)
+			buckets[i + 1] += buckets[i];
+
+		// names and chunks
+		String names;
+		vector<ui64>::type chunks;
+		for (PackEntry& packEntry : packEntries)
+		{
+			packEntry.m_entry.m_nameOffset = ui32(names.size());
+			packEntry.m_entry.m_nameLength = ui32(packEntry.m_name.size());
+			names += packEntry.m_name;
+
+			packEntry.m_entry.m_firstChunk = ui32(chunks.size());
+			chunks.insert(chunks.end(), packEntry.m_chunks.begin(), packEntry.m_chunks.end());
+		}
+
+		// layout
+		auto alignUp = [](ui64 value, ui64 align) { return (value + align - 1) / align * align; };
+
+		Header header;
+		std::memset(&header, 0, sizeof(Header));
+		header.m_magic = Magic;
+		header.m_version = Version;
+		header.m_entryCount = ui32(packEntries.size());
+		header.m_bucketCount = bucketCount;
+		header.m_chunkCount = ui32(chunks.size());
+		header.m_bucketsOffset = sizeof(Header);
+		header.m_entriesOffset = ui32(alignUp(header.m_bucketsOffset + buckets.size() * sizeof(ui32), 8));
+		header.m_chunksOffset = header.m_entriesOffset + header.m_entryCount * sizeof(Entry);
+		header.m_namesOffset = header.m_chunksOffset + header.m_chunkCount * sizeof(ui64);
+		header.m_namesSize = ui32(names.size());
+
+		ui64 offset = alignUp(header.m_namesOffset + header.m_namesSize, PageSize);
+		for (PackEntry& packEntry : packEntries)
+		{
+			packEntry.m_entry.m_offset = offset;
+			offset = alignUp(offset + packEntry.m_entry.m_storedSize, PageSize);
+		}
+
+		// write
 		folderPath.pop_back();
 		String packagPathName = folderPath + ".pkg";
-		writer.save(packagPathName.c_str());
+		FILE* file = fopen(packagPathName.c_str(), "wb");
+		if (!file)
+		{
+			EchoLogError("FilePackage can't write [%s]", packagPathName.c_str());
+			return;
+		}
+
+		ByteArray padding(PageSize, 0);
+		auto writePadding = [&](ui64 position)
+		{
+			ui64 current = ui64(ftell(file));
+			if (position > current)
+				fwrite(padding.data(), 1, size_t(position - current), file);
+		};
+
+		fwrite(&header, sizeof(Header), 1, file);
+		fwrite(buckets.data(), sizeof(ui32), buckets.size(), file);
+		writePadding(header.m_entriesOffset);
+		for (const PackEntry& packEntry : packEntries)
+			fwrite(&packEntry.m_entry, sizeof(Entry), 1, file);
+
+		if (!chunks.empty())
+			fwrite(chunks.data(), sizeof(ui64), chunks.size(), file);
+
+		fwrite(names.data(), 1, names.size(), file);
+		for (const PackEntry& packEntry : packEntries)
+		{
+			writePadding(packEntry.m_entry.m_offset);
+			fwrite(packEntry.m_data.data(), 1, packEntry.m_data.size(), file);
+		}
+
+		fclose(file);
 	}
 
 	int FilePackage::uncompress(unsigned char* dest, unsigned int* destLen, const unsigned char* source, unsigned int sourceLen)
@@ -1,33 +1,100 @@
 #pragma once
 
 #include <engine/core/io/stream/FileHandleDataStream.h>
+#include "engine/core/io/mapped_file.h"
 #include "engine/core/util/XmlBinary.h"
 #include "engine/core/thread/Threading.h"
 
 namespace Echo
 {
+	// Package file: header, hashed table of contents, then page aligned entries.
+	// The file is memory mapped, uncompressed entries are read in place without copy,
+	// compressed entries are split into chunks so reads only inflate what they touch.
+	// Packages of the old xml binary format are still readable.
 	class FilePackage
 	{
+	public:
+		// entry compression
+		enum class Codec : ui32
+		{
+			None = 0,
+			Zlib,
+		};
+
+		static constexpr ui32 Magic = 0x474b5045;		// "EPKG"
+		static constexpr ui32 Version = 1;
+		static constexpr ui32 PageSize = 4096;
+		static constexpr ui32 ChunkSize = 64 * 1024;
+
+		// file header
+		struct Header
+		{
+			ui32	m_magic;
+			ui32	m_version;
+			ui32	m_entryCount;
+			ui32	m_bucketCount;			// power of two, entries are sorted by bucket
+			ui32	m_chunkCount;
+			ui32	m_bucketsOffset;		// ui32[bucketCount + 1], first entry of each bucket
+			ui32	m_entriesOffset;		// Entry[entryCount]
+			ui32	m_chunksOffset;			// ui64[chunkCount], chunk offsets relative to entry data
+			ui32	m_namesOffset;
+			ui32	m_namesSize;
+		};
+
+		// table of contents entry
+		struct Entry
+		{
+			ui64	m_hash;
+			ui64	m_offset;				// page aligned
+			ui64	m_size;					// uncompressed size
+			ui64	m_storedSize;
+			ui32	m_nameOffset;
+			ui32	m_nameLength;
+			ui32	m_codec;
+			ui32	m_firstChunk;			// compressed entries own (size + ChunkSize - 1) / ChunkSize + 1 offsets
+		};
+
 	public:
 		FilePackage(const char* packageFile);
 		~FilePackage();
 
 		// open
 		DataStream* open(const char* fileName);
-        
+
         // is exist
         bool isExist(const String& filename);
-        
-		// add data
-		static void compressFolder(const char* folderPath);
+
+		// add data, entries are compressed when it saves space
+		static void compressFolder(const char* folderPath, Codec codec = Codec::Zlib);
+
+		// hash of entry name
+		static ui64 hashName(const char* name, size_t length);
 
 	private:
+		// load indexed package
+		bool loadIndexed();
+
+		// check buckets and entries stay inside the mapped file and their tables
+		bool isTableValid(size_t fileSize) const;
+
+		// find entry by name relative to the package
+		const Entry* findEntry(const char* fileName) const;
+
 		// compress|uncompress
-		int uncompress(unsigned char* dest, unsigned int* destLen, const unsigned char* source, unsigned int sourceLen);
-		int	compress(unsigned char* dest, unsigned int* destLen, const unsigned char* source, unsigned int sourceLen);
+		static int uncompress(unsigned char* dest, unsigned int* destLen, const unsigned char* source, unsigned int sourceLen);
+		static int compress(unsigned char* dest, unsigned int* destLen, const unsigned char* source, unsigned int sourceLen);
+
+		friend class PackageChunkDataStream;
 
 	private:
         String                      m_packageFile;
+		String						m_prefix;
+		MappedFile					m_file;
+		const Header*				m_header = nullptr;
+		const ui32*					m_buckets = nullptr;
+		const Entry*				m_entries = nullptr;
+		const ui64*					m_chunks = nullptr;
+		const char*					m_names = nullptr;
         map<String,String>::type    m_files;
 		XmlBinaryReader             m_reader;
 	};
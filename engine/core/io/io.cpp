@@ -13,6 +13,8 @@ namespace Echo
 
 	IO::~IO()
 	{
+		for (auto& it : m_preloads)
+			EchoSafeDelete(it.second, MemoryDataStream);
 	}
 
 	IO* IO::instance()
@@ -79,6 +81,21 @@ namespace Echo
 
 	DataStream* IO::open(const String& resourceName, ui32 accessMode)
 	{
+		if (m_preloadCount.load() > 0 && accessMode == DataStream::READ)
+		{
+			EE_LOCK_MUTEX(m_mutex)
+
+			auto it = m_preloads.find(resourceName);
+			if (it != m_preloads.end())
+			{
+				DataStream* stream = it->second;
+				m_preloads.erase(it);
+				m_preloadCount--;
+
+				return stream;
+			}
+		}
+
 		if (StringUtil::StartWith(resourceName, "Res://"))
         {
             DataStream* stream = m_resFileSystem.open(resourceName, accessMode);
@@ -107,6 +124,53 @@ namespace Echo
 		return  nullptr;
 	}
 
+	bool IO::preload(const String& resourceName)
+	{
+		{
+			EE_LOCK_MUTEX(m_mutex)
+			if (m_preloads.find(resourceName) != m_preloads.end())
+				return true;
+		}
+
+		DataStream* stream = open(resourceName);
+		if (!stream)
+			return false;
+
+		MemoryDataStream* memoryStream = EchoNew(MemoryDataStream(stream->size(), true, true));
+		stream->read(memoryStream->getPtr(), stream->size());
+		EchoSafeDelete(stream, DataStream);
+
+		EE_LOCK_MUTEX(m_mutex)
+		auto it = m_preloads.find(resourceName);
+		if (it == m_preloads.end())
+		{
+			m_preloads[resourceName] = memoryStream;
+			m_preloadCount++;
+		}
+		else
+		{
+			EchoSafeDelete(memoryStream, MemoryDataStream);
+		}
+
+		return true;
+	}
+
+	void IO::releasePreload(const String& resourceName)
+	{
+		if (m_preloadCount.load() > 0)
+		{
+			EE_LOCK_MUTEX(m_mutex)
+
+			auto it = m_preloads.find(resourceName);
+			if (it != m_preloads.end())
+			{
+				EchoSafeDelete(it->second, MemoryDataStream);
+				m_preloads.erase(it);
+				m_preloadCount--;
+			}
+		}
+	}
+
 	bool IO::isExist(const String& resourceName)
 	{
         EE_LOCK_MUTEX(m_mutex)
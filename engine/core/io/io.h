@@ -1,12 +1,15 @@
 #pragma once
 
 #include <functional>
+#include <atomic>
 #include "engine/core/base/object.h"
 #include "engine/core/thread/Threading.h"
 #include "stream/DataStream.h"
 #include "memory_reader.h"
 #include "archive/FileSystem.h"
 #include "archive/FilePackage.h"
+#include "stream/MemoryDataStream.h"
+#include <unordered_map>
 
 namespace Echo
 {
@@ -38,6 +41,11 @@ namespace Echo
 		// is resource exist
 		bool isExist(const String& filename);
 
+		// read file into memory ahead of time, thread safe.
+		// the next open of it takes over the data without touching the disk.
+		bool preload(const String& resourceName);
+		void releasePreload(const String& resourceName);
+
 		// convert between fullpath|respath
 		String convertResPathToFullPath(const String& filename);
 		bool convertFullPathToResPath(const String& fullPath, String& resPath);
@@ -60,5 +68,7 @@ namespace Echo
         vector<FilePackage*>::type  m_resFilePackages;
 		FileSystem					m_userFileSystem;				// ("User://")
 		FileSystem					m_externalFileSystem;
+		std::unordered_map<String, MemoryDataStream*>	m_preloads;
+		std::atomic<i32>			m_preloadCount = { 0 };
 	};
 }
@@ -0,0 +1,139 @@
+#include "mapped_file.h"
+
+#ifdef ECHO_PLATFORM_WINDOWS
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif !defined(ECHO_PLATFORM_HTML5)
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+namespace Echo
+{
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+#ifdef ECHO_PLATFORM_WINDOWS
+	bool MappedFile::open(const String& path)
+	{
+		close();
+
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+		{
+			CloseHandle(file);
+			return false;
+		}
+
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+
+		m_fileHandle = file;
+		m_mappingHandle = mapping;
+		m_data = static_cast<ui8*>(data);
+		m_size = size_t(size.QuadPart);
+
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (m_data)
+		{
+			UnmapViewOfFile(m_data);
+			CloseHandle(m_mappingHandle);
+			CloseHandle(m_fileHandle);
+
+			m_data = nullptr;
+			m_size = 0;
+			m_fileHandle = nullptr;
+			m_mappingHandle = nullptr;
+		}
+	}
+#elif defined(ECHO_PLATFORM_HTML5)
+	bool MappedFile::open(const String& path)
+	{
+		close();
+
+		FILE* file = fopen(path.c_str(), "rb");
+		if (!file)
+			return false;
+
+		fseek(file, 0, SEEK_END);
+		long size = ftell(file);
+		fseek(file, 0, SEEK_SET);
+		if (size > 0)
+		{
+			m_data = static_cast<ui8*>(EchoMalloc(size));
+			m_size = fread(m_data, 1, size, file);
+		}
+
+		fclose(file);
+
+		return m_data != nullptr;
+	}
+
+	void MappedFile::close()
+	{
+		EchoSafeFree(m_data);
+		m_size = 0;
+	}
+#else
+	bool MappedFile::open(const String& path)
+	{
+		close();
+
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0)
+		{
+			::close(fd);
+			return false;
+		}
+
+		// the mapping stays valid after the descriptor is closed
+		void* data = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+
+		m_data = static_cast<ui8*>(data);
+		m_size = size_t(st.st_size);
+
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+		if (m_data)
+		{
+			munmap(m_data, m_size);
+			m_data = nullptr;
+			m_size = 0;
+		}
+	}
+#endif
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "engine/core/memory/MemAllocDef.h"
+
+namespace Echo
+{
+	// Read only file mapped into memory, pages are loaded by the os on first touch.
+	// Platforms without mmap read the whole file instead.
+	class MappedFile
+	{
+	public:
+		MappedFile() {}
+		~MappedFile();
+
+		// open|close
+		bool open(const String& path);
+		void close();
+
+		// data
+		const ui8* getData() const { return m_data; }
+		size_t getSize() const { return m_size; }
+		bool isOpen() const { return m_data != nullptr; }
+
+	private:
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+	private:
+		ui8*	m_data = nullptr;
+		size_t	m_size = 0;
+#ifdef ECHO_PLATFORM_WINDOWS
+		void*	m_fileHandle = nullptr;
+		void*	m_mappingHandle = nullptr;
+#endif
+	};
+}
@@ -14,9 +14,11 @@
 #include "engine/core/render/base/pipeline/render_stage.h"
 #include "engine/core/render/base/shader/shader_program.h"
 #include "engine/core/render/base/texture/texture_cube.h"
+#include "engine/core/render/base/texture/texture_streamer.h"
 #include "engine/core/scene/render_node.h"
 #include "engine/core/scene/node_tree.h"
 #include "engine/core/util/Timer.h"
+#include "engine/core/thread/JobSystem.h"
 #include "game_settings.h"
 #include "plugin_settings.h"
 #include "engine/core/script/lua/register_core_to_lua.cx"
@@ -67,6 +69,9 @@ namespace Echo
 	{
 		m_config = cfg;
 
+		// start worker threads, the calling thread becomes job system thread 0
+		JobSystem::instance();
+
         ImageCodecMgr::instance();
         IO::instance();
 
@@ -319,11 +324,15 @@ namespace Echo
 
 		// res
 		Res::updateAll(m_frameTime);
+		TextureStreamer::instance()->update();
 
 		// update logic
 		Module::updateAll(m_frameTime);
 		NodeTree::instance()->update(m_frameTime);
 
+		// modules gathering what nodes produced this frame
+		Module::lateUpdateAll(m_frameTime);
+
 		// render
 		RenderScene::renderAll();
 	}
@@ -49,6 +49,8 @@ namespace Echo
 		CLASS_BIND_METHOD(GameSettings, setRenderPipeline);
 		CLASS_BIND_METHOD(GameSettings, getLaunchScene);
 		CLASS_BIND_METHOD(GameSettings, setLaunchScene);
+		CLASS_BIND_METHOD(GameSettings, isFlatTransformHierarchy);
+		CLASS_BIND_METHOD(GameSettings, setFlatTransformHierarchy);
 
         CLASS_REGISTER_PROPERTY(GameSettings, "FullScreen", Variant::Type::Int, isFullScreen, setFullScreen);
 		CLASS_REGISTER_PROPERTY(GameSettings, "DesignWidth", Variant::Type::Int, getDesignWidth, setDesignWidth);
@@ -58,6 +60,7 @@ namespace Echo
 		CLASS_REGISTER_PROPERTY(GameSettings, "Aspect", Variant::Type::StringOption, getAspect, setAspect);
 		CLASS_REGISTER_PROPERTY(GameSettings, "RenderPipeline", Variant::Type::ResourcePath, getRenderPipeline, setRenderPipeline);
 		CLASS_REGISTER_PROPERTY(GameSettings, "LaunchScene", Variant::Type::ResourcePath, getLaunchScene, setLaunchScene);
+		CLASS_REGISTER_PROPERTY(GameSettings, "FlatTransformHierarchy", Variant::Type::Bool, isFlatTransformHierarchy, setFlatTransformHierarchy);
 	}
 
     void GameSettings::setFullScreen(bool fullScreen)
@@ -65,6 +68,12 @@ namespace Echo
         m_fullScreen = fullScreen;
     }
 
+	void GameSettings::setFlatTransformHierarchy(bool isFlat)
+	{
+		m_flatTransformHierarchy = isFlat;
+		NodeTree::instance()->setFlatTransformHierarchy(isFlat);
+	}
+
 	void GameSettings::setDesignWidth(i32 width) 
 	{ 
 		m_designWidth = width;
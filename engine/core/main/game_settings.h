@@ -61,6 +61,10 @@ namespace Echo
 		void setRenderPipeline(const ResourcePath& path);
 		const ResourcePath& getRenderPipeline() const;
 
+		// flat transform hierarchy for scenes with many nodes
+		void setFlatTransformHierarchy(bool isFlat);
+		bool isFlatTransformHierarchy() const { return m_flatTransformHierarchy; }
+
 		// on size
 		void onSize(ui32 windowWidth, ui32 windowHeight);
 
@@ -78,5 +82,6 @@ namespace Echo
 		StringOption		m_aspect;
 		ResourcePath		m_launchScene;
 		ResourcePath		m_renderPipelinePath;
+		bool				m_flatTransformHierarchy = false;
 	};
 }
@@ -1,16 +1,29 @@
 #include "module.h"
 #include "engine/core/base/object.h"
 #include "engine/core/memory/MemAllocDef.h"
+#include "engine/core/thread/JobSystem.h"
+#include <chrono>
 
 namespace Echo
 {
 	static Module*				  g_currentModule = nullptr;
 	static vector<Module*>::type* g_modules = nullptr;
 
+	// modules of one wave don't conflict with each other, waves update in order
+	static vector<vector<Module*>::type>::type g_updateWaves;
+	static bool								   g_updateWavesDirty = true;
+	static float							   g_updateAllTime = 0.f;
+
+	static ui64 getTimeMicroseconds()
+	{
+		return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
 	void Module::bindMethods()
 	{
 		CLASS_BIND_METHOD(Module, setEnable);
 		CLASS_BIND_METHOD(Module, isEnable);
+		CLASS_BIND_METHOD(Module, getUpdateTime);
 
 		CLASS_REGISTER_PROPERTY(Module, "Enable", Variant::Type::Bool, isEnable, setEnable);
 	}
@@ -26,6 +39,7 @@ namespace Echo
 			g_modules = new vector<Module*>::type;
 
 		g_modules->push_back(module);
+		g_updateWavesDirty = true;
 	}
     
     void Module::clear()
@@ -43,6 +57,8 @@ namespace Echo
             g_modules = nullptr;
         }
         
+        g_updateWaves.clear();
+        g_updateWavesDirty = true;
         g_currentModule = nullptr;
     }
 
@@ -65,14 +81,121 @@ namespace Echo
 		return g_currentModule ? g_currentModule->getName().c_str() : "";
 	}
 
+	void Module::setUpdatePhase(UpdatePhase phase)
+	{
+		m_updatePhase = phase;
+		g_updateWavesDirty = true;
+	}
+
+	void Module::setUpdateAccess(ui32 reads, ui32 writes, bool isMainThread)
+	{
+		m_updateReads = reads;
+		m_updateWrites = writes;
+		m_updateOnMainThread = isMainThread;
+		g_updateWavesDirty = true;
+	}
+
+	bool Module::isUpdateConflict(const Module* other) const
+	{
+		return (m_updateWrites & (other->m_updateReads | other->m_updateWrites)) || (other->m_updateWrites & m_updateReads);
+	}
+
+	void Module::timedUpdate(float elapsedTime)
+	{
+		ui64 beginTime = getTimeMicroseconds();
+
+		update(elapsedTime);
+
+		m_updateTime = (getTimeMicroseconds() - beginTime) * 0.001f;
+	}
+
+	void Module::buildUpdateWaves()
+	{
+		g_updateWaves.clear();
+
+		for (i32 phase = 0; phase < i32(UpdatePhase::Count); phase++)
+		{
+			// a module goes to the wave after the last one holding a conflicting module
+			size_t phaseBegin = g_updateWaves.size();
+			for (Module* module : *g_modules)
+			{
+				if (i32(module->m_updatePhase) != phase)
+					continue;
+
+				size_t wave = phaseBegin;
+				for (size_t i = phaseBegin; i < g_updateWaves.size(); i++)
+				{
+					for (Module* other : g_updateWaves[i])
+					{
+						if (module->isUpdateConflict(other))
+						{
+							wave = i + 1;
+							break;
+						}
+					}
+				}
+
+				if (wave == g_updateWaves.size())
+					g_updateWaves.emplace_back();
+
+				g_updateWaves[wave].emplace_back(module);
+			}
+		}
+
+		g_updateWavesDirty = false;
+	}
+
 	void Module::updateAll(float elapsedTime)
 	{
 		if (g_modules)
 		{
-			for (Module* module : *g_modules)
+			ui64 beginTime = getTimeMicroseconds();
+
+			if (g_updateWavesDirty)
+				buildUpdateWaves();
+
+			JobSystem* jobSystem = JobSystem::instance();
+			for (const vector<Module*>::type& wave : g_updateWaves)
 			{
-				module->update(elapsedTime);
+				if (wave.size() == 1 || jobSystem->getThreadCount() == 1)
+				{
+					for (Module* module : wave)
+						module->timedUpdate(elapsedTime);
+				}
+				else
+				{
+					JobCounter counter;
+					for (Module* module : wave)
+					{
+						if (!module->m_updateOnMainThread)
+							jobSystem->run([module, elapsedTime]() { module->timedUpdate(elapsedTime); }, &counter);
+					}
+
+					for (Module* module : wave)
+					{
+						if (module->m_updateOnMainThread)
+							module->timedUpdate(elapsedTime);
+					}
+
+					jobSystem->wait(counter);
+				}
 			}
+
+			g_updateAllTime = (getTimeMicroseconds() - beginTime) * 0.001f;
 		}
 	}
+
+	void Module::lateUpdateAll(float elapsedTime)
+	{
+		if (g_modules)
+		{
+			for (Module* module : *g_modules)
+				module->lateUpdate(elapsedTime);
+		}
+	}
+
+	float Module::getUpdateAllTime()
+	{
+		return g_updateAllTime;
+	}
 }
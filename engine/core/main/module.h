@@ -11,6 +11,31 @@ namespace Echo
 	{
 		ECHO_VIRTUAL_CLASS(Module, Object);
 
+	public:
+		// Phases update in order, modules of the same phase may update in parallel
+		enum class UpdatePhase
+		{
+			PreUpdate = 0,
+			Physics,
+			Update,
+			PostUpdate,
+			Count
+		};
+
+		// Data touched by update. Modules whose accesses conflict (one writes what the other
+		// reads or writes) update one after another in registration order.
+		enum UpdateAccess : ui32
+		{
+			Access_None			= 0,
+			Access_Nodes		= 1 << 0,		// node tree, transforms, scripts
+			Access_Physics3D	= 1 << 1,
+			Access_Physics2D	= 1 << 2,
+			Access_Navigation	= 1 << 3,
+			Access_Audio		= 1 << 4,
+			Access_Render		= 1 << 5,		// render proxies, gizmos, gpu resources
+			Access_All			= 0xffffffff,
+		};
+
 	public:
 		virtual ~Module() {}
 
@@ -23,6 +48,9 @@ namespace Echo
         // update this module
 		virtual void update(float elapsedTime) {}
 
+		// update after the node tree updated and before rendering, on the main thread
+		virtual void lateUpdate(float elapsedTime) {}
+
 		// enable
 		virtual void setEnable(bool isEnable) { m_isEnable = isEnable; }
 		bool isEnable() const { return m_isEnable; }
@@ -30,6 +58,19 @@ namespace Echo
 		// is for editor
 		virtual bool isEditorOnly() { return false; }
 
+		// update phase
+		void setUpdatePhase(UpdatePhase phase);
+		UpdatePhase getUpdatePhase() const { return m_updatePhase; }
+
+		// update access, a module only updates on worker threads when it's not bound to the main thread
+		void setUpdateAccess(ui32 reads, ui32 writes, bool isMainThread);
+		ui32 getUpdateReads() const { return m_updateReads; }
+		ui32 getUpdateWrites() const { return m_updateWrites; }
+		bool isUpdateOnMainThread() const { return m_updateOnMainThread; }
+
+		// time of the last update (ms)
+		float getUpdateTime() const { return m_updateTime; }
+
 	public:
 		// get all modules
 		static vector<Module*>::type* getAllModules();
@@ -48,13 +89,34 @@ namespace Echo
 
 		// update all modules every frame(ms)
 		static void updateAll(float elapsedTime);
+
+		// late update all modules in registration order
+		static void lateUpdateAll(float elapsedTime);
+
+		// total time of the last updateAll (ms)
+		static float getUpdateAllTime();
         
         // clear all
         static void clear();
 
+	private:
+		// update and record time
+		void timedUpdate(float elapsedTime);
+
+		// group modules of each phase into waves of non conflicting modules
+		static void buildUpdateWaves();
+
+		// does update conflict with other's
+		bool isUpdateConflict(const Module* other) const;
+
 	protected:
 		String			m_name;
 		bool			m_isEnable = true;
+		UpdatePhase		m_updatePhase = UpdatePhase::Update;
+		ui32			m_updateReads = Access_All;
+		ui32			m_updateWrites = Access_All;
+		bool			m_updateOnMainThread = true;
+		float			m_updateTime = 0.f;
 	};
     
     // add module by type
@@ -7,6 +7,7 @@
 #include <thirdparty/spirv-cross/spirv_hlsl.hpp>
 #include <thirdparty/spirv-cross/spirv_msl.hpp>
 #include "engine/core/util/magic_enum.hpp"
+#include "shader_cache.h"
 #include "engine/core/log/Log.h"
 
 const TBuiltInResource k_defaultConf = {
@@ -212,106 +213,179 @@ namespace Echo
     
     std::string GLSLCrossCompiler::getOutput(ShaderLanguage language, ShaderType shaderType)
     {
-		// compile gles to spirv
-		compileGlslToSpirv();
+        String target = String(magic_enum::enum_name(language)) + "." + String(magic_enum::enum_name(shaderType));
+        ui64 cacheKey = ShaderCache::makeKey(m_inputGlsl, ShaderType::Total, target.c_str());
 
-		// cross compile spirv to target language
-		switch (language)
-		{
-		case ShaderLanguage::GLES: return compileSpirvToGles(shaderType);
-		case ShaderLanguage::GLSL: return compileSpirvToGlsl(shaderType);
-		case ShaderLanguage::MSL:  return compileSpirvToMsl(shaderType);
-		case ShaderLanguage::HLSL: return compileSpirvToHlsl(shaderType);
-		}
+        std::string output;
+        ByteArray cached;
+        bool isCached = ShaderCache::load(cacheKey, cached);
+        if (isCached)
+        {
+            output.assign(cached.begin(), cached.end());
+        }
+        else
+        {
+            // compile gles to spirv
+            compileGlslToSpirv();
 
-        return std::string();
+            // cross compile spirv to target language
+            switch (language)
+            {
+            case ShaderLanguage::GLES: output = compileSpirvToGles(shaderType); break;
+            case ShaderLanguage::GLSL: output = compileSpirvToGlsl(shaderType); break;
+            case ShaderLanguage::MSL:  output = compileSpirvToMsl(shaderType);  break;
+            case ShaderLanguage::HLSL: output = compileSpirvToHlsl(shaderType); break;
+            }
+        }
+
+        if (!isCached || !m_cacheFolder.empty())
+            ShaderCache::save(cacheKey, output.data(), output.size(), m_cacheFolder);
+
+        return output;
     }
     
     void GLSLCrossCompiler::compileGlslToSpirv()
     {
-		if (m_isNeedUpdateSpriv)
-		{
-			// initialize process (wrong place)
-			glslang::InitializeProcess();
+        if (m_isNeedUpdateSpriv)
+        {
+            // cache entry: word count of each stage, then the words
+            ui64 cacheKey = ShaderCache::makeKey(m_inputGlsl, ShaderType::Total, "SPIRV");
+            ByteArray cached;
+            bool isCached = false;
+            if (ShaderCache::load(cacheKey, cached) && cached.size() >= sizeof(ui32) * ShaderType::Total)
+            {
+                ui32 counts[ShaderType::Total];
+                std::memcpy(counts, cached.data(), sizeof(counts));
 
-			// create shader program
-			glslang::TProgram* prog = EchoNew(glslang::TProgram);
+                size_t totalCount = 0;
+                for (int i = 0; i < ShaderType::Total; i++)
+                    totalCount += counts[i];
 
-			// shader
-			glslang::TShader* shaders[ShaderType::Total] = { nullptr, nullptr, nullptr };
-			EShLanguage types[ShaderType::Total] = { EShLangVertex, EShLangFragment, EShLangCompute };
-			for (int i = 0; i < ShaderType::Total; i++)
+                if (cached.size() == sizeof(counts) + totalCount * sizeof(ui32))
+                {
+                    const Byte* words = cached.data() + sizeof(counts);
+                    for (int i = 0; i < ShaderType::Total; i++)
+                    {
+                        m_spirv[i].resize(counts[i]);
+                        std::memcpy(m_spirv[i].data(), words, counts[i] * sizeof(ui32));
+                        words += counts[i] * sizeof(ui32);
+                    }
+
+                    isCached = true;
+                }
+            }
+
+            bool isCompiled = isCached || compileGlslToSpirvWithGlslang();
+            if (isCompiled && (!isCached || !m_cacheFolder.empty()))
+            {
+                ByteArray entry(sizeof(ui32) * ShaderType::Total);
+                for (int i = 0; i < ShaderType::Total; i++)
+                {
+                    ui32 count = static_cast<ui32>(m_spirv[i].size());
+                    std::memcpy(entry.data() + sizeof(ui32) * i, &count, sizeof(ui32));
+
+                    const Byte* words = reinterpret_cast<const Byte*>(m_spirv[i].data());
+                    entry.insert(entry.end(), words, words + count * sizeof(ui32));
+                }
+
+                ShaderCache::save(cacheKey, entry.data(), entry.size(), m_cacheFolder);
+            }
+
+            m_isNeedUpdateSpriv = false;
+        }
+    }
+
+    bool GLSLCrossCompiler::compileGlslToSpirvWithGlslang()
+    {
+		bool isSucceed = true;
+
+		// initialize process (wrong place)
+		glslang::InitializeProcess();
+
+		// create shader program
+		glslang::TProgram* prog = EchoNew(glslang::TProgram);
+
+		// shader
+		glslang::TShader* shaders[ShaderType::Total] = { nullptr, nullptr, nullptr };
+		EShLanguage types[ShaderType::Total] = { EShLangVertex, EShLangFragment, EShLangCompute };
+		for (int i = 0; i < ShaderType::Total; i++)
+		{
+			m_spirv[i].clear();
+			if (!m_inputGlsl[i].empty())
 			{
-				if (!m_inputGlsl[i].empty())
+				const char* shaderSrc = m_inputGlsl[i].c_str();
+				int shaderLen = m_inputGlsl[i].size();
+				int defaultVersion = 100; // 110 for desktop
+
+				glslang::TShader* shader = shaders[i] = EchoNew(glslang::TShader(types[i]));
+				shader->setStringsWithLengths(&shaderSrc, &shaderLen, 1);
+				shader->setInvertY(false);
+				shader->setEnvInput(glslang::EShSourceGlsl, types[i], glslang::EShClientVulkan, defaultVersion);
+				shader->setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
+				shader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
+				shader->setPreamble(getPreamble());
+				shader->addProcesses(getProcesses());
+
+				// parse
+				Includer  inc;
+				if (shader->parse(&k_defaultConf, defaultVersion, false, EShMsgDefault, inc))
 				{
-					const char* shaderSrc = m_inputGlsl[i].c_str();
-					int shaderLen = m_inputGlsl[i].size();
-					int defaultVersion = 100; // 110 for desktop
-
-					glslang::TShader* shader = shaders[i] = EchoNew(glslang::TShader(types[i]));
-					shader->setStringsWithLengths(&shaderSrc, &shaderLen, 1);
-					shader->setInvertY(false);
-					shader->setEnvInput(glslang::EShSourceGlsl, types[i], glslang::EShClientVulkan, defaultVersion);
-					shader->setEnvClient(glslang::EShClientVulkan, glslang::EShTargetVulkan_1_1);
-					shader->setEnvTarget(glslang::EShTargetSpv, glslang::EShTargetSpv_1_0);
-					shader->setPreamble(getPreamble());
-					shader->addProcesses(getProcesses());
-
-					// parse
-					Includer  inc;
-					if (shader->parse(&k_defaultConf, defaultVersion, false, EShMsgDefault, inc))
-					{
-						prog->addShader(shader);
-					}
-					else
+					prog->addShader(shader);
+				}
+				else
+				{
+                    std::string shaderType = std::string(magic_enum::enum_name(ShaderType(i)));
+					StringArray lines = StringUtil::Split(shader->getInfoLog(), "\n");
+					for (String& line : lines)
 					{
-                        std::string shaderType = std::string(magic_enum::enum_name(ShaderType(i)));
-						StringArray lines = StringUtil::Split(shader->getInfoLog(), "\n");
-						for (String& line : lines)
-						{
-							EchoLogError(("[GLSLCrossCompiler - %s] " + line).c_str(), shaderType.c_str());
-						}
+						EchoLogError(("[GLSLCrossCompiler - %s] " + line).c_str(), shaderType.c_str());
 					}
+
+					isSucceed = false;
 				}
 			}
+		}
 
-			// link
-			EShMessages messages = EShMsgDefault;
-			if (prog->link(messages))
+		// link
+		EShMessages messages = EShMsgDefault;
+		if (isSucceed && prog->link(messages))
+		{
+			// Output and save SPIR-V for each shader
+			for (int i = 0; i < ShaderType::Total; i++)
 			{
-				// Output and save SPIR-V for each shader
-				for (int i = 0; i < ShaderType::Total; i++)
+				glslang::TIntermediate* intermediate = prog->getIntermediate(types[i]);
+				if (intermediate)
 				{
-					glslang::TIntermediate* intermediate = prog->getIntermediate(types[i]);
-					if (intermediate)
+					glslang::SpvOptions spvOptions;
+					spvOptions.validate = true;
+					spv::SpvBuildLogger spvBuildLogger;
+					glslang::GlslangToSpv(*intermediate, m_spirv[i], &spvBuildLogger, &spvOptions);
+					std::string messages = spvBuildLogger.getAllMessages();
+					if (!messages.empty())
 					{
-						glslang::SpvOptions spvOptions;
-						spvOptions.validate = true;
-						spv::SpvBuildLogger spvBuildLogger;
-						glslang::GlslangToSpv(*intermediate, m_spirv[i], &spvBuildLogger, &spvOptions);
-						std::string messages = spvBuildLogger.getAllMessages();
-						if (!messages.empty())
-						{
-							EchoLogError(messages.c_str());
-						}
+						EchoLogError(messages.c_str());
 					}
 				}
 			}
+		}
+		else
+		{
+			isSucceed = false;
+		}
 
-			// deallocate shaders
-			for (int i = 0; i < ShaderType::Total; i++)
-			{
-				EchoSafeDelete(shaders[i], TShader);
-			}
+		// deallocate shaders
+		for (int i = 0; i < ShaderType::Total; i++)
+		{
+			EchoSafeDelete(shaders[i], TShader);
+		}
 
-			// deallocate program
-			EchoSafeDelete(prog, TProgram);;
+		// deallocate program
+		EchoSafeDelete(prog, TProgram);;
 
-			// finalize process (wrong place)
-			glslang::FinalizeProcess();
+		// finalize process (wrong place)
+		glslang::FinalizeProcess();
 
-			m_isNeedUpdateSpriv = false;
-		}
+		return isSucceed;
     }
 
     std::string GLSLCrossCompiler::compileSpirvToGles(ShaderType shaderType)
@@ -417,6 +491,9 @@ namespace Echo
 	const char* GLSLCrossCompiler::getPreamble()
 	{
 		static std::string preambles;
+		if (!preambles.empty())
+			return preambles.c_str();
+
 		preambles += "#extension GL_GOOGLE_include_directive : require\n";
 		preambles += "#define POSITION 0\n";
 		preambles += "#define NORMAL 1\n";
@@ -32,6 +32,9 @@ namespace Echo
     public:
         // set input (glsl)
         void setInput(const char* vs, const char* fs, const char* cs);
+
+        // write every result to folder instead of only new compiles to the user cache, for precompiling
+        void setCacheFolder(const String& folder) { m_cacheFolder = folder; }
         
         // get spirv (for vulkan)
         const vector<ui32>::type& getSPIRV(ShaderType Type);
@@ -40,8 +43,9 @@ namespace Echo
         std::string getOutput(ShaderLanguage language, ShaderType shaderType);
         
     private:
-        // compile glsl to spirv
+        // compile glsl to spirv, cached
         void compileGlslToSpirv();
+        bool compileGlslToSpirvWithGlslang();
 
 		// compile spirv to cross
         std::string compileSpirvToGles(ShaderType shaderType);
@@ -61,5 +65,6 @@ namespace Echo
 		bool				m_isNeedUpdateOutput= true;
         String              m_inputGlsl[ShaderType::Total];	// input shaders (glsl vulkan)
         vector<ui32>::type  m_spirv[ShaderType::Total];		// standard portabble intermediate representation
+        String              m_cacheFolder;
     };
 }
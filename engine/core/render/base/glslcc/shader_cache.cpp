@@ -0,0 +1,164 @@
+#include "shader_cache.h"
+#include "glsl_cross_compiler.h"
+#include "engine/core/io/IO.h"
+#include "engine/core/io/memory_reader.h"
+#include "engine/core/util/PathUtil.h"
+#include "engine/core/log/Log.h"
+#include "base/shader/material.h"
+
+namespace Echo
+{
+    static bool g_isShaderCacheEnable = true;
+
+    void ShaderCache::setEnable(bool isEnable)
+    {
+        g_isShaderCacheEnable = isEnable;
+    }
+
+    bool ShaderCache::isEnable()
+    {
+        return g_isShaderCacheEnable;
+    }
+
+    ui64 ShaderCache::makeKey(const String* sources, ui32 count, const char* target)
+    {
+        // FNV-1a, lengths are hashed too so moving text between sources changes the key
+        ui64 hash = 14695981039346656037ULL;
+        auto hashBytes = [&hash](const void* data, size_t size)
+        {
+            const ui8* bytes = static_cast<const ui8*>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+
+        ui32 version = Version;
+        hashBytes(&version, sizeof(version));
+        hashBytes(target, strlen(target));
+        for (ui32 i = 0; i < count; i++)
+        {
+            ui64 length = sources[i].size();
+            hashBytes(&length, sizeof(length));
+            hashBytes(sources[i].data(), sources[i].size());
+        }
+
+        return hash;
+    }
+
+    String ShaderCache::getFileName(ui64 key)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+
+        return name;
+    }
+
+    bool ShaderCache::load(ui64 key, ByteArray& data)
+    {
+        if (g_isShaderCacheEnable)
+        {
+            String fileName = getFileName(key);
+            for (const char* folder : { "User://ShaderCache/", "Res://ShaderCache/" })
+            {
+                String path = folder + fileName;
+                if (IO::instance()->isExist(path))
+                {
+                    MemoryReader reader(path);
+                    if (reader.getSize())
+                    {
+                        data.assign(reader.getData<const Byte*>(), reader.getData<const Byte*>() + reader.getSize());
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    bool ShaderCache::save(ui64 key, const void* data, size_t size, const String& folder)
+    {
+        if (!g_isShaderCacheEnable || !size)
+            return false;
+
+        String fullFolder = folder.empty() ? IO::instance()->convertResPathToFullPath("User://ShaderCache/") : folder;
+        if (!PathUtil::IsDirExist(fullFolder))
+            PathUtil::CreateDir(fullFolder);
+
+        String fullPath = fullFolder + getFileName(key);
+        FILE* file = fopen(fullPath.c_str(), "wb");
+        if (file)
+        {
+            fwrite(data, 1, size, file);
+            fclose(file);
+
+            return true;
+        }
+
+        EchoLogError("ShaderCache can't write file [%s]", fullPath.c_str());
+        return false;
+    }
+
+    ui32 ShaderCache::precompile(const String& outputFolder)
+    {
+        ui32 count = 0;
+
+        StringArray allFiles;
+        PathUtil::EnumFilesInDir(allFiles, IO::instance()->convertResPathToFullPath("Res://"), false, true, true);
+        for (const String& file : allFiles)
+        {
+            String resPath;
+            if (!IO::instance()->convertFullPathToResPath(file, resPath))
+                continue;
+
+            // materials compile their shader with their own macros
+            String ext = PathUtil::GetFileExt(file, true);
+            StringUtil::LowerCase(ext);
+
+            String shaderPath;
+            StringArray macros;
+            if (ext == ".material")
+            {
+                ResRef<Material> material = ECHO_DOWN_CAST<Material*>(Res::get(resPath));
+                if (!material)
+                    continue;
+
+                shaderPath = material->getShaderPath().getPath();
+                macros = material->getMacros();
+            }
+            else if (ext == ".shader")
+            {
+                shaderPath = resPath;
+            }
+
+            if (shaderPath.empty())
+                continue;
+
+            ShaderProgramPtr shader = ECHO_DOWN_CAST<ShaderProgram*>(Res::get(shaderPath));
+            if (!shader || shader->getType() != "glsl")
+                continue;
+
+            String vsSrc = shader->getVsCode();
+            String psSrc = shader->getPsCode();
+            ShaderProgram::insertMacros(macros, vsSrc);
+            ShaderProgram::insertMacros(macros, psSrc);
+
+            // every target, the device of the build is not known here
+            GLSLCrossCompiler glslCompiler;
+            glslCompiler.setCacheFolder(outputFolder);
+            glslCompiler.setInput(vsSrc.c_str(), psSrc.c_str(), nullptr);
+            glslCompiler.getSPIRV(GLSLCrossCompiler::ShaderType::VS);
+            for (GLSLCrossCompiler::ShaderLanguage language : { GLSLCrossCompiler::ShaderLanguage::GLES, GLSLCrossCompiler::ShaderLanguage::MSL })
+            {
+                glslCompiler.getOutput(language, GLSLCrossCompiler::ShaderType::VS);
+                glslCompiler.getOutput(language, GLSLCrossCompiler::ShaderType::FS);
+            }
+
+            count++;
+        }
+
+        return count;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "engine/core/util/StringUtil.h"
+
+namespace Echo
+{
+    /**
+     * Content hashed cache of cross compiled shaders. A key hashes the glsl sources (macros are
+     * already inserted), the target and the cache version, so an edited shader misses instead of
+     * going stale. Entries are looked up in User://ShaderCache/, then in Res://ShaderCache/ which
+     * is precompiled when a project is built. New compiles are written to the user cache.
+     */
+    class ShaderCache
+    {
+    public:
+        static constexpr ui32 Version = 1;      // bump when the compiler or its options change
+
+    public:
+        // enable, on by default
+        static void setEnable(bool isEnable);
+        static bool isEnable();
+
+        // key of sources for a target
+        static ui64 makeKey(const String* sources, ui32 count, const char* target);
+
+        // load entry
+        static bool load(ui64 key, ByteArray& data);
+
+        // save entry, to the user cache if folder is empty
+        static bool save(ui64 key, const void* data, size_t size, const String& folder = StringUtil::BLANK);
+
+        // compile shaders of all materials and shader files of the project for every target, returns the count
+        static ui32 precompile(const String& outputFolder);
+
+    private:
+        // file name of key
+        static String getFileName(ui64 key);
+    };
+}
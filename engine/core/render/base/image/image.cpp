@@ -7,6 +7,7 @@
 #include "image_resampler.h"
 #include "image_codec.h"
 #include "image_codec_mgr.h"
+#include "base/texture/texture_streamer.h"
 
 
 namespace Echo
@@ -82,6 +83,10 @@ namespace Echo
 
 	Image* Image::createFromMemory(const Buffer &inBuff, ImageFormat imgFmt)
 	{
+		// cooked textures keep their source extension
+		if (TextureStreamer::isCooked(inBuff.getData(), inBuff.getSize()))
+			return TextureStreamer::createImage(inBuff.getData(), inBuff.getSize());
+
 		ImageCodec* pImgCodec = ImageCodecMgr::instance()->getCodec(imgFmt);
 		if(!pImgCodec)
 		{
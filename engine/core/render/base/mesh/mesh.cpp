@@ -106,12 +106,12 @@ namespace Echo
 
 	ui32 Mesh::getIndexCount() const
 	{
-		return m_idxCount;
+		return std::min<ui32>(m_idxCount, m_drawIdxCount);
 	}
 
 	ui32 Mesh::getPrimitiveCount() const
 	{
-		ui32 count = m_indexBuffer ? m_idxCount : getVertexCount();
+		ui32 count = m_indexBuffer ? getIndexCount() : getVertexCount();
 		switch (m_topologyType)
 		{
 		case TT_POINTLIST:		return count;
@@ -242,11 +242,16 @@ namespace Echo
 	{
 		m_vertData = vertexData;
 
-		// calculate local aabb
+		updateVertexs();
+	}
+
+	void Mesh::updateVertexs()
+	{
+		// calculate local aabb, addressed by int as 32 bit indexed meshes pass 65535 vertices
 		m_box.reset();
 		for (i32 i = 0; i < m_vertData.getVertexCount(); i++)
 		{
-			m_box.addPoint(m_vertData.getPosition(i));
+			m_box.addPoint(*(const Vector3*)(m_vertData.getVertice(i) + m_vertData.getFormat().m_posOffset));
 		}
 
 		buildVertexBuffer();
@@ -354,9 +359,9 @@ namespace Echo
 
 		// indices
 		pugi::xml_node indices = root.append_child("indices");
-		indices.append_attribute("count").set_value(getIndexCount());
+		indices.append_attribute("count").set_value(m_idxCount);
 		indices.append_attribute("stride").set_value(getIndexStride());
-		writer.addData("Indices", StringUtil::Format("Byte%d", getIndexStride()).c_str(), getIndices(), getIndexCount() * getIndexStride());
+		writer.addData("Indices", StringUtil::Format("Byte%d", getIndexStride()).c_str(), getIndices(), m_idxCount * m_idxStride);
 
 		// vertex
 		pugi::xml_node vertex = root.append_child("vertex");
@@ -64,6 +64,9 @@ namespace Echo
 		// get index count
 		ui32 getIndexCount() const;
 
+		// draw the first count indices only, the index buffer keeps all of them
+		void setDrawIndexCount(ui32 count) { m_drawIdxCount = count; }
+
 		// get index stride
 		ui32 getIndexStride() const;
 
@@ -110,6 +113,9 @@ namespace Echo
 		void updateVertexs(const MeshVertexFormat& format, ui32 vertCount, const Byte* vertices);
 		void updateVertexs(const MeshVertexData& vertexData);
 
+		// vertex data was written in place through getVertexData()
+		void updateVertexs();
+
 		// clear
 		void clear();
 
@@ -140,6 +146,7 @@ namespace Echo
 		ui32						m_startVert = 0;
 		ui32						m_startIdx = 0;
 		ui32						m_idxCount = 0;
+		ui32						m_drawIdxCount = 0xFFFFFFFF;
 		ui32						m_idxStride = 0;
 		vector<Byte>::type			m_indices;
 		MeshVertexData				m_vertData;
@@ -91,11 +91,11 @@ namespace Echo
 		}
 	}
 
-	void RenderPipeline::addRenderable(const String& name, RenderableID id)
+	void RenderPipeline::addRenderable(const String& name, RenderProxyHandle handle)
 	{
 		for (RenderStage* stage : m_stages)
 		{
-			stage->addRenderable(name, id);
+			stage->addRenderable(name, handle);
 		}
 	}
 
@@ -21,7 +21,7 @@ namespace Echo
 		virtual ~RenderPipeline();
 
 		// add render able
-		void addRenderable(const String& name, RenderableID id);
+		void addRenderable(const String& name, RenderProxyHandle handle);
 
 		// on Resize
 		void onSize(ui32 width, ui32 height);
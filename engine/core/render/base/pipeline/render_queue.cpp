@@ -13,13 +13,102 @@ namespace Echo
 	{
 		CLASS_BIND_METHOD(RenderQueue, isSort);
 		CLASS_BIND_METHOD(RenderQueue, setSort);
+		CLASS_BIND_METHOD(RenderQueue, isStateSort);
+		CLASS_BIND_METHOD(RenderQueue, setStateSort);
+		CLASS_BIND_METHOD(RenderQueue, isInstancing);
+		CLASS_BIND_METHOD(RenderQueue, setInstancing);
 		CLASS_BIND_METHOD(RenderQueue, getCameraFilter);
 		CLASS_BIND_METHOD(RenderQueue, setCameraFilter);
 
 		CLASS_REGISTER_PROPERTY(RenderQueue, "Sort", Variant::Type::Bool, isSort, setSort);
+		CLASS_REGISTER_PROPERTY(RenderQueue, "StateSort", Variant::Type::Bool, isStateSort, setStateSort);
+		CLASS_REGISTER_PROPERTY(RenderQueue, "Instancing", Variant::Type::Bool, isInstancing, setInstancing);
 		CLASS_REGISTER_PROPERTY(RenderQueue, "CameraFilter", Variant::Type::Int, getCameraFilter, setCameraFilter);
 	}
 
+	// map a float to an unsigned integer with the same ordering
+	static ui32 toSortableBits(float value)
+	{
+		ui32 bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+	}
+
+	ui64 RenderQueue::calcDistanceSortKey(RenderProxy* proxy)
+	{
+		Render* node = proxy->getNode();
+		Camera* camera = node ? node->getCamera() : nullptr;
+		if (camera)
+		{
+			Vector3 v = node->getWorldPosition() - camera->getPosition();
+			float len = v.dot(camera->getForward());
+			len += node->getRenderType().getIdx() == 1 ? 1e6f : 0.f;
+
+			// far to near, then by order
+			return (ui64(~toSortableBits(len)) << 32) | proxy->getOrder();
+		}
+
+		return ~ui64(0);
+	}
+
+	ui64 RenderQueue::calcStateSortKey(RenderProxy* proxy)
+	{
+		// | render type 4 | shader 16 | material 16 | mesh 16 | depth 12 |
+		Render* node = proxy->getNode();
+		Material* material = proxy->getMaterial();
+		ShaderProgram* shader = material ? material->getShader() : nullptr;
+		Mesh* mesh = proxy->getMesh();
+		Camera* camera = node ? node->getCamera() : nullptr;
+
+		ui64 renderType = node ? ui64(node->getRenderType().getIdx() & 0xF) : 0;
+		ui64 shaderId = shader ? ui64(shader->getId() & 0xFFFF) : 0;
+		ui64 materialId = material ? ui64(material->getId() & 0xFFFF) : 0;
+		ui64 meshId = mesh ? ui64(mesh->getId() & 0xFFFF) : 0;
+
+		// near to far inside camera range
+		ui64 depth = 0;
+		if (camera)
+		{
+			Vector3 v = node->getWorldPosition() - camera->getPosition();
+			float ratio = Math::Clamp(v.dot(camera->getForward()) / std::max<float>(camera->getFar(), 1e-3f), 0.f, 1.f);
+			depth = ui64(ratio * 4095.f);
+		}
+
+		return (renderType << 60) | (shaderId << 44) | (materialId << 28) | (meshId << 12) | depth;
+	}
+
+	bool RenderQueue::isInstanceCompatible(RenderProxy* first, RenderProxy* proxy)
+	{
+		if (proxy->getMaterial() != first->getMaterial() || proxy->getMesh().ptr() != first->getMesh().ptr() || proxy->getCamera() != first->getCamera())
+			return false;
+
+		Render* firstNode = first->getNode();
+		Render* node = proxy->getNode();
+		if (node == firstNode)
+			return true;
+
+		// the world matrix comes from the instance buffer, every other node uniform is shared by the draw
+		ShaderProgram* shader = first->getMaterial() ? first->getMaterial()->getShader() : nullptr;
+		if (!shader || !firstNode || !node)
+			return false;
+
+		for (ShaderProgram::UniformMap& uniformMap : shader->getUniforms())
+		{
+			for (auto& it : uniformMap)
+			{
+				if (it.second->m_type == SPT_TEXTURE || it.first == "u_WorldMatrix")
+					continue;
+
+				const void* firstValue = firstNode->getGlobalUniformValue(it.first);
+				const void* value = node->getGlobalUniformValue(it.first);
+				if (firstValue != value && (!firstValue || !value || std::memcmp(firstValue, value, it.second->m_sizeInBytes) != 0))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
 	void RenderQueue::render(FrameBufferPtr& frameBuffer)
 	{
 		onRenderBegin();
@@ -27,49 +116,59 @@ namespace Echo
 			Renderer* render = Renderer::instance();
 			if (render)
 			{
-				if (m_sort)
+				// resolve proxies and compute sort keys once per frame
+				m_sortItems.clear();
+				m_sortItems.reserve(m_renderables.size());
+				for (RenderProxyHandle handle : m_renderables)
 				{
-					std::sort(m_renderables.begin(), m_renderables.end(), [](RenderableID a, RenderableID b) -> bool
+					RenderProxy* proxy = render->getRenderProxy(handle);
+					if (proxy)
 					{
-						RenderProxy* renderproxyA = Renderer::instance()->getRenderProxy(a);
-						RenderProxy* renderproxyB = Renderer::instance()->getRenderProxy(b);
-						if (renderproxyA && renderproxyB)
-						{
-							Render* nodeA = renderproxyA->getNode();
-							Render* nodeB = renderproxyB->getNode();
-
-							Camera* cameraA = nodeA->getCamera();
-							Camera* cameraB = nodeB->getCamera();
-
-							Vector3 vA = nodeA->getWorldPosition() - cameraA->getPosition();
-							Vector3 vB = nodeB->getWorldPosition() - cameraB->getPosition();
-
-							float lenA = vA.dot(cameraA->getForward());
-							float lenB = vB.dot(cameraB->getForward());
-
-							lenA += nodeA->getRenderType().getIdx() == 1 ? 1e6f : 0.f;
-							lenB += nodeB->getRenderType().getIdx() == 1 ? 1e6f : 0.f;
-
-							return lenA > lenB;
-						}
-						else
-						{
-							return false;
-						}
-					});
+						ui64 key = m_sort ? calcDistanceSortKey(proxy) : (m_stateSort ? calcStateSortKey(proxy) : 0);
+						m_sortItems.push_back({ key, proxy });
+					}
 				}
 
+				if (m_sort || m_stateSort)
+					std::stable_sort(m_sortItems.begin(), m_sortItems.end());
+
 				// render
-				for (RenderableID id : m_renderables)
-				{
-					RenderProxy* renderable = Renderer::instance()->getRenderProxy(id);
-					if (renderable)
-						render->draw(renderable, frameBuffer);
-				}
+				drawItems(frameBuffer);
 			}
 
 			m_renderables.clear();
 		}
 		onRenderEnd();
 	}
+
+	void RenderQueue::drawItems(FrameBufferPtr& frameBuffer)
+	{
+		Renderer* render = Renderer::instance();
+		for (size_t i = 0; i < m_sortItems.size();)
+		{
+			RenderProxy* proxy = m_sortItems[i].m_proxy;
+
+			size_t end = i + 1;
+			if (m_instancing)
+			{
+				while (end < m_sortItems.size() && isInstanceCompatible(proxy, m_sortItems[end].m_proxy))
+					end++;
+			}
+
+			if (end - i > 1)
+			{
+				m_instances.clear();
+				for (size_t j = i; j < end; j++)
+					m_instances.emplace_back(m_sortItems[j].m_proxy);
+
+				render->drawInstanced(m_instances.data(), ui32(m_instances.size()), frameBuffer);
+			}
+			else
+			{
+				render->draw(proxy, frameBuffer);
+			}
+
+			i = end;
+		}
+	}
 }
\ No newline at end of file
@@ -10,6 +10,17 @@ namespace Echo
 	{
 		ECHO_CLASS(RenderQueue, IRenderQueue)
 
+	public:
+		// sort item, key is computed once per frame
+		struct SortItem
+		{
+			ui64			m_key;
+			RenderProxy*	m_proxy;
+
+			bool operator < (const SortItem& other) const { return m_key < other.m_key; }
+		};
+		typedef vector<SortItem>::type SortItems;
+
 	public:
 		RenderQueue() {}
 		virtual ~RenderQueue();
@@ -18,19 +29,42 @@ namespace Echo
 		virtual void render(FrameBufferPtr& frameBuffer);
 
 		// add render able
-		void addRenderable(RenderableID id) { m_renderables.emplace_back(id); }
+		void addRenderable(RenderProxyHandle handle) { m_renderables.emplace_back(handle); }
 
-		// sort
+		// sort back to front by camera distance
 		void setSort(bool isSort) { m_sort = isSort; }
 		bool isSort() const { return m_sort; }
 
+		// sort by render state (shader/material/mesh), front to back
+		void setStateSort(bool isStateSort) { m_stateSort = isStateSort; }
+		bool isStateSort() const { return m_stateSort; }
+
+		// merge consecutive proxies sharing mesh and material into instanced draws
+		void setInstancing(bool isInstancing) { m_instancing = isInstancing; }
+		bool isInstancing() const { return m_instancing; }
+
 		// filter
 		void setCameraFilter(i32 filter) { m_cameraFilter = filter; }
 		i32 getCameraFilter() const { return m_cameraFilter; }
 
 	protected:
-		bool							m_sort;
+		// sort key
+		static ui64 calcDistanceSortKey(RenderProxy* proxy);
+		static ui64 calcStateSortKey(RenderProxy* proxy);
+
+		// proxy can join the instanced draw of first, only their world matrices may differ
+		static bool isInstanceCompatible(RenderProxy* first, RenderProxy* proxy);
+
+		// draw sorted items
+		void drawItems(FrameBufferPtr& frameBuffer);
+
+	protected:
+		bool							m_sort = false;
+		bool							m_stateSort = false;
+		bool							m_instancing = false;
 		i32								m_cameraFilter = 0xFFFFFFFF;
-		vector<RenderableID>::type		m_renderables;
+		vector<RenderProxyHandle>::type	m_renderables;
+		SortItems						m_sortItems;
+		vector<RenderProxy*>::type		m_instances;
 	};
 }
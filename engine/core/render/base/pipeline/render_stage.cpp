@@ -93,7 +93,7 @@ namespace Echo
 		}
 	}
 
-	void RenderStage::addRenderable(const String& name, RenderableID id)
+	void RenderStage::addRenderable(const String& name, RenderProxyHandle handle)
 	{
 		for (IRenderQueue* iqueue : m_renderQueues)
 		{
@@ -101,7 +101,7 @@ namespace Echo
 			if (queue && queue->isEnable())
 			{
 				if (queue->getName() == name)
-					queue->addRenderable(id);
+					queue->addRenderable(handle);
 			}
 		}
 	}
@@ -32,7 +32,7 @@ namespace Echo
 		void setFrameBuffer(Object* fb) { m_frameBuffer = (FrameBuffer*)fb; }
 
 		// add render able
-		void addRenderable(const String& name, RenderableID id);
+		void addRenderable(const String& name, RenderProxyHandle handle);
 
 		// on size
 		void onSize(ui32 width, ui32 height);
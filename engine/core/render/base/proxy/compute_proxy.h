@@ -49,5 +49,4 @@ namespace Echo
 		MeshPtr			m_mesh;
 		MaterialPtr		m_material;
 	};
-	typedef ui32 RenderableID;
 }
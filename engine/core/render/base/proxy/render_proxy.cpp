@@ -19,8 +19,7 @@ namespace Echo
 
 	void RenderProxy::subRefCount()
 	{
-		m_refCount--;
-		if (m_refCount <= 0)
+		if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) <= 1)
 		{
 			RenderProxy* ptr = this;
 			Renderer::instance()->destroyRenderProxies(&ptr, 1);
@@ -54,7 +53,7 @@ namespace Echo
 	{
 		if (m_mesh && m_mesh->isValid())
 		{
-			pipeline->addRenderable(m_material->getRenderStage(), getId());
+			pipeline->addRenderable(m_material->getRenderStage(), m_handle);
 		}
 	}
 }
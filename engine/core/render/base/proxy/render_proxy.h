@@ -1,6 +1,7 @@
 #pragma once
 
 #include <engine/core/util/Array.hpp>
+#include <engine/core/util/handle_table.h>
 #include "base/shader/shader_program.h"
 #include "base/texture/texture.h"
 #include "base/state/render_state.h"
@@ -9,7 +10,9 @@
 
 namespace Echo
 {
-	typedef ui32 RenderableID;
+	class RenderProxy;
+	typedef HandleTable<RenderProxy> RenderProxyTable;
+	typedef RenderProxyTable::Handle RenderProxyHandle;
 
 	class Render;
 	class RenderCamera;
@@ -35,6 +38,9 @@ namespace Echo
 		// Release
 		virtual void subRefCount() override;
 
+		// Handle in renderer's proxy table
+		RenderProxyHandle getHandle() const { return m_handle; }
+
 		// Set mesh
 		MeshPtr getMesh() { return m_mesh; }
 		virtual void setMesh(MeshPtr mesh) = 0;
@@ -63,6 +69,14 @@ namespace Echo
 		bool isCustomDepth() const { return m_customDepth; }
 		void setCustomDepth( bool customDepth) { m_customDepth = customDepth; }
 
+		// Bounds in node space, for nodes drawn by many proxies. The node's local AABB when invalid
+		void setLocalAABB(const AABB& aabb) { m_localAABB = aabb; }
+		const AABB& getLocalAABB() const { return m_localAABB; }
+
+		// Draw order among proxies a distance sorted queue sees at the same depth
+		void setOrder(ui32 order) { m_order = order; }
+		ui32 getOrder() const { return m_order; }
+
 		// Is enable submit to render queues
 		bool isSubmitToRenderQueue() const { return m_isSubmitToRenderQueue; }
 		void setSubmitToRenderQueue(bool enable);
@@ -75,6 +89,7 @@ namespace Echo
 		virtual ~RenderProxy();
 
 	protected:
+		RenderProxyHandle	m_handle = RenderProxyTable::InvalidHandle;
 		Render*			m_node = nullptr;
 		RenderCamera*	m_camera = nullptr;
 		i32				m_bvhNodeId = -1;
@@ -85,6 +100,8 @@ namespace Echo
 		bool			m_castShadow = false;
 		bool			m_customDepth = false;
 		bool			m_isSubmitToRenderQueue = false;
+		ui32			m_order = 0;
+		AABB			m_localAABB;
 	};
 	typedef ResRef<RenderProxy> RenderProxyPtr;
 }
@@ -94,6 +94,7 @@ namespace Echo
 		Class::registerType<RenderStage>();
 		Class::registerType<RenderPipeline>();
 		Class::registerType<Texture>();
+		Res::registerResImageLoad("Texture", Texture::loadImage);
 		Class::registerType<TextureCube>();
 		Class::registerType<TextureRenderTarget2D>();
 		Class::registerType<ShaderProgram>();
@@ -191,7 +192,9 @@ namespace Echo
 
 	Renderer::~Renderer()
 	{
-		EchoSafeDeleteMap(m_renderProxies, RenderProxy);
+		vector<RenderProxy*>::type renderProxies = m_renderProxies.getObjects();
+		m_renderProxies.clear();
+		EchoSafeDeleteContainer(renderProxies, RenderProxy);
 	}
 
 	bool Renderer::initialize(const Settings& settings)
@@ -247,13 +250,17 @@ namespace Echo
 		worldPos = (Vector3)vWorld;
 	}
 
-	RenderProxy* Renderer::getRenderProxy(RenderableID id)
+	void Renderer::drawInstanced(RenderProxy** renderables, ui32 count, FrameBufferPtr& frameBuffer)
 	{
-		std::map<ui32, RenderProxy*>::iterator it = m_renderProxies.find(id);
-		if (it != m_renderProxies.end())
-			return it->second;
+		for (ui32 i = 0; i < count; i++)
+		{
+			draw(renderables[i], frameBuffer);
+		}
+	}
 
-		return nullptr;
+	void Renderer::registerRenderProxy(RenderProxy* proxy)
+	{
+		proxy->m_handle = m_renderProxies.add(proxy);
 	}
 
 	void Renderer::destroyRenderProxies(RenderProxy** renderables, int num)
@@ -263,14 +270,11 @@ namespace Echo
 			RenderProxy* renderable = renderables[i];
 			if (renderable)
 			{
-				std::map<ui32, RenderProxy*>::iterator it = m_renderProxies.find(renderable->getId());
-				if(it != m_renderProxies.end())
+				if (m_renderProxies.remove(renderable->m_handle))
                 {
 					if (renderable->m_bvh)
 						renderable->m_bvh->destroyProxy(renderable->m_bvhNodeId);
 
-                    m_renderProxies.erase(it);
-
                     EchoSafeDelete(renderable, RenderProxy);
                     renderables[i] = nullptr;
                 }
@@ -304,19 +308,20 @@ namespace Echo
 			renderProxy->m_bvhNodeId = -1;
 		}
 
+		const AABB& localAABB = renderProxy->m_localAABB.isValid() ? renderProxy->m_localAABB : renderNode->getLocalAABB();
 		if (renderProxy->m_bvhNodeId == -1)
 		{
-			AABB worldAABB = renderNode->getLocalAABB();
+			AABB worldAABB = localAABB;
 			if (worldAABB.isValid())
 			{
 				worldAABB = worldAABB.transform(renderNode->getWorldMatrix());
 				renderProxy->m_bvh = bvh;
-				renderProxy->m_bvhNodeId = bvh->createProxy(worldAABB, renderProxy->getId());
+				renderProxy->m_bvhNodeId = bvh->createProxy(worldAABB, i32(renderProxy->m_handle));
 			}
 		}
 		else
 		{
-			AABB worldAABB = renderNode->getLocalAABB();
+			AABB worldAABB = localAABB;
 			if (worldAABB.isValid())
 			{
 				worldAABB = worldAABB.transform(renderNode->getWorldMatrix());
@@ -325,56 +330,86 @@ namespace Echo
 		}
 	}
 
+	const Bvh& Renderer::getRenderProxyBvh(RenderProxy::RenderType renderType) const
+	{
+		if		(renderType == RenderProxy::RenderType2D)	return m_renderProxies2dBvh;
+		else if (renderType == RenderProxy::RenderType3D)	return m_renderProxies3dBvh;
+		else												return m_renderProxiesUiBvh;
+	}
+
+	const PackedBvh& Renderer::getPackedRenderProxyBvh(RenderProxy::RenderType renderType)
+	{
+		PackedBvh& packedBvh = renderType == RenderProxy::RenderType2D ? m_renderProxies2dPackedBvh : (renderType == RenderProxy::RenderType3D ? m_renderProxies3dPackedBvh : m_renderProxiesUiPackedBvh);
+		Bvh& bvh = renderType == RenderProxy::RenderType2D ? m_renderProxies2dBvh : (renderType == RenderProxy::RenderType3D ? m_renderProxies3dBvh : m_renderProxiesUiBvh);
+
+		// moved proxies are consumed by the packed copy
+		packedBvh.build(bvh);
+		bvh.clearMovedProxies();
+
+		return packedBvh;
+	}
+
 	vector<RenderProxy*>::type Renderer::gatherRenderProxies(RenderProxy::RenderType renderType, const Frustum& frustum)
 	{
-		vector<RenderProxy*>::type result;
+		PackedFrustum packedFrustum(frustum);
+		return gatherRenderProxies(renderType, [&](const PackedBvh& bvh, i32* result, ui32 capacity)
+		{
+			return bvh.query(packedFrustum, result, capacity);
+		});
+	}
 
-		auto gatherProxyId = [&](Bvh& bvh)
+	vector<RenderProxy*>::type Renderer::gatherRenderProxies(RenderProxy::RenderType renderType, const AABB& aabb)
+	{
+		return gatherRenderProxies(renderType, [&](const PackedBvh& bvh, i32* result, ui32 capacity)
 		{
-			BvhCbDefault cb;
-			bvh.query(&cb, frustum);
+			return bvh.query(aabb, result, capacity);
+		});
+	}
 
-			for (i32 nodeId : cb.getQueryResults())
+	void Renderer::rayCastRenderProxies(RenderProxy::RenderType renderType, const Ray* rays, ui32 rayCount, float maxDistance, RenderProxy** results)
+	{
+		// grow the buffer and cast again if hits didn't fit
+		const PackedBvh& bvh = getPackedRenderProxyBvh(renderType);
+		ui32 count = bvh.rayCast(rays, rayCount, maxDistance, m_rayHits.data(), ui32(m_rayHits.size()));
+		if (count > m_rayHits.size())
+		{
+			m_rayHits.resize(count);
+			bvh.rayCast(rays, rayCount, maxDistance, m_rayHits.data(), count);
+		}
+
+		vector<float>::type distances(rayCount, maxDistance);
+		std::fill(results, results + rayCount, nullptr);
+		for (ui32 i = 0; i < count; i++)
+		{
+			const PackedBvhRayHit& hit = m_rayHits[i];
+			if (hit.distance <= distances[hit.rayIdx])
 			{
-				i32 renderProxyId = bvh.getUserData(nodeId);
-				RenderProxy* proxy = getRenderProxy(renderProxyId);
+				RenderProxy* proxy = getRenderProxy(RenderProxyHandle(hit.userData));
 				if (proxy && proxy->isSubmitToRenderQueue())
 				{
-					result.push_back(proxy);
+					results[hit.rayIdx] = proxy;
+					distances[hit.rayIdx] = hit.distance;
 				}
 			}
-		};
-
-		if (renderType == RenderProxy::RenderType3D)
-			gatherProxyId(m_renderProxies3dBvh);
-
-		if (renderType == RenderProxy::RenderType2D)
-			gatherProxyId(m_renderProxies2dBvh);
-
-		if (renderType == RenderProxy::RenderTypeUI)
-			gatherProxyId(m_renderProxiesUiBvh);
-
-		return result;
+		}
 	}
 
-	vector<RenderProxy*>::type Renderer::gatherRenderProxies(RenderProxy::RenderType renderType, const AABB& aabb)
+	vector<RenderProxy*>::type Renderer::gatherRenderProxies(RenderProxy::RenderType renderType, const std::function<ui32(const PackedBvh&, i32*, ui32)>& query)
 	{
-		BvhCbDefault cb;
-
-		if (renderType == RenderProxy::RenderType3D)
-			m_renderProxies3dBvh.query(&cb, aabb);
-
-		if (renderType == RenderProxy::RenderType2D)
-			m_renderProxies2dBvh.query(&cb, aabb);
-
-		if (renderType == RenderProxy::RenderTypeUI)
-			m_renderProxiesUiBvh.query(&cb, aabb);
+		vector<RenderProxy*>::type result;
 
+		// grow the buffer and query again if results didn't fit
+		const PackedBvh& bvh = getPackedRenderProxyBvh(renderType);
+		ui32 count = query(bvh, m_queryUserDatas.data(), ui32(m_queryUserDatas.size()));
+		if (count > m_queryUserDatas.size())
+		{
+			m_queryUserDatas.resize(count);
+			query(bvh, m_queryUserDatas.data(), count);
+		}
 
-		vector<RenderProxy*>::type result;
-		for (i32 nodeId : cb.getQueryResults())
+		for (ui32 i = 0; i < count; i++)
 		{
-			RenderProxy* proxy = getRenderProxy(nodeId);
+			RenderProxy* proxy = getRenderProxy(RenderProxyHandle(m_queryUserDatas[i]));
 			if (proxy && proxy->isSubmitToRenderQueue())
 			{
 				result.push_back(proxy);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include "misc/device_features.h"
 #include "state/render_state.h"
 #include "texture/texture_cube.h"
@@ -10,6 +11,7 @@
 #include "base/buffer/gpu_buffer.h"
 #include "base/misc/view_port.h"
 #include "scene/bvh.h"
+#include "scene/bvh_packed.h"
 
 namespace Echo
 {
@@ -104,6 +106,12 @@ namespace Echo
 		// draw
 		virtual void draw(RenderProxy* renderable, FrameBufferPtr& frameBuffer) = 0;
 
+		// draw proxies sharing mesh and material, default draws them one by one
+		virtual void drawInstanced(RenderProxy** renderables, ui32 count, FrameBufferPtr& frameBuffer);
+
+		// shaders get the INSTANCING macro and read a_InstanceWorldMatrix instead of u_WorldMatrix
+		virtual bool isInstancingSupported() const { return false; }
+
     public:
         // screen width and height
         virtual ui32 getWindowWidth() = 0;
@@ -126,10 +134,15 @@ namespace Echo
 	public:
 		// create|get render proxy
 		virtual RenderProxy* createRenderProxy() { return nullptr; }
-		RenderProxy* getRenderProxy(RenderableID id);
+		RenderProxy* getRenderProxy(RenderProxyHandle handle) const { return m_renderProxies.get(handle); }
+		const vector<RenderProxy*>::type& getRenderProxies() const { return m_renderProxies.getObjects(); }
 
 		// update bvh
 		void updateRenderProxyBvh(RenderProxy* renderProxy);
+		const Bvh& getRenderProxyBvh(RenderProxy::RenderType renderType) const;
+
+		// packed copy of bvh, rebuilt on demand when the bvh changed
+		const PackedBvh& getPackedRenderProxyBvh(RenderProxy::RenderType renderType);
 
 		// destroy render proxyies
 		void destroyRenderProxies(RenderProxy** renderables, int num);
@@ -138,16 +151,34 @@ namespace Echo
 		// computation proxy
 		virtual ComputeProxy* createComputeProxy() { return nullptr; }
 
+	protected:
+		// register render proxy created by implementation
+		void registerRenderProxy(RenderProxy* proxy);
+
+	public:
+
 		// Gather renderables
 		vector<RenderProxy*>::type gatherRenderProxies(RenderProxy::RenderType renderType, const Frustum& frustum);
 		vector<RenderProxy*>::type gatherRenderProxies(RenderProxy::RenderType renderType, const AABB& aabb);
 
+		// cast a batch of rays against proxy bounds, results[i] is the nearest proxy hit by rays[i] or nullptr
+		void rayCastRenderProxies(RenderProxy::RenderType renderType, const Ray* rays, ui32 rayCount, float maxDistance, RenderProxy** results);
+
+	protected:
+		// gather renderables with a query on packed bvh
+		vector<RenderProxy*>::type gatherRenderProxies(RenderProxy::RenderType renderType, const std::function<ui32(const PackedBvh&, i32*, ui32)>& query);
+
 	protected:
 		Settings						m_settings;
-		std::map<ui32, RenderProxy*>	m_renderProxies;
+		RenderProxyTable				m_renderProxies;
 		Bvh								m_renderProxies3dBvh;
 		Bvh								m_renderProxies2dBvh;
 		Bvh								m_renderProxiesUiBvh;
+		PackedBvh						m_renderProxies3dPackedBvh;
+		PackedBvh						m_renderProxies2dPackedBvh;
+		PackedBvh						m_renderProxiesUiPackedBvh;
+		vector<i32>::type				m_queryUserDatas;
+		vector<PackedBvhRayHit>::type	m_rayHits;
 		std::map<ui32, ComputeProxy*>	m_computeProxies;
 		ui32							m_startMipmap = 0;
 		DeviceFeature					m_deviceFeature;
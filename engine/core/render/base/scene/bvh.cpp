@@ -38,6 +38,8 @@ namespace Echo
 		m_path = 0;
 
 		m_insertionCount = 0;
+
+		m_version = 1;
 	}
 
 	Bvh::~Bvh()
@@ -113,6 +115,7 @@ namespace Echo
 		m_nodes[proxyId].height = 0;
 
 		insertLeaf(proxyId);
+		++m_topologyVersion;
 
 		return proxyId;
 	}
@@ -126,6 +129,7 @@ namespace Echo
 
 		removeLeaf(proxyId);
 		freeNode(proxyId);
+		++m_topologyVersion;
 	}
 
 	bool Bvh::moveProxy(i32 proxyId, const AABB& aabb, const Vector3& displacement)
@@ -180,11 +184,18 @@ namespace Echo
 		m_nodes[proxyId].aabb = b;
 
 		insertLeaf(proxyId);
+
+		if (m_movedProxies.size() < size_t(m_nodeCount))
+			m_movedProxies.emplace_back(proxyId);
+		else
+			m_isMovedProxiesOverflow = true;
+
 		return true;
 	}
 
 	void Bvh::insertLeaf(i32 leaf)
 	{
+		++m_version;
 		++m_insertionCount;
 
 		if (m_root == NullNode)
@@ -325,6 +336,7 @@ namespace Echo
 
 	void Bvh::removeLeaf(i32 leaf)
 	{
+		++m_version;
 		if (leaf == m_root)
 		{
 			m_root = NullNode;
@@ -771,6 +783,8 @@ namespace Echo
 
 		m_root = nodes[0];
 		EchoSafeFree(nodes);
+		++m_version;
+		++m_topologyVersion;
 
 		validate();
 	}
@@ -783,6 +797,9 @@ namespace Echo
 			m_nodes[i].aabb.vMin -= newOrigin;
 			m_nodes[i].aabb.vMax -= newOrigin;
 		}
+
+		++m_version;
+		++m_topologyVersion;
 	}
 
 	const i32 Bvh::getUserData(i32 proxyId) const
@@ -864,6 +881,73 @@ namespace Echo
 		}
 	}
 
+	void Bvh::splitQuery(const PackedFrustum& frustum, ui32 minCount, BvhSubtreeArray& subtrees) const
+	{
+		subtrees.clear();
+		if (m_root == NullNode)
+			return;
+
+		BvhSubtree root = { m_root, PackedFrustum::AllPlaneMask };
+		if (!frustum.isAABBIn(m_nodes[m_root].aabb.vMin, m_nodes[m_root].aabb.vMax, root.planeMask))
+			return;
+
+		// breadth first, one level at a time
+		subtrees.emplace_back(root);
+		BvhSubtreeArray level;
+		while (subtrees.size() < minCount)
+		{
+			bool expanded = false;
+			level.clear();
+			for (const BvhSubtree& subtree : subtrees)
+			{
+				const BvhNode& node = m_nodes[subtree.nodeId];
+				if (node.IsLeaf())
+				{
+					level.emplace_back(subtree);
+					continue;
+				}
+
+				for (i32 childId : { node.child1, node.child2 })
+				{
+					BvhSubtree child = { childId, subtree.planeMask };
+					if (frustum.isAABBIn(m_nodes[childId].aabb.vMin, m_nodes[childId].aabb.vMax, child.planeMask))
+						level.emplace_back(child);
+				}
+
+				expanded = true;
+			}
+
+			subtrees.swap(level);
+			if (!expanded)
+				break;
+		}
+	}
+
+	void Bvh::querySubtree(const PackedFrustum& frustum, const BvhSubtree& subtree, vector<i32>::type& result) const
+	{
+		GrowableStack<BvhSubtree, 256> stack;
+		stack.push(subtree);
+
+		while (stack.getCount() > 0)
+		{
+			BvhSubtree current = stack.pop();
+			const BvhNode& node = m_nodes[current.nodeId];
+			if (node.IsLeaf())
+			{
+				result.emplace_back(node.userData);
+				continue;
+			}
+
+			// a box inside all planes, the whole subtree is visible without further tests
+			for (i32 childId : { node.child1, node.child2 })
+			{
+				BvhSubtree child = { childId, current.planeMask };
+				if (!child.planeMask || frustum.isAABBIn(m_nodes[childId].aabb.vMin, m_nodes[childId].aabb.vMax, child.planeMask))
+					stack.push(child);
+			}
+		}
+	}
+
 	void Bvh::rayCast(BvhCb* callback, const Vector3& start, const Vector3& end) const
 	{
 		Vector3 p1 = start;
@@ -4,6 +4,7 @@
 #include "engine/core/util/Any.hpp"
 #include "engine/core/geom/AABB.h"
 #include "engine/core/geom/Frustum.h"
+#include "engine/core/geom/PackedFrustum.h"
 
 namespace Echo
 {
@@ -64,6 +65,14 @@ namespace Echo
 	};
 	typedef vector<BvhNode>::type BvhNodeArray;
 
+	// subtree root which is visible, with the frustum planes it still straddles
+	struct BvhSubtree
+	{
+		i32		nodeId;
+		ui32	planeMask;
+	};
+	typedef vector<BvhSubtree>::type BvhSubtreeArray;
+
 	class Bvh
 	{
 	public:
@@ -87,11 +96,35 @@ namespace Echo
 		// Get the fat AABB for a proxy.
 		const AABB& getFatAABB(i32 proxyId) const;
 
+		// Read access to the tree structure, root is -1 for an empty tree.
+		i32 getRoot() const { return m_root; }
+		const BvhNode& getNode(i32 nodeId) const { return m_nodes[nodeId]; }
+
+		// Changes every time the tree structure or node bounds change, used to refresh derived data.
+		ui32 getVersion() const { return m_version; }
+
+		// Changes only when proxies are created or destroyed, or all bounds change at once.
+		// Between two such changes derived data can be refit by the moved proxies.
+		ui32 getTopologyVersion() const { return m_topologyVersion; }
+
+		// Proxies re-inserted by moveProxy since the last clear, may repeat. Overflowed when
+		// more moves were recorded than the tree has nodes, derived data should refit all leaves.
+		const vector<i32>::type& getMovedProxies() const { return m_movedProxies; }
+		bool isMovedProxiesOverflow() const { return m_isMovedProxiesOverflow; }
+		void clearMovedProxies() { m_movedProxies.clear(); m_isMovedProxiesOverflow = false; }
+
 		// Query an AABB for overlapping proxies. The callback class
 		// is called for each proxy that overlaps the supplied AABB.
 		void query(BvhCb* callback, const AABB& aabb) const;
 		void query(BvhCb* callback, const Frustum& frustum) const;
 
+		// Split the frustum query into at least minCount visible subtrees (fewer if the tree is small).
+		// Subtrees are disjoint, so they can be traversed by querySubtree on different threads.
+		void splitQuery(const PackedFrustum& frustum, ui32 minCount, BvhSubtreeArray& subtrees) const;
+
+		// Traverse one visible subtree, user data of visible leaves are appended to result.
+		void querySubtree(const PackedFrustum& frustum, const BvhSubtree& subtree, vector<i32>::type& result) const;
+
 		// Ray-cast against the proxies in the tree. This relies on the callback
 		// to perform a exact ray-cast in the case were the proxy contains a shape.
 		// The callback also performs the any collision filtering. This has performance
@@ -144,5 +177,9 @@ namespace Echo
 		i32				m_freeList;
 		ui32			m_path;				// This is used to incrementally traverse the tree for re-balancing.
 		i32				m_insertionCount;
+		ui32			m_version;
+		ui32			m_topologyVersion = 1;
+		vector<i32>::type	m_movedProxies;
+		bool			m_isMovedProxiesOverflow = false;
 	};
 }
\ No newline at end of file
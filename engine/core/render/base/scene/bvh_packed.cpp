@@ -0,0 +1,474 @@
+#include "bvh_packed.h"
+#include <algorithm>
+
+#ifdef ECHO_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+// bounds of unused lanes, never pass any test
+#define EmptyMin	 1e30f
+#define EmptyMax	-1e30f
+
+namespace Echo
+{
+	// lane bits of the children which are visible in the frustum
+	static ui32 testFrustum(const PackedFrustum& frustum, const PackedBvhNode& node)
+	{
+		ui32 countMask = (1 << node.count) - 1;
+
+#ifdef ECHO_SIMD_SSE
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 minX = _mm_loadu_ps(node.minX);
+		const __m128 minY = _mm_loadu_ps(node.minY);
+		const __m128 minZ = _mm_loadu_ps(node.minZ);
+		const __m128 maxX = _mm_loadu_ps(node.maxX);
+		const __m128 maxY = _mm_loadu_ps(node.maxY);
+		const __m128 maxZ = _mm_loadu_ps(node.maxZ);
+		const __m128 centerX = _mm_mul_ps(_mm_add_ps(minX, maxX), half);
+		const __m128 centerY = _mm_mul_ps(_mm_add_ps(minY, maxY), half);
+		const __m128 centerZ = _mm_mul_ps(_mm_add_ps(minZ, maxZ), half);
+		const __m128 extentX = _mm_mul_ps(_mm_sub_ps(maxX, minX), half);
+		const __m128 extentY = _mm_mul_ps(_mm_sub_ps(maxY, minY), half);
+		const __m128 extentZ = _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half);
+
+		// four children against one plane per iteration
+		__m128 outside = _mm_setzero_ps();
+		for (i32 i = 0; i < 6; i++)
+		{
+			__m128 dist = _mm_add_ps(_mm_set1_ps(frustum.m_d[i]), _mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.m_nx[i]), centerX),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.m_ny[i]), centerY), _mm_mul_ps(_mm_set1_ps(frustum.m_nz[i]), centerZ))));
+			__m128 radius = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.m_absNx[i]), extentX),
+				_mm_add_ps(_mm_mul_ps(_mm_set1_ps(frustum.m_absNy[i]), extentY), _mm_mul_ps(_mm_set1_ps(frustum.m_absNz[i]), extentZ)));
+			outside = _mm_or_ps(outside, _mm_cmpgt_ps(dist, radius));
+		}
+
+		return ~ui32(_mm_movemask_ps(outside)) & countMask;
+#else
+		ui32 visible = 0;
+		for (ui32 i = 0; i < node.count; i++)
+		{
+			ui32 planeMask = PackedFrustum::AllPlaneMask;
+			if (frustum.isAABBIn(Vector3(node.minX[i], node.minY[i], node.minZ[i]), Vector3(node.maxX[i], node.maxY[i], node.maxZ[i]), planeMask))
+				visible |= 1 << i;
+		}
+
+		return visible & countMask;
+#endif
+	}
+
+	// lane bits of the children overlapping the aabb
+	static ui32 testAABB(const AABB& aabb, const PackedBvhNode& node)
+	{
+		ui32 countMask = (1 << node.count) - 1;
+
+#ifdef ECHO_SIMD_SSE
+		__m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(node.minX), _mm_set1_ps(aabb.vMax.x)), _mm_cmpge_ps(_mm_loadu_ps(node.maxX), _mm_set1_ps(aabb.vMin.x)));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(node.minY), _mm_set1_ps(aabb.vMax.y)), _mm_cmpge_ps(_mm_loadu_ps(node.maxY), _mm_set1_ps(aabb.vMin.y))));
+		overlap = _mm_and_ps(overlap, _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(node.minZ), _mm_set1_ps(aabb.vMax.z)), _mm_cmpge_ps(_mm_loadu_ps(node.maxZ), _mm_set1_ps(aabb.vMin.z))));
+
+		return ui32(_mm_movemask_ps(overlap)) & countMask;
+#else
+		ui32 overlap = 0;
+		for (ui32 i = 0; i < node.count; i++)
+		{
+			if (node.minX[i] <= aabb.vMax.x && node.maxX[i] >= aabb.vMin.x &&
+				node.minY[i] <= aabb.vMax.y && node.maxY[i] >= aabb.vMin.y &&
+				node.minZ[i] <= aabb.vMax.z && node.maxZ[i] >= aabb.vMin.z)
+				overlap |= 1 << i;
+		}
+
+		return overlap & countMask;
+#endif
+	}
+
+	// four rays in SoA layout
+	struct RayPacket
+	{
+		float originX[4];
+		float originY[4];
+		float originZ[4];
+		float invDirX[4];
+		float invDirY[4];
+		float invDirZ[4];
+		float maxDistance;
+	};
+
+	// avoid inf * 0 in slab test
+	static float safeInverse(float v)
+	{
+		return 1.f / (std::abs(v) > 1e-20f ? v : (v < 0.f ? -1e-20f : 1e-20f));
+	}
+
+	// lane bits of the rays hitting one child box, entry distances are written to distance
+	static ui32 testRays(const RayPacket& packet, const PackedBvhNode& node, ui32 lane, ui32 rayMask, float* distance)
+	{
+#ifdef ECHO_SIMD_SSE
+		const __m128 invDirX = _mm_loadu_ps(packet.invDirX);
+		const __m128 invDirY = _mm_loadu_ps(packet.invDirY);
+		const __m128 invDirZ = _mm_loadu_ps(packet.invDirZ);
+		const __m128 originX = _mm_loadu_ps(packet.originX);
+		const __m128 originY = _mm_loadu_ps(packet.originY);
+		const __m128 originZ = _mm_loadu_ps(packet.originZ);
+
+		__m128 t1x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minX[lane]), originX), invDirX);
+		__m128 t2x = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxX[lane]), originX), invDirX);
+		__m128 t1y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minY[lane]), originY), invDirY);
+		__m128 t2y = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxY[lane]), originY), invDirY);
+		__m128 t1z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.minZ[lane]), originZ), invDirZ);
+		__m128 t2z = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.maxZ[lane]), originZ), invDirZ);
+
+		__m128 tNear = _mm_max_ps(_mm_max_ps(_mm_min_ps(t1x, t2x), _mm_min_ps(t1y, t2y)), _mm_max_ps(_mm_min_ps(t1z, t2z), _mm_setzero_ps()));
+		__m128 tFar = _mm_min_ps(_mm_min_ps(_mm_max_ps(t1x, t2x), _mm_max_ps(t1y, t2y)), _mm_min_ps(_mm_max_ps(t1z, t2z), _mm_set1_ps(packet.maxDistance)));
+		_mm_storeu_ps(distance, tNear);
+
+		return ui32(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar))) & rayMask;
+#else
+		ui32 hit = 0;
+		for (ui32 i = 0; i < 4; i++)
+		{
+			if (!(rayMask & (1 << i)))
+				continue;
+
+			float t1x = (node.minX[lane] - packet.originX[i]) * packet.invDirX[i];
+			float t2x = (node.maxX[lane] - packet.originX[i]) * packet.invDirX[i];
+			float t1y = (node.minY[lane] - packet.originY[i]) * packet.invDirY[i];
+			float t2y = (node.maxY[lane] - packet.originY[i]) * packet.invDirY[i];
+			float t1z = (node.minZ[lane] - packet.originZ[i]) * packet.invDirZ[i];
+			float t2z = (node.maxZ[lane] - packet.originZ[i]) * packet.invDirZ[i];
+
+			float tNear = std::max<float>(std::max<float>(std::min<float>(t1x, t2x), std::min<float>(t1y, t2y)), std::max<float>(std::min<float>(t1z, t2z), 0.f));
+			float tFar = std::min<float>(std::min<float>(std::max<float>(t1x, t2x), std::max<float>(t1y, t2y)), std::min<float>(std::max<float>(t1z, t2z), packet.maxDistance));
+			distance[i] = tNear;
+			if (tNear <= tFar)
+				hit |= 1 << i;
+		}
+
+		return hit;
+#endif
+	}
+
+	void PackedBvh::build(const Bvh& bvh)
+	{
+		if (m_source == &bvh && m_sourceVersion == bvh.getVersion())
+			return;
+
+		if (m_source == &bvh && m_sourceTopologyVersion == bvh.getTopologyVersion())
+		{
+			refit(bvh);
+			m_sourceVersion = bvh.getVersion();
+			return;
+		}
+
+		m_source = &bvh;
+		m_sourceVersion = bvh.getVersion();
+		m_sourceTopologyVersion = bvh.getTopologyVersion();
+		m_nodes.clear();
+		m_nodeParents.clear();
+		m_leafUserDatas.clear();
+		m_leafProxyIds.clear();
+		m_leafSlots.clear();
+		m_proxyLeaves.clear();
+
+		if (bvh.getRoot() != -1)
+			buildNode(bvh, bvh.getRoot(), -1, 0);
+
+		for (size_t i = 0; i < m_leafProxyIds.size(); i++)
+		{
+			i32 proxyId = m_leafProxyIds[i];
+			if (proxyId >= i32(m_proxyLeaves.size()))
+				m_proxyLeaves.resize(proxyId + 1, -1);
+
+			m_proxyLeaves[proxyId] = i32(i);
+		}
+
+		m_dirtyNodes.assign(m_nodes.size(), 0);
+	}
+
+	void PackedBvh::refit(const Bvh& bvh)
+	{
+		// copy the bounds of a moved leaf, mark its node and the ancestors
+		auto refitLeaf = [this, &bvh](i32 leafIdx)
+		{
+			const Slot& slot = m_leafSlots[leafIdx];
+			const AABB& aabb = bvh.getFatAABB(m_leafProxyIds[leafIdx]);
+			PackedBvhNode& node = m_nodes[slot.node];
+			node.minX[slot.lane] = aabb.vMin.x;
+			node.minY[slot.lane] = aabb.vMin.y;
+			node.minZ[slot.lane] = aabb.vMin.z;
+			node.maxX[slot.lane] = aabb.vMax.x;
+			node.maxY[slot.lane] = aabb.vMax.y;
+			node.maxZ[slot.lane] = aabb.vMax.z;
+
+			for (i32 nodeIdx = slot.node; nodeIdx != -1 && !m_dirtyNodes[nodeIdx]; nodeIdx = m_nodeParents[nodeIdx].node)
+				m_dirtyNodes[nodeIdx] = 1;
+		};
+
+		if (bvh.isMovedProxiesOverflow())
+		{
+			for (i32 i = 0; i < i32(m_leafSlots.size()); i++)
+				refitLeaf(i);
+		}
+		else
+		{
+			for (i32 proxyId : bvh.getMovedProxies())
+			{
+				i32 leafIdx = proxyId < i32(m_proxyLeaves.size()) ? m_proxyLeaves[proxyId] : -1;
+				if (leafIdx != -1)
+					refitLeaf(leafIdx);
+			}
+		}
+
+		// children are stored after their parents, so a backward pass sees children updated first
+		for (i32 nodeIdx = i32(m_nodes.size()) - 1; nodeIdx >= 0; nodeIdx--)
+		{
+			const PackedBvhNode& node = m_nodes[nodeIdx];
+			for (ui32 i = 0; i < node.count; i++)
+			{
+				i32 child = node.children[i];
+				if (child < 0 || !m_dirtyNodes[child])
+					continue;
+
+				const PackedBvhNode& packed = m_nodes[child];
+				PackedBvhNode& parent = m_nodes[nodeIdx];
+				parent.minX[i] = *std::min_element(packed.minX, packed.minX + packed.count);
+				parent.minY[i] = *std::min_element(packed.minY, packed.minY + packed.count);
+				parent.minZ[i] = *std::min_element(packed.minZ, packed.minZ + packed.count);
+				parent.maxX[i] = *std::max_element(packed.maxX, packed.maxX + packed.count);
+				parent.maxY[i] = *std::max_element(packed.maxY, packed.maxY + packed.count);
+				parent.maxZ[i] = *std::max_element(packed.maxZ, packed.maxZ + packed.count);
+				m_dirtyNodes[child] = 0;
+			}
+		}
+
+		m_dirtyNodes[0] = 0;
+	}
+
+	i32 PackedBvh::buildNode(const Bvh& bvh, i32 nodeId, i32 parent, ui32 parentLane)
+	{
+		i32 entries[Width];
+		ui32 count = 0;
+
+		const BvhNode& node = bvh.getNode(nodeId);
+		if (node.IsLeaf())
+		{
+			entries[count++] = nodeId;
+		}
+		else
+		{
+			entries[count++] = node.child1;
+			entries[count++] = node.child2;
+
+			// pull grandchildren up, open the largest internal entry first
+			while (count < Width)
+			{
+				i32 best = -1;
+				float bestArea = -1.f;
+				for (ui32 i = 0; i < count; i++)
+				{
+					const BvhNode& entry = bvh.getNode(entries[i]);
+					if (!entry.IsLeaf() && entry.aabb.getPerimeter() > bestArea)
+					{
+						best = i;
+						bestArea = entry.aabb.getPerimeter();
+					}
+				}
+
+				if (best == -1)
+					break;
+
+				const BvhNode& opened = bvh.getNode(entries[best]);
+				entries[best] = opened.child1;
+				entries[count++] = opened.child2;
+			}
+		}
+
+		i32 packedIdx = i32(m_nodes.size());
+		m_nodes.emplace_back();
+		m_nodeParents.push_back({ parent, parentLane });
+		{
+			PackedBvhNode& packed = m_nodes[packedIdx];
+			for (ui32 i = 0; i < Width; i++)
+			{
+				packed.minX[i] = packed.minY[i] = packed.minZ[i] = EmptyMin;
+				packed.maxX[i] = packed.maxY[i] = packed.maxZ[i] = EmptyMax;
+				packed.children[i] = 0;
+			}
+			packed.count = count;
+		}
+
+		for (ui32 i = 0; i < count; i++)
+		{
+			const BvhNode& child = bvh.getNode(entries[i]);
+
+			i32 childIdx;
+			if (child.IsLeaf())
+			{
+				childIdx = ~i32(m_leafUserDatas.size());
+				m_leafUserDatas.emplace_back(child.userData);
+				m_leafProxyIds.emplace_back(entries[i]);
+				m_leafSlots.push_back({ packedIdx, i });
+			}
+			else
+			{
+				childIdx = buildNode(bvh, entries[i], packedIdx, i);
+			}
+
+			// node array may have grown while building children
+			PackedBvhNode& packed = m_nodes[packedIdx];
+			packed.minX[i] = child.aabb.vMin.x;
+			packed.minY[i] = child.aabb.vMin.y;
+			packed.minZ[i] = child.aabb.vMin.z;
+			packed.maxX[i] = child.aabb.vMax.x;
+			packed.maxY[i] = child.aabb.vMax.y;
+			packed.maxZ[i] = child.aabb.vMax.z;
+			packed.children[i] = childIdx;
+		}
+
+		return packedIdx;
+	}
+
+	ui32 PackedBvh::query(const PackedFrustum& frustum, i32* result, ui32 capacity) const
+	{
+		ui32 count = 0;
+		if (m_nodes.empty())
+			return count;
+
+		GrowableStack<i32, 256> stack;
+		stack.push(0);
+
+		while (stack.getCount() > 0)
+		{
+			const PackedBvhNode& node = m_nodes[stack.pop()];
+			ui32 visible = testFrustum(frustum, node);
+			for (ui32 i = 0; i < node.count; i++)
+			{
+				if (!(visible & (1 << i)))
+					continue;
+
+				i32 child = node.children[i];
+				if (child >= 0)
+				{
+					stack.push(child);
+				}
+				else
+				{
+					if (count < capacity)
+						result[count] = m_leafUserDatas[~child];
+
+					count++;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	ui32 PackedBvh::query(const AABB& aabb, i32* result, ui32 capacity) const
+	{
+		ui32 count = 0;
+		if (m_nodes.empty())
+			return count;
+
+		GrowableStack<i32, 256> stack;
+		stack.push(0);
+
+		while (stack.getCount() > 0)
+		{
+			const PackedBvhNode& node = m_nodes[stack.pop()];
+			ui32 overlap = testAABB(aabb, node);
+			for (ui32 i = 0; i < node.count; i++)
+			{
+				if (!(overlap & (1 << i)))
+					continue;
+
+				i32 child = node.children[i];
+				if (child >= 0)
+				{
+					stack.push(child);
+				}
+				else
+				{
+					if (count < capacity)
+						result[count] = m_leafUserDatas[~child];
+
+					count++;
+				}
+			}
+		}
+
+		return count;
+	}
+
+	ui32 PackedBvh::rayCast(const Ray* rays, ui32 rayCount, float maxDistance, PackedBvhRayHit* hits, ui32 capacity) const
+	{
+		ui32 hitCount = 0;
+		if (m_nodes.empty())
+			return hitCount;
+
+		for (ui32 offset = 0; offset < rayCount; offset += 4)
+		{
+			rayCastPacket(rays + offset, std::min<ui32>(rayCount - offset, 4), offset, maxDistance, hits, capacity, hitCount);
+		}
+
+		return hitCount;
+	}
+
+	void PackedBvh::rayCastPacket(const Ray* rays, ui32 rayCount, ui32 rayOffset, float maxDistance, PackedBvhRayHit* hits, ui32 capacity, ui32& hitCount) const
+	{
+		// unused lanes repeat the first ray, and are masked out
+		RayPacket packet;
+		for (ui32 i = 0; i < 4; i++)
+		{
+			const Ray& ray = rays[i < rayCount ? i : 0];
+			packet.originX[i] = ray.m_origin.x;
+			packet.originY[i] = ray.m_origin.y;
+			packet.originZ[i] = ray.m_origin.z;
+			packet.invDirX[i] = safeInverse(ray.m_dir.x);
+			packet.invDirY[i] = safeInverse(ray.m_dir.y);
+			packet.invDirZ[i] = safeInverse(ray.m_dir.z);
+		}
+		packet.maxDistance = maxDistance;
+
+		// node index, and the rays which reached it
+		struct StackEntry
+		{
+			i32		nodeIdx;
+			ui32	rayMask;
+		};
+
+		GrowableStack<StackEntry, 256> stack;
+		stack.push({ 0, (1u << rayCount) - 1 });
+
+		float distance[4];
+		while (stack.getCount() > 0)
+		{
+			StackEntry entry = stack.pop();
+			const PackedBvhNode& node = m_nodes[entry.nodeIdx];
+			for (ui32 i = 0; i < node.count; i++)
+			{
+				ui32 rayMask = testRays(packet, node, i, entry.rayMask, distance);
+				if (!rayMask)
+					continue;
+
+				i32 child = node.children[i];
+				if (child >= 0)
+				{
+					stack.push({ child, rayMask });
+				}
+				else
+				{
+					for (ui32 rayIdx = 0; rayIdx < rayCount; rayIdx++)
+					{
+						if (rayMask & (1 << rayIdx))
+						{
+							if (hitCount < capacity)
+								hits[hitCount] = { rayOffset + rayIdx, m_leafUserDatas[~child], distance[rayIdx] };
+
+							hitCount++;
+						}
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "bvh.h"
+#include "engine/core/geom/Ray.h"
+
+namespace Echo
+{
+	// 4-wide node, bounds of the children in SoA layout so one node is tested with one pass of SIMD
+	struct PackedBvhNode
+	{
+		float	minX[4];
+		float	minY[4];
+		float	minZ[4];
+		float	maxX[4];
+		float	maxY[4];
+		float	maxZ[4];
+
+		// >= 0 internal node index, < 0 leaf index stored as ~index
+		i32		children[4];
+		ui32	count;
+	};
+	typedef vector<PackedBvhNode>::type PackedBvhNodeArray;
+
+	// ray hit of a leaf box
+	struct PackedBvhRayHit
+	{
+		ui32	rayIdx;
+		i32		userData;
+		float	distance;
+	};
+
+	// Read-only 4-wide copy of a dynamic Bvh, built by collapsing the binary tree. While the
+	// source only moves proxies the copy keeps its shape and refits bounds of the moved leaves.
+	// Queries write user data of hit leaves to caller memory instead of calling back.
+	// They return the total number of results, which may be larger than capacity,
+	// results that don't fit are dropped.
+	class PackedBvh
+	{
+	public:
+		static constexpr ui32 Width = 4;
+
+	public:
+		PackedBvh() {}
+		~PackedBvh() {}
+
+		// build from the dynamic tree, refits when proxies only moved since the last build and
+		// returns immediately if the tree hasn't changed
+		void build(const Bvh& bvh);
+
+		// is empty
+		bool isEmpty() const { return m_nodes.empty(); }
+
+		// query leaves overlapping the frustum or aabb
+		ui32 query(const PackedFrustum& frustum, i32* result, ui32 capacity) const;
+		ui32 query(const AABB& aabb, i32* result, ui32 capacity) const;
+
+		// cast a batch of rays, traversed four rays at a time. Directions needn't be normalized,
+		// distance is measured in units of direction length
+		ui32 rayCast(const Ray* rays, ui32 rayCount, float maxDistance, PackedBvhRayHit* hits, ui32 capacity) const;
+
+	private:
+		// collapse the binary subtree under nodeId into packed nodes, returns packed node index
+		i32 buildNode(const Bvh& bvh, i32 nodeId, i32 parent, ui32 parentLane);
+
+		// copy bounds of moved leaves and update their ancestors
+		void refit(const Bvh& bvh);
+
+		// cast up to four rays
+		void rayCastPacket(const Ray* rays, ui32 rayCount, ui32 rayOffset, float maxDistance, PackedBvhRayHit* hits, ui32 capacity, ui32& hitCount) const;
+
+		// lane of a packed node
+		struct Slot
+		{
+			i32		node;
+			ui32	lane;
+		};
+
+	private:
+		const Bvh*			m_source = nullptr;
+		ui32				m_sourceVersion = 0;
+		ui32				m_sourceTopologyVersion = 0;
+		PackedBvhNodeArray	m_nodes;
+		vector<Slot>::type	m_nodeParents;			// parent lane of each node, node -1 for the root
+		vector<i32>::type	m_leafUserDatas;
+		vector<i32>::type	m_leafProxyIds;
+		vector<Slot>::type	m_leafSlots;
+		vector<i32>::type	m_proxyLeaves;			// leaf index by source proxy id, -1 if none
+		vector<Byte>::type	m_dirtyNodes;
+	};
+}
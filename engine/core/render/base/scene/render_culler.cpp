@@ -0,0 +1,68 @@
+#include "render_culler.h"
+#include "../renderer.h"
+#include "engine/core/thread/JobSystem.h"
+
+namespace Echo
+{
+	// subtrees per thread, more subtrees balance better but cost more splitting on the calling thread
+	static const ui32 SubtreesPerThread = 4;
+
+	void RenderCuller::begin()
+	{
+		m_bvhs.clear();
+		m_frustums.clear();
+	}
+
+	void RenderCuller::addBvh(const Bvh& bvh, const Frustum& frustum)
+	{
+		m_bvhs.emplace_back(&bvh);
+		m_frustums.emplace_back(frustum);
+	}
+
+	void RenderCuller::cull()
+	{
+		JobSystem* jobSystem = JobSystem::instance();
+		ui32 threadCount = jobSystem->getThreadCount();
+
+		// split every bvh into subtrees
+		m_tasks.clear();
+		for (ui32 i = 0; i < m_bvhs.size(); i++)
+		{
+			m_bvhs[i]->splitQuery(m_frustums[i], threadCount > 1 ? threadCount * SubtreesPerThread : 1, m_subtrees);
+			for (const BvhSubtree& subtree : m_subtrees)
+			{
+				m_tasks.push_back({ m_bvhs[i], i, subtree });
+			}
+		}
+
+		// buffers keep their capacity from frame to frame
+		if (m_taskResults.size() < m_tasks.size())
+			m_taskResults.resize(m_tasks.size());
+
+		for (vector<RenderProxy*>::type& taskResult : m_taskResults)
+			taskResult.clear();
+
+		m_threadUserDatas.resize(threadCount);
+
+		Renderer* renderer = Renderer::instance();
+		jobSystem->parallelFor(ui32(m_tasks.size()), 1, [&](ui32 begin, ui32 end, ui32 threadIdx)
+		{
+			vector<i32>::type& userDatas = m_threadUserDatas[threadIdx];
+			for (ui32 taskIdx = begin; taskIdx < end; taskIdx++)
+			{
+				const Task& task = m_tasks[taskIdx];
+
+				userDatas.clear();
+				task.m_bvh->querySubtree(m_frustums[task.m_frustumIdx], task.m_subtree, userDatas);
+
+				vector<RenderProxy*>::type& taskResult = m_taskResults[taskIdx];
+				for (i32 userData : userDatas)
+				{
+					RenderProxy* proxy = renderer->getRenderProxy(RenderProxyHandle(userData));
+					if (proxy && proxy->isSubmitToRenderQueue())
+						taskResult.emplace_back(proxy);
+				}
+			}
+		});
+	}
+}
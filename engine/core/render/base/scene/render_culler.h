@@ -0,0 +1,52 @@
+#pragma once
+
+#include "bvh.h"
+#include "../proxy/render_proxy.h"
+
+namespace Echo
+{
+	// Frustum culling of several bvhs in one pass. Each bvh query is split into subtrees,
+	// subtrees are culled on job system threads, every one writes its own result buffer.
+	// Buffers are merged in subtree order, so the result is the same whichever thread ran it.
+	class RenderCuller
+	{
+	public:
+		RenderCuller() {}
+		~RenderCuller() {}
+
+		// clear bvhs and results of last frame
+		void begin();
+
+		// add bvh to cull, frustum planes are packed here
+		void addBvh(const Bvh& bvh, const Frustum& frustum);
+
+		// cull all added bvhs
+		void cull();
+
+		// visit visible render proxies, in order of added bvhs
+		template<typename Func> void forEachVisible(Func func) const
+		{
+			for (const vector<RenderProxy*>::type& taskResult : m_taskResults)
+			{
+				for (RenderProxy* renderProxy : taskResult)
+					func(renderProxy);
+			}
+		}
+
+	private:
+		struct Task
+		{
+			const Bvh*	m_bvh;
+			ui32		m_frustumIdx;
+			BvhSubtree	m_subtree;
+		};
+
+	private:
+		vector<const Bvh*>::type					m_bvhs;
+		vector<PackedFrustum>::type					m_frustums;
+		vector<Task>::type							m_tasks;
+		BvhSubtreeArray								m_subtrees;
+		vector<vector<RenderProxy*>::type>::type	m_taskResults;
+		vector<vector<i32>::type>::type				m_threadUserDatas;
+	};
+}
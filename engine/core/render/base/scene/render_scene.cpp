@@ -34,24 +34,22 @@ namespace Echo
 
 	void RenderScene::render()
 	{
-		vector<RenderProxy*>::type visibleRenderProxies3D = Renderer::instance()->gatherRenderProxies(RenderProxy::RenderType3D, m_3dFrustum);
-		for (RenderProxy* renderproxy : visibleRenderProxies3D)
+		Renderer* renderer = Renderer::instance();
+
+		// cull 3d, 2d and ui together, across job system threads
+		m_culler.begin();
+		m_culler.addBvh(renderer->getRenderProxyBvh(RenderProxy::RenderType3D), m_3dFrustum);
+		m_culler.addBvh(renderer->getRenderProxyBvh(RenderProxy::RenderType2D), m_2dFrustum);
+		m_culler.addBvh(renderer->getRenderProxyBvh(RenderProxy::RenderTypeUI), m_uiFrustum);
+		m_culler.cull();
+
+		// render queues aren't thread safe, merge on this thread
+		RenderPipeline* pipeline = RenderPipeline::current();
+		m_culler.forEachVisible([pipeline](RenderProxy* renderProxy)
 		{
-			renderproxy->submitToRenderQueue(RenderPipeline::current());
-		}
-
-		vector<RenderProxy*>::type visibleRenderProxies2D = Renderer::instance()->gatherRenderProxies(RenderProxy::RenderType2D, m_2dFrustum);
-		for (RenderProxy* renderproxy : visibleRenderProxies2D)
-		{
-			renderproxy->submitToRenderQueue(RenderPipeline::current());
-		}
-
-		vector<RenderProxy*>::type visibleRenderProxiesUI = Renderer::instance()->gatherRenderProxies(RenderProxy::RenderTypeUI, m_uiFrustum);
-		for (RenderProxy* renderproxy : visibleRenderProxiesUI)
-		{
-			renderproxy->submitToRenderQueue(RenderPipeline::current());
-		}
+			renderProxy->submitToRenderQueue(pipeline);
+		});
 
-		RenderPipeline::current()->render();
+		pipeline->render();
 	}
 }
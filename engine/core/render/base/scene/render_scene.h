@@ -4,6 +4,7 @@
 #include "engine/core/resource/ResRef.h"
 #include "engine/core/math/Math.h"
 #include "engine/core/geom/Frustum.h"
+#include "render_culler.h"
 
 namespace Echo
 {
@@ -30,6 +31,7 @@ namespace Echo
 		Frustum				m_3dFrustum;
 		Frustum				m_2dFrustum;
 		Frustum				m_uiFrustum;
+		RenderCuller		m_culler;
 		//RenderPipelinePtr	m_pipeline;
 	};
 	typedef ResRef<RenderScene> RenderScenePtr;
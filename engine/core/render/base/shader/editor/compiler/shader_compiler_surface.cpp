@@ -17,6 +17,14 @@ layout(binding = 0) uniform UBO
 // inputs
 layout(location = 0) in vec3 a_Position;
 
+// per instance world matrix, fed as vertex attribute by renderers supporting instancing
+#ifdef INSTANCING
+layout(location = 7) in mat4 a_InstanceWorldMatrix;
+#define WORLD_MATRIX a_InstanceWorldMatrix
+#else
+#define WORLD_MATRIX vs_ubo.u_WorldMatrix
+#endif
+
 #ifdef ENABLE_VERTEX_POSITION
 struct Position
 {
@@ -71,7 +79,7 @@ void main(void)
 	 //     \/                                      -- handled by GPU / driver
 	 // screen space  [   0,    0] to [   W,    H] /
 
-	vec4 worldPosition = vs_ubo.u_WorldMatrix * vec4(a_Position, 1.0);
+	vec4 worldPosition = WORLD_MATRIX * vec4(a_Position, 1.0);
     vec4 clipPosition = vs_ubo.u_ViewProjMatrix * worldPosition;
 
 #ifdef ENABLE_VERTEX_POSITION
@@ -84,13 +92,13 @@ void main(void)
 
 #ifdef ENABLE_VERTEX_NORMAL
 	#ifdef HAS_TANGENTS
-		vec3 normalW = normalize(vec3(vs_ubo.u_WorldMatrix * vec4(a_Normal.xyz, 0.0)));
-		vec3 tangentW = normalize(vec3(vs_ubo.u_WorldMatrix * vec4(a_Tangent.xyz, 0.0)));
+		vec3 normalW = normalize(vec3(WORLD_MATRIX * vec4(a_Normal.xyz, 0.0)));
+		vec3 tangentW = normalize(vec3(WORLD_MATRIX * vec4(a_Tangent.xyz, 0.0)));
 		vec3 bitangentW = cross(normalW, tangentW) * a_Tangent.w;
 		v_Normal = normalW;
 		v_TBN = mat3(tangentW, bitangentW, normalW);
 	#else // HAS_TANGENTS != 1
-		v_Normal = normalize(vec3(vs_ubo.u_WorldMatrix * vec4(a_Normal.xyz, 0.0)));
+		v_Normal = normalize(vec3(WORLD_MATRIX * vec4(a_Normal.xyz, 0.0)));
 	#endif
 
 	v_NormalLocal = a_Normal;
@@ -93,6 +93,7 @@ namespace Echo
 		// macro
         bool isMacroUsed(const String& macro);
 		void setMacros(const String& macros);
+		const StringArray& getMacros() const { return m_macros; }
         void setMacro(const String& macro, bool enabled);
 
 		// operate uniform
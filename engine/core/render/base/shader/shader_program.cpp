@@ -17,22 +17,49 @@ layout(binding = 0) uniform UBO
 {
 	mat4 u_WorldMatrix;
 	mat4 u_ViewProjMatrix;
+#ifdef BILLBOARD
+	vec3 u_CameraPosition;
+	vec3 u_CameraDirection;
+#endif
 } vs_ubo;
 
 // inputs
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec2 a_UV;
+#ifdef VERTEX_COLOR
+layout(location = 2) in vec4 a_Color;
+#endif
+#ifdef BILLBOARD
+layout(location = 3) in vec3 a_Normal;     // corner offset, billboard type (0 none, 1 look at, 2 view direction)
+#endif
 
 // outputs
 layout(location = 0) out vec2 v_TexCoord;
+#ifdef VERTEX_COLOR
+layout(location = 1) out vec4 v_Color;
+#endif
 
 void main(void)
 {
     vec4 position = vs_ubo.u_WorldMatrix * vec4(a_Position, 1.0);
+#ifdef BILLBOARD
+    // turn the corner to face the camera around the billboard center
+    if (a_Normal.z > 0.5)
+    {
+        vec3 faceDir = a_Normal.z > 1.5 ? vs_ubo.u_CameraDirection : normalize(position.xyz - vs_ubo.u_CameraPosition);
+        vec3 hDir = normalize(vec3(faceDir.x, 0.0, faceDir.z));
+        vec3 right = vec3(hDir.z, 0.0, -hDir.x);
+        vec3 up = cross(faceDir, right);
+        position.xyz += right * a_Normal.x + up * a_Normal.y;
+    }
+#endif
     position = vs_ubo.u_ViewProjMatrix * position;
     gl_Position = position;
     
     v_TexCoord = a_UV;
+#ifdef VERTEX_COLOR
+    v_Color = a_Color;
+#endif
 }
 )";
 
@@ -42,6 +69,12 @@ static const char* g_2dPsCode = R"(#version 450
 layout(binding = 0) uniform UBO
 {
     float u_Alpha;
+#ifdef SDF
+    vec4 SdfColor;          // fill, the vertex color when VERTEX_COLOR is defined
+    vec4 SdfOutlineColor;
+    vec4 SdfGlowColor;
+    vec4 SdfEdges;          // outline edge, glow edge
+#endif
 } fs_ubo;
 
 // uniforms
@@ -49,14 +82,48 @@ layout(set=1, binding = 3) uniform sampler2D BaseColor;
 
 // inputs
 layout(location = 0) in vec2  v_TexCoord;
+#ifdef VERTEX_COLOR
+layout(location = 1) in vec4  v_Color;
+#endif
 
 // outputs
 layout(location = 0) out vec4 o_FragColor;
 
+#ifdef SDF
+// BaseColor holds a distance field, 0.5 on the glyph edge
+vec4 SdfShade(float distance, vec4 fillColor)
+{
+    float aa = max(fwidth(distance), 0.0001);
+    float fill = smoothstep(0.5 - aa, 0.5 + aa, distance);
+    float outline = smoothstep(fs_ubo.SdfEdges.x - aa, fs_ubo.SdfEdges.x + aa, distance);
+    float glow = fs_ubo.SdfGlowColor.a * clamp((distance - fs_ubo.SdfEdges.y) / max(fs_ubo.SdfEdges.x - fs_ubo.SdfEdges.y, 0.0001), 0.0, 1.0);
+
+    vec4 color = mix(fs_ubo.SdfOutlineColor, fillColor, fill);
+    color.a *= outline;
+
+    // glow behind the glyph
+    float alpha = color.a + glow * (1.0 - color.a);
+    vec3 rgb = (color.rgb * color.a + fs_ubo.SdfGlowColor.rgb * glow * (1.0 - color.a)) / max(alpha, 0.0001);
+
+    return vec4(rgb, alpha);
+}
+#endif
+
 void main(void)
 {
+#ifdef SDF
+#ifdef VERTEX_COLOR
+    vec4 finalColor = SdfShade(texture(BaseColor, v_TexCoord).r, v_Color);
+#else
+    vec4 finalColor = SdfShade(texture(BaseColor, v_TexCoord).r, fs_ubo.SdfColor);
+#endif
+#else
     vec4 textureColor = texture(BaseColor, v_TexCoord);
     vec4 finalColor = textureColor;
+#ifdef VERTEX_COLOR
+    finalColor = finalColor * v_Color;
+#endif
+#endif
 
 #ifdef ALPHA_ADJUST
     finalColor.a = finalColor.a * fs_ubo.u_Alpha;
@@ -78,6 +145,14 @@ layout(binding = 0) uniform UBO
 // inputs
 layout(location = 0) in vec3 a_Position;
 
+// per instance world matrix, fed as vertex attribute by renderers supporting instancing
+#ifdef INSTANCING
+layout(location = 7) in mat4 a_InstanceWorldMatrix;
+#define WORLD_MATRIX a_InstanceWorldMatrix
+#else
+#define WORLD_MATRIX vs_ubo.u_WorldMatrix
+#endif
+
 // outputs
 layout(location = 0) out vec3 v_Position;
 
@@ -89,14 +164,14 @@ layout(location = 1) out vec3 v_Normal;
 void main(void)
 {
     vec4 position = vec4(a_Position, 1.0);
-    position = vs_ubo.u_WorldMatrix * position;
+    position = WORLD_MATRIX * position;
 
     gl_Position = vs_ubo.u_ViewProjMatrix * position;
 
     v_Position  = position.xyz / position.w;
 
 #ifdef HAS_NORMALS
-	v_Normal = normalize(vec3(vs_ubo.u_WorldMatrix * vec4(a_Normal.xyz, 0.0)));
+	v_Normal = normalize(vec3(WORLD_MATRIX * vec4(a_Normal.xyz, 0.0)));
 #endif
 }
 )";
@@ -193,12 +268,17 @@ namespace Echo
 	{
         if (value)
         {
-			m_value.resize(m_sizeInBytes);
-			memcpy(m_value.data(), value, m_sizeInBytes);
+            if (m_value.size() != size_t(m_sizeInBytes) || std::memcmp(m_value.data(), value, m_sizeInBytes) != 0)
+            {
+				m_value.resize(m_sizeInBytes);
+				memcpy(m_value.data(), value, m_sizeInBytes);
+				m_dirty = true;
+            }
         }
-        else
+        else if (!m_value.empty())
         {
             m_value.clear();
+            m_dirty = true;
         }
 	}
 
@@ -208,6 +288,7 @@ namespace Echo
         {
 			m_valueDefault.resize(m_sizeInBytes);
 			memcpy(m_valueDefault.data(), value, m_sizeInBytes);
+			m_dirty = true;
         }
     }
 
@@ -326,11 +407,11 @@ namespace Echo
 		return StringUtil::StartWith(name, "u_") ? true : false;
 	}
 
-    void ShaderProgram::insertMacros(String& code)
+    void ShaderProgram::insertMacros(const StringArray& macros, String& code)
     {
         // make sure macros
         String finalMacros; finalMacros.reserve(512);
-        for (const String& macro : m_macros)
+        for (const String& macro : macros)
             finalMacros += "#define " + macro + "\n";
         
         if (!finalMacros.empty())
@@ -348,8 +429,13 @@ namespace Echo
 		String psSrc = getPsCode();
         if(!vsSrc.empty() && !psSrc.empty())
         {
-            insertMacros(vsSrc);
-            insertMacros(psSrc);
+            // renderers with instanced draws feed the world matrix as vertex attribute
+            StringArray macros = m_macros;
+            if (Renderer::instance()->isInstancingSupported())
+                macros.emplace_back("INSTANCING");
+
+            insertMacros(macros, vsSrc);
+            insertMacros(macros, psSrc);
             
             // convert based on renderer type
             convert(m_type, vsSrc, psSrc);
@@ -73,6 +73,7 @@ namespace Echo
             int                 m_sizeInBytes = 0;
             int                 m_location = -1;
             vector<Byte>::type  m_value;
+            bool                m_dirty = true;     // value changed since last upload
 
             Uniform() {}
             ~Uniform() {}
@@ -81,6 +82,10 @@ namespace Echo
 			void setValue(const void* value);
             const vector<Byte>::type& getValue() { return m_value; }
 
+            // dirty
+            bool isDirty() const { return m_dirty; }
+            void setDirty(bool dirty) { m_dirty = dirty; }
+
             // value default
             virtual void setValueDefault(const void* value) {}
             virtual void setValueDefault(float value) { setValueDefault(&value); }
@@ -128,6 +133,9 @@ namespace Echo
 		static StringArray getEditableMacros();
         void setMacros(const StringArray& macros) { m_macros = macros; }
 
+        // insert macros after the first line (#version) of code
+        static void insertMacros(const StringArray& macros, String& code);
+
 		// clear
 		void clear();
 
@@ -216,9 +224,6 @@ namespace Echo
 
         // build
         bool build();
-        
-        // insert macros
-        void insertMacros(String& code);
 
 	protected:
         Domain                      m_domain = Domain::Surface;
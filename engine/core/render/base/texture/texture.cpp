@@ -1,8 +1,10 @@
 #include <engine/core/io/IO.h>
+#include <engine/core/io/memory_reader.h>
 #include <engine/core/io/stream/DataStream.h>
 #include <engine/core/util/PathUtil.h>
 #include <engine/core/base/echo_def.h>
 #include "base/texture/texture.h"
+#include "base/texture/texture_streamer.h"
 #include "base/renderer.h"
 #include "engine/core/log/Log.h"
 #include "engine/core/math/Function.h"
@@ -27,6 +29,8 @@ namespace Echo
 
 	Texture::~Texture()
 	{
+		if (m_isStreaming)
+			TextureStreamer::instance()->remove(this);
 	}
 
 	void Texture::bindMethods()
@@ -56,6 +60,34 @@ namespace Echo
 		return nullptr;
 	}
 
+	Res* Texture::loadImage(const ResourcePath& path, Image* image)
+	{
+		Texture* texture = Renderer::instance()->createTexture2D(path.getPath());
+		texture->m_decodedImage = image;
+		texture->load();
+
+		// load didn't take it, e.g. the file is cooked and streamed
+		EchoSafeDelete(texture->m_decodedImage, Image);
+
+		return texture;
+	}
+
+	Image* Texture::acquireImage()
+	{
+		if (m_decodedImage)
+		{
+			Image* image = m_decodedImage;
+			m_decodedImage = nullptr;
+			return image;
+		}
+
+		MemoryReader memReader(getPath());
+		if (memReader.getSize())
+			return Image::createFromMemory(Buffer(memReader.getSize(), memReader.getData<ui8*>(), false), Image::GetImageFormat(getPath()));
+
+		return nullptr;
+	}
+
 	Texture* Texture::getGlobal(ui32 globalTextureIdx)
 	{
 		auto it = g_globalTextures.find(globalTextureIdx);
@@ -9,12 +9,15 @@
 
 namespace Echo
 {
+	class Image;
+
 	class Texture : public Res
 	{
 		ECHO_RES(Texture, Res, ".png|.jpeg|.bmp|.tga|.jpg", nullptr, Texture::load);
 
 		friend class Renderer;
 		friend class FrameBuffer;
+		friend class TextureStreamer;
 
 	public:
 		enum TexType
@@ -103,6 +106,13 @@ namespace Echo
 		// update data
 		virtual bool updateTexture2D(PixelFormat format, TexUsage usage, i32 width, i32 height, void* data, ui32 size) { return false; }
 
+		// upload a level of a streamed texture, levels arrive from smallest to largest
+		virtual bool updateMipData(ui32 level, ui32 width, ui32 height, const Buffer& buff) { return false; }
+		virtual bool isMipStreamingSupported() const { return false; }
+
+		// is streaming mips
+		bool isStreaming() const { return m_isStreaming; }
+
 	protected:
 		Texture(const String& name);
 		virtual ~Texture();
@@ -110,6 +120,12 @@ namespace Echo
 		// static load
 		static Res* load(const ResourcePath& path);
 
+		// static load from an image decoded by an async load, takes the image
+		static Res* loadImage(const ResourcePath& path, Image* image);
+
+		// image decoded by an async load, or decode the file now. Caller deletes it
+		Image* acquireImage();
+
 	protected:
 		PixelFormat			m_pixFmt = PF_UNKNOWN;
 		bool				m_isCompressed = false;
@@ -126,6 +142,8 @@ namespace Echo
 		ui32				m_yDimension = 0;
 		ui32				m_zDimension = 0;
 		ui32				m_surfaceNum;
+		bool				m_isStreaming = false;
+		Image*				m_decodedImage = nullptr;
 		SamplerStatePtr		m_samplerState;
 	};
 	typedef ResRef<Texture> TexturePtr;
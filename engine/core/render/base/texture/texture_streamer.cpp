@@ -0,0 +1,371 @@
+#include "texture_streamer.h"
+#include "base/image/image.h"
+#include "engine/core/io/IO.h"
+#include "engine/core/io/memory_reader.h"
+#include "engine/core/util/PathUtil.h"
+#include "engine/core/main/frame_state.h"
+#include "engine/core/log/Log.h"
+#include "engine/core/thread/JobSystem.h"
+#include <algorithm>
+
+namespace Echo
+{
+	TextureStreamer::~TextureStreamer()
+	{
+		for (Request& request : m_requests)
+			request.m_texture->m_isStreaming = false;
+
+		m_requests.clear();
+	}
+
+	TextureStreamer* TextureStreamer::instance()
+	{
+		static TextureStreamer* inst = EchoNew(TextureStreamer);
+		return inst;
+	}
+
+	bool TextureStreamer::isCooked(const void* data, size_t size)
+	{
+		ui32 magic = 0;
+		if (data && size >= sizeof(Header))
+			std::memcpy(&magic, data, sizeof(ui32));
+
+		return magic == Magic;
+	}
+
+	bool TextureStreamer::cook(const Buffer& source, ImageFormat format, ByteArray& cooked)
+	{
+		Image* image = Image::createFromMemory(source, format);
+		if (!image)
+			return false;
+
+		// levels from largest to smallest
+		PixelFormat pixFmt = image->getPixelFormat();
+		vector<MipInfo>::type mips;
+		ByteArray levels;
+		auto addLevel = [&](ui32 width, ui32 height, const Byte* data)
+		{
+			MipInfo mip;
+			mip.m_level = static_cast<ui32>(mips.size());
+			mip.m_width = width;
+			mip.m_height = height;
+			mip.m_offset = static_cast<ui32>(levels.size());
+			mip.m_size = PixelUtil::GetMemorySize(width, height, 1, pixFmt);
+			levels.insert(levels.end(), data, data + mip.m_size);
+			mips.emplace_back(mip);
+		};
+
+		if (image->getNumMipmaps() > 1 || PixelUtil::IsCompressed(pixFmt))
+		{
+			// baked by the source, compressed blocks can't be scaled here
+			const Byte* data = image->getData();
+			ui32 width = image->getWidth();
+			ui32 height = image->getHeight();
+			ui32 mipCount = std::max<ui32>(image->getNumMipmaps(), 1);
+			for (ui32 level = 0; level < mipCount; level++)
+			{
+				addLevel(width, height, data);
+				data += mips.back().m_size;
+				width = std::max<ui32>(width / 2, 1);
+				height = std::max<ui32>(height / 2, 1);
+			}
+		}
+		else
+		{
+			addLevel(image->getWidth(), image->getHeight(), image->getData());
+			while ((image->getWidth() > 1 || image->getHeight() > 1) && mips.size() < Texture::MAX_MINMAPS)
+			{
+				if (!image->scale(std::max<ui32>(image->getWidth() / 2, 1), std::max<ui32>(image->getHeight() / 2, 1)))
+					break;
+
+				addLevel(image->getWidth(), image->getHeight(), image->getData());
+			}
+		}
+
+		Header header;
+		header.m_magic = Magic;
+		header.m_version = Version;
+		header.m_pixFmt = ui32(pixFmt);
+		header.m_width = mips.front().m_width;
+		header.m_height = mips.front().m_height;
+		header.m_mipCount = static_cast<ui32>(mips.size());
+
+		EchoSafeDelete(image, Image);
+
+		// store smallest level first, a stream reads forward while refining
+		ui32 dataOffset = static_cast<ui32>(sizeof(Header) + sizeof(MipInfo) * mips.size());
+		ByteArray data;
+		data.reserve(levels.size());
+		for (auto it = mips.rbegin(); it != mips.rend(); it++)
+		{
+			const Byte* level = levels.data() + it->m_offset;
+			it->m_offset = dataOffset + static_cast<ui32>(data.size());
+			data.insert(data.end(), level, level + it->m_size);
+		}
+
+		cooked.clear();
+		cooked.reserve(dataOffset + data.size());
+		const Byte* headerData = reinterpret_cast<const Byte*>(&header);
+		cooked.insert(cooked.end(), headerData, headerData + sizeof(Header));
+		for (auto it = mips.rbegin(); it != mips.rend(); it++)
+		{
+			const Byte* mipData = reinterpret_cast<const Byte*>(&(*it));
+			cooked.insert(cooked.end(), mipData, mipData + sizeof(MipInfo));
+		}
+		cooked.insert(cooked.end(), data.begin(), data.end());
+
+		return true;
+	}
+
+	void TextureStreamer::cookFolder(const String& folderPath)
+	{
+		StringArray allFiles;
+		PathUtil::EnumFilesInDir(allFiles, folderPath, false, true, true);
+		for (const String& file : allFiles)
+		{
+			String ext = PathUtil::GetFileExt(file, true);
+			StringUtil::LowerCase(ext);
+			const Res::ResFun* resFun = Res::getResFunByExtension(ext);
+			if (!resFun || resFun->m_class != "Texture")
+				continue;
+
+			ByteArray cooked;
+			{
+				MemoryReader reader(file);
+				if (!reader.getSize() || isCooked(reader.getData<const char*>(), reader.getSize()) || !cook(Buffer(reader.getSize(), reader.getData<ui8*>(), false), Image::GetImageFormat(file), cooked))
+					continue;
+			}
+
+			FILE* cookedFile = fopen(file.c_str(), "wb");
+			if (cookedFile)
+			{
+				fwrite(cooked.data(), 1, cooked.size(), cookedFile);
+				fclose(cookedFile);
+			}
+			else
+			{
+				EchoLogError("TextureStreamer::cookFolder can't write file [%s]", file.c_str());
+			}
+		}
+	}
+
+	Image* TextureStreamer::createImage(const void* data, size_t size)
+	{
+		const Byte* bytes = static_cast<const Byte*>(data);
+		if (isCooked(data, size))
+		{
+			Header header;
+			std::memcpy(&header, bytes, sizeof(Header));
+			if (header.m_version == Version && header.m_mipCount && size >= sizeof(Header) + sizeof(MipInfo) * header.m_mipCount)
+			{
+				MipInfo mip;
+				std::memcpy(&mip, bytes + sizeof(Header) + sizeof(MipInfo) * (header.m_mipCount - 1), sizeof(MipInfo));
+				if (size_t(mip.m_offset) + mip.m_size <= size)
+					return EchoNew(Image(const_cast<Byte*>(bytes + mip.m_offset), mip.m_width, mip.m_height, 1, PixelFormat(header.m_pixFmt)));
+			}
+		}
+
+		EchoLogError("TextureStreamer::createImage failed. invalid cooked texture");
+		return nullptr;
+	}
+
+	bool TextureStreamer::load(Texture* texture)
+	{
+		DataStream* stream = IO::instance()->open(texture->getPath());
+		if (!stream)
+			return false;
+
+		Header header;
+		size_t fileSize = stream->size();
+		bool isCooked = fileSize >= sizeof(Header) && stream->read(&header, sizeof(Header)) == sizeof(Header) && header.m_magic == Magic;
+		if (!isCooked || !texture->isMipStreamingSupported())
+		{
+			if (isCooked && !m_isUnsupportedLogged)
+			{
+				EchoLogWarning("TextureStreamer: renderer can't upload single mips, cooked textures like [%s] load their top level only", texture->getPath().c_str());
+				m_isUnsupportedLogged = true;
+			}
+
+			// decode from this read instead of opening the file again, a cooked file gives its top level
+			ByteArray data(texture->m_decodedImage ? 0 : fileSize);
+			stream->seek(0);
+			if (!data.empty() && stream->read(data.data(), fileSize) == fileSize)
+				texture->m_decodedImage = Image::createFromMemory(Buffer(fileSize, data.data(), false), Image::GetImageFormat(texture->getPath()));
+
+			EchoSafeDelete(stream, DataStream);
+			return false;
+		}
+
+		Request request;
+		request.m_texture = texture;
+		request.m_mips.resize(header.m_mipCount);
+		size_t mipsSize = sizeof(MipInfo) * header.m_mipCount;
+		if (header.m_version != Version || !header.m_mipCount || header.m_mipCount > Texture::MAX_MINMAPS || stream->read(request.m_mips.data(), mipsSize) != mipsSize)
+		{
+			EchoLogError("TextureStreamer::load failed. invalid cooked texture [%s]", texture->getPath().c_str());
+			EchoSafeDelete(stream, DataStream);
+			return false;
+		}
+
+		remove(texture);
+
+		texture->m_pixFmt = PixelFormat(header.m_pixFmt);
+		texture->m_isCompressed = PixelUtil::IsCompressed(texture->m_pixFmt);
+		texture->m_compressType = Texture::CompressType_Unknown;
+		texture->m_width = header.m_width;
+		texture->m_height = header.m_height;
+		texture->m_depth = 1;
+		texture->m_numMipmaps = header.m_mipCount;
+
+		// the tail, at least the smallest level, is resident at once
+		bool isUploaded = true;
+		while (request.m_next < header.m_mipCount)
+		{
+			const MipInfo& mip = request.m_mips[request.m_next];
+			if (request.m_next > 0 && (mip.m_width > ResidentSize || mip.m_height > ResidentSize))
+				break;
+
+			isUploaded = readLevel(stream, mip, m_buffer) && uploadLevel(texture, mip, m_buffer);
+			if (!isUploaded)
+				break;
+
+			request.m_next++;
+		}
+
+		// larger levels reopen the file in their own read jobs
+		EchoSafeDelete(stream, DataStream);
+		if (!isUploaded)
+			return false;
+
+		if (request.m_next < header.m_mipCount)
+		{
+			request.m_id = ++m_nextRequestId;
+			texture->m_isStreaming = true;
+			m_requests.emplace_back(request);
+		}
+
+		return true;
+	}
+
+	void TextureStreamer::remove(Texture* texture)
+	{
+		// a read still in flight is dropped by uploadReadLevels, its request id is gone
+		for (size_t i = 0; i < m_requests.size(); i++)
+		{
+			if (m_requests[i].m_texture == texture)
+			{
+				texture->m_isStreaming = false;
+				m_requests[i] = m_requests.back();
+				m_requests.pop_back();
+				break;
+			}
+		}
+	}
+
+	void TextureStreamer::update()
+	{
+		uploadReadLevels();
+
+		// levels waiting for upload count against this frame's reads
+		ui32 queuedSize = 0;
+		for (const ReadLevel& level : m_uploadLevels)
+			queuedSize += level.m_mip.m_size;
+
+		while (true)
+		{
+			// smallest pending level first, so every texture gets sharper before any gets full detail
+			Request* best = nullptr;
+			for (Request& request : m_requests)
+			{
+				if (!request.m_isReading && (!best || request.m_mips[request.m_next].m_size < best->m_mips[best->m_next].m_size))
+					best = &request;
+			}
+
+			if (!best)
+				break;
+
+			// at least one level per frame, so a level larger than the budget still arrives
+			const MipInfo& mip = best->m_mips[best->m_next];
+			if (queuedSize > 0 && queuedSize + mip.m_size > m_uploadBudget)
+				break;
+
+			best->m_isReading = true;
+			queuedSize += mip.m_size;
+
+			// the file is opened per read, no stream is held between frames
+			ui32 requestId = best->m_id;
+			String path = best->m_texture->getPath();
+			JobSystem::instance()->runBackground([this, requestId, path, mip]()
+			{
+				ReadLevel level;
+				level.m_requestId = requestId;
+				level.m_mip = mip;
+
+				DataStream* stream = IO::instance()->open(path);
+				if (stream)
+				{
+					level.m_isRead = readLevel(stream, mip, level.m_data);
+					EchoSafeDelete(stream, DataStream);
+				}
+
+				EE_LOCK_MUTEX(m_readLevelsMutex)
+				m_readLevels.emplace_back(std::move(level));
+			});
+		}
+	}
+
+	void TextureStreamer::uploadReadLevels()
+	{
+		{
+			EE_LOCK_MUTEX(m_readLevelsMutex)
+			for (ReadLevel& level : m_readLevels)
+				m_uploadLevels.emplace_back(std::move(level));
+
+			m_readLevels.clear();
+		}
+
+		// levels over the budget wait for the next frame, the first one always goes so a level larger than the budget still arrives
+		ui32 uploadedSize = 0;
+		size_t count = 0;
+		for (; count < m_uploadLevels.size(); count++)
+		{
+			ReadLevel& level = m_uploadLevels[count];
+			auto it = std::find_if(m_requests.begin(), m_requests.end(), [&level](const Request& request) { return request.m_id == level.m_requestId; });
+			if (it == m_requests.end())
+				continue;
+
+			if (uploadedSize > 0 && uploadedSize + level.m_mip.m_size > m_uploadBudget)
+				break;
+
+			uploadedSize += level.m_mip.m_size;
+			Request& request = *it;
+			bool isUploaded = level.m_isRead && uploadLevel(request.m_texture, level.m_mip, level.m_data);
+			if (!isUploaded)
+				EchoLogError("TextureStreamer read level [%d] of [%s] failed", level.m_mip.m_level, request.m_texture->getPath().c_str());
+
+			request.m_isReading = false;
+			request.m_next++;
+			if (!isUploaded || request.m_next >= request.m_mips.size())
+				remove(request.m_texture);
+		}
+
+		m_uploadLevels.erase(m_uploadLevels.begin(), m_uploadLevels.begin() + count);
+	}
+
+	bool TextureStreamer::readLevel(DataStream* stream, const MipInfo& mip, ByteArray& data)
+	{
+		data.resize(mip.m_size);
+		stream->seek(mip.m_offset);
+		return stream->read(data.data(), mip.m_size) == mip.m_size;
+	}
+
+	bool TextureStreamer::uploadLevel(Texture* texture, const MipInfo& mip, ByteArray& data)
+	{
+		if (!texture->updateMipData(mip.m_level, mip.m_width, mip.m_height, Buffer(mip.m_size, data.data(), false)))
+			return false;
+
+		FrameState::instance()->incrUploadTextureSizeInBytes(mip.m_size);
+
+		return true;
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "texture.h"
+#include "engine/core/thread/Threading.h"
+
+namespace Echo
+{
+	class Image;
+
+	// Streams cooked textures. Cooking bakes the whole mip chain into a container, smallest
+	// level first. Loading uploads the small tail levels at once so the texture can be used,
+	// larger levels are read by background jobs within a per frame budget and uploaded by update.
+	class TextureStreamer
+	{
+	public:
+		static constexpr ui32 Magic = 0x58455445;		// "ETEX"
+		static constexpr ui32 Version = 1;
+		static constexpr ui32 ResidentSize = 64;		// levels up to this size are uploaded on load
+
+		// container header, followed by MipInfo[m_mipCount] and level data, smallest level first
+		struct Header
+		{
+			ui32	m_magic;
+			ui32	m_version;
+			ui32	m_pixFmt;
+			ui32	m_width;
+			ui32	m_height;
+			ui32	m_mipCount;
+		};
+
+		struct MipInfo
+		{
+			ui32	m_level;
+			ui32	m_width;
+			ui32	m_height;
+			ui32	m_offset;
+			ui32	m_size;
+		};
+
+	public:
+		~TextureStreamer();
+
+		// instance
+		static TextureStreamer* instance();
+
+		// is data a cooked texture
+		static bool isCooked(const void* data, size_t size);
+
+		// cook image file data, mips baked by the source (dds, pvr, ktx) are kept as they are
+		static bool cook(const Buffer& source, ImageFormat format, ByteArray& cooked);
+
+		// cook texture files of a folder in place
+		static void cookFolder(const String& folderPath);
+
+		// top level of a cooked texture, for cpu side users of the image
+		static Image* createImage(const void* data, size_t size);
+
+	public:
+		// load cooked texture, false if the file isn't cooked or the texture can't stream mips. the file
+		// is opened once, otherwise it's decoded from the same read and handed to texture->acquireImage
+		bool load(Texture* texture);
+
+		// stop streaming
+		void remove(Texture* texture);
+
+		// upload budget in bytes per frame
+		void setUploadBudget(ui32 bytes) { m_uploadBudget = bytes; }
+		ui32 getUploadBudget() const { return m_uploadBudget; }
+
+		// textures still streaming
+		ui32 getPendingCount() const { return static_cast<ui32>(m_requests.size()); }
+
+		// upload levels read since last frame, then queue reads within budget, smallest levels of all textures first
+		void update();
+
+	private:
+		TextureStreamer() {}
+
+		// read a level from stream
+		static bool readLevel(DataStream* stream, const MipInfo& mip, ByteArray& data);
+
+		// upload a level
+		bool uploadLevel(Texture* texture, const MipInfo& mip, ByteArray& data);
+
+		// upload levels the background jobs have read, within the upload budget
+		void uploadReadLevels();
+
+	private:
+		struct Request
+		{
+			ui32					m_id = 0;
+			Texture*				m_texture = nullptr;
+			vector<MipInfo>::type	m_mips;
+			ui32					m_next = 0;			// next level to upload
+			bool					m_isReading = false;
+		};
+
+		struct ReadLevel
+		{
+			ui32					m_requestId = 0;
+			MipInfo					m_mip;
+			ByteArray				m_data;
+			bool					m_isRead = false;
+		};
+
+		vector<Request>::type		m_requests;
+		ui32						m_nextRequestId = 0;
+		ui32						m_uploadBudget = 4 * 1024 * 1024;
+		ByteArray					m_buffer;			// reused read buffer of main thread
+		EE_MUTEX					(m_readLevelsMutex)
+		vector<ReadLevel>::type		m_readLevels;		// filled by background jobs
+		vector<ReadLevel>::type		m_uploadLevels;		// read, waiting for upload budget
+		bool						m_isUnsupportedLogged = false;
+	};
+}
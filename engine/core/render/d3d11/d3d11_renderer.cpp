@@ -95,7 +95,7 @@ namespace Echo
     RenderProxy* D3D11Renderer::createRenderProxy()
     {
         RenderProxy* renderable = EchoNew(VKRenderProxy);
-        m_renderProxies[renderable->getId()] = renderable;
+        registerRenderProxy(renderable);
 
         return renderable;
     }
@@ -24,51 +24,91 @@ namespace Echo
 	{
 	}
 
-	void GLESRenderable::bindShaderParams()
+	void GLESRenderable::buildUniformBindings()
 	{
-		ShaderProgram* shaderProgram = m_material->getShader();
+		m_uniformBindings.clear();
+		m_uniformBindingsCamera = m_camera;
+		m_uniformBindingsNode = m_node;
+		m_uniformBindingsDirty = false;
+
+		ShaderProgram* shaderProgram = m_material ? m_material->getShader() : nullptr;
 		if (shaderProgram)
 		{
 			i32 textureCount = 0;
-			for(ShaderProgram::UniformMap& uniformMap : shaderProgram->getUniforms())
+			for (ShaderProgram::UniformMap& uniformMap : shaderProgram->getUniforms())
 			{
 				for (auto& it : uniformMap)
 				{
-					ShaderProgram::UniformPtr uniform = it.second;
-					Material::UniformValue* uniformValue = m_material->getUniform(uniform->m_name);
-					if (uniform->m_type != SPT_TEXTURE)
+					UniformBinding binding;
+					binding.m_uniform = it.second;
+					binding.m_name = &it.first;
+					binding.m_value = m_material->getUniform(it.first);
+					if (binding.m_uniform->m_type != SPT_TEXTURE)
 					{
-						const void* value = nullptr;
-						if (!value && m_camera)
-							value = m_camera->getGlobalUniformValue(uniform->m_name);
-
-						if (!value && m_node)
-							value = m_node->getGlobalUniformValue(uniform->m_name);
-
-						if (!value)
-							value = uniformValue->getValue();
-
-						shaderProgram->setUniform(uniform->m_name.c_str(), value, uniform->m_type, uniform->m_count);
+						// only the source is cached, values are looked up when binding
+						if (m_camera && m_camera->getGlobalUniformValue(it.first))
+							binding.m_source = UniformSource::Camera;
+						else if (m_node && m_node->getGlobalUniformValue(it.first))
+							binding.m_source = UniformSource::Node;
+						else
+							binding.m_source = UniformSource::Material;
 					}
 					else
 					{
-						if (uniformValue)
-						{
-							Texture* texture = uniformValue->getTexture();
-							if (texture)
-							{
-								Renderer::instance()->setTexture(textureCount, texture);
-							}
-						}
-
-						shaderProgram->setUniform(uniform->m_name.c_str(), &textureCount, uniform->m_type, uniform->m_count);
-						textureCount++;
+						binding.m_source = UniformSource::Texture;
+						binding.m_textureUnit = textureCount++;
 					}
+
+					m_uniformBindings.emplace_back(binding);
+				}
+			}
+		}
+	}
+
+	void GLESRenderable::bindShaderParams()
+	{
+		if (m_uniformBindingsDirty || m_uniformBindingsCamera != m_camera || m_uniformBindingsNode != m_node)
+			buildUniformBindings();
+
+		for (UniformBinding& binding : m_uniformBindings)
+		{
+			switch (binding.m_source)
+			{
+			case UniformSource::Camera:		binding.m_uniform->setValue(m_camera->getGlobalUniformValue(*binding.m_name));	break;
+			case UniformSource::Node:		binding.m_uniform->setValue(m_node->getGlobalUniformValue(*binding.m_name));	break;
+			case UniformSource::Material:	binding.m_uniform->setValue(binding.m_value ? binding.m_value->getValue() : nullptr); break;
+			case UniformSource::Texture:
+			{
+				Texture* texture = binding.m_value ? binding.m_value->getTexture() : nullptr;
+				if (texture)
+				{
+					Renderer::instance()->setTexture(binding.m_textureUnit, texture);
 				}
+
+				binding.m_uniform->setValue(&binding.m_textureUnit);
+			}
+			break;
+			default: break;
 			}
 		}
 	}
 
+	const Matrix4& GLESRenderable::getWorldMatrix()
+	{
+		// same lookup order as the uniform bindings, resolved every call as the node may move its storage
+		const void* value = m_camera ? m_camera->getGlobalUniformValue("u_WorldMatrix") : nullptr;
+		if (!value && m_node)
+			value = m_node->getGlobalUniformValue("u_WorldMatrix");
+
+		if (!value && m_material)
+		{
+			Material::UniformValue* uniformValue = m_material->getUniform("u_WorldMatrix");
+			value = uniformValue ? uniformValue->getValue() : nullptr;
+		}
+
+		return value ? *(const Matrix4*)value : Matrix4::IDENTITY;
+	}
+
 	void GLESRenderable::setMesh(MeshPtr mesh)
 	{
 		m_mesh = mesh;
@@ -81,8 +121,10 @@ namespace Echo
 		m_material = material;
 
 		bindVertexStream();
+		markUniformBindingsDirty();
 
 		material->onShaderChanged.connectClassMethod(this, createMethodBind(&GLESRenderable::bindVertexStream));
+		material->onShaderChanged.connectClassMethod(this, createMethodBind(&GLESRenderable::markUniformBindingsDirty));
 	}
 
 	void GLESRenderable::bindVertexStream()
@@ -32,6 +32,26 @@ namespace Echo
 			{}
 		};
 
+		// uniform value source
+		enum class UniformSource
+		{
+			Camera,			// camera global value
+			Node,			// node global value, resolved every bind as nodes may reallocate it (skin joints)
+			Material,		// material uniform value
+			Texture,		// material texture bound to a fixed texture unit
+		};
+
+		// pre-resolved uniform binding
+		struct UniformBinding
+		{
+			ShaderProgram::Uniform*	m_uniform = nullptr;
+			UniformSource			m_source = UniformSource::Material;
+			const String*			m_name = nullptr;
+			Material::UniformValue*	m_value = nullptr;
+			i32						m_textureUnit = -1;
+		};
+		typedef vector<UniformBinding>::type UniformBindingList;
+
 	public:
 		GLESRenderable();
 		~GLESRenderable();
@@ -48,6 +68,9 @@ namespace Echo
 		// bind render state
 		void bindRenderState();
 
+		// world matrix, used by instanced draws
+		const Matrix4& getWorldMatrix();
+
 	private:
 		// set mesh
 		virtual void setMesh(MeshPtr mesh) override;
@@ -61,8 +84,16 @@ namespace Echo
 		// build vertex declaration
 		virtual bool buildVertStreamDeclaration(StreamUnit* stream);
 
+		// uniform bindings
+		void buildUniformBindings();
+		void markUniformBindingsDirty() { m_uniformBindingsDirty = true; }
+
 	private:
 		vector<StreamUnit>::type		m_vertexStreams;
+		UniformBindingList				m_uniformBindings;
+		RenderCamera*					m_uniformBindingsCamera = nullptr;
+		Render*							m_uniformBindingsNode = nullptr;
+		bool							m_uniformBindingsDirty = true;
 		//GLuint						m_vao = -1;
 	};
 }
@@ -144,6 +144,7 @@ namespace Echo
 
 	void GLESRenderer::cleanSystemResource()
 	{
+		EchoSafeDelete(m_instanceBuffer, GPUBuffer);
 	}
 
 	void GLESRenderer::setViewport(Viewport* pViewport)
@@ -299,45 +300,127 @@ namespace Echo
 			shaderProgram->bindUniforms();
 			shaderProgram->bindRenderable(renderable);
 
-			MeshPtr mesh = renderable->getMesh();
+			// instancing shader drawn alone, feed world matrix as constant attribute
+			if (shaderProgram->isInstancingSupported())
+			{
+				const Real* worldMatrix = (const Real*)&glesRenderable->getWorldMatrix();
+				GLint location = shaderProgram->getInstanceMatrixLocation();
+				for (GLint i = 0; i < 4; i++)
+				{
+					disableAttribLocation(location + i);
+					OGLESDebug(glVertexAttrib4fv(location + i, worldMatrix + i * 4));
+				}
+			}
 
-			// set the type of primitive that should be rendered from this vertex buffer
-			GLenum glTopologyType = GLESMapping::MapPrimitiveTopology(mesh->getTopologyType());
+			drawMesh(renderable->getMesh(), 1);
 
-			//set the index buffer to active in the input assembler
-			GPUBuffer* pIdxBuff = mesh->getIndexBuffer();
-			if (pIdxBuff)
-			{
-				// map index type
-				GLenum idxType;
-				if (mesh->getIndexStride() == sizeof(ui32))		idxType = GL_UNSIGNED_INT;
-				else if (mesh->getIndexStride() == sizeof(Word))	idxType = GL_UNSIGNED_SHORT;
-				else											idxType = GL_UNSIGNED_BYTE;
+			shaderProgram->unbind();
+		}
+	}
+
+	void GLESRenderer::drawInstanced(RenderProxy** renderables, ui32 count, FrameBufferPtr& frameBuffer)
+	{
+		RenderProxy* renderable = renderables[0];
+		GLESShaderProgram* shaderProgram = ECHO_DOWN_CAST<GLESShaderProgram*>(renderable->getMaterial()->getShader());
+		if (!shaderProgram || !shaderProgram->isLinked() || !shaderProgram->isInstancingSupported() || m_settings.m_polygonMode != RasterizerState::PM_FILL)
+		{
+			Renderer::drawInstanced(renderables, count, frameBuffer);
+			return;
+		}
 
-				// index count
-				ui32 idxCount = mesh->getIndexCount();
+		FrameState::instance()->increaseDrawCalls();
 
-				// index offset
-				Byte* idxOffset = 0; idxOffset += mesh->getStartIndex() * mesh->getIndexStride();
+		// gather per instance world matrix
+		m_instanceMatrixs.resize(count);
+		for (ui32 i = 0; i < count; i++)
+		{
+			m_instanceMatrixs[i] = ((GLESRenderable*)renderables[i])->getWorldMatrix();
+		}
 
-				// draw
+		Buffer instanceBuff(count * sizeof(Matrix4), m_instanceMatrixs.data());
+		if (!m_instanceBuffer)
+			m_instanceBuffer = createVertexBuffer(GPUBuffer::GBU_DYNAMIC, instanceBuff);
+		else
+			m_instanceBuffer->updateData(instanceBuff);
+
+		GLESRenderable* glesRenderable = (GLESRenderable*)renderable;
+		shaderProgram->bind();
+		glesRenderable->bindRenderState();
+		glesRenderable->bindShaderParams();
+		shaderProgram->bindUniforms();
+		shaderProgram->bindRenderable(renderable);
+
+		// one matrix column per attribute location, advanced once per instance
+		GLint location = shaderProgram->getInstanceMatrixLocation();
+		((GLESGPUBuffer*)m_instanceBuffer)->bindBuffer();
+		for (GLint i = 0; i < 4; i++)
+		{
+			OGLESDebug(glVertexAttribPointer(location + i, 4, GL_FLOAT, GL_FALSE, sizeof(Matrix4), (GLvoid*)(sizeof(Real) * 4 * i)));
+			OGLESDebug(glVertexAttribDivisor(location + i, 1));
+			enableAttribLocation(location + i);
+		}
+
+		drawMesh(renderable->getMesh(), count);
+
+		for (GLint i = 0; i < 4; i++)
+		{
+			OGLESDebug(glVertexAttribDivisor(location + i, 0));
+			disableAttribLocation(location + i);
+		}
+
+		shaderProgram->unbind();
+	}
+
+	void GLESRenderer::drawMesh(Mesh* mesh, ui32 instanceCount)
+	{
+		// set the type of primitive that should be rendered from this vertex buffer
+		GLenum glTopologyType = GLESMapping::MapPrimitiveTopology(mesh->getTopologyType());
+
+		//set the index buffer to active in the input assembler
+		GPUBuffer* pIdxBuff = mesh->getIndexBuffer();
+		if (pIdxBuff)
+		{
+			// map index type
+			GLenum idxType;
+			if (mesh->getIndexStride() == sizeof(ui32))		idxType = GL_UNSIGNED_INT;
+			else if (mesh->getIndexStride() == sizeof(Word))	idxType = GL_UNSIGNED_SHORT;
+			else											idxType = GL_UNSIGNED_BYTE;
+
+			// index count
+			ui32 idxCount = mesh->getIndexCount();
+
+			// index offset
+			Byte* idxOffset = 0; idxOffset += mesh->getStartIndex() * mesh->getIndexStride();
+
+			// draw
+			if (instanceCount > 1)
+			{
+				OGLESDebug(glDrawElementsInstanced(glTopologyType, idxCount, idxType, idxOffset, instanceCount));
+			}
+			else
+			{
 				OGLESDebug(glDrawElements(glTopologyType, idxCount, idxType, idxOffset));
 			}
-			else	// no using index buffer
+		}
+		else	// no using index buffer
+		{
+			ui32 vertCount = mesh->getVertexCount();
+			if (vertCount > 0)
 			{
-				ui32 vertCount = mesh->getVertexCount();
-				if (vertCount > 0)
+				ui32 startVert = mesh->getStartVertex();
+				if (instanceCount > 1)
 				{
-					ui32 startVert = mesh->getStartVertex();
-					OGLESDebug(glDrawArrays(glTopologyType, startVert, vertCount));
+					OGLESDebug(glDrawArraysInstanced(glTopologyType, startVert, vertCount, instanceCount));
 				}
 				else
 				{
-					EchoLogError("GLES2Renderer::render failed!");
+					OGLESDebug(glDrawArrays(glTopologyType, startVert, vertCount));
 				}
 			}
-
-			shaderProgram->unbind();
+			else
+			{
+				EchoLogError("GLES2Renderer::render failed!");
+			}
 		}
 	}
 
@@ -643,7 +726,7 @@ namespace Echo
 	RenderProxy* GLESRenderer::createRenderProxy()
 	{
 		RenderProxy* proxy = EchoNew(GLESRenderable);
-		m_renderProxies[proxy->getId()] = proxy;
+		registerRenderProxy(proxy);
 
 		return proxy;
 	}
@@ -32,7 +32,7 @@ namespace Echo
 	{
 		typedef vector<GLuint>::type			TexUintList;
 		typedef vector<SamplerState*>::type		SamplerList;
-		typedef array<bool, 9>					NineBoolArray;
+		typedef array<bool, 16>					AttribEnableArray;
 
 	public:
 		GLESRenderer();
@@ -57,6 +57,12 @@ namespace Echo
 		// draw
 		virtual void draw(RenderProxy* renderable, FrameBufferPtr& frameBuffer) override;
 
+		// draw instanced
+		virtual void drawInstanced(RenderProxy** renderables, ui32 count, FrameBufferPtr& frameBuffer) override;
+
+		// instancing
+		virtual bool isInstancingSupported() const override { return true; }
+
 		// draw in WireFrame mode
 		bool drawWireframe(RenderProxy* renderable);
 
@@ -126,6 +132,9 @@ namespace Echo
 		// bind texture to slot
 		void bindTexture(GLenum slot, GLenum target, GLuint texture, bool needReset = false);
 
+		// issue draw call of mesh
+		void drawMesh(Mesh* mesh, ui32 instanceCount);
+
 		bool initializeImpl(const Settings& config);
 		void destroyImpl();
 		virtual void createSystemResource();
@@ -144,7 +153,9 @@ namespace Echo
 		String						m_gpuDesc;
 		ui32						m_screenWidth = 800;
 		ui32						m_screenHeight = 600;
-		NineBoolArray				m_isVertexAttribArrayEnable;
+		AttribEnableArray			m_isVertexAttribArrayEnable;
+		GPUBuffer*					m_instanceBuffer = nullptr;
+		vector<Matrix4>::type		m_instanceMatrixs;
 
 #ifdef ECHO_EDITOR_MODE
 		GPUBuffer*					m_wireFrameIndexBuffer = nullptr;
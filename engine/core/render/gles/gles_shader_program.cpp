@@ -137,6 +137,8 @@ namespace Echo
 			}
 		}
 
+		m_instanceMatrixLocation = OGLESDebug(glGetAttribLocation(m_glesProgram, "a_InstanceWorldMatrix"));
+
 		m_isLinked = true;
 
 		return true;
@@ -148,7 +150,11 @@ namespace Echo
 		{
 			for (UniformMap::iterator it = uniformMap.begin(); it != uniformMap.end(); it++)
 			{
-				UniformPtr uniform = it->second;
+				// gl keeps uniform values per program, skip unchanged ones
+				Uniform* uniform = it->second;
+				if (!uniform->isDirty())
+					continue;
+
 				void* value = uniform->m_value.empty() ? uniform->getValueDefault().data() : uniform->m_value.data();
 				if (value)
 				{
@@ -166,6 +172,8 @@ namespace Echo
 						default:			EchoAssertX(0, "unknow shader param format!");													break;
 						}
 					}
+
+					uniform->setDirty(false);
 				}
 				else
 				{
@@ -39,6 +39,10 @@ namespace Echo
 		// get attribute location
 		i32 getAtrribLocation(VertexSemantic vertexSemantic);
 
+		// instancing, shader declares "mat4 a_InstanceWorldMatrix" to opt in
+		bool isInstancingSupported() const { return m_instanceMatrixLocation != -1; }
+		i32 getInstanceMatrixLocation() const { return m_instanceMatrixLocation; }
+
 		// Create
 		virtual bool createShaderProgram(const String& vsContent, const String& psContent) override;
 		void clearShaderProgram();
@@ -56,6 +60,7 @@ namespace Echo
 		ShaderArray			m_shaders;
 		GLESRenderable*		m_preRenderable;					// Geomerty
 		AttribLocationArray	m_attribLocationMapping;			// Attribute location
+		GLint				m_instanceMatrixLocation = -1;		// Per instance world matrix, occupies 4 locations
 		GLuint				m_glesProgram = 0;
 	};
 }
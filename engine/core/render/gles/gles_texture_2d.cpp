@@ -4,6 +4,7 @@
 #include "base/image/pixel_format.h"
 #include "base/image/Image.h"
 #include "base/image/texture_loader.h"
+#include "base/texture/texture_streamer.h"
 #include "gles_render_base.h"
 #include "gles_renderer.h"
 #include "gles_texture_2d.h"
@@ -65,6 +66,19 @@ namespace Echo
 		return true;
 	}
 
+	bool GLESTexture2D::updateMipData(ui32 level, ui32 width, ui32 height, const Buffer& buff)
+	{
+		set2DSurfaceData(level, m_pixFmt, m_usage, width, height, buff);
+
+		// sample from the largest level uploaded so far
+		OGLESDebug(glBindTexture(GL_TEXTURE_2D, m_glesTexture));
+		OGLESDebug(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, level));
+		OGLESDebug(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, m_numMipmaps - 1));
+		OGLESDebug(glBindTexture(GL_TEXTURE_2D, 0));
+
+		return true;
+	}
+
 	void GLESTexture2D::create2DTexture()
 	{
 		if (!m_glesTexture)
@@ -102,43 +116,43 @@ namespace Echo
 	{
 		create2DTexture();
 
-		MemoryReader memReader(getPath());
-		if (memReader.getSize())
+		// cooked textures stream their baked mips
+		if (TextureStreamer::instance()->load(this))
+			return true;
+
+		Image* image = acquireImage();
+		if (image)
 		{
-			Image* image = Image::createFromMemory(Buffer(memReader.getSize(), memReader.getData<ui8*>(), false), Image::GetImageFormat(getPath()));
-			if (image)
+			m_isCompressed = false;
+			m_compressType = Texture::CompressType_Unknown;
+			m_width = image->getWidth();
+			m_height = image->getHeight();
+			m_depth = image->getDepth();
+			m_pixFmt = image->getPixelFormat();
+			m_numMipmaps = image->getNumMipmaps() ? image->getNumMipmaps() : 1;
+			ui32 pixelsSize = PixelUtil::CalcSurfaceSize(m_width, m_height, m_depth, m_numMipmaps, m_pixFmt);
+			i32 level = 0;
+
+			set2DSurfaceData(level, m_pixFmt, m_usage, m_width, m_height, Buffer(pixelsSize, image->getData(), false));
+
+			// Generate mipmaps
+			if (m_isMipMapEnable && !m_compressType)
 			{
-				m_isCompressed = false;
-				m_compressType = Texture::CompressType_Unknown;
-				m_width = image->getWidth();
-				m_height = image->getHeight();
-				m_depth = image->getDepth();
-				m_pixFmt = image->getPixelFormat();
-				m_numMipmaps = image->getNumMipmaps() ? image->getNumMipmaps() : 1;
-				ui32 pixelsSize = PixelUtil::CalcSurfaceSize(m_width, m_height, m_depth, m_numMipmaps, m_pixFmt);
-				i32 level = 0;
-
-				set2DSurfaceData(level, m_pixFmt, m_usage, m_width, m_height, Buffer(pixelsSize, image->getData(), false));
-
-				// Generate mipmaps
-				if (m_isMipMapEnable && !m_compressType)
+				while (true)
 				{
-					while (true)
-					{
-						i32 halfWidth = image->getWidth() / 2;
-						i32 halfHeight = image->getHeight() / 2;
-						if (!image->scale(halfWidth, halfHeight))
-							break;
-
-						pixelsSize = PixelUtil::CalcSurfaceSize(halfWidth, halfHeight, 1, 1, m_pixFmt);
-						set2DSurfaceData(++level, m_pixFmt, m_usage, halfWidth, halfHeight, Buffer(pixelsSize, image->getData(), false));
-					}
+					i32 halfWidth = image->getWidth() / 2;
+					i32 halfHeight = image->getHeight() / 2;
+					if (!image->scale(halfWidth, halfHeight))
+						break;
+
+					pixelsSize = PixelUtil::CalcSurfaceSize(halfWidth, halfHeight, 1, 1, m_pixFmt);
+					set2DSurfaceData(++level, m_pixFmt, m_usage, halfWidth, halfHeight, Buffer(pixelsSize, image->getData(), false));
 				}
+			}
 
-				EchoSafeDelete(image, Image);
+			EchoSafeDelete(image, Image);
 
-				return true;
-			}
+			return true;
 		}
 
 		return false;
@@ -13,6 +13,10 @@ namespace Echo
 		virtual bool updateTexture2D(PixelFormat format, TexUsage usage, i32 width, i32 height, void* data, ui32 size) override;
 		bool updateSubTex2D(ui32 level, const Rect& rect, void* pData, ui32 size);
 
+		// upload a streamed level
+		virtual bool updateMipData(ui32 level, ui32 width, ui32 height, const Buffer& buff) override;
+		virtual bool isMipStreamingSupported() const override { return true; }
+
 		// type
 		virtual TexType getType() const override { return TT_2D; }
 
@@ -4,6 +4,7 @@
 #include "mt_render_state.h"
 #include "engine/core/io/IO.h"
 #include "base/image/image.h"
+#include "base/texture/texture_streamer.h"
 
 namespace Echo
 {
@@ -35,32 +36,31 @@ namespace Echo
 
     bool MTTexture2D::load()
     {
-        MemoryReader memReader(getPath());
-        if (memReader.getSize())
+        // cooked textures stream their baked mips
+        if (TextureStreamer::instance()->load(this))
+            return true;
+
+        Image* image = acquireImage();
+        if (image)
         {
-            Buffer commonTextureBuffer(memReader.getSize(), memReader.getData<ui8*>(), false);
-            Image* image = Image::createFromMemory(commonTextureBuffer, Image::GetImageFormat(getPath()));
-            if (image)
-            {
-                // metal doesn't support rgb format
-                convertFormat(image);
-                
-                m_isCompressed = false;
-                m_compressType = Texture::CompressType_Unknown;
-                m_width = image->getWidth();
-                m_height = image->getHeight();
-                m_depth = image->getDepth();
-                m_pixFmt = image->getPixelFormat();
-                m_numMipmaps = image->getNumMipmaps() ? image->getNumMipmaps() : 1;
-                ui32 pixelsSize = PixelUtil::CalcSurfaceSize(m_width, m_height, m_depth, m_numMipmaps, m_pixFmt);
-                Buffer buff(pixelsSize, image->getData(), false);
+            // metal doesn't support rgb format
+            convertFormat(image);
+            
+            m_isCompressed = false;
+            m_compressType = Texture::CompressType_Unknown;
+            m_width = image->getWidth();
+            m_height = image->getHeight();
+            m_depth = image->getDepth();
+            m_pixFmt = image->getPixelFormat();
+            m_numMipmaps = image->getNumMipmaps() ? image->getNumMipmaps() : 1;
+            ui32 pixelsSize = PixelUtil::CalcSurfaceSize(m_width, m_height, m_depth, m_numMipmaps, m_pixFmt);
+            Buffer buff(pixelsSize, image->getData(), false);
 
-                setSurfaceData( 0, m_pixFmt, m_usage, m_width, m_height, buff);
-                
-                EchoSafeDelete(image, Image);
+            setSurfaceData( 0, m_pixFmt, m_usage, m_width, m_height, buff);
+            
+            EchoSafeDelete(image, Image);
 
-                return true;
-            }
+            return true;
         }
 
         return false;
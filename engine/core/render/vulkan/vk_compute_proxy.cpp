@@ -13,6 +13,11 @@ namespace Echo
     {
     }
 
+    VKComputeProxy::~VKComputeProxy()
+    {
+        destroyVkPipeline();
+    }
+
     void VKComputeProxy::setMesh(MeshPtr mesh)
     {
         m_mesh = mesh;
@@ -78,7 +83,8 @@ namespace Echo
                 m_vkPipelineInfo.basePipelineHandle = 0;
                 m_vkPipelineInfo.basePipelineIndex = 0;
 
-				VKDebug(vkCreateGraphicsPipelines(VKRenderer::instance()->getVkDevice(), VK_NULL_HANDLE, 1, &m_vkPipelineInfo, nullptr, &m_vkPipeline));
+				// identical proxies share one pipeline
+				m_vkPipeline = VKRenderer::instance()->getPipelineLibrary().acquire(m_vkPipelineInfo);
 			}
         }
 
@@ -89,7 +95,7 @@ namespace Echo
     {
         if (m_vkPipeline)
         {
-            vkDestroyPipeline(VKRenderer::instance()->getVkDevice(), m_vkPipeline, nullptr);
+            VKRenderer::instance()->getPipelineLibrary().release(m_vkPipeline);
             m_vkPipeline = VK_NULL_HANDLE;
         }
     }
@@ -10,7 +10,7 @@ namespace Echo
 	{
 	public:
         VKComputeProxy(int identifier);
-        virtual ~VKComputeProxy() {}
+        virtual ~VKComputeProxy();
 
         // bind shader uniforms
 		void bindRenderState();
@@ -19,6 +19,8 @@ namespace Echo
     {
         if (m_vkRenderPass)
         {
+            // a new render pass may get the same handle, its pipelines mustn't be shared
+            VKRenderer::instance()->getPipelineLibrary().removeRenderPass(m_vkRenderPass);
             vkDestroyRenderPass(VKRenderer::instance()->getVkDevice(), m_vkRenderPass, nullptr);
             m_vkRenderPass = VK_NULL_HANDLE;
         }
@@ -90,20 +92,26 @@ namespace Echo
         // End command buffer before submit
         VKDebug(vkEndCommandBuffer(getVkCommandbuffer()));
 
-        // Submit command buffer
+        // uploads recorded while drawing go ahead of the draws
+        VKRenderer::instance()->flushVkUploadCommandBuffer();
+
+        // Submit command buffer, the frame's fence tells when it finished
+        VkCommandBuffer vkCommandBuffer = getVkCommandbuffer();
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &m_vkCommandBuffers[0];
-
-        VKDebug(vkQueueSubmit(VKRenderer::instance()->getVkGraphicsQueue(), 1, &submitInfo, 0));
+        submitInfo.pCommandBuffers = &vkCommandBuffer;
 
-        // Wait command buffer finished
-        VKDebug(vkQueueWaitIdle(VKRenderer::instance()->getVkGraphicsQueue()));
+        VKDebug(vkQueueSubmit(VKRenderer::instance()->getVkGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE));
 
         return true;
     }
 
+    VkCommandBuffer VKFramebufferOffscreen::getVkCommandbuffer()
+    {
+        return m_vkCommandBuffers[VKRenderer::instance()->getFrameIndex()];
+    }
+
     void VKFramebufferOffscreen::onSize(ui32 width, ui32 height)
     {
         for (TextureRenderTarget2D* colorView : m_views)
@@ -251,14 +259,24 @@ namespace Echo
             subpassDesc.preserveAttachmentCount = 0;
             subpassDesc.pPreserveAttachments = nullptr;
 
-            VkSubpassDependency subpassDependency = {};
-            subpassDependency.srcSubpass = VK_SUBPASS_EXTERNAL;
-            subpassDependency.dstSubpass = 0;
-            subpassDependency.srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            subpassDependency.dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-            subpassDependency.srcAccessMask = 0;
-            subpassDependency.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-            subpassDependency.dependencyFlags = 0;
+            // the previous frame may still sample the attachments, and this frame samples them
+            // after the pass. Without waiting idle these dependencies are the only ordering
+            array<VkSubpassDependency, 2> subpassDependencies;
+            subpassDependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+            subpassDependencies[0].dstSubpass = 0;
+            subpassDependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            subpassDependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+            subpassDependencies[0].srcAccessMask = 0;
+            subpassDependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            subpassDependencies[0].dependencyFlags = 0;
+
+            subpassDependencies[1].srcSubpass = 0;
+            subpassDependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+            subpassDependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+            subpassDependencies[1].dstStageMask = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+            subpassDependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+            subpassDependencies[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            subpassDependencies[1].dependencyFlags = 0;
 
             VkRenderPassCreateInfo renderPassCreateInfo = {};
             renderPassCreateInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
@@ -268,8 +286,8 @@ namespace Echo
             renderPassCreateInfo.pAttachments = attachDescs.data();
             renderPassCreateInfo.subpassCount = 1;
             renderPassCreateInfo.pSubpasses = &subpassDesc;
-            renderPassCreateInfo.dependencyCount = 1;
-            renderPassCreateInfo.pDependencies = &subpassDependency;
+            renderPassCreateInfo.dependencyCount = subpassDependencies.size();
+            renderPassCreateInfo.pDependencies = subpassDependencies.data();
 
             VKDebug(vkCreateRenderPass(VKRenderer::instance()->getVkDevice(), &renderPassCreateInfo, nullptr, &m_vkRenderPass));
         }
@@ -279,7 +297,7 @@ namespace Echo
     {
         destroyVkCommandBuffers();
 
-        m_vkCommandBuffers.resize(1);
+        m_vkCommandBuffers.resize(VKMaxFramesInFlight);
         for (size_t i = 0; i < m_vkCommandBuffers.size(); i++)
         {
             m_vkCommandBuffers[i] = VKRenderer::instance()->createVkCommandBuffer();
@@ -314,13 +332,18 @@ namespace Echo
         destroyVkSwapChain(m_vkSwapChain);
 
         vkDestroySurfaceKHR(VKRenderer::instance()->getVkInstance(), m_vkWindowSurface, nullptr);
-        vkDestroySemaphore(VKRenderer::instance()->getVkDevice(), m_vkRenderFinishedSemaphore, nullptr);
-        vkDestroySemaphore(VKRenderer::instance()->getVkDevice(), m_vkImageAvailableSemaphore, nullptr);
+        destroyVkSemaphores();
+    }
+
+    VkCommandBuffer VKFramebufferWindow::getVkCommandbuffer()
+    {
+        return m_vkCommandBuffers[VKRenderer::instance()->getFrameIndex()];
     }
 
     bool VKFramebufferWindow::begin()
     {
-        VKDebug(vkAcquireNextImageKHR(VKRenderer::instance()->getVkDevice(), m_vkSwapChain, Math::MAX_UI64, m_vkImageAvailableSemaphore, VK_NULL_HANDLE, &m_imageIndex));
+        ui32 frameIndex = VKRenderer::instance()->getFrameIndex();
+        VKDebug(vkAcquireNextImageKHR(VKRenderer::instance()->getVkDevice(), m_vkSwapChain, Math::MAX_UI64, m_vkImageAvailableSemaphores[frameIndex], VK_NULL_HANDLE, &m_imageIndex));
 
 		VkCommandBufferBeginInfo commandBufferBeginInfo = {};
 		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
@@ -474,7 +497,6 @@ namespace Echo
             createVkRenderPass();
             createVkFramebuffers();
             createVkCommandBuffers();
-            createVkFences();
 
             VKDebug(vkDeviceWaitIdle(vkDevice));
         }
@@ -490,7 +512,7 @@ namespace Echo
     {
         destroyVkCommandBuffers();
 
-        m_vkCommandBuffers.resize(m_vkSwapChainImages.size());
+        m_vkCommandBuffers.resize(VKMaxFramesInFlight);
         for (size_t i = 0; i < m_vkCommandBuffers.size(); i++)
         {
             m_vkCommandBuffers[i] = VKRenderer::instance()->createVkCommandBuffer();
@@ -501,6 +523,8 @@ namespace Echo
     {
         if (!m_vkCommandBuffers.empty())
             vkFreeCommandBuffers(VKRenderer::instance()->getVkDevice(), VKRenderer::instance()->getVkCommandPool(), m_vkCommandBuffers.size(), m_vkCommandBuffers.data());
+
+        m_vkCommandBuffers.clear();
     }
 
     void VKFramebufferWindow::createVkSemaphores()
@@ -510,33 +534,21 @@ namespace Echo
         semaphoreCreateInfo.pNext = nullptr;
         semaphoreCreateInfo.flags = 0;
 
-        VKDebug(vkCreateSemaphore(VKRenderer::instance()->getVkDevice(), &semaphoreCreateInfo, nullptr, &m_vkImageAvailableSemaphore));
-        VKDebug(vkCreateSemaphore(VKRenderer::instance()->getVkDevice(), &semaphoreCreateInfo, nullptr, &m_vkRenderFinishedSemaphore));
-    }
-
-    void VKFramebufferWindow::createVkFences()
-    {
-        destroyVkFences();
-
-        // Fences (Used to check draw command buffer completion)
-        VkFenceCreateInfo fenceCreateInfo = {};
-        fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-        fenceCreateInfo.pNext = nullptr;
-
-        // Create in signaled state so we don't wait on first render of each command buffer
-        fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-        m_waitFences.resize(m_vkSwapChainImages.size());
-        for (VkFence& fence : m_waitFences)
-            VKDebug(vkCreateFence(VKRenderer::instance()->getVkDevice(), &fenceCreateInfo, nullptr, &fence));
+        // a semaphore pair per frame in flight, a frame's semaphores are free again once its fence signaled
+        for (ui32 i = 0; i < VKMaxFramesInFlight; i++)
+        {
+            VKDebug(vkCreateSemaphore(VKRenderer::instance()->getVkDevice(), &semaphoreCreateInfo, nullptr, &m_vkImageAvailableSemaphores[i]));
+            VKDebug(vkCreateSemaphore(VKRenderer::instance()->getVkDevice(), &semaphoreCreateInfo, nullptr, &m_vkRenderFinishedSemaphores[i]));
+        }
     }
 
-    void VKFramebufferWindow::destroyVkFences()
+    void VKFramebufferWindow::destroyVkSemaphores()
     {
-        for (VkFence& fence : m_waitFences)
-            vkDestroyFence(VKRenderer::instance()->getVkDevice(), fence, nullptr);
-
-        m_waitFences.clear();
+        for (ui32 i = 0; i < VKMaxFramesInFlight; i++)
+        {
+            vkDestroySemaphore(VKRenderer::instance()->getVkDevice(), m_vkRenderFinishedSemaphores[i], nullptr);
+            vkDestroySemaphore(VKRenderer::instance()->getVkDevice(), m_vkImageAvailableSemaphores[i], nullptr);
+        }
     }
 
     void VKFramebufferWindow::createVkSurface(void* handle)
@@ -581,26 +593,27 @@ namespace Echo
         // end command buffer before submit
         VKDebug(vkEndCommandBuffer(getVkCommandbuffer()));
 
-        // Use a fence to wait until the command buffer has finished execution before using it again
-        VKDebug(vkWaitForFences(VKRenderer::instance()->getVkDevice(), 1, &m_waitFences[m_imageIndex], VK_TRUE, UINT64_MAX));
-        VKDebug(vkResetFences(VKRenderer::instance()->getVkDevice(), 1, &m_waitFences[m_imageIndex]));
+        // uploads recorded while drawing go ahead of the draws
+        VKRenderer::instance()->flushVkUploadCommandBuffer();
 
-		// wait stage flags
-        VkSemaphore waitSemaphores[] = { m_vkImageAvailableSemaphore };
-        VkSemaphore signalSemaphores[] = { m_vkRenderFinishedSemaphore };
+		// wait stage flags, the renderer's frame fence guards reuse of the command buffer
+        ui32 frameIndex = VKRenderer::instance()->getFrameIndex();
+        VkSemaphore waitSemaphores[] = { m_vkImageAvailableSemaphores[frameIndex] };
+        VkSemaphore signalSemaphores[] = { m_vkRenderFinishedSemaphores[frameIndex] };
         VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
 
+        VkCommandBuffer vkCommandBuffer = getVkCommandbuffer();
         VkSubmitInfo submitInfo = {};
         submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
         submitInfo.commandBufferCount = 1;
-        submitInfo.pCommandBuffers = &m_vkCommandBuffers[m_imageIndex];
+        submitInfo.pCommandBuffers = &vkCommandBuffer;
         submitInfo.waitSemaphoreCount = 1;
         submitInfo.pWaitSemaphores = waitSemaphores;							            // Semaphore(s) to wait upon before the submitted command buffer starts executing
         submitInfo.signalSemaphoreCount = 1;
         submitInfo.pSignalSemaphores = signalSemaphores;						// Semaphore(s) to be signaled when command buffers have completed
         submitInfo.pWaitDstStageMask = waitStages;
 
-        VKDebug(vkQueueSubmit(VKRenderer::instance()->getVkGraphicsQueue(), 1, &submitInfo, m_waitFences[m_imageIndex]));
+        VKDebug(vkQueueSubmit(VKRenderer::instance()->getVkGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE));
     }
 
     void VKFramebufferWindow::present()
@@ -609,14 +622,13 @@ namespace Echo
         present.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
         present.pNext = nullptr;
 		present.waitSemaphoreCount = 1;
-		present.pWaitSemaphores = &m_vkRenderFinishedSemaphore;
+		present.pWaitSemaphores = &m_vkRenderFinishedSemaphores[VKRenderer::instance()->getFrameIndex()];
         present.swapchainCount = 1;
         present.pSwapchains = &m_vkSwapChain;
         present.pImageIndices = &m_imageIndex;
         present.pResults = nullptr;
 
         VKDebug(vkQueuePresentKHR(m_vkPresentQueue, &present));
-        VKDebug(vkQueueWaitIdle(m_vkPresentQueue));
     }
 
     void VKFramebufferWindow::createSwapChain(VkDevice vkDevice)
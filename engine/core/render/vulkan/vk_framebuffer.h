@@ -63,8 +63,8 @@ namespace Echo
         virtual void onSize(ui32 width, ui32 height) override;
 
     protected:
-        // get vk command buffer
-        virtual VkCommandBuffer getVkCommandbuffer() override { return m_vkCommandBuffers[0]; }
+        // get vk command buffer of the frame in flight
+        virtual VkCommandBuffer getVkCommandbuffer() override;
 
         // get vk frame buffer
         virtual VkFramebuffer getVkFramebuffer() override { return m_vkFramebuffers[0]; }
@@ -88,7 +88,7 @@ namespace Echo
         virtual void createVkRenderPass() override;
 
     protected:
-        vector<VkCommandBuffer>::type   m_vkCommandBuffers;
+        vector<VkCommandBuffer>::type   m_vkCommandBuffers;     // one per frame in flight
     };
 
     class VKFramebufferWindow : public FrameBufferWindow, public VKFramebuffer
@@ -105,8 +105,8 @@ namespace Echo
         virtual void onSize(ui32 width, ui32 height) override;
 
     public:
-        // get vk command buffer
-        virtual VkCommandBuffer getVkCommandbuffer() override { return m_vkCommandBuffers[m_imageIndex]; }
+        // get vk command buffer of the frame in flight
+        virtual VkCommandBuffer getVkCommandbuffer() override;
 
         // get vk frame buffer
         virtual VkFramebuffer getVkFramebuffer() override { return m_vkFramebuffers[m_imageIndex]; }
@@ -129,10 +129,7 @@ namespace Echo
 
         // create semaphores
         void createVkSemaphores();
-
-        // create fences
-        void createVkFences();
-        void destroyVkFences();
+        void destroyVkSemaphores();
 
         // create swap chain
         void createSwapChain(VkDevice vkDevice);
@@ -162,9 +159,8 @@ namespace Echo
 
     protected:
         ui32                            m_imageIndex = 0;
-        vector<VkFence>::type           m_waitFences;
-        VkSemaphore                     m_vkImageAvailableSemaphore;
-        VkSemaphore                     m_vkRenderFinishedSemaphore;
+        array<VkSemaphore, VKMaxFramesInFlight> m_vkImageAvailableSemaphores;
+        array<VkSemaphore, VKMaxFramesInFlight> m_vkRenderFinishedSemaphores;
         PixelFormat                     m_colorFormat = PF_BGRA8_UNORM;
         VkSurfaceKHR                    m_vkWindowSurface;
         VkSwapchainKHR				    m_vkSwapChain = VK_NULL_HANDLE;
@@ -172,7 +168,7 @@ namespace Echo
         vector<VkImageView>::type	    m_vkSwapChainImageViews;
         PixelFormat                     m_depthFormat = PF_D32_FLOAT;
         VKTextureRender*                m_vkDepthImageView = nullptr;
-        vector<VkCommandBuffer>::type   m_vkCommandBuffers;    // https://vulkan.lunarg.com/doc/view/1.2.141.0/windows/chunked_spec/chap5.html
+        vector<VkCommandBuffer>::type   m_vkCommandBuffers;    // one per frame in flight, https://vulkan.lunarg.com/doc/view/1.2.141.0/windows/chunked_spec/chap5.html
         VkQueue                         m_vkPresentQueue;
     };
 }
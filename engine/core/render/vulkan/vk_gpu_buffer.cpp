@@ -17,13 +17,14 @@ namespace Echo
 
     bool VKBuffer::updateData(const Buffer& buff)
     {
+        // frames in flight may still read the old contents of a dynamic buffer, orphan it instead of writing over
+        if (m_usage & GBU_CPU_WRITE)
+            clear();
+
         if (create(buff.getSize()))
         {
-            // filling the buffer
-            void* data = nullptr;
-            VKDebug(vkMapMemory(VKRenderer::instance()->getVkDevice(), m_vkBufferMemory, 0, buff.getSize(), 0, &data));
-            memcpy(data, buff.getData(), buff.getSize());
-            vkUnmapMemory(VKRenderer::instance()->getVkDevice(), m_vkBufferMemory);
+            // filling the buffer, memory is mapped for its whole life
+            memcpy(m_allocation.m_mapped, buff.getData(), buff.getSize());
 
             return true;
         }
@@ -54,18 +55,16 @@ namespace Echo
 					VkMemoryRequirements memRequirements;
 					vkGetBufferMemoryRequirements(VKRenderer::instance()->getVkDevice(), m_vkBuffer, &memRequirements);
 
-					VkMemoryAllocateInfo allocInfo = {};
-					allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-					allocInfo.pNext = nullptr;
-					allocInfo.memoryTypeIndex = 0;
-					allocInfo.allocationSize = memRequirements.size;
-					allocInfo.memoryTypeIndex = VKRenderer::instance()->findVkMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+					if (VKRenderer::instance()->getMemoryAllocator().allocate(memRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false, m_allocation))
+					{
+						VKDebug(vkBindBufferMemory(VKRenderer::instance()->getVkDevice(), m_vkBuffer, m_allocation.m_vkMemory, m_allocation.m_offset));
 
-					VKDebug(vkAllocateMemory(VKRenderer::instance()->getVkDevice(), &allocInfo, nullptr, &m_vkBufferMemory));
-					VKDebug(vkBindBufferMemory(VKRenderer::instance()->getVkDevice(), m_vkBuffer, m_vkBufferMemory, 0));
+						m_size = sizeInBytes;
+						return true;
+					}
 
-					m_size = sizeInBytes;
-					return true;
+					vkDestroyBuffer(VKRenderer::instance()->getVkDevice(), m_vkBuffer, nullptr);
+					m_vkBuffer = VK_NULL_HANDLE;
 				}
 
 				EchoLogError("vulkan crete gpu buffer failed");
@@ -85,9 +84,16 @@ namespace Echo
         if (m_vkBuffer)
         {
             VKRenderer* vkRenderer = ECHO_DOWN_CAST<VKRenderer*>(Renderer::instance());
-            vkDestroyBuffer(vkRenderer->getVkDevice(), m_vkBuffer, nullptr);
-            vkFreeMemory(vkRenderer->getVkDevice(), m_vkBufferMemory, nullptr);
+            VkBuffer vkBuffer = m_vkBuffer;
+            VKAllocation allocation = m_allocation;
+            vkRenderer->destroyLater([vkRenderer, vkBuffer, allocation]() mutable
+            {
+                vkDestroyBuffer(vkRenderer->getVkDevice(), vkBuffer, nullptr);
+                vkRenderer->getMemoryAllocator().free(allocation);
+            });
+
             m_vkBuffer = VK_NULL_HANDLE;
+            m_allocation = VKAllocation();
         }
 
         m_size = 0;
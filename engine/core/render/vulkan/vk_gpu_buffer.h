@@ -2,6 +2,7 @@
 
 #include <base/buffer/gpu_buffer.h>
 #include "vk_render_base.h"
+#include "vk_memory_allocator.h"
 
 namespace Echo
 {
@@ -21,11 +22,11 @@ namespace Echo
         // create
         bool create(ui32 sizeInBytes);
 
-        // clear
+        // clear, the gpu may still read the buffer so it's destroyed once its frames finished
         void clear();
 
     private:
         VkBuffer        m_vkBuffer = VK_NULL_HANDLE;
-        VkDeviceMemory  m_vkBufferMemory = VK_NULL_HANDLE;
+        VKAllocation    m_allocation;
     };
 }
@@ -0,0 +1,234 @@
+#include "vk_memory_allocator.h"
+
+namespace Echo
+{
+    void VKMemoryAllocator::create(VkDevice vkDevice, VkPhysicalDevice vkPhysicalDevice)
+    {
+        m_vkDevice = vkDevice;
+        vkGetPhysicalDeviceMemoryProperties(vkPhysicalDevice, &m_vkMemoryProperties);
+    }
+
+    void VKMemoryAllocator::cleanup()
+    {
+        for (Pool& pool : m_pools)
+        {
+            for (Block& block : pool.m_blocks)
+            {
+                if (block.m_vkMemory)
+                    vkFreeMemory(m_vkDevice, block.m_vkMemory, nullptr);
+            }
+        }
+
+        m_pools.clear();
+    }
+
+    bool VKMemoryAllocator::findMemoryType(ui32 typeBits, VkMemoryPropertyFlags properties, ui32& memoryType)
+    {
+        for (ui32 i = 0; i < m_vkMemoryProperties.memoryTypeCount; i++)
+        {
+            if ((typeBits & (1 << i)) && (m_vkMemoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+            {
+                memoryType = i;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    ui32 VKMemoryAllocator::getPool(ui32 memoryType, bool isImage)
+    {
+        for (size_t i = 0; i < m_pools.size(); i++)
+        {
+            if (m_pools[i].m_memoryType == memoryType && m_pools[i].m_isImage == isImage)
+                return static_cast<ui32>(i);
+        }
+
+        Pool pool;
+        pool.m_memoryType = memoryType;
+        pool.m_isHostVisible = (m_vkMemoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) != 0;
+        pool.m_isImage = isImage;
+        m_pools.emplace_back(pool);
+
+        return static_cast<ui32>(m_pools.size() - 1);
+    }
+
+    i32 VKMemoryAllocator::createBlock(Pool& pool, VkDeviceSize size)
+    {
+        VkMemoryAllocateInfo allocInfo = {};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.pNext = nullptr;
+        allocInfo.allocationSize = size;
+        allocInfo.memoryTypeIndex = pool.m_memoryType;
+
+        Block block;
+        if (VK_SUCCESS != vkAllocateMemory(m_vkDevice, &allocInfo, nullptr, &block.m_vkMemory))
+        {
+            EchoLogError("vulkan allocate device memory of [%llu] bytes failed", static_cast<unsigned long long>(size));
+            return -1;
+        }
+
+        if (pool.m_isHostVisible)
+            VKDebug(vkMapMemory(m_vkDevice, block.m_vkMemory, 0, VK_WHOLE_SIZE, 0, &block.m_mapped));
+
+        block.m_size = size;
+        block.m_frees.push_back({ 0, size });
+
+        // reuse the slot of a freed block, allocations refer to blocks by index
+        for (size_t i = 0; i < pool.m_blocks.size(); i++)
+        {
+            if (!pool.m_blocks[i].m_vkMemory)
+            {
+                pool.m_blocks[i] = block;
+                return static_cast<i32>(i);
+            }
+        }
+
+        pool.m_blocks.emplace_back(block);
+        return static_cast<i32>(pool.m_blocks.size() - 1);
+    }
+
+    bool VKMemoryAllocator::allocateFromBlock(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset)
+    {
+        // first fit
+        for (size_t i = 0; i < block.m_frees.size(); i++)
+        {
+            Range& range = block.m_frees[i];
+            VkDeviceSize alignedOffset = (range.m_offset + alignment - 1) / alignment * alignment;
+            VkDeviceSize padding = alignedOffset - range.m_offset;
+            if (range.m_size < padding + size)
+                continue;
+
+            Range tail = { alignedOffset + size, range.m_size - padding - size };
+            if (padding)
+            {
+                range.m_size = padding;
+                if (tail.m_size)
+                    block.m_frees.insert(block.m_frees.begin() + i + 1, tail);
+            }
+            else if (tail.m_size)
+            {
+                range = tail;
+            }
+            else
+            {
+                block.m_frees.erase(block.m_frees.begin() + i);
+            }
+
+            offset = alignedOffset;
+            block.m_allocationCount++;
+            return true;
+        }
+
+        return false;
+    }
+
+    bool VKMemoryAllocator::allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool isImage, VKAllocation& allocation)
+    {
+        ui32 memoryType = 0;
+        if (!findMemoryType(requirements.memoryTypeBits, properties, memoryType))
+        {
+            // device local is only a preference
+            if (!(properties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) || !findMemoryType(requirements.memoryTypeBits, properties & ~VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memoryType))
+            {
+                EchoLogError("vulkan no memory type matches the requirements");
+                return false;
+            }
+        }
+
+        ui32 poolIndex = getPool(memoryType, isImage);
+        Pool& pool = m_pools[poolIndex];
+        auto allocateFrom = [&](ui32 blockIndex)->bool
+        {
+            Block& block = pool.m_blocks[blockIndex];
+            VkDeviceSize offset = 0;
+            if (!allocateFromBlock(block, requirements.size, requirements.alignment, offset))
+                return false;
+
+            allocation.m_vkMemory = block.m_vkMemory;
+            allocation.m_offset = offset;
+            allocation.m_size = requirements.size;
+            allocation.m_mapped = block.m_mapped ? static_cast<Byte*>(block.m_mapped) + offset : nullptr;
+            allocation.m_pool = poolIndex;
+            allocation.m_block = blockIndex;
+            return true;
+        };
+
+        // big resources get a block of their own
+        bool isDedicated = requirements.size > BlockSize / 2;
+        if (!isDedicated)
+        {
+            for (size_t i = 0; i < pool.m_blocks.size(); i++)
+            {
+                if (pool.m_blocks[i].m_vkMemory && pool.m_blocks[i].m_size == BlockSize && allocateFrom(static_cast<ui32>(i)))
+                    return true;
+            }
+        }
+
+        i32 blockIndex = createBlock(pool, isDedicated ? requirements.size : BlockSize);
+        return blockIndex >= 0 && allocateFrom(static_cast<ui32>(blockIndex));
+    }
+
+    void VKMemoryAllocator::free(VKAllocation& allocation)
+    {
+        if (!allocation.m_vkMemory || allocation.m_pool >= m_pools.size())
+            return;
+
+        Pool& pool = m_pools[allocation.m_pool];
+        Block& block = pool.m_blocks[allocation.m_block];
+
+        // insert sorted and merge with the neighbours
+        Range range = { allocation.m_offset, allocation.m_size };
+        auto it = std::lower_bound(block.m_frees.begin(), block.m_frees.end(), range, [](const Range& a, const Range& b) { return a.m_offset < b.m_offset; });
+        it = block.m_frees.insert(it, range);
+        if (it + 1 != block.m_frees.end() && it->m_offset + it->m_size == (it + 1)->m_offset)
+        {
+            it->m_size += (it + 1)->m_size;
+            block.m_frees.erase(it + 1);
+        }
+        if (it != block.m_frees.begin() && (it - 1)->m_offset + (it - 1)->m_size == it->m_offset)
+        {
+            (it - 1)->m_size += it->m_size;
+            block.m_frees.erase(it);
+        }
+
+        block.m_allocationCount--;
+
+        // dedicated blocks are freed at once, one empty block of a pool is kept against churn
+        if (block.m_allocationCount == 0)
+        {
+            bool isKeep = block.m_size == BlockSize;
+            if (isKeep)
+            {
+                for (Block& other : pool.m_blocks)
+                {
+                    if (&other != &block && other.m_vkMemory && other.m_size == BlockSize && other.m_allocationCount == 0)
+                        isKeep = false;
+                }
+            }
+
+            if (!isKeep)
+            {
+                vkFreeMemory(m_vkDevice, block.m_vkMemory, nullptr);
+                block = Block();
+            }
+        }
+
+        allocation = VKAllocation();
+    }
+
+    ui32 VKMemoryAllocator::getBlockCount() const
+    {
+        ui32 count = 0;
+        for (const Pool& pool : m_pools)
+        {
+            for (const Block& block : pool.m_blocks)
+            {
+                if (block.m_vkMemory)
+                    count++;
+            }
+        }
+
+        return count;
+    }
+}
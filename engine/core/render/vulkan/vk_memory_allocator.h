@@ -0,0 +1,85 @@
+#pragma once
+
+#include "vk_render_base.h"
+
+namespace Echo
+{
+    // a range of a device memory block
+    struct VKAllocation
+    {
+        VkDeviceMemory  m_vkMemory = VK_NULL_HANDLE;
+        VkDeviceSize    m_offset = 0;
+        VkDeviceSize    m_size = 0;
+        void*           m_mapped = nullptr;         // host visible memory is mapped for its whole life
+        ui32            m_pool = 0;
+        ui32            m_block = 0;
+    };
+
+    // Sub allocates buffers and images from large device memory blocks, so resources don't
+    // cost a vkAllocateMemory each (drivers limit the count). Buffers and images are kept in
+    // different blocks, which keeps linear and optimal resources bufferImageGranularity apart.
+    class VKMemoryAllocator
+    {
+    public:
+        static constexpr VkDeviceSize BlockSize = 64 * 1024 * 1024;
+
+    public:
+        VKMemoryAllocator() {}
+        ~VKMemoryAllocator() {}
+
+        // create
+        void create(VkDevice vkDevice, VkPhysicalDevice vkPhysicalDevice);
+
+        // free all blocks
+        void cleanup();
+
+        // allocate|free
+        bool allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool isImage, VKAllocation& allocation);
+        void free(VKAllocation& allocation);
+
+        // device memory count
+        ui32 getBlockCount() const;
+
+    private:
+        struct Range
+        {
+            VkDeviceSize    m_offset;
+            VkDeviceSize    m_size;
+        };
+
+        struct Block
+        {
+            VkDeviceMemory          m_vkMemory = VK_NULL_HANDLE;
+            VkDeviceSize            m_size = 0;
+            void*                   m_mapped = nullptr;
+            vector<Range>::type     m_frees;            // sorted by offset
+            ui32                    m_allocationCount = 0;
+        };
+
+        struct Pool
+        {
+            ui32                    m_memoryType = 0;
+            bool                    m_isHostVisible = false;
+            bool                    m_isImage = false;
+            vector<Block>::type     m_blocks;
+        };
+
+    private:
+        // find memory type
+        bool findMemoryType(ui32 typeBits, VkMemoryPropertyFlags properties, ui32& memoryType);
+
+        // get pool of a memory type
+        ui32 getPool(ui32 memoryType, bool isImage);
+
+        // allocate from a block
+        bool allocateFromBlock(Block& block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& offset);
+
+        // create block, returns its index or -1
+        i32 createBlock(Pool& pool, VkDeviceSize size);
+
+    private:
+        VkDevice                            m_vkDevice = VK_NULL_HANDLE;
+        VkPhysicalDeviceMemoryProperties    m_vkMemoryProperties = {};
+        vector<Pool>::type                  m_pools;
+    };
+}
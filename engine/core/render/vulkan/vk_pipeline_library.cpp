@@ -0,0 +1,337 @@
+#include "vk_pipeline_library.h"
+#include "vk_renderer.h"
+#include "engine/core/io/IO.h"
+#include "engine/core/io/memory_reader.h"
+#include "engine/core/util/PathUtil.h"
+
+namespace Echo
+{
+    static const char* g_vkPipelineCachePath = "User://VkPipelineCache.bin";
+
+    // header of vk pipeline cache data, as defined by the spec
+    struct VKPipelineCacheHeader
+    {
+        ui32    m_headerSize;
+        ui32    m_headerVersion;
+        ui32    m_vendorID;
+        ui32    m_deviceID;
+        ui8     m_pipelineCacheUUID[VK_UUID_SIZE];
+    };
+
+    // writes pipeline key bytes, members are added one by one because the vk structs have padding after sType
+    struct VKKeyWriter
+    {
+        ByteArray& m_key;
+
+        VKKeyWriter(ByteArray& key) : m_key(key) {}
+
+        void addBytes(const void* data, size_t size)
+        {
+            const Byte* bytes = static_cast<const Byte*>(data);
+            m_key.insert(m_key.end(), bytes, bytes + size);
+        }
+
+        template<typename T> void add(const T& value)
+        {
+            addBytes(&value, sizeof(T));
+        }
+
+        // only for structs made of 32 bit members
+        template<typename T> void addArray(const T* values, ui32 count)
+        {
+            add(count);
+            if (values && count)
+                addBytes(values, sizeof(T) * count);
+        }
+    };
+
+    void VKPipelineLibrary::create(VkDevice vkDevice, VkPhysicalDevice vkPhysicalDevice)
+    {
+        m_vkDevice = vkDevice;
+
+        // data of another driver or device is ignored
+        ByteArray initialData;
+        if (IO::instance()->isExist(g_vkPipelineCachePath))
+        {
+            MemoryReader reader(g_vkPipelineCachePath);
+            if (reader.getSize() >= sizeof(VKPipelineCacheHeader))
+            {
+                VkPhysicalDeviceProperties deviceProperties;
+                vkGetPhysicalDeviceProperties(vkPhysicalDevice, &deviceProperties);
+
+                VKPipelineCacheHeader header;
+                std::memcpy(&header, reader.getData<const Byte*>(), sizeof(header));
+                if (header.m_headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE && header.m_vendorID == deviceProperties.vendorID && header.m_deviceID == deviceProperties.deviceID &&
+                    std::memcmp(header.m_pipelineCacheUUID, deviceProperties.pipelineCacheUUID, VK_UUID_SIZE) == 0)
+                {
+                    initialData.assign(reader.getData<const Byte*>(), reader.getData<const Byte*>() + reader.getSize());
+                }
+            }
+        }
+
+        VkPipelineCacheCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+        createInfo.pNext = nullptr;
+        createInfo.flags = 0;
+        createInfo.initialDataSize = initialData.size();
+        createInfo.pInitialData = initialData.empty() ? nullptr : initialData.data();
+
+        if (vkCreatePipelineCache(m_vkDevice, &createInfo, nullptr, &m_vkPipelineCache) != VK_SUCCESS)
+        {
+            // corrupted data, start empty
+            createInfo.initialDataSize = 0;
+            createInfo.pInitialData = nullptr;
+            VKDebug(vkCreatePipelineCache(m_vkDevice, &createInfo, nullptr, &m_vkPipelineCache));
+        }
+    }
+
+    void VKPipelineLibrary::cleanup()
+    {
+        if (m_vkDevice)
+        {
+            for (auto& it : m_entries)
+                vkDestroyPipeline(m_vkDevice, it.first, nullptr);
+
+            m_entries.clear();
+            m_pipelines.clear();
+
+            if (m_vkPipelineCache)
+            {
+                saveVkPipelineCache();
+
+                vkDestroyPipelineCache(m_vkDevice, m_vkPipelineCache, nullptr);
+                m_vkPipelineCache = VK_NULL_HANDLE;
+            }
+
+            m_vkDevice = VK_NULL_HANDLE;
+        }
+    }
+
+    void VKPipelineLibrary::saveVkPipelineCache()
+    {
+        size_t dataSize = 0;
+        if (vkGetPipelineCacheData(m_vkDevice, m_vkPipelineCache, &dataSize, nullptr) != VK_SUCCESS || !dataSize)
+            return;
+
+        ByteArray data(dataSize);
+        if (vkGetPipelineCacheData(m_vkDevice, m_vkPipelineCache, &dataSize, data.data()) != VK_SUCCESS)
+            return;
+
+        String fullPath = IO::instance()->convertResPathToFullPath(g_vkPipelineCachePath);
+        String folder = PathUtil::GetFileDirPath(fullPath);
+        if (!PathUtil::IsDirExist(folder))
+            PathUtil::CreateDir(folder);
+
+        FILE* file = fopen(fullPath.c_str(), "wb");
+        if (file)
+        {
+            fwrite(data.data(), 1, dataSize, file);
+            fclose(file);
+        }
+        else
+        {
+            EchoLogError("VKPipelineLibrary can't write file [%s]", fullPath.c_str());
+        }
+    }
+
+    VkPipeline VKPipelineLibrary::acquire(const VkGraphicsPipelineCreateInfo& createInfo)
+    {
+        ByteArray key;
+        buildKey(createInfo, key);
+        ui64 keyHash = hash(key);
+
+        // a hash match is only a candidate, the whole key has to be the same
+        VkPipeline vkPipeline = VK_NULL_HANDLE;
+        auto range = m_pipelines.equal_range(keyHash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (m_entries[it->second].m_key == key)
+            {
+                vkPipeline = it->second;
+                break;
+            }
+        }
+
+        if (!vkPipeline)
+        {
+            VKDebug(vkCreateGraphicsPipelines(m_vkDevice, m_vkPipelineCache, 1, &createInfo, nullptr, &vkPipeline));
+            if (!vkPipeline)
+                return VK_NULL_HANDLE;
+
+            Entry& entry = m_entries[vkPipeline];
+            entry.m_hash = keyHash;
+            entry.m_key = std::move(key);
+            entry.m_vkPipelineLayout = createInfo.layout;
+            entry.m_vkRenderPass = createInfo.renderPass;
+            m_pipelines.emplace(keyHash, vkPipeline);
+        }
+
+        m_entries[vkPipeline].m_refCount++;
+
+        return vkPipeline;
+    }
+
+    void VKPipelineLibrary::release(VkPipeline vkPipeline)
+    {
+        auto it = m_entries.find(vkPipeline);
+        if (it != m_entries.end() && --it->second.m_refCount == 0)
+        {
+            removeKey(vkPipeline, it->second.m_hash);
+            m_entries.erase(it);
+
+            // frames in flight may still draw with the pipeline
+            VKRenderer* vkRenderer = VKRenderer::instance();
+            vkRenderer->destroyLater([vkRenderer, vkPipeline]()
+            {
+                vkDestroyPipeline(vkRenderer->getVkDevice(), vkPipeline, nullptr);
+            });
+        }
+    }
+
+    void VKPipelineLibrary::removePipelineLayout(VkPipelineLayout vkPipelineLayout)
+    {
+        // pipelines still used are destroyed by their last release
+        for (auto& it : m_entries)
+        {
+            if (it.second.m_vkPipelineLayout == vkPipelineLayout)
+                removeKey(it.first, it.second.m_hash);
+        }
+    }
+
+    void VKPipelineLibrary::removeRenderPass(VkRenderPass vkRenderPass)
+    {
+        // pipelines still used are destroyed by their last release
+        for (auto& it : m_entries)
+        {
+            if (it.second.m_vkRenderPass == vkRenderPass)
+                removeKey(it.first, it.second.m_hash);
+        }
+    }
+
+    void VKPipelineLibrary::removeKey(VkPipeline vkPipeline, ui64 keyHash)
+    {
+        auto range = m_pipelines.equal_range(keyHash);
+        for (auto it = range.first; it != range.second; it++)
+        {
+            if (it->second == vkPipeline)
+            {
+                m_pipelines.erase(it);
+                break;
+            }
+        }
+    }
+
+    ui64 VKPipelineLibrary::hash(const ByteArray& key)
+    {
+        // FNV-1a
+        ui64 result = 14695981039346656037ULL;
+        for (Byte byte : key)
+        {
+            result ^= byte;
+            result *= 1099511628211ULL;
+        }
+
+        return result;
+    }
+
+    void VKPipelineLibrary::buildKey(const VkGraphicsPipelineCreateInfo& createInfo, ByteArray& key)
+    {
+        VKKeyWriter writer(key);
+        writer.add(createInfo.flags);
+
+        // shader stages
+        writer.add(createInfo.stageCount);
+        for (ui32 i = 0; i < createInfo.stageCount; i++)
+        {
+            const VkPipelineShaderStageCreateInfo& stage = createInfo.pStages[i];
+            writer.add(stage.stage);
+            writer.add(stage.module);
+            writer.addBytes(stage.pName, strlen(stage.pName));
+            if (stage.pSpecializationInfo)
+            {
+                writer.addArray(stage.pSpecializationInfo->pMapEntries, stage.pSpecializationInfo->mapEntryCount);
+                writer.addBytes(stage.pSpecializationInfo->pData, stage.pSpecializationInfo->dataSize);
+            }
+        }
+
+        // vertex layout
+        if (const VkPipelineVertexInputStateCreateInfo* state = createInfo.pVertexInputState)
+        {
+            writer.addArray(state->pVertexBindingDescriptions, state->vertexBindingDescriptionCount);
+            writer.addArray(state->pVertexAttributeDescriptions, state->vertexAttributeDescriptionCount);
+        }
+
+        if (const VkPipelineInputAssemblyStateCreateInfo* state = createInfo.pInputAssemblyState)
+        {
+            writer.add(state->topology);
+            writer.add(state->primitiveRestartEnable);
+        }
+
+        if (const VkPipelineTessellationStateCreateInfo* state = createInfo.pTessellationState)
+        {
+            writer.add(state->patchControlPoints);
+        }
+
+        // viewport isn't dynamic, so it is part of the pipeline
+        if (const VkPipelineViewportStateCreateInfo* state = createInfo.pViewportState)
+        {
+            writer.addArray(state->pViewports, state->viewportCount);
+            writer.addArray(state->pScissors, state->scissorCount);
+        }
+
+        if (const VkPipelineRasterizationStateCreateInfo* state = createInfo.pRasterizationState)
+        {
+            writer.add(state->depthClampEnable);
+            writer.add(state->rasterizerDiscardEnable);
+            writer.add(state->polygonMode);
+            writer.add(state->cullMode);
+            writer.add(state->frontFace);
+            writer.add(state->depthBiasEnable);
+            writer.add(state->depthBiasConstantFactor);
+            writer.add(state->depthBiasClamp);
+            writer.add(state->depthBiasSlopeFactor);
+            writer.add(state->lineWidth);
+        }
+
+        if (const VkPipelineMultisampleStateCreateInfo* state = createInfo.pMultisampleState)
+        {
+            writer.add(state->rasterizationSamples);
+            writer.add(state->sampleShadingEnable);
+            writer.add(state->minSampleShading);
+            writer.addArray(state->pSampleMask, state->pSampleMask ? (static_cast<ui32>(state->rasterizationSamples) + 31) / 32 : 0);
+            writer.add(state->alphaToCoverageEnable);
+            writer.add(state->alphaToOneEnable);
+        }
+
+        if (const VkPipelineDepthStencilStateCreateInfo* state = createInfo.pDepthStencilState)
+        {
+            writer.add(state->depthTestEnable);
+            writer.add(state->depthWriteEnable);
+            writer.add(state->depthCompareOp);
+            writer.add(state->depthBoundsTestEnable);
+            writer.add(state->stencilTestEnable);
+            writer.add(state->front);
+            writer.add(state->back);
+            writer.add(state->minDepthBounds);
+            writer.add(state->maxDepthBounds);
+        }
+
+        if (const VkPipelineColorBlendStateCreateInfo* state = createInfo.pColorBlendState)
+        {
+            writer.add(state->logicOpEnable);
+            writer.add(state->logicOp);
+            writer.addArray(state->pAttachments, state->attachmentCount);
+            writer.add(state->blendConstants);
+        }
+
+        if (const VkPipelineDynamicStateCreateInfo* state = createInfo.pDynamicState)
+        {
+            writer.addArray(state->pDynamicStates, state->dynamicStateCount);
+        }
+
+        // layout and render pass
+        writer.add(createInfo.layout);
+        writer.add(createInfo.renderPass);
+        writer.add(createInfo.subpass);
+    }
+}
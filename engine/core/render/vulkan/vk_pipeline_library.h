@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vk_render_base.h"
+
+namespace Echo
+{
+    // Renderer wide graphics pipelines. Identical create infos (shader, vertex layout, states
+    // and render pass) share one reference counted pipeline, all pipelines are created through
+    // one VkPipelineCache which is written to User:// on cleanup and reused by the next run.
+    class VKPipelineLibrary
+    {
+    public:
+        VKPipelineLibrary() {}
+        ~VKPipelineLibrary() {}
+
+        // create vk pipeline cache with the data of the last run
+        void create(VkDevice vkDevice, VkPhysicalDevice vkPhysicalDevice);
+
+        // save vk pipeline cache and destroy all pipelines
+        void cleanup();
+
+        // get pipeline of create info, release it when it isn't used anymore. the last release
+        // destroys the pipeline once the frames recorded so far are finished
+        VkPipeline acquire(const VkGraphicsPipelineCreateInfo& createInfo);
+        void release(VkPipeline vkPipeline);
+
+        // forget pipelines of a pipeline layout, the handle may be reused by a new shader
+        void removePipelineLayout(VkPipelineLayout vkPipelineLayout);
+
+        // forget pipelines of a render pass, the handle may be reused by a new render pass
+        void removeRenderPass(VkRenderPass vkRenderPass);
+
+        // pipeline count
+        ui32 getPipelineCount() const { return static_cast<ui32>(m_entries.size()); }
+
+        // get vk pipeline cache
+        VkPipelineCache getVkPipelineCache() { return m_vkPipelineCache; }
+
+    public:
+        // bytes of everything a pipeline is created from
+        static void buildKey(const VkGraphicsPipelineCreateInfo& createInfo, ByteArray& key);
+
+        // hash of a key
+        static ui64 hash(const ByteArray& key);
+
+    private:
+        // save vk pipeline cache data
+        void saveVkPipelineCache();
+
+        // forget pipeline of its key
+        void removeKey(VkPipeline vkPipeline, ui64 hash);
+
+    private:
+        struct Entry
+        {
+            ui64                m_hash = 0;
+            ByteArray           m_key;              // compared on hash match
+            VkPipelineLayout    m_vkPipelineLayout = VK_NULL_HANDLE;
+            VkRenderPass        m_vkRenderPass = VK_NULL_HANDLE;
+            ui32                m_refCount = 0;
+        };
+        VkDevice                            m_vkDevice = VK_NULL_HANDLE;
+        VkPipelineCache                     m_vkPipelineCache = VK_NULL_HANDLE;
+        multimap<ui64, VkPipeline>::type    m_pipelines;
+        map<VkPipeline, Entry>::type        m_entries;
+    };
+}
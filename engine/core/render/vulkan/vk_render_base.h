@@ -21,6 +21,9 @@
 
 namespace Echo
 {
+    // frames the cpu may record ahead of the gpu
+    static constexpr ui32 VKMaxFramesInFlight = 2;
+
     // Debug Vk Error
     void OutputVKError(VkResult vkResult, const char* filename, int lineNum);
 }
@@ -13,6 +13,11 @@ namespace Echo
     {
     }
 
+    VKRenderProxy::~VKRenderProxy()
+    {
+        destroyVkPipeline();
+    }
+
     void VKRenderProxy::setMesh(MeshPtr mesh)
     {
         m_mesh = mesh;
@@ -81,7 +86,8 @@ namespace Echo
                 m_vkPipelineInfo.basePipelineHandle = 0;
                 m_vkPipelineInfo.basePipelineIndex = 0;
 
-				VKDebug(vkCreateGraphicsPipelines(VKRenderer::instance()->getVkDevice(), VK_NULL_HANDLE, 1, &m_vkPipelineInfo, nullptr, &m_vkPipeline));
+				// identical proxies share one pipeline
+				m_vkPipeline = VKRenderer::instance()->getPipelineLibrary().acquire(m_vkPipelineInfo);
 			}
         }
 
@@ -92,7 +98,7 @@ namespace Echo
     {
         if (m_vkPipeline)
         {
-            vkDestroyPipeline(VKRenderer::instance()->getVkDevice(), m_vkPipeline, nullptr);
+            VKRenderer::instance()->getPipelineLibrary().release(m_vkPipeline);
             m_vkPipeline = VK_NULL_HANDLE;
         }
     }
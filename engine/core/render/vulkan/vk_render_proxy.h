@@ -10,7 +10,7 @@ namespace Echo
 	{
 	public:
 		VKRenderProxy();
-        virtual ~VKRenderProxy() {}
+        virtual ~VKRenderProxy();
 
         // bind shader uniforms
 		void bindRenderState();
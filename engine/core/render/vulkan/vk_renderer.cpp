@@ -26,7 +26,14 @@ namespace Echo
 
     VKRenderer::~VKRenderer()
     {
-		vkDestroyDescriptorPool(VKRenderer::instance()->getVkDevice(), m_vkDescriptorPool, nullptr);
+		if (m_vkDevice)
+			VKDebug(vkDeviceWaitIdle(m_vkDevice));
+
+		destroyVkFrames();
+		m_uploadRing.cleanup();
+
+		m_pipelineLibrary.cleanup();
+		m_memoryAllocator.cleanup();
 
 		m_validation.cleanup();
 		vkDestroyDevice(m_vkDevice, nullptr);
@@ -53,9 +60,17 @@ namespace Echo
 
 		createVkLogicalDevice();
 
+		m_pipelineLibrary.create(m_vkDevice, m_vkPhysicalDevice);
+
+		m_memoryAllocator.create(m_vkDevice, m_vkPhysicalDevice);
+
 		createVkCommandPool();
 
-		createVkDescriptorPool();
+		createVkFrames();
+
+		m_uploadRing.create(m_vkDevice, &m_memoryAllocator);
+
+		beginFrame();
 
 		initRayTracer();
 
@@ -95,7 +110,7 @@ namespace Echo
     RenderProxy* VKRenderer::createRenderProxy()
     {
         RenderProxy* renderable = EchoNew(VKRenderProxy);
-        m_renderProxies[renderable->getId()] = renderable;
+        registerRenderProxy(renderable);
 
         return renderable;
     }
@@ -274,6 +289,7 @@ namespace Echo
 		// output error
 		if(m_vkPhysicalDevice!=VK_NULL_HANDLE)
 		{
+			vkGetPhysicalDeviceProperties(m_vkPhysicalDevice, &m_vkPhysicalDeviceProperties);
 			enumerateQueueFamalies();
 		}
 		else
@@ -379,15 +395,16 @@ namespace Echo
         VKDebug(vkCreateCommandPool(m_vkDevice, &createInfo, nullptr, &m_vkCommandPool));
 	}
 
-	void VKRenderer::createVkDescriptorPool()
+	VkDescriptorPool VKRenderer::createVkDescriptorPool()
 	{
+		// sets of one frame slot, a frame that binds more gets another pool
 		array<VkDescriptorPoolSize, 2> typeCounts;
 		typeCounts[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-		typeCounts[0].descriptorCount = 512;
+		typeCounts[0].descriptorCount = 1024;
 
 		// For additional type you need to add new entries in the type count list
 		typeCounts[1].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		typeCounts[1].descriptorCount = 512;
+		typeCounts[1].descriptorCount = 1024;
 
 		// Create the global descriptor pool
 		VkDescriptorPoolCreateInfo descriptorPoolInfo = {};
@@ -397,7 +414,10 @@ namespace Echo
 		descriptorPoolInfo.pPoolSizes = typeCounts.data();
 		descriptorPoolInfo.maxSets = 512;
 
-		VKDebug(vkCreateDescriptorPool( m_vkDevice, &descriptorPoolInfo, nullptr, &m_vkDescriptorPool));
+		VkDescriptorPool vkDescriptorPool = VK_NULL_HANDLE;
+		VKDebug(vkCreateDescriptorPool( m_vkDevice, &descriptorPoolInfo, nullptr, &vkDescriptorPool));
+
+		return vkDescriptorPool;
 	}
 
 	ui32 VKRenderer::findVkMemoryType(ui32 typeBits, VkMemoryPropertyFlags properties)
@@ -534,8 +554,155 @@ namespace Echo
 		}
     }
 
+	void VKRenderer::createVkFrames()
+	{
+		// signaled, the first wait of a slot returns at once
+		VkFenceCreateInfo fenceCreateInfo = {};
+		fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		fenceCreateInfo.pNext = nullptr;
+		fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+		for (Frame& frame : m_frames)
+			VKDebug(vkCreateFence(m_vkDevice, &fenceCreateInfo, nullptr, &frame.m_vkFence));
+	}
+
+	void VKRenderer::destroyVkFrames()
+	{
+		for (Frame& frame : m_frames)
+		{
+			for (std::function<void()>& destroy : frame.m_destroys)
+				destroy();
+			frame.m_destroys.clear();
+
+			if (!frame.m_vkUploadCommandBuffers.empty())
+				vkFreeCommandBuffers(m_vkDevice, m_vkCommandPool, frame.m_vkUploadCommandBuffers.size(), frame.m_vkUploadCommandBuffers.data());
+			frame.m_vkUploadCommandBuffers.clear();
+
+			for (VkDescriptorPool vkDescriptorPool : frame.m_vkDescriptorPools)
+				vkDestroyDescriptorPool(m_vkDevice, vkDescriptorPool, nullptr);
+			frame.m_vkDescriptorPools.clear();
+
+			if (frame.m_vkFence)
+			{
+				vkDestroyFence(m_vkDevice, frame.m_vkFence, nullptr);
+				frame.m_vkFence = VK_NULL_HANDLE;
+			}
+		}
+	}
+
+	void VKRenderer::beginFrame()
+	{
+		Frame& frame = m_frames[m_frameIndex];
+		VKDebug(vkWaitForFences(m_vkDevice, 1, &frame.m_vkFence, VK_TRUE, UINT64_MAX));
+		VKDebug(vkResetFences(m_vkDevice, 1, &frame.m_vkFence));
+
+		// a destroy may defer another one, that goes to this frame again
+		vector<std::function<void()>>::type destroys;
+		destroys.swap(frame.m_destroys);
+		for (std::function<void()>& destroy : destroys)
+			destroy();
+
+		frame.m_uploadCommandBufferCount = 0;
+		m_uploadRing.beginFrame(m_frameIndex);
+
+		// sets the gpu read for this slot are finished as well
+		for (VkDescriptorPool vkDescriptorPool : frame.m_vkDescriptorPools)
+			VKDebug(vkResetDescriptorPool(m_vkDevice, vkDescriptorPool, 0));
+		frame.m_descriptorPoolIndex = 0;
+	}
+
+	void VKRenderer::destroyLater(const std::function<void()>& destroy)
+	{
+		m_frames[m_frameIndex].m_destroys.emplace_back(destroy);
+	}
+
+	VkDescriptorSet VKRenderer::allocateVkDescriptorSet(VkDescriptorSetLayout vkDescriptorSetLayout)
+	{
+		Frame& frame = m_frames[m_frameIndex];
+		while (true)
+		{
+			if (frame.m_descriptorPoolIndex == frame.m_vkDescriptorPools.size())
+			{
+				VkDescriptorPool vkDescriptorPool = createVkDescriptorPool();
+				if (!vkDescriptorPool)
+					return VK_NULL_HANDLE;
+
+				frame.m_vkDescriptorPools.emplace_back(vkDescriptorPool);
+			}
+
+			VkDescriptorSetAllocateInfo allocInfo = {};
+			allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+			allocInfo.descriptorPool = frame.m_vkDescriptorPools[frame.m_descriptorPoolIndex];
+			allocInfo.descriptorSetCount = 1;
+			allocInfo.pSetLayouts = &vkDescriptorSetLayout;
+
+			VkDescriptorSet vkDescriptorSet = VK_NULL_HANDLE;
+			VkResult result = vkAllocateDescriptorSets(m_vkDevice, &allocInfo, &vkDescriptorSet);
+			if (result == VK_SUCCESS)
+				return vkDescriptorSet;
+
+			// pool is full, go on with the next one
+			if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL)
+			{
+				EchoLogError("vulkan allocate descriptor set failed.");
+				return VK_NULL_HANDLE;
+			}
+
+			frame.m_descriptorPoolIndex++;
+		}
+	}
+
+	VkCommandBuffer VKRenderer::getVkUploadCommandBuffer()
+	{
+		Frame& frame = m_frames[m_frameIndex];
+		if (!frame.m_isUploadRecording)
+		{
+			// a submitted command buffer can't be recorded again until the frame's fence
+			if (frame.m_uploadCommandBufferCount == frame.m_vkUploadCommandBuffers.size())
+				frame.m_vkUploadCommandBuffers.emplace_back(createVkCommandBuffer());
+
+			VkCommandBufferBeginInfo commandBufferBeginInfo = {};
+			commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			commandBufferBeginInfo.pNext = nullptr;
+			commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			commandBufferBeginInfo.pInheritanceInfo = nullptr;
+
+			VKDebug(vkBeginCommandBuffer(frame.m_vkUploadCommandBuffers[frame.m_uploadCommandBufferCount], &commandBufferBeginInfo));
+			frame.m_uploadCommandBufferCount++;
+			frame.m_isUploadRecording = true;
+		}
+
+		return frame.m_vkUploadCommandBuffers[frame.m_uploadCommandBufferCount - 1];
+	}
+
+	void VKRenderer::flushVkUploadCommandBuffer()
+	{
+		Frame& frame = m_frames[m_frameIndex];
+		if (frame.m_isUploadRecording)
+		{
+			VkCommandBuffer vkCommandBuffer = frame.m_vkUploadCommandBuffers[frame.m_uploadCommandBufferCount - 1];
+			VKDebug(vkEndCommandBuffer(vkCommandBuffer));
+
+			VkSubmitInfo submitInfo = {};
+			submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+			submitInfo.commandBufferCount = 1;
+			submitInfo.pCommandBuffers = &vkCommandBuffer;
+			VKDebug(vkQueueSubmit(m_vkGraphicsQueue, 1, &submitInfo, VK_NULL_HANDLE));
+
+			frame.m_isUploadRecording = false;
+		}
+	}
+
     bool VKRenderer::present()
     {
-        return false;
+		flushVkUploadCommandBuffer();
+
+		// an empty submit signals the fence once everything submitted before it is done
+		VKDebug(vkQueueSubmit(m_vkGraphicsQueue, 0, nullptr, m_frames[m_frameIndex].m_vkFence));
+
+		m_frameIndex = (m_frameIndex + 1) % VKMaxFramesInFlight;
+		beginFrame();
+
+        return true;
     }
 }
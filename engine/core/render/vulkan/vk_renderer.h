@@ -5,6 +5,9 @@
 #include "vk_validation.h"
 #include "vk_framebuffer.h"
 #include "vk_ray_tracer.h"
+#include "vk_pipeline_library.h"
+#include "vk_memory_allocator.h"
+#include "vk_upload_ring.h"
 
 namespace Echo
 {
@@ -107,8 +110,20 @@ namespace Echo
         // get clear command buffer
         VkCommandPool getVkCommandPool() { return m_vkCommandPool; }
 
-		// get vk descriptor pool
-		VkDescriptorPool getVkDescriptorPool() { return m_vkDescriptorPool; }
+		// allocate descriptor set from the pools of this frame, they are reset when the frame slot comes around again
+		VkDescriptorSet allocateVkDescriptorSet(VkDescriptorSetLayout vkDescriptorSetLayout);
+
+		// get pipeline library
+		VKPipelineLibrary& getPipelineLibrary() { return m_pipelineLibrary; }
+
+		// get memory allocator
+		VKMemoryAllocator& getMemoryAllocator() { return m_memoryAllocator; }
+
+		// get upload ring
+		VKUploadRing& getUploadRing() { return m_uploadRing; }
+
+		// get physical device limits
+		const VkPhysicalDeviceLimits& getVkLimits() const { return m_vkPhysicalDeviceProperties.limits; }
 
         // find memory type
         ui32 findVkMemoryType(ui32 typeBits, VkMemoryPropertyFlags properties);
@@ -121,6 +136,17 @@ namespace Echo
         // Submit single time commands
         void submitSingleTimeCommands(const std::function<void(VkCommandBuffer)>& action);
 
+    public:
+        // frame in flight being recorded
+        ui32 getFrameIndex() const { return m_frameIndex; }
+
+        // destroy once the gpu finished the frames recorded so far
+        void destroyLater(const std::function<void()>& destroy);
+
+        // command buffer for uploads of this frame, submitted ahead of the frame's draws
+        VkCommandBuffer getVkUploadCommandBuffer();
+        void flushVkUploadCommandBuffer();
+
     public:
         // Ray tracing
         VKRayTracer* getRayTracer() { return m_rayTracer; }
@@ -147,7 +173,26 @@ namespace Echo
 		void createVkCommandPool();
 
 		// create vk descriptor pool
-		void createVkDescriptorPool();
+		VkDescriptorPool createVkDescriptorPool();
+
+		// frames in flight
+		void createVkFrames();
+		void destroyVkFrames();
+
+		// wait until the gpu finished the frame slot, then reuse it
+		void beginFrame();
+
+    private:
+        struct Frame
+        {
+            VkFence                             m_vkFence = VK_NULL_HANDLE;
+            vector<std::function<void()>>::type m_destroys;
+            vector<VkCommandBuffer>::type       m_vkUploadCommandBuffers;
+            ui32                                m_uploadCommandBufferCount = 0;
+            vector<VkDescriptorPool>::type      m_vkDescriptorPools;
+            ui32                                m_descriptorPoolIndex = 0;
+            bool                                m_isUploadRecording = false;
+        };
 
     private:
 		ui32				m_screenWidth = 800;
@@ -155,12 +200,17 @@ namespace Echo
 		Extensions			m_vkInstanceExtensions;
 		VkInstance			m_vkInstance;
         VkPhysicalDevice    m_vkPhysicalDevice = nullptr;
+        VkPhysicalDeviceProperties m_vkPhysicalDeviceProperties = {};
         QueueFamilies       m_vkQueueFamilies;
         VkDevice            m_vkDevice = nullptr;
 		VKValidation		m_validation;
+		VKPipelineLibrary	m_pipelineLibrary;
+		VKMemoryAllocator	m_memoryAllocator;
+		VKUploadRing		m_uploadRing;
+		array<Frame, VKMaxFramesInFlight> m_frames;
+		ui32				m_frameIndex = 0;
         VkQueue             m_vkGraphicsQueue = nullptr;
 		VkCommandPool		m_vkCommandPool;
-        VkDescriptorPool    m_vkDescriptorPool = VK_NULL_HANDLE;
         VKRayTracer*        m_rayTracer = nullptr;
         array<Texture*, 32> m_currentTextures = { nullptr };
 	};
@@ -32,9 +32,20 @@ namespace Echo
     VKShaderProgram::~VKShaderProgram()
     {
         VKRenderer* vkRenderer = ECHO_DOWN_CAST<VKRenderer*>(Renderer::instance());
-
-        vkDestroyShaderModule(vkRenderer->getVkDevice(), m_vkVertexShader, nullptr);
-        vkDestroyShaderModule(vkRenderer->getVkDevice(), m_vkFragmentShader, nullptr);
+        vkRenderer->getPipelineLibrary().removePipelineLayout(m_vkPipelineLayout);
+
+        // frames in flight may still draw with this program
+        VkShaderModule vkVertexShader = m_vkVertexShader;
+        VkShaderModule vkFragmentShader = m_vkFragmentShader;
+        VkPipelineLayout vkPipelineLayout = m_vkPipelineLayout;
+        VkDescriptorSetLayout vkDescriptorSetLayout = m_vkDescriptorSetLayout;
+        vkRenderer->destroyLater([vkRenderer, vkVertexShader, vkFragmentShader, vkPipelineLayout, vkDescriptorSetLayout]()
+        {
+            vkDestroyShaderModule(vkRenderer->getVkDevice(), vkVertexShader, nullptr);
+            vkDestroyShaderModule(vkRenderer->getVkDevice(), vkFragmentShader, nullptr);
+            vkDestroyPipelineLayout(vkRenderer->getVkDevice(), vkPipelineLayout, nullptr);
+            vkDestroyDescriptorSetLayout(vkRenderer->getVkDevice(), vkDescriptorSetLayout, nullptr);
+        });
     }
 
     bool VKShaderProgram::createShaderProgram(const String& vsSrc, const String& psSrc)
@@ -72,26 +83,24 @@ namespace Echo
         return m_isLinked;
     }
 
-    void VKShaderProgram::createVkUniformBuffer(UniformsInstance& uniformsInstance)
+    void VKShaderProgram::uploadUniformBytes(const vector<Byte>::type& uniformBytes, VkDescriptorBufferInfo& bufferInfo)
     {
-        // this is not good here, reuse VkBuffer afterwards
-        EchoSafeDelete(uniformsInstance.m_vkVertexShaderUniformBuffer, VKBuffer);
-        EchoSafeDelete(uniformsInstance.m_vkFragmentShaderUniformBuffer, VKBuffer);
-
-        Buffer vertUniformBuffer(m_vertexShaderUniformBytes.size(), m_vertexShaderUniformBytes.data(), false);
-        uniformsInstance.m_vkVertexShaderUniformBuffer = EchoNew(VKBuffer(GPUBuffer::GPUBufferType::GBT_UNIFORM, GPUBuffer::GBU_DYNAMIC, vertUniformBuffer));
+        bufferInfo.buffer = VK_NULL_HANDLE;
+        bufferInfo.offset = 0;
+        bufferInfo.range = uniformBytes.size();
 
-        Buffer fragmentUniformBuffer(m_fragmentShaderUniformBytes.size(), m_fragmentShaderUniformBytes.data(), false);
-        uniformsInstance.m_vkFragmentShaderUniformBuffer = EchoNew(VKBuffer(GPUBuffer::GPUBufferType::GBT_UNIFORM, GPUBuffer::GBU_DYNAMIC, fragmentUniformBuffer));
-
-        // Store information in the uniform's descriptor that is used by the descriptor set
-        uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::VS].buffer = uniformsInstance.m_vkVertexShaderUniformBuffer->getVkBuffer();
-        uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::VS].offset = 0;
-        uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::VS].range = uniformsInstance.m_vkVertexShaderUniformBuffer->getSize();
+        if (!uniformBytes.empty())
+        {
+            VKUploadRing::Allocation allocation;
+            if (VKRenderer::instance()->getUploadRing().allocate(uniformBytes.size(), VKRenderer::instance()->getVkLimits().minUniformBufferOffsetAlignment, allocation))
+            {
+                std::memcpy(allocation.m_data, uniformBytes.data(), uniformBytes.size());
 
-        uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::FS].buffer = uniformsInstance.m_vkFragmentShaderUniformBuffer->getVkBuffer();
-        uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::FS].offset = 0;
-        uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::FS].range = uniformsInstance.m_vkFragmentShaderUniformBuffer->getSize();
+                // Store information in the uniform's descriptor that is used by the descriptor set
+                bufferInfo.buffer = allocation.m_vkBuffer;
+                bufferInfo.offset = allocation.m_offset;
+            }
+        }
     }
 
     void VKShaderProgram::updateVkUniformBuffer(UniformsInstance& uniformsInstance)
@@ -120,38 +129,12 @@ namespace Echo
             }
         }
 
-        if (!uniformsInstance.m_vkVertexShaderUniformBuffer ||
-            !uniformsInstance.m_vkFragmentShaderUniformBuffer ||
-            uniformsInstance.m_vkVertexShaderUniformBuffer->getSize() != m_vertexShaderUniformBytes.size() ||
-            uniformsInstance.m_vkFragmentShaderUniformBuffer->getSize() != m_fragmentShaderUniformBytes.size())
-        {
-            createVkUniformBuffer(uniformsInstance);
-            createVkDescriptorSet(uniformsInstance);
-        }
-
-        Buffer vertUniformBuffer(m_vertexShaderUniformBytes.size(), m_vertexShaderUniformBytes.data(), false);
-        uniformsInstance.m_vkVertexShaderUniformBuffer->updateData(vertUniformBuffer);
-
-        Buffer fragmentUniformBuffer(m_fragmentShaderUniformBytes.size(), m_fragmentShaderUniformBytes.data(), false);
-        uniformsInstance.m_vkFragmentShaderUniformBuffer->updateData( fragmentUniformBuffer);
+        // fresh ring space every bind
+        uploadUniformBytes(m_vertexShaderUniformBytes, uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::VS]);
+        uploadUniformBytes(m_fragmentShaderUniformBytes, uniformsInstance.m_vkShaderUniformBufferDescriptors[ShaderType::FS]);
     }
 
-    void VKShaderProgram::createVkDescriptorSet(UniformsInstance& uniformsInstance)
-    {
-        VkDescriptorSetAllocateInfo allocInfo = {};
-        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-        allocInfo.descriptorPool =VKRenderer::instance()->getVkDescriptorPool();
-        allocInfo.descriptorSetCount = 1;
-        allocInfo.pSetLayouts = &m_vkDescriptorSetLayout;
-
-        VkResult result = vkAllocateDescriptorSets(VKRenderer::instance()->getVkDevice(), &allocInfo, &uniformsInstance.m_vkDescriptorSet);
-        if (VK_SUCCESS != result)
-        {
-            EchoLogError("vulkan set descriptor set failed.");
-        }
-    }
-
-    void VKShaderProgram::updateDescriptorSet(UniformsInstance& uniformsInstance)
+    void VKShaderProgram::updateDescriptorSet(UniformsInstance& uniformsInstance, VkDescriptorSet vkDescriptorSet)
     {
         // Update the descriptor set determining the shader binding points
         // For every binding point used in a shader there needs to be one
@@ -165,7 +148,7 @@ namespace Echo
                 VkWriteDescriptorSet writeDescriptorSet;
                 writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
                 writeDescriptorSet.pNext = nullptr;
-                writeDescriptorSet.dstSet = uniformsInstance.m_vkDescriptorSet;
+                writeDescriptorSet.dstSet = vkDescriptorSet;
                 writeDescriptorSet.dstBinding = i;
                 writeDescriptorSet.dstArrayElement = 0;
                 writeDescriptorSet.descriptorCount = 1;
@@ -192,7 +175,7 @@ namespace Echo
                         VkWriteDescriptorSet writeDescriptorSet;
                         writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
                         writeDescriptorSet.pNext = nullptr;
-                        writeDescriptorSet.dstSet = uniformsInstance.m_vkDescriptorSet;
+                        writeDescriptorSet.dstSet = vkDescriptorSet;
                         writeDescriptorSet.dstBinding = uniform->m_location;
                         writeDescriptorSet.dstArrayElement = 0;
                         writeDescriptorSet.descriptorCount = 1;
@@ -380,10 +363,16 @@ namespace Echo
     {
         // update uniform VkBuffer by memory
         updateVkUniformBuffer(uniformsInstance);
-        updateDescriptorSet(uniformsInstance);
+
+        // a set written earlier in the frame may still be read by a recorded draw, so every bind writes a new one
+        VkDescriptorSet vkDescriptorSet = VKRenderer::instance()->allocateVkDescriptorSet(m_vkDescriptorSetLayout);
+        if (!vkDescriptorSet)
+            return;
+
+        updateDescriptorSet(uniformsInstance, vkDescriptorSet);
 
         // Bind descriptor sets describing shader binding points
-        vkCmdBindDescriptorSets(vkCommandbuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_vkPipelineLayout, 0, 1, &uniformsInstance.m_vkDescriptorSet, 0, nullptr);
+        vkCmdBindDescriptorSets(vkCommandbuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, m_vkPipelineLayout, 0, 1, &vkDescriptorSet, 0, nullptr);
     }
 
     const spirv_cross::ShaderResources VKShaderProgram::getSpirvShaderResources(ShaderType type)
@@ -12,13 +12,11 @@ namespace Echo
         typedef VkPipelineShaderStageCreateInfo VkPipelineSSCI;
 
     public:
-        // Uniform Buffer
+        // Uniform Buffer, bytes live in the renderer's upload ring. Every bind gets a descriptor
+        // set of its own from the frame's pools, so a proxy drawn twice in a frame keeps both
         struct UniformsInstance
         {
-			VKBuffer*                       m_vkVertexShaderUniformBuffer = nullptr;
-			VKBuffer*                       m_vkFragmentShaderUniformBuffer = nullptr;
-			array<VkDescriptorBufferInfo, 2>m_vkShaderUniformBufferDescriptors;
-			VkDescriptorSet                 m_vkDescriptorSet = VK_NULL_HANDLE;
+			array<VkDescriptorBufferInfo, 2>                m_vkShaderUniformBufferDescriptors;
         };
 
     public:
@@ -47,13 +45,14 @@ namespace Echo
 		// create shader library
 		virtual bool createShaderProgram(const String& vsContent, const String& psContent) override;
 
-        // create|update uniform buffer
-        void createVkUniformBuffer(UniformsInstance& uniformData);
+        // update uniform buffer
         void updateVkUniformBuffer(UniformsInstance& uniformData);
 
-        // setup descriptor set
-        void createVkDescriptorSet(UniformsInstance& uniformData);
-        void updateDescriptorSet(UniformsInstance& uniformsInstance);
+        // write uniform bytes to the upload ring
+        void uploadUniformBytes(const vector<Byte>::type& uniformBytes, VkDescriptorBufferInfo& bufferInfo);
+
+        // setup descriptor set of this bind
+        void updateDescriptorSet(UniformsInstance& uniformsInstance, VkDescriptorSet vkDescriptorSet);
 
         // create vk descriptor set layout
         void createVkDescriptorSetLayout();
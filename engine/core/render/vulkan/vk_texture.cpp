@@ -3,6 +3,7 @@
 #include "vk_renderer.h"
 #include "engine/core/io/io.h"
 #include "base/image/image.h"
+#include "base/texture/texture_streamer.h"
 
 namespace Echo
 {
@@ -13,7 +14,7 @@ namespace Echo
 
 	VKTexture::~VKTexture()
 	{
-
+		destroyVkImage();
 	}
 
 	bool VKTexture::createVkImage(SamplerStatePtr samplerState, PixelFormat format, i32 width, i32 height, i32 depth, VkImageUsageFlags usage, VkFlags requirementsMask, VkImageTiling tiling, VkImageLayout initialLayout)
@@ -38,9 +39,8 @@ namespace Echo
 		imageCreateInfo.initialLayout = initialLayout;
 
 		VKDebug(vkCreateImage(VKRenderer::instance()->getVkDevice(), &imageCreateInfo, nullptr, &m_vkImage));
-		if (m_vkImage)
+		if (m_vkImage && createVkImageMemory(requirementsMask, tiling))
 		{
-			createVkImageMemory(requirementsMask);
 			createVkImageView(format);
 
 			createDescriptorImageInfo(samplerState);
@@ -53,37 +53,39 @@ namespace Echo
 
 	void VKTexture::destroyVkImage()
 	{
+		// view goes first, it refers to the image
+		destroyVkImageView();
+
 		if (m_vkImage)
 		{
-			vkDestroyImage(VKRenderer::instance()->getVkDevice(), m_vkImage, nullptr);
+			VKRenderer* vkRenderer = VKRenderer::instance();
+			VkImage vkImage = m_vkImage;
+			VKAllocation allocation = m_allocation;
+			vkRenderer->destroyLater([vkRenderer, vkImage, allocation]() mutable
+			{
+				vkDestroyImage(vkRenderer->getVkDevice(), vkImage, nullptr);
+				vkRenderer->getMemoryAllocator().free(allocation);
+			});
+
 			m_vkImage = VK_NULL_HANDLE;
+			m_allocation = VKAllocation();
 		}
 	}
 
-	void VKTexture::createVkImageMemory(VkFlags requirementsMask)
+	bool VKTexture::createVkImageMemory(VkFlags requirementsMask, VkImageTiling tiling)
 	{
-		destroyVkImageMemory();
-
 		VkMemoryRequirements memRequirements;
 		vkGetImageMemoryRequirements(VKRenderer::instance()->getVkDevice(), m_vkImage, &memRequirements);
 
-		VkMemoryAllocateInfo allocInfo;
-		allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		allocInfo.pNext = nullptr;
-		allocInfo.allocationSize = memRequirements.size;
-		allocInfo.memoryTypeIndex = VKRenderer::instance()->findVkMemoryType(memRequirements.memoryTypeBits, requirementsMask);
-
-		VKDebug(vkAllocateMemory(VKRenderer::instance()->getVkDevice(), &allocInfo, nullptr, &m_vkImageMemory));
-		VKDebug(vkBindImageMemory(VKRenderer::instance()->getVkDevice(), m_vkImage, m_vkImageMemory, 0));
-	}
-
-	void VKTexture::destroyVkImageMemory()
-	{
-		if (m_vkImageMemory)
+		// linear images share blocks with buffers, granularity only separates linear from optimal
+		if (VKRenderer::instance()->getMemoryAllocator().allocate(memRequirements, requirementsMask, tiling == VK_IMAGE_TILING_OPTIMAL, m_allocation))
 		{
-			vkFreeMemory(VKRenderer::instance()->getVkDevice(), m_vkImageMemory, nullptr);
-			m_vkImageMemory = VK_NULL_HANDLE;
+			VKDebug(vkBindImageMemory(VKRenderer::instance()->getVkDevice(), m_vkImage, m_allocation.m_vkMemory, m_allocation.m_offset));
+			return true;
 		}
+
+		EchoLogError("vulkan allocate image memory failed");
+		return false;
 	}
 
 	void VKTexture::createVkImageView(PixelFormat format)
@@ -114,7 +116,13 @@ namespace Echo
 	{
 		if (m_vkImageView)
 		{
-			vkDestroyImageView(VKRenderer::instance()->getVkDevice(), m_vkImageView, nullptr);
+			VKRenderer* vkRenderer = VKRenderer::instance();
+			VkImageView vkImageView = m_vkImageView;
+			vkRenderer->destroyLater([vkRenderer, vkImageView]()
+			{
+				vkDestroyImageView(vkRenderer->getVkDevice(), vkImageView, nullptr);
+			});
+
 			m_vkImageView = VK_NULL_HANDLE;
 		}
 	}
@@ -133,34 +141,18 @@ namespace Echo
 	{
 		if (isUseStaging)
 		{
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingMemory;
-
-			VkBufferCreateInfo bufferCreateInfo = {};
-			bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			bufferCreateInfo.size = buff.getSize();
-			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-			VKDebug(vkCreateBuffer(VKRenderer::instance()->getVkDevice(), &bufferCreateInfo, nullptr, &stagingBuffer));
-
-			// Get memroy requirements for the staging buffer (alignment, memory type bits)
-			VkMemoryRequirements memReqs;
-			vkGetBufferMemoryRequirements(VKRenderer::instance()->getVkDevice(), stagingBuffer, &memReqs);
-
-			VkMemoryAllocateInfo memAllocInfo{};
-			memAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			memAllocInfo.allocationSize = memReqs.size;
-			memAllocInfo.memoryTypeIndex = VKRenderer::instance()->findVkMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-			VKDebug(vkAllocateMemory(VKRenderer::instance()->getVkDevice(), &memAllocInfo, nullptr, &stagingMemory));
-			VKDebug(vkBindBufferMemory(VKRenderer::instance()->getVkDevice(), stagingBuffer, stagingMemory, 0));
+			// staging bytes live in the upload ring until this frame finished, offsets must be
+			// multiples of both 4 and the texel size
+			VKUploadRing::Allocation staging;
+			if (!VKRenderer::instance()->getUploadRing().allocate(buff.getSize(), 4 * Math::Max<ui32>(1, PixelUtil::GetPixelBytes(pixFmt)), staging))
+			{
+				EchoLogError("vulkan allocate texture staging memory failed");
+				return;
+			}
 
 			// Copy texture data into staging buffer
-			ui8* data = nullptr;
-			VKDebug(vkMapMemory(VKRenderer::instance()->getVkDevice(), stagingMemory, 0, memReqs.size, 0, (void**)&data));
-			memcpy(data, buff.getData(), buff.getSize());
-			vkUnmapMemory(VKRenderer::instance()->getVkDevice(), stagingMemory);
+			if (buff.getData())
+				memcpy(staging.m_data, buff.getData(), buff.getSize());
 
 			// setup buffer copy regions for each mip level
 			vector<VkBufferImageCopy>::type bufferCopyRegions;
@@ -174,41 +166,28 @@ namespace Echo
 				bufferCopyRegion.imageExtent.width = Math::Max(1u, width >> i);
 				bufferCopyRegion.imageExtent.height = Math::Max(1u, height >> i);
 				bufferCopyRegion.imageExtent.depth = 1;
-				bufferCopyRegion.bufferOffset = 0;
+				bufferCopyRegion.bufferOffset = staging.m_offset;
 
 				bufferCopyRegions.push_back(bufferCopyRegion);
 			}
 
+			// recorded into the frame's upload command buffer, submitted ahead of the frame's draws
+			// instead of stalling the queue here
+			VkCommandBuffer copyCmd = VKRenderer::instance()->getVkUploadCommandBuffer();
+			setImageLayout(copyCmd, m_vkImage, VK_IMAGE_LAYOUT_PREINITIALIZED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+			vkCmdCopyBufferToImage(copyCmd, staging.m_vkBuffer, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(bufferCopyRegions.size()), bufferCopyRegions.data());
+			setImageLayout(copyCmd, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		}
+		else if (m_allocation.m_mapped)
+		{
+			memcpy(m_allocation.m_mapped, buff.getData(), buff.getSize());
+
 			// setup image memory barrier transfer image to shader read layout
-			VKRenderer::instance()->submitSingleTimeCommands([&](VkCommandBuffer copyCmd)
-				{
-					setImageLayout(copyCmd, m_vkImage, VK_IMAGE_LAYOUT_PREINITIALIZED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-					vkCmdCopyBufferToImage(copyCmd, stagingBuffer, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(bufferCopyRegions.size()), bufferCopyRegions.data());
-					setImageLayout(copyCmd, m_vkImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-				});
-
-			// Clean up staging resources
-			vkFreeMemory(VKRenderer::instance()->getVkDevice(), stagingMemory, nullptr);
-			vkDestroyBuffer(VKRenderer::instance()->getVkDevice(), stagingBuffer, nullptr);
+			setImageLayout(VKRenderer::instance()->getVkUploadCommandBuffer(), m_vkImage, VK_IMAGE_LAYOUT_PREINITIALIZED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 		}
 		else
 		{
-			void* data = nullptr;
-			if (VK_SUCCESS == vkMapMemory(VKRenderer::instance()->getVkDevice(), m_vkImageMemory, 0, buff.getSize(), 0, &data))
-			{
-				memcpy(data, buff.getData(), buff.getSize());
-				vkUnmapMemory(VKRenderer::instance()->getVkDevice(), m_vkImageMemory);
-
-				// setup image memory barrier transfer image to shader read layout
-				VKRenderer::instance()->submitSingleTimeCommands([&](VkCommandBuffer copyCmd)
-					{
-						setImageLayout(copyCmd, m_vkImage, VK_IMAGE_LAYOUT_PREINITIALIZED, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-					});
-			}
-			else
-			{
-				EchoLogError("Vulkan vkMapMemory failed");
-			}
+			EchoLogError("Vulkan image memory isn't host visible");
 		}
 	}
 
@@ -221,12 +200,18 @@ namespace Echo
 		subResourcesRange.levelCount = 1;
 		subResourcesRange.layerCount = 1;
 
+		// the copy has to wait for the layout change, and sampling for the copy
+		VkAccessFlags srcAccessMask = oldImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_HOST_WRITE_BIT;
+		VkAccessFlags dstAccessMask = newImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_SHADER_READ_BIT;
+		VkPipelineStageFlags srcStageMask = oldImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_HOST_BIT;
+		VkPipelineStageFlags dstStageMask = newImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_PIPELINE_STAGE_TRANSFER_BIT : VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+
 		// transition the texture image layout to shader read, so it can be sampled from
 		VkImageMemoryBarrier imageMemoryBarrier = {};
 		imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 		imageMemoryBarrier.pNext = nullptr;
-		imageMemoryBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		imageMemoryBarrier.srcAccessMask = srcAccessMask;
+		imageMemoryBarrier.dstAccessMask = dstAccessMask;
 		imageMemoryBarrier.oldLayout = oldImageLayout;
 		imageMemoryBarrier.newLayout = newImageLayout;
 		imageMemoryBarrier.srcQueueFamilyIndex = VKRenderer::instance()->getGraphicsQueueFamilyIndex();
@@ -235,12 +220,10 @@ namespace Echo
 		imageMemoryBarrier.subresourceRange = subResourcesRange;
 
 		// insert a memory dependency at the proper pipeline stages that will execute the image layout transition
-		// source pipeline stage is host write/read execution (VK_PIPELINE_STAGE_HOST_BIT)
-		// destination pipeline stage fragment shader access (VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT)
 		vkCmdPipelineBarrier(
 			cmdBuffer,
-			VK_PIPELINE_STAGE_HOST_BIT,
-			VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+			srcStageMask,
+			dstStageMask,
 			0,
 			0, nullptr,
 			0, nullptr,
@@ -269,26 +252,25 @@ namespace Echo
 
 	bool VKTexture2D::load()
 	{
-		MemoryReader memReader(getPath());
-		if (memReader.getSize())
+		// cooked textures stream their baked mips
+		if (TextureStreamer::instance()->load(this))
+			return true;
+
+		Image* image = acquireImage();
+		if (image)
 		{
-			Buffer commonTextureBuffer(memReader.getSize(), memReader.getData<ui8*>(), false);
-			Image* image = Image::createFromMemory(commonTextureBuffer, Image::GetImageFormat(getPath()));
-			if (image)
+			// vulkan doesn't support rgb format
+			convertFormat(image);
+
+			if (updateTexture2D(image->getPixelFormat(), TexUsage::TU_CPU_READ, image->getWidth(), image->getHeight(), image->getData(), 0))
+			{
+				EchoSafeDelete(image, Image);
+				return true;
+			}
+			else
 			{
-				// vulkan doesn't support rgb format
-				convertFormat(image);
-
-				if (updateTexture2D(image->getPixelFormat(), TexUsage::TU_CPU_READ, image->getWidth(), image->getHeight(), image->getData(), 0))
-				{
-					EchoSafeDelete(image, Image);
-					return true;
-				}
-				else
-				{
-					EchoSafeDelete(image, Image);
-					return false;
-				}
+				EchoSafeDelete(image, Image);
+				return false;
 			}
 		}
 
@@ -307,7 +289,7 @@ namespace Echo
 
 		bool isUseTilingOptimal = true;
 		VkImageUsageFlags vkUsageFlags = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-		VkFlags requirementsMask = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;// VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+		VkFlags requirementsMask = isUseTilingOptimal ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
 		VkImageTiling tiling = isUseTilingOptimal ? VK_IMAGE_TILING_OPTIMAL : VK_IMAGE_TILING_LINEAR;
 		VkImageLayout initialLayout = VK_IMAGE_LAYOUT_PREINITIALIZED;
 
@@ -367,7 +349,7 @@ namespace Echo
 			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT :
 			VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
 
-		VkFlags requirementsMask = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		VkFlags requirementsMask = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
 		VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
 		VkImageLayout initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         createVkImage(getSamplerState(), m_pixFmt, m_width, m_height, m_depth, vkUsageFlags, requirementsMask, tiling, initialLayout);
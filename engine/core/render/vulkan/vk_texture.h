@@ -4,6 +4,7 @@
 #include "base/texture/texture_render_target_2d.h"
 #include "vk_render_base.h"
 #include "vk_render_state.h"
+#include "vk_memory_allocator.h"
 
 namespace Echo
 {
@@ -20,13 +21,12 @@ namespace Echo
         VkDescriptorImageInfo* getVkDescriptorImageInfo() { return m_vkDescriptorImageInfo.sampler ? &m_vkDescriptorImageInfo : nullptr; }
 
 	protected:
-		// VkImage
+		// VkImage, destroyed with its memory and view once the frames using it finished
 		bool createVkImage(SamplerStatePtr samplerState, PixelFormat format, i32 width, i32 height, i32 depth, VkImageUsageFlags usage, VkFlags requirementsMask, VkImageTiling tiling, VkImageLayout initialLayout);
 		void destroyVkImage();
 
 		// VkImageMemory
-		void createVkImageMemory(VkFlags requirementsMask);
-		void destroyVkImageMemory();
+		bool createVkImageMemory(VkFlags requirementsMask, VkImageTiling tiling);
 
 		// VkImageView
 		void createVkImageView(PixelFormat format);
@@ -43,7 +43,7 @@ namespace Echo
 
 	protected:
 		VkImage                 m_vkImage = VK_NULL_HANDLE;
-		VkDeviceMemory          m_vkImageMemory = VK_NULL_HANDLE;
+		VKAllocation            m_allocation;
 		VkImageView             m_vkImageView = VK_NULL_HANDLE;
         VkDescriptorImageInfo   m_vkDescriptorImageInfo = {};
     };
@@ -0,0 +1,126 @@
+#include "vk_upload_ring.h"
+
+namespace Echo
+{
+    static const VkBufferUsageFlags g_vkUploadUsage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
+
+    static bool createHostVisibleBuffer(VkDevice vkDevice, VKMemoryAllocator* allocator, VkDeviceSize size, VkBuffer& vkBuffer, VKAllocation& allocation)
+    {
+        VkBufferCreateInfo createInfo = {};
+        createInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+        createInfo.size = size;
+        createInfo.usage = g_vkUploadUsage;
+        createInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (VK_SUCCESS == vkCreateBuffer(vkDevice, &createInfo, nullptr, &vkBuffer))
+        {
+            VkMemoryRequirements memRequirements;
+            vkGetBufferMemoryRequirements(vkDevice, vkBuffer, &memRequirements);
+            if (allocator->allocate(memRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, false, allocation))
+            {
+                VKDebug(vkBindBufferMemory(vkDevice, vkBuffer, allocation.m_vkMemory, allocation.m_offset));
+                return true;
+            }
+
+            vkDestroyBuffer(vkDevice, vkBuffer, nullptr);
+            vkBuffer = VK_NULL_HANDLE;
+        }
+
+        EchoLogError("vulkan create upload buffer failed");
+        return false;
+    }
+
+    void VKUploadRing::create(VkDevice vkDevice, VKMemoryAllocator* allocator, VkDeviceSize size)
+    {
+        m_vkDevice = vkDevice;
+        m_allocator = allocator;
+        if (createHostVisibleBuffer(m_vkDevice, m_allocator, size, m_vkBuffer, m_allocation))
+            m_size = size;
+    }
+
+    void VKUploadRing::cleanup()
+    {
+        for (vector<Dedicated>::type& dedicateds : m_dedicateds)
+        {
+            for (Dedicated& dedicated : dedicateds)
+            {
+                vkDestroyBuffer(m_vkDevice, dedicated.m_vkBuffer, nullptr);
+                m_allocator->free(dedicated.m_allocation);
+            }
+            dedicateds.clear();
+        }
+
+        if (m_vkBuffer)
+        {
+            vkDestroyBuffer(m_vkDevice, m_vkBuffer, nullptr);
+            m_allocator->free(m_allocation);
+            m_vkBuffer = VK_NULL_HANDLE;
+        }
+
+        m_size = 0;
+        m_head = 0;
+        m_usedSize = 0;
+        m_frameSizes.fill(0);
+    }
+
+    void VKUploadRing::beginFrame(ui32 frameIndex)
+    {
+        m_frameIndex = frameIndex;
+
+        // allocations are FIFO, so the oldest frame's bytes are the ones right after the free space
+        m_usedSize -= m_frameSizes[frameIndex];
+        m_frameSizes[frameIndex] = 0;
+
+        for (Dedicated& dedicated : m_dedicateds[frameIndex])
+        {
+            vkDestroyBuffer(m_vkDevice, dedicated.m_vkBuffer, nullptr);
+            m_allocator->free(dedicated.m_allocation);
+        }
+        m_dedicateds[frameIndex].clear();
+    }
+
+    bool VKUploadRing::allocate(VkDeviceSize size, VkDeviceSize alignment, Allocation& allocation)
+    {
+        if (m_vkBuffer && size <= m_size)
+        {
+            VkDeviceSize offset = (m_head + alignment - 1) / alignment * alignment;
+            VkDeviceSize padding = offset - m_head;
+            if (offset + size > m_size)
+            {
+                // wrap, the tail of the ring is skipped
+                padding = m_size - m_head;
+                offset = 0;
+            }
+
+            if (m_usedSize + padding + size <= m_size)
+            {
+                m_head = offset + size;
+                m_usedSize += padding + size;
+                m_frameSizes[m_frameIndex] += padding + size;
+
+                allocation.m_vkBuffer = m_vkBuffer;
+                allocation.m_offset = offset;
+                allocation.m_data = static_cast<Byte*>(m_allocation.m_mapped) + offset;
+                return true;
+            }
+        }
+
+        return allocateDedicated(size, allocation);
+    }
+
+    bool VKUploadRing::allocateDedicated(VkDeviceSize size, Allocation& allocation)
+    {
+        Dedicated dedicated;
+        if (createHostVisibleBuffer(m_vkDevice, m_allocator, size, dedicated.m_vkBuffer, dedicated.m_allocation))
+        {
+            m_dedicateds[m_frameIndex].emplace_back(dedicated);
+
+            allocation.m_vkBuffer = dedicated.m_vkBuffer;
+            allocation.m_offset = 0;
+            allocation.m_data = static_cast<Byte*>(dedicated.m_allocation.m_mapped);
+            return true;
+        }
+
+        return false;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "vk_memory_allocator.h"
+#include "engine/core/util/Array.hpp"
+
+namespace Echo
+{
+    // Persistently mapped ring for data the gpu reads once, texture staging and uniforms of a
+    // frame. Space used by a frame is reclaimed when that frame slot comes around again, after
+    // its fence was waited on. Requests the ring can't hold get a buffer of their own which is
+    // released the same way.
+    class VKUploadRing
+    {
+    public:
+        static constexpr VkDeviceSize DefaultSize = 16 * 1024 * 1024;
+
+        struct Allocation
+        {
+            VkBuffer        m_vkBuffer = VK_NULL_HANDLE;
+            VkDeviceSize    m_offset = 0;
+            Byte*           m_data = nullptr;
+        };
+
+    public:
+        VKUploadRing() {}
+        ~VKUploadRing() {}
+
+        // create|cleanup
+        void create(VkDevice vkDevice, VKMemoryAllocator* allocator, VkDeviceSize size = DefaultSize);
+        void cleanup();
+
+        // frame slot begins, space it used before is free again
+        void beginFrame(ui32 frameIndex);
+
+        // allocate, alignment needn't be a power of two (texel sizes)
+        bool allocate(VkDeviceSize size, VkDeviceSize alignment, Allocation& allocation);
+
+        // used bytes
+        VkDeviceSize getUsedSize() const { return m_usedSize; }
+
+    private:
+        // a buffer of its own, for requests larger than the ring
+        bool allocateDedicated(VkDeviceSize size, Allocation& allocation);
+
+    private:
+        struct Dedicated
+        {
+            VkBuffer        m_vkBuffer;
+            VKAllocation    m_allocation;
+        };
+
+    private:
+        VkDevice                                        m_vkDevice = VK_NULL_HANDLE;
+        VKMemoryAllocator*                              m_allocator = nullptr;
+        VkBuffer                                        m_vkBuffer = VK_NULL_HANDLE;
+        VKAllocation                                    m_allocation;
+        VkDeviceSize                                    m_size = 0;
+        VkDeviceSize                                    m_head = 0;
+        VkDeviceSize                                    m_usedSize = 0;
+        ui32                                            m_frameIndex = 0;
+        array<VkDeviceSize, VKMaxFramesInFlight>        m_frameSizes = { 0 };   // bytes used by a frame, padding included
+        array<vector<Dedicated>::type, VKMaxFramesInFlight> m_dedicateds;
+    };
+}
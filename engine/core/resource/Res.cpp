@@ -2,14 +2,46 @@
 #include "engine/core/log/Log.h"
 #include "engine/core/io/IO.h"
 #include "engine/core/util/PathUtil.h"
+#include "engine/core/thread/JobSystem.h"
+#include "engine/core/base/object_cooker.h"
+#include "engine/core/io/memory_reader.h"
+#include "engine/core/render/base/image/image.h"
 #include <thirdparty/pugixml/pugixml.hpp>
 #include <thirdparty/pugixml/pugiconfig.hpp>
+#include <chrono>
 
 namespace Echo
 {
+	// g_ress is only touched on the main thread, async workers read files and parse only
 	static std::unordered_map<String, Res*>			g_ress;
 	static std::unordered_map<String, Res::ResFun>	g_resFuncs;
 
+	// async loading, requests by path for dedup, queues are ordered by priority on use
+	static Mutex												g_asyncMutex;
+	static std::unordered_map<String, ResLoadRequestPtr>		g_asyncRequests;
+	static vector<ResLoadRequestPtr>::type						g_asyncReadQueue;
+	static vector<ResLoadRequestPtr>::type						g_asyncFinalizeQueue;
+	static float												g_asyncBudget = 4.f;
+
+	// pop the request of highest priority
+	static ResLoadRequestPtr popAsyncRequest(vector<ResLoadRequestPtr>::type& queue, const std::function<i32(const ResLoadRequestPtr&)>& priority)
+	{
+		if (queue.empty())
+			return nullptr;
+
+		size_t best = 0;
+		for (size_t i = 1; i < queue.size(); i++)
+		{
+			if (priority(queue[i]) > priority(queue[best]))
+				best = i;
+		}
+
+		ResLoadRequestPtr request = queue[best];
+		queue.erase(queue.begin() + best);
+
+		return request;
+	}
+
 	static void addResToCache(const String& path, Res* res)
 	{
 		auto it = g_ress.find(path);
@@ -61,8 +93,176 @@ namespace Echo
 	{
 	}
 
+	ResLoadRequest::~ResLoadRequest()
+	{
+		pugi::xml_document* doc = static_cast<pugi::xml_document*>(m_document);
+		EchoSafeDelete(doc, xml_document);
+		EchoSafeDelete(m_image, Image);
+	}
+
+	float ResLoadRequest::getProgress() const
+	{
+		switch (m_state.load())
+		{
+		case State::Queued:
+		case State::Reading:	return 0.f;
+		case State::Finalizing:	return 0.5f;
+		default:				return 1.f;
+		}
+	}
+
+	ResLoadRequestPtr Res::getAsync(const ResourcePath& path, i32 priority)
+	{
+		auto it = g_ress.find(path.getPath());
+		if (it != g_ress.end())
+		{
+			ResLoadRequestPtr request = std::make_shared<ResLoadRequest>(path, priority);
+			request->m_res = it->second;
+			request->m_state = ResLoadRequest::State::Done;
+			return request;
+		}
+
+		// dedup, requests of the same path share one
+		EE_LOCK_MUTEX(g_asyncMutex)
+		auto itRequest = g_asyncRequests.find(path.getPath());
+		if (itRequest != g_asyncRequests.end())
+		{
+			itRequest->second->m_priority = std::max<i32>(itRequest->second->m_priority, priority);
+			return itRequest->second;
+		}
+
+		ResLoadRequestPtr request = std::make_shared<ResLoadRequest>(path, priority);
+		g_asyncRequests[path.getPath()] = request;
+		g_asyncReadQueue.emplace_back(request);
+
+		// every job reads the most important request queued at the time it runs
+		JobSystem::instance()->runBackground([]()
+		{
+			ResLoadRequestPtr request;
+			{
+				EE_LOCK_MUTEX(g_asyncMutex)
+				request = popAsyncRequest(g_asyncReadQueue, [](const ResLoadRequestPtr& r) { return r->m_priority; });
+			}
+
+			if (request)
+			{
+				request->m_state = ResLoadRequest::State::Reading;
+
+				const ResFun* resFun = getResFunByExtension(PathUtil::GetFileExt(request->m_path.getPath(), true));
+				if (resFun && resFun->m_lfun == &Res::load)
+				{
+					MemoryReader reader(request->m_path.getPath());
+					if (ObjectCooker::isCooked(reader.getData<const char*>(), reader.getSize()))
+					{
+						request->m_cooked.assign(reader.getData<const Byte*>(), reader.getData<const Byte*>() + reader.getSize());
+					}
+					else if (reader.getSize())
+					{
+						pugi::xml_document* doc = EchoNew(pugi::xml_document);
+						if (doc->load_buffer(reader.getData<char*>(), reader.getSize()))
+							request->m_document = doc;
+						else
+							EchoSafeDelete(doc, xml_document);
+					}
+				}
+				else if (resFun && resFun->m_ifun)
+				{
+					// decode here, the main thread only creates the resource
+					MemoryReader reader(request->m_path.getPath());
+					if (reader.getSize())
+						request->m_image = Image::createFromMemory(Buffer(reader.getSize(), reader.getData<ui8*>(), false), Image::GetImageFormat(request->m_path.getPath()));
+				}
+				else
+				{
+					IO::instance()->preload(request->m_path.getPath());
+				}
+
+				request->m_state = ResLoadRequest::State::Finalizing;
+
+				EE_LOCK_MUTEX(g_asyncMutex)
+				g_asyncFinalizeQueue.emplace_back(request);
+			}
+		});
+
+		return request;
+	}
+
+	void Res::setAsyncBudget(float ms)
+	{
+		g_asyncBudget = ms;
+	}
+
+	ui32 Res::getAsyncPendingCount()
+	{
+		EE_LOCK_MUTEX(g_asyncMutex)
+		return ui32(g_asyncRequests.size());
+	}
+
 	void Res::updateAll(float delta)
 	{
+		// finalize async loads, at least one per frame so loading always moves on
+		auto beginTime = std::chrono::steady_clock::now();
+		for (;;)
+		{
+			ResLoadRequestPtr request;
+			{
+				EE_LOCK_MUTEX(g_asyncMutex)
+				request = popAsyncRequest(g_asyncFinalizeQueue, [](const ResLoadRequestPtr& r) { return r->m_priority; });
+			}
+
+			if (!request)
+				break;
+
+			const String& path = request->m_path.getPath();
+			auto it = g_ress.find(path);
+			if (it != g_ress.end())
+			{
+				request->m_res = it->second;
+			}
+			else if (!request->m_cooked.empty())
+			{
+				request->m_res = ObjectCooker::instanceRes(request->m_cooked.data(), request->m_cooked.size(), request->m_path);
+				if (request->m_res)
+					g_ress[path] = request->m_res;
+			}
+			else if (request->m_document)
+			{
+				pugi::xml_node root = static_cast<pugi::xml_document*>(request->m_document)->child("res");
+				if (root)
+				{
+					request->m_res = instanceRes(&root, request->m_path);
+					if (request->m_res)
+						g_ress[path] = request->m_res;
+				}
+			}
+			else if (request->m_image)
+			{
+				// the load function owns the image
+				const ResFun* resFun = getResFunByExtension(PathUtil::GetFileExt(path, true));
+				Image* image = request->m_image;
+				request->m_image = nullptr;
+
+				request->m_res = resFun->m_ifun(request->m_path, image);
+				if (request->m_res)
+					request->m_res->setPath(path);
+			}
+			else
+			{
+				request->m_res = get(request->m_path);
+			}
+
+			IO::instance()->releasePreload(path);
+			request->m_state = request->m_res ? ResLoadRequest::State::Done : ResLoadRequest::State::Failed;
+			{
+				EE_LOCK_MUTEX(g_asyncMutex)
+				g_asyncRequests.erase(path);
+			}
+
+			float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - beginTime).count();
+			if (elapsed > g_asyncBudget)
+				break;
+		}
+
 #ifdef ECHO_EDITOR_MODE
 		for (auto& [key, res] : g_ress)
 		{
@@ -95,6 +295,15 @@ namespace Echo
 			EchoLogError("setPath [%s] failed", path.c_str());
 	}
 
+	void Res::registerResImageLoad(const String& className, RES_LOAD_IMAGE_FUNC ifun)
+	{
+		for (auto& [ext, fun] : g_resFuncs)
+		{
+			if (fun.m_class == className)
+				fun.m_ifun = ifun;
+		}
+	}
+
 	void Res::registerRes(const String& className, const String& exts, RES_CREATE_FUNC cfun, RES_LOAD_FUNC lfun)
 	{
 		ResFun fun;
@@ -229,7 +438,15 @@ namespace Echo
 	Res* Res::load(const ResourcePath& path)
 	{
 		MemoryReader reader(path.getPath());
-		if (reader.getSize())
+		if (ObjectCooker::isCooked(reader.getData<const char*>(), reader.getSize()))
+		{
+			Res* res = ObjectCooker::instanceRes(reader.getData<const char*>(), reader.getSize(), path);
+			if (res)
+				g_ress[path.getPath()] = res;
+
+			return res;
+		}
+		else if (reader.getSize())
 		{
 			pugi::xml_document doc;
 			if (doc.load_buffer(reader.getData<char*>(), reader.getSize()))
@@ -3,16 +3,69 @@
 #include "ResRef.h"
 #include "ResourcePath.h"
 #include "engine/core/base/object.h"
+#include <atomic>
+#include <memory>
 
 namespace Echo
 {
+	class Res;
+	class Image;
+
+	// Async load of a resource. Requests of the same path share one instance.
+	// File reading, xml parsing and image decoding run on worker threads, the resource is
+	// created on the main thread by Res::updateAll within the per frame budget.
+	class ResLoadRequest
+	{
+		friend class Res;
+
+	public:
+		enum class State
+		{
+			Queued,
+			Reading,
+			Finalizing,
+			Done,
+			Failed,
+		};
+
+	public:
+		ResLoadRequest(const ResourcePath& path, i32 priority) : m_path(path), m_priority(priority) {}
+		~ResLoadRequest();
+
+		// path
+		const ResourcePath& getPath() const { return m_path; }
+
+		// state
+		State getState() const { return m_state.load(); }
+		bool isDone() const { return m_state.load() >= State::Done; }
+
+		// 0 queued, 0.5 read, 1 done
+		float getProgress() const;
+
+		// result, valid when done
+		Res* getRes() const { return m_res; }
+
+	private:
+		ResourcePath		m_path;
+		i32					m_priority;
+		std::atomic<State>	m_state = { State::Queued };
+		void*				m_document = nullptr;		// xml parsed on the worker
+		ByteArray			m_cooked;					// cooked document read on the worker
+		Image*				m_image = nullptr;			// image decoded on the worker
+		Res*				m_res = nullptr;
+	};
+	typedef std::shared_ptr<ResLoadRequest> ResLoadRequestPtr;
+
 	class Res : public Object
 	{
 		ECHO_CLASS(Res, Object)
 
+		friend class ObjectCooker;
+
 	public:
 		typedef Res*(*RES_CREATE_FUNC)();
 		typedef Res*(*RES_LOAD_FUNC)(const ResourcePath&);
+		typedef Res*(*RES_LOAD_IMAGE_FUNC)(const ResourcePath&, Image*);
 
 		struct ResFun
 		{
@@ -20,6 +73,7 @@ namespace Echo
 			String				m_ext;
 			RES_CREATE_FUNC		m_cfun = nullptr;
 			RES_LOAD_FUNC		m_lfun = nullptr;
+			RES_LOAD_IMAGE_FUNC	m_ifun = nullptr;
 		};
 
 	public:
@@ -34,9 +88,21 @@ namespace Echo
 		// resister res
 		static void registerRes(const String& className, const String& exts, RES_CREATE_FUNC cfun, RES_LOAD_FUNC lfun);
 
+		// async loads of the class decode images on workers, ifun creates the res from it and owns the image
+		static void registerResImageLoad(const String& className, RES_LOAD_IMAGE_FUNC ifun);
+
 		// get res
 		static Res* get(const ResourcePath& path);
 
+		// get res asynchronously from the main thread, higher priority requests are read and finalized first
+		static ResLoadRequestPtr getAsync(const ResourcePath& path, i32 priority = 0);
+
+		// main thread time budget (ms) per frame for finalizing async loads
+		static void setAsyncBudget(float ms);
+
+		// async requests not finished yet
+		static ui32 getAsyncPendingCount();
+
 		// create by extension
 		static ResRef<Res> createByFileExtension(const String& extWithDot, bool ignoreError);
 
@@ -1,29 +1,35 @@
 #pragma once
 
+#include <atomic>
 #include "engine/core/memory/MemAllocDef.h"
 
 namespace Echo
 {
+	// reference count is atomic, refs of one object may be copied on several job threads at once
 	class Refable
 	{
 	public:
+		Refable() {}
+		Refable(const Refable&) {}
 		virtual ~Refable() {}
 
+		// a copy is a new object, it has no references yet
+		Refable& operator=(const Refable&) { return *this; }
+
 		// add ref count
-		void addRefCount() { m_refCount++; }
+		void addRefCount() { m_refCount.fetch_add(1, std::memory_order_relaxed); }
 
 		// release
 		virtual void subRefCount()
 		{
-			m_refCount--;
-			if (m_refCount <= 0)
+			if (m_refCount.fetch_sub(1, std::memory_order_acq_rel) <= 1)
 			{
 				ECHO_DELETE_T(this, Refable);
 			}
 		}
 
 	protected:
-		int	m_refCount = 0;
+		std::atomic<int>	m_refCount{ 0 };
 	};
 
 	template<typename T>
@@ -3,12 +3,17 @@
 #include "engine/core/io/IO.h"
 #include "engine/core/main/Engine.h"
 #include "engine/core/util/PathUtil.h"
+#include "engine/core/base/object_cooker.h"
 #include "engine/core/script/lua/lua_binder.h"
+#include "transform_hierarchy.h"
 #include <thirdparty/pugixml/pugixml.hpp>
 #include <thirdparty/pugixml/pugiconfig.hpp>
 
 namespace Echo
 {
+	// source of tree version stamps, so a version is never reused by another subtree
+	static ui32 g_treeVersion = 0;
+
 	void Node::LuaScript::release(Node* obj)
 	{
 		if (obj->isRegisteredToScript())
@@ -79,9 +84,25 @@ namespace Echo
 
 	Node::~Node()
 	{
+		if (m_transformIdx != -1)
+			TransformHierarchy::current()->removeNode(this);
+
 		m_script.release(this);
 	}
 
+	void Node::setName(const String& name)
+	{
+		m_name = name;
+		markTreeChanged();
+	}
+
+	void Node::markTreeChanged()
+	{
+		ui32 version = ++g_treeVersion;
+		for (Node* node = this; node; node = node->m_parent)
+			node->m_treeVersion = version;
+	}
+
 	void Node::rotate(const Quaternion& rot)
 	{
 		// Normalize quaternion to avoid drift
@@ -231,6 +252,10 @@ namespace Echo
 
 		node->m_parent = this;
 		m_children.insert(m_children.begin() + idx, node);
+		markTreeChanged();
+
+		if (TransformHierarchy::current())
+			TransformHierarchy::current()->markStructureDirty();
 
 		needUpdate();
 	}
@@ -265,6 +290,11 @@ namespace Echo
 			if (*it == node)
 			{
 				m_children.erase(it);
+				markTreeChanged();
+
+				if (TransformHierarchy::current())
+					TransformHierarchy::current()->markStructureDirty();
+
 				return true;
 			}
 		}
@@ -315,8 +345,37 @@ namespace Echo
 		return m_worldTransform.m_pos;
 	}
 	
+	bool Node::composeWorldTransform(ui32 epoch)
+	{
+		if (m_composedEpoch != epoch)
+		{
+			// a clean chain keeps the result of the last hierarchy update
+			bool isParentDirty = m_parent && m_parent->composeWorldTransform(epoch);
+			m_isChainDirty = isParentDirty || m_isTransformDirty;
+			if (m_isChainDirty)
+			{
+				m_worldTransform = m_parent ? m_parent->m_worldTransform * m_localTransform : m_localTransform;
+				m_worldTransform.buildMatrix(m_matWorld);
+			}
+
+			m_composedEpoch = epoch;
+		}
+
+		return m_isChainDirty;
+	}
+	
 	const Matrix4& Node::getWorldMatrix()
 	{
+		if (m_transformIdx != -1)
+		{
+			// flat hierarchy only flags the moved node, until its next update descendants compose
+			// the chain on demand. Flags are left for the hierarchy update to clear
+			if (TransformHierarchy::current()->isDirty())
+				composeWorldTransform(TransformHierarchy::getDirtyEpoch());
+
+			return m_matWorld;
+		}
+
 		if (m_isTransformDirty)
 		{
 			// build mat world matrix
@@ -386,6 +445,13 @@ namespace Echo
 
 	void Node::needUpdate()
 	{
+		// flat hierarchy refreshes descendants in its next update, no need to visit them here
+		if (m_transformIdx != -1 && TransformHierarchy::current()->markDirty(this))
+		{
+			m_isTransformDirty = true;
+			return;
+		}
+
 		if (m_isTransformDirty)
 			return;
 
@@ -697,24 +763,30 @@ namespace Echo
 		MemoryReader reader(path);
 		if (reader.getSize())
 		{
+			Node* rootNode = nullptr;
 			pugi::xml_document doc;
-			if (doc.load_buffer(reader.getData<char*>(), reader.getSize()))
+			if (ObjectCooker::isCooked(reader.getData<const char*>(), reader.getSize()))
+			{
+				rootNode = ObjectCooker::instanceNodeTree(reader.getData<const char*>(), reader.getSize());
+			}
+			else if (doc.load_buffer(reader.getData<char*>(), reader.getSize()))
 			{
 				pugi::xml_node root = doc.child("node");
-				Node* rootNode = instanceNodeTree(&root, nullptr);
-				if (rootNode)
+				rootNode = instanceNodeTree(&root, nullptr);
+			}
+
+			if (rootNode)
+			{
+				if (isLink)
 				{
-					if (isLink)
+					rootNode->setPath(path);
+					for (Echo::ui32 idx = 0; idx < rootNode->getChildNum(); idx++)
 					{
-						rootNode->setPath(path);
-						for (Echo::ui32 idx = 0; idx < rootNode->getChildNum(); idx++)
-						{
-							rootNode->getChildByIndex(idx)->setLink(true);
-						}
+						rootNode->getChildByIndex(idx)->setLink(true);
 					}
-					rootNode->registerToScript();
-					return rootNode;
 				}
+				rootNode->registerToScript();
+				return rootNode;
 			}
 		}
 
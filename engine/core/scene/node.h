@@ -11,6 +11,7 @@ namespace Echo
 		ECHO_CLASS(Node, Object)
 
 		friend class NodeTree;		
+		friend class TransformHierarchy;
 
 	public:
 		typedef vector<Node*>::type NodeArray;
@@ -35,9 +36,12 @@ namespace Echo
 		virtual ~Node();
 
 		// name
-		void setName(const String& name) { m_name = name; }
+		void setName(const String& name);
 		const String& getName() const { return m_name; }
 
+		// changes whenever a node is added, removed or renamed in this subtree, so path lookups can be cached
+		ui32 getTreeVersion() const { return m_treeVersion; }
+
 		// path
 		virtual void setPath(const String& path) override { m_path.setPath(path); }
 		virtual const String& getPath() const override { return m_path.getPath(); }
@@ -164,6 +168,13 @@ namespace Echo
 	protected:
         // dirty update flag
 		void needUpdate();
+
+		// stamp a new tree version on this node and its ancestors
+		void markTreeChanged();
+
+		// compose world transform of a chain with pending moves, ancestors composed in the same
+		// dirty epoch are reused. Returns true if this node or an ancestor waits for the update
+		bool composeWorldTransform(ui32 epoch);
         
         // start (the first time update the node)
         virtual void start() {}
@@ -179,6 +190,10 @@ namespace Echo
 		Node*			m_parent = nullptr;
 		NodeArray		m_children;
 		bool			m_isTransformDirty = false;	// for rendering.
+		i32				m_transformIdx = -1;		// index in TransformHierarchy, -1 if not tracked
+		ui32			m_treeVersion = 0;			// stamp of the last structure change in this subtree
+		ui32			m_composedEpoch = ~0u;		// dirty epoch of the last on demand composition
+		bool			m_isChainDirty = false;		// result of the last on demand composition
 		Transform		m_localTransform;
 		Transform		m_worldTransform;
 		Matrix4			m_matWorld;			        // cached derived transform as a 4x4 matrix
@@ -10,6 +10,7 @@ namespace Echo
 
 	NodeTree::~NodeTree()
 	{
+		m_transformHierarchy.setEnable(false);
         m_invisibleRoot->queueFree();
         
         EchoSafeDelete(m_2dCamera, Camera);
@@ -74,8 +75,12 @@ namespace Echo
 		m_renderScene->update(m_3dCamera->getFrustum(), m_2dCamera->getFrustum(), m_uiCamera->getFrustum());
 		
 		// Update nodes
+		m_transformHierarchy.update(m_invisibleRoot);
 		m_invisibleRoot->update(elapsedTime, true);
 
+		// World transforms changed by node updates
+		m_transformHierarchy.update(m_invisibleRoot);
+
 		// Update scripts
 		LuaBinder::instance()->execString("update_all_nodes()", true);
         
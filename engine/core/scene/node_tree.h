@@ -4,6 +4,7 @@
 #include "engine/core/gizmos/gizmos.h"
 #include "engine/core/camera/camera.h"
 #include "engine/core/render/base/scene/render_scene.h"
+#include "transform_hierarchy.h"
 
 namespace Echo
 {
@@ -37,6 +38,10 @@ namespace Echo
 		// set ui camera
 		void setUiCamera(Camera* pCamera) { m_uiCamera = pCamera; }
 
+		// flat transform hierarchy, world transforms are composed in depth order instead of recursively
+		void setFlatTransformHierarchy(bool isEnable) { m_transformHierarchy.setEnable(isEnable); }
+		bool isFlatTransformHierarchy() const { return m_transformHierarchy.isEnable(); }
+
 	public:
 		void update( float elapsedTime);
 
@@ -49,5 +54,6 @@ namespace Echo
 		Camera*				m_uiCamera = nullptr;
 		RenderScenePtr		m_renderScene;				// Main render scene
         Node*				m_invisibleRoot = nullptr;	// Invisible root node
+		TransformHierarchy	m_transformHierarchy;
 	};
 }
@@ -43,7 +43,7 @@ namespace Echo
 		virtual void update(float delta, bool bUpdateChildren) override;
 
 	public:
-		// get global uniforms
+		// get global uniforms, the returned address is cached by render proxies and must stay valid
 		virtual void* getGlobalUniformValue(const String& name);
 
 	protected:
@@ -0,0 +1,224 @@
+#include "transform_hierarchy.h"
+#include "node.h"
+#include "engine/core/thread/JobSystem.h"
+
+namespace Echo
+{
+	// levels smaller than this are composed on the calling thread
+	static const ui32 ParallelLevelSize = 2048;
+	static const ui32 ParallelGrain = 512;
+
+	static TransformHierarchy* g_current = nullptr;
+	static ui32 g_dirtyEpoch = 0;
+
+	TransformHierarchy::TransformHierarchy()
+	{
+	}
+
+	TransformHierarchy::~TransformHierarchy()
+	{
+		setEnable(false);
+	}
+
+	TransformHierarchy* TransformHierarchy::current()
+	{
+		return g_current;
+	}
+
+	ui32 TransformHierarchy::getDirtyEpoch()
+	{
+		return g_dirtyEpoch;
+	}
+
+	void TransformHierarchy::setEnable(bool isEnable)
+	{
+		if (isEnable)
+		{
+			if (g_current && g_current != this)
+				g_current->setEnable(false);
+
+			g_current = this;
+			m_isStructureDirty = true;
+		}
+		else if (g_current == this)
+		{
+			clear();
+			g_current = nullptr;
+		}
+	}
+
+	bool TransformHierarchy::markDirty(Node* node)
+	{
+		// on demand compositions of the last epoch may miss this move
+		g_dirtyEpoch++;
+
+		if (m_isStructureDirty || node->m_transformIdx < 0)
+			return false;
+
+		ui32 idx = ui32(node->m_transformIdx);
+		m_locals[idx] = node->m_localTransform;
+		m_dirtys[idx] = 1;
+		m_isDirty = true;
+
+		ui32 level = ui32(std::upper_bound(m_levelStarts.begin(), m_levelStarts.end(), idx) - m_levelStarts.begin()) - 1;
+		addDirtyRange(level, idx, idx + 1);
+
+		return true;
+	}
+
+	void TransformHierarchy::removeNode(Node* node)
+	{
+		if (node->m_transformIdx >= 0)
+		{
+			m_nodes[node->m_transformIdx] = nullptr;
+			node->m_transformIdx = -1;
+			m_isStructureDirty = true;
+		}
+	}
+
+	void TransformHierarchy::clear()
+	{
+		for (Node* node : m_nodes)
+		{
+			if (node)
+				node->m_transformIdx = -1;
+		}
+
+		m_nodes.clear();
+		m_parents.clear();
+		m_firstChilds.clear();
+		m_childCounts.clear();
+		m_locals.clear();
+		m_worlds.clear();
+		m_dirtys.clear();
+		m_levelStarts.clear();
+		m_dirtyRanges.clear();
+		m_isStructureDirty = true;
+		m_isDirty = false;
+	}
+
+	void TransformHierarchy::rebuild(Node* root)
+	{
+		clear();
+
+		m_nodes.emplace_back(root);
+		m_parents.emplace_back(-1);
+		m_levelStarts.emplace_back(0);
+
+		// breadth first, children of consecutive nodes are appended consecutively
+		ui32 levelEnd = 1;
+		for (ui32 i = 0; i < m_nodes.size(); i++)
+		{
+			if (i == levelEnd)
+			{
+				m_levelStarts.emplace_back(i);
+				levelEnd = ui32(m_nodes.size());
+			}
+
+			Node* node = m_nodes[i];
+			node->m_transformIdx = i32(i);
+			m_firstChilds.emplace_back(ui32(m_nodes.size()));
+			m_childCounts.emplace_back(ui32(node->m_children.size()));
+			for (Node* child : node->m_children)
+			{
+				m_nodes.emplace_back(child);
+				m_parents.emplace_back(i32(i));
+			}
+		}
+		m_levelStarts.emplace_back(ui32(m_nodes.size()));
+
+		m_locals.resize(m_nodes.size());
+		for (size_t i = 0; i < m_nodes.size(); i++)
+			m_locals[i] = m_nodes[i]->m_localTransform;
+
+		m_worlds.resize(m_nodes.size());
+		m_dirtys.assign(m_nodes.size(), 0);
+		m_dirtyRanges.assign(m_levelStarts.size() - 1, { 0, 0 });
+
+		// everything is recomposed from the root down
+		m_dirtys[0] = 1;
+		addDirtyRange(0, 0, 1);
+
+		m_isStructureDirty = false;
+	}
+
+	void TransformHierarchy::addDirtyRange(ui32 level, ui32 begin, ui32 end)
+	{
+		Range& range = m_dirtyRanges[level];
+		if (range.m_begin < range.m_end)
+		{
+			range.m_begin = std::min<ui32>(range.m_begin, begin);
+			range.m_end = std::max<ui32>(range.m_end, end);
+		}
+		else
+		{
+			range = { begin, end };
+		}
+	}
+
+	void TransformHierarchy::update(Node* root)
+	{
+		if (!isEnable())
+			return;
+
+		if (m_isStructureDirty)
+			rebuild(root);
+
+		for (ui32 level = 0; level < m_dirtyRanges.size(); level++)
+		{
+			Range range = m_dirtyRanges[level];
+			if (range.m_begin >= range.m_end)
+				continue;
+
+			// previous level is complete, nodes of this level only read their parents
+			ui32 count = range.m_end - range.m_begin;
+			if (count >= ParallelLevelSize)
+			{
+				JobSystem::instance()->parallelFor(count, ParallelGrain, [&](ui32 begin, ui32 end, ui32 threadIdx)
+				{
+					updateRange(range.m_begin + begin, range.m_begin + end);
+				});
+			}
+			else
+			{
+				updateRange(range.m_begin, range.m_end);
+			}
+
+			// children of a dirty range are a range of the next level
+			ui32 childBegin = m_firstChilds[range.m_begin];
+			ui32 childEnd = m_firstChilds[range.m_end - 1] + m_childCounts[range.m_end - 1];
+			if (childBegin < childEnd)
+				addDirtyRange(level + 1, childBegin, childEnd);
+		}
+
+		// dirty flags of updated ranges
+		for (Range& range : m_dirtyRanges)
+		{
+			if (range.m_begin < range.m_end)
+				std::fill(m_dirtys.begin() + range.m_begin, m_dirtys.begin() + range.m_end, 0);
+
+			range = { 0, 0 };
+		}
+
+		m_isDirty = false;
+		g_dirtyEpoch++;
+	}
+
+	void TransformHierarchy::updateRange(ui32 begin, ui32 end)
+	{
+		for (ui32 i = begin; i < end; i++)
+		{
+			i32 parent = m_parents[i];
+			if (!m_dirtys[i] && !(parent >= 0 && m_dirtys[parent]))
+				continue;
+
+			m_worlds[i] = parent >= 0 ? m_worlds[parent] * m_locals[i] : m_locals[i];
+			m_dirtys[i] = 1;
+
+			Node* node = m_nodes[i];
+			node->m_worldTransform = m_worlds[i];
+			node->m_worldTransform.buildMatrix(node->m_matWorld);
+			node->m_isTransformDirty = false;
+		}
+	}
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "engine/core/math/Math.h"
+#include "engine/core/memory/MemAllocDef.h"
+
+namespace Echo
+{
+	class Node;
+
+	// Flat copy of the node tree for world transform updates. Nodes are stored breadth first, so
+	// every depth level is a contiguous range and the children of a range of nodes are a range of
+	// the next level. Changing a local transform only marks the node's index, world transforms
+	// of dirty ranges and their descendants are composed level by level, large levels in parallel.
+	// Results are written back to the nodes, Node getters and cached matrix addresses stay valid.
+	class TransformHierarchy
+	{
+	public:
+		TransformHierarchy();
+		~TransformHierarchy();
+
+		// the enabled hierarchy, nullptr if nodes use recursive updates
+		static TransformHierarchy* current();
+
+		// enable
+		void setEnable(bool isEnable);
+		bool isEnable() const { return current() == this; }
+
+		// node tree structure changed, the flat copy is rebuilt on next update
+		void markStructureDirty() { m_isStructureDirty = true; }
+
+		// local transform of a node changed, returns false if node isn't tracked yet
+		bool markDirty(Node* node);
+
+		// some world transforms wait for the next update
+		bool isDirty() const { return m_isDirty || m_isStructureDirty; }
+
+		// changes whenever a node is marked or an update ran, stamps on demand compositions
+		static ui32 getDirtyEpoch();
+
+		// node is being deleted
+		void removeNode(Node* node);
+
+		// compose world transforms of dirty ranges
+		void update(Node* root);
+
+	private:
+		// rebuild breadth first arrays
+		void rebuild(Node* root);
+
+		// reset node indices and arrays
+		void clear();
+
+		// compose world transforms of [begin, end)
+		void updateRange(ui32 begin, ui32 end);
+
+		// extend dirty range of level
+		void addDirtyRange(ui32 level, ui32 begin, ui32 end);
+
+	private:
+		struct Range
+		{
+			ui32 m_begin;
+			ui32 m_end;
+		};
+
+	private:
+		bool						m_isStructureDirty = true;
+		bool						m_isDirty = false;
+		vector<Node*>::type			m_nodes;
+		vector<i32>::type			m_parents;
+		vector<ui32>::type			m_firstChilds;
+		vector<ui32>::type			m_childCounts;
+		vector<Transform>::type		m_locals;
+		vector<Transform>::type		m_worlds;
+		vector<ui8>::type			m_dirtys;
+		vector<ui32>::type			m_levelStarts;
+		vector<Range>::type			m_dirtyRanges;
+	};
+}
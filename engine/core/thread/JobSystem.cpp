@@ -0,0 +1,309 @@
+#include "JobSystem.h"
+#include <algorithm>
+
+namespace Echo
+{
+	// index of current thread, 0 for the main thread
+	static thread_local ui32 g_threadIdx = 0;
+
+	// failed steal rounds before an idle worker sleeps
+	static const i32 SpinRounds = 64;
+
+	JobSystem* JobSystem::instance()
+	{
+		static JobSystem inst;
+		return &inst;
+	}
+
+	JobSystem::JobSystem()
+		: m_pendingJobs(0)
+#ifndef ECHO_PLATFORM_HTML5
+		, m_sleepingWorkers(0)
+#endif
+	{
+		// leave one core to the main thread
+		ui32 workerCount = 0;
+#ifndef ECHO_PLATFORM_HTML5
+		ui32 hardwareThreads = std::thread::hardware_concurrency();
+		workerCount = hardwareThreads > 1 ? std::min<ui32>(hardwareThreads - 1, 15) : 0;
+#endif
+
+		for (ui32 i = 0; i < workerCount + 1; i++)
+		{
+			m_queues.emplace_back(EchoNew(JobQueue));
+		}
+
+#ifndef ECHO_PLATFORM_HTML5
+		for (ui32 i = 0; i < workerCount; i++)
+		{
+			m_workers.emplace_back(&JobSystem::workerMain, this, i + 1);
+		}
+#endif
+	}
+
+	JobSystem::~JobSystem()
+	{
+#ifndef ECHO_PLATFORM_HTML5
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_quit = true;
+		}
+		m_sleepCondition.notify_all();
+
+		for (std::thread& worker : m_workers)
+		{
+			worker.join();
+		}
+		m_workers.clear();
+#endif
+
+		EchoSafeDeleteContainer(m_queues, JobQueue);
+	}
+
+	ui32 JobSystem::getThreadCount() const
+	{
+		return ui32(m_queues.size());
+	}
+
+	ui32 JobSystem::getThreadIdx() const
+	{
+		return g_threadIdx;
+	}
+
+	void JobSystem::run(const JobFunc& func, JobCounter* counter)
+	{
+		if (counter)
+			counter->m_value++;
+
+		push({ func, counter });
+	}
+
+	void JobSystem::run(const JobFunc& func, JobCounter* counter, JobCounter& dependency)
+	{
+		if (counter)
+			counter->m_value++;
+
+		// the counter drains its dependents under the same lock after reaching zero
+		{
+			EE_LOCK_MUTEX(dependency.m_mutex);
+			if (dependency.m_value.load() > 0)
+			{
+				dependency.m_dependents.emplace_back([this, func, counter]() { push({ func, counter }); });
+				return;
+			}
+		}
+
+		push({ func, counter });
+	}
+
+	void JobSystem::runBackground(const JobFunc& func)
+	{
+#ifndef ECHO_PLATFORM_HTML5
+		if (!m_workers.empty())
+		{
+			{
+				EE_LOCK_MUTEX(m_backgroundQueue.m_mutex);
+				m_backgroundQueue.m_jobs.push_back({ func, nullptr });
+			}
+
+			m_pendingJobs++;
+			if (m_sleepingWorkers.load() > 0)
+			{
+				std::unique_lock<std::mutex> lock(m_sleepMutex);
+				m_sleepCondition.notify_one();
+			}
+
+			return;
+		}
+#endif
+
+		// nobody else would take it, run now
+		Job job = { func, nullptr };
+		execute(job);
+	}
+
+	void JobSystem::wait(JobCounter& counter)
+	{
+		ui32 threadIdx = g_threadIdx;
+		while (counter.m_value.load() > 0)
+		{
+			Job job;
+			if (pop(threadIdx, job))
+			{
+				execute(job);
+			}
+			else
+			{
+#ifndef ECHO_PLATFORM_HTML5
+				std::this_thread::yield();
+#endif
+			}
+		}
+
+		// the last job releases the lock after reaching zero, then the counter may be destroyed
+		EE_LOCK_MUTEX(counter.m_mutex);
+	}
+
+	void JobSystem::parallelFor(ui32 count, ui32 grain, const RangeFunc& func)
+	{
+		if (!count)
+			return;
+
+		grain = std::max<ui32>(grain, 1);
+
+		ui32 chunkCount = (count + grain - 1) / grain;
+		if (chunkCount == 1 || getThreadCount() == 1)
+		{
+			func(0, count, g_threadIdx);
+			return;
+		}
+
+		// one job per thread, each takes chunks until the range is used up
+		std::atomic<ui32> nextChunk(0);
+		auto body = [&]()
+		{
+			ui32 threadIdx = g_threadIdx;
+			while (true)
+			{
+				ui32 chunk = nextChunk.fetch_add(1);
+				if (chunk >= chunkCount)
+					break;
+
+				ui32 begin = chunk * grain;
+				func(begin, std::min<ui32>(begin + grain, count), threadIdx);
+			}
+		};
+
+		JobCounter counter;
+		ui32 jobCount = std::min<ui32>(chunkCount, getThreadCount()) - 1;
+		for (ui32 i = 0; i < jobCount; i++)
+		{
+			run(body, &counter);
+		}
+
+		body();
+		wait(counter);
+	}
+
+	void JobSystem::push(Job&& job)
+	{
+#ifdef ECHO_PLATFORM_HTML5
+		// no workers, run now
+		execute(job);
+#else
+		JobQueue* queue = m_queues[g_threadIdx];
+		{
+			EE_LOCK_MUTEX(queue->m_mutex);
+			queue->m_jobs.emplace_back(std::move(job));
+		}
+
+		m_pendingJobs++;
+		if (m_sleepingWorkers.load() > 0)
+		{
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_sleepCondition.notify_one();
+		}
+#endif
+	}
+
+	bool JobSystem::pop(ui32 threadIdx, Job& job, bool isBackgroundAllowed)
+	{
+		// own deque, newest first
+		{
+			JobQueue* queue = m_queues[threadIdx];
+			EE_LOCK_MUTEX(queue->m_mutex);
+			if (!queue->m_jobs.empty())
+			{
+				job = std::move(queue->m_jobs.back());
+				queue->m_jobs.pop_back();
+				m_pendingJobs--;
+				return true;
+			}
+		}
+
+		// steal oldest from others
+		ui32 queueCount = ui32(m_queues.size());
+		for (ui32 i = 1; i < queueCount; i++)
+		{
+			JobQueue* queue = m_queues[(threadIdx + i) % queueCount];
+			EE_LOCK_MUTEX(queue->m_mutex);
+			if (!queue->m_jobs.empty())
+			{
+				job = std::move(queue->m_jobs.front());
+				queue->m_jobs.pop_front();
+				m_pendingJobs--;
+				return true;
+			}
+		}
+
+		// background jobs, oldest first
+		if (isBackgroundAllowed)
+		{
+			EE_LOCK_MUTEX(m_backgroundQueue.m_mutex);
+			if (!m_backgroundQueue.m_jobs.empty())
+			{
+				job = std::move(m_backgroundQueue.m_jobs.front());
+				m_backgroundQueue.m_jobs.pop_front();
+				m_pendingJobs--;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void JobSystem::execute(Job& job)
+	{
+		job.m_func();
+
+		// decrement under lock, run() checks the value under the same lock before adding a dependent
+		JobCounter* counter = job.m_counter;
+		if (counter)
+		{
+			vector<JobFunc>::type dependents;
+			{
+				EE_LOCK_MUTEX(counter->m_mutex);
+				if (--counter->m_value == 0)
+					dependents.swap(counter->m_dependents);
+			}
+
+			for (JobFunc& dependent : dependents)
+				dependent();
+		}
+	}
+
+	void JobSystem::workerMain(ui32 threadIdx)
+	{
+#ifndef ECHO_PLATFORM_HTML5
+		g_threadIdx = threadIdx;
+
+		i32 idleRounds = 0;
+		while (true)
+		{
+			Job job;
+			if (pop(threadIdx, job, true))
+			{
+				execute(job);
+				idleRounds = 0;
+				continue;
+			}
+
+			if (++idleRounds < SpinRounds)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			// sleep until a job is pushed
+			std::unique_lock<std::mutex> lock(m_sleepMutex);
+			m_sleepingWorkers++;
+			m_sleepCondition.wait(lock, [this]() { return m_quit || m_pendingJobs.load() > 0; });
+			m_sleepingWorkers--;
+			idleRounds = 0;
+
+			if (m_quit)
+				return;
+		}
+#endif
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <functional>
+#include "Threading.h"
+#include "engine/core/memory/MemAllocDef.h"
+#include <atomic>
+
+namespace Echo
+{
+	// Counts unfinished jobs of a group. Jobs can be held back until a counter reaches zero.
+	class JobCounter
+	{
+		friend class JobSystem;
+
+	public:
+		JobCounter() : m_value(0) {}
+		~JobCounter() {}
+
+		// all counted jobs finished, use JobSystem::wait before destroying the counter
+		bool isDone() const { return m_value.load() == 0; }
+
+	private:
+		std::atomic<i32>						m_value;
+		Mutex									m_mutex;
+		vector<std::function<void()>>::type		m_dependents;
+	};
+
+	// Work stealing job system. Every thread owns a deque, it pushes and pops at the back,
+	// idle threads steal from the front of other deques. Thread index 0 is the main thread,
+	// waiting threads run other jobs until their counter reaches zero.
+	// Background jobs (file reads, decoding) share one low priority queue, only idle workers take
+	// them and wait() never does, so a frame waiting on its own jobs isn't held up by slow I/O.
+	// Jobs and waits are issued from the main thread or from inside jobs.
+	class JobSystem
+	{
+	public:
+		// job function
+		typedef std::function<void()> JobFunc;
+
+		// range function, called with [begin, end) and the index of the executing thread
+		typedef std::function<void(ui32 begin, ui32 end, ui32 threadIdx)> RangeFunc;
+
+	public:
+		static JobSystem* instance();
+
+		// thread count, include the main thread
+		ui32 getThreadCount() const;
+
+		// index of the current thread
+		ui32 getThreadIdx() const;
+
+		// run job, counter (optional) is incremented now and decremented when the job finished
+		void run(const JobFunc& func, JobCounter* counter = nullptr);
+
+		// run job once dependency reaches zero
+		void run(const JobFunc& func, JobCounter* counter, JobCounter& dependency);
+
+		// run fire and forget job on the background queue
+		void runBackground(const JobFunc& func);
+
+		// wait until counter reaches zero, run other jobs in the meantime
+		void wait(JobCounter& counter);
+
+		// split [0, count) into chunks of grain size, and run them on all threads, returns when finished
+		void parallelFor(ui32 count, ui32 grain, const RangeFunc& func);
+
+	private:
+		JobSystem();
+		~JobSystem();
+
+		// job
+		struct Job
+		{
+			JobFunc		m_func;
+			JobCounter*	m_counter;
+		};
+
+		// per thread deque
+		struct JobQueue
+		{
+			Mutex				m_mutex;
+			deque<Job>::type	m_jobs;
+		};
+
+		// push job to current thread's deque
+		void push(Job&& job);
+
+		// pop from own deque, or steal from others, then background queue if allowed
+		bool pop(ui32 threadIdx, Job& job, bool isBackgroundAllowed = false);
+
+		// execute job and release its dependents
+		void execute(Job& job);
+
+		// worker thread main loop
+		void workerMain(ui32 threadIdx);
+
+	private:
+		vector<JobQueue*>::type		m_queues;
+		JobQueue					m_backgroundQueue;
+		std::atomic<i32>			m_pendingJobs;
+#ifndef ECHO_PLATFORM_HTML5
+		vector<std::thread>::type	m_workers;
+		std::mutex					m_sleepMutex;
+		std::condition_variable		m_sleepCondition;
+		std::atomic<i32>			m_sleepingWorkers;
+		bool						m_quit = false;
+#endif
+	};
+}
@@ -1,111 +0,0 @@
-#pragma once
-
-#include <thread>
-#include <engine/core/util/Array.hpp>
-
-namespace Echo
-{
-	/**
-	 * CPU̳߳ʵ
-	 */
-	class CpuThreadPool
-	{
-	public:
-		// Ϣ
-		struct Cinfo
-		{
-			ui32		m_numThreads;		// ߳
-			bool		m_isBlocking;		// ִйʱǷ߳
-
-			// 캯
-			Cinfo()
-			{
-				m_numThreads = 0;
-				m_isBlocking = true;
-			}
-		};
-
-		// ̳߳ؿʼ״̬
-		enum StartThreadsMode
-		{
-			STM_OnConstruction,		// 
-			STM_Manually,			// ֶstartThreads
-		};
-
-		/**
-		* Job Base type for all jobs
-		*/
-		class Job
-		{
-		public:
-			Job(){}
-			virtual ~Job(){}
-
-			// 
-			virtual bool process() = 0;
-
-			// ɺ(߳)
-			virtual bool onFinished() { return true; }
-
-			// ȡ
-			virtual int getType() = 0;
-		};
-
-
-		// Ϣ
-		struct JobInfo
-		{
-			Job*	m_job;
-		};
-
-		// ߳״̬
-		struct ThreadData
-		{
-			CpuThreadPool*			m_threadPool;		// Ӧ̳߳
-			int						m_threadId;			// ߳Id (0-N)
-			std::thread				m_thread;			// ߳
-			//scl::semaphore			m_semaphore;		// źͣ߳
-			//scl::ring_buffer		m_buffer;			// 
-			bool					m_killThread;		// λ̱߳ҪرʱΪtrue
-
-			// 캯
-			ThreadData()
-				: m_threadPool( NULL)
-			{
-				//m_semaphore.create();
-			}
-		};
-
-	public:
-		CpuThreadPool(const Cinfo& info, StartThreadsMode mode=STM_OnConstruction);
-		virtual ~CpuThreadPool();
-
-		// ߳,ֻеʱSTM_Manually²ſԵô˺
-		void startThreads(const Cinfo& info);
-
-		// ()
-		void processJobs(Job** jobs, int numOfJobs);
-
-		// ȴ(Ҫ߳Ϊģʽ)
-		void waitForComplete( int type);
-
-		// ȡʹõ߳
-		int getNumThreads() const;
-
-		// ֹ
-		void stop();
-
-	protected:
-		// ߳ں
-		static void threadMainForwarder(ThreadData& threadData);
-
-		// ߳
-		void threadMain(int threadIndex);
-
-	private:
-		Cinfo						m_info;								// ǰ߳
-		array<ThreadData, 32>		m_workerThreads;					// ߳
-		//array<scl::semaphore, 24>	m_semaphores;						// ź̵߳ȴ
-		//array<int, 24>				m_numOfJobsProcessed;				// ̴߳Ӧ
-	};
-}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "engine/core/base/echo_def.h"
+#include "engine/core/memory/MemAllocDef.h"
+
+namespace Echo
+{
+	// Generational slot array, a handle packs slot index (low bits) and generation (high bits).
+	// Lookup is O(1), a stale handle of a removed object resolves to nullptr.
+	// Objects are also kept dense for iteration, removal swaps the last one in.
+	template<typename T>
+	class HandleTable
+	{
+	public:
+		typedef ui32 Handle;
+
+		static constexpr ui32 IndexBits = 20;
+		static constexpr ui32 IndexMask = (1 << IndexBits) - 1;
+		static constexpr ui32 GenerationMask = (1 << (32 - IndexBits)) - 1;
+		static constexpr Handle InvalidHandle = 0;
+
+	public:
+		HandleTable() {}
+		~HandleTable() {}
+
+		// add object, returns its handle
+		Handle add(T* obj)
+		{
+			ui32 index;
+			if (!m_frees.empty())
+			{
+				index = m_frees.back();
+				m_frees.pop_back();
+			}
+			else
+			{
+				index = static_cast<ui32>(m_slots.size());
+				m_slots.emplace_back();
+			}
+
+			Slot& slot = m_slots[index];
+			slot.m_obj = obj;
+			slot.m_denseIdx = static_cast<ui32>(m_dense.size());
+
+			m_dense.emplace_back(obj);
+			m_denseSlots.emplace_back(index);
+
+			return makeHandle(index, slot.m_generation);
+		}
+
+		// remove object, the handle becomes stale
+		bool remove(Handle handle)
+		{
+			ui32 index = handle & IndexMask;
+			if (!isValid(handle))
+				return false;
+
+			Slot& slot = m_slots[index];
+
+			// keep dense array packed
+			ui32 lastDenseIdx = static_cast<ui32>(m_dense.size() - 1);
+			if (slot.m_denseIdx != lastDenseIdx)
+			{
+				m_dense[slot.m_denseIdx] = m_dense[lastDenseIdx];
+				m_denseSlots[slot.m_denseIdx] = m_denseSlots[lastDenseIdx];
+				m_slots[m_denseSlots[slot.m_denseIdx]].m_denseIdx = slot.m_denseIdx;
+			}
+			m_dense.pop_back();
+			m_denseSlots.pop_back();
+
+			// generation 0 is never used, so handle 0 stays invalid
+			slot.m_obj = nullptr;
+			slot.m_generation = (slot.m_generation + 1) & GenerationMask;
+			if (slot.m_generation == 0)
+				slot.m_generation = 1;
+
+			m_frees.emplace_back(index);
+
+			return true;
+		}
+
+		// is valid
+		bool isValid(Handle handle) const
+		{
+			ui32 index = handle & IndexMask;
+			return index < m_slots.size() && m_slots[index].m_obj && m_slots[index].m_generation == (handle >> IndexBits);
+		}
+
+		// get object by handle
+		T* get(Handle handle) const
+		{
+			ui32 index = handle & IndexMask;
+			if (index < m_slots.size())
+			{
+				const Slot& slot = m_slots[index];
+				if (slot.m_generation == (handle >> IndexBits))
+					return slot.m_obj;
+			}
+
+			return nullptr;
+		}
+
+		// dense objects
+		const typename vector<T*>::type& getObjects() const { return m_dense; }
+		size_t size() const { return m_dense.size(); }
+		bool empty() const { return m_dense.empty(); }
+
+		// clear
+		void clear()
+		{
+			m_slots.clear();
+			m_frees.clear();
+			m_dense.clear();
+			m_denseSlots.clear();
+		}
+
+	private:
+		// make handle
+		static Handle makeHandle(ui32 index, ui32 generation) { return (generation << IndexBits) | index; }
+
+	private:
+		struct Slot
+		{
+			T*		m_obj = nullptr;
+			ui32	m_generation = 1;
+			ui32	m_denseIdx = 0;
+		};
+
+		typename vector<Slot>::type	m_slots;
+		vector<ui32>::type			m_frees;
+		typename vector<T*>::type	m_dense;
+		vector<ui32>::type			m_denseSlots;
+	};
+}
@@ -1,51 +1,167 @@
 #include "anim_curve.h"
 #include "engine/core/math/Function.h"
 #include "engine/core/log/Log.h"
+#include <algorithm>
+
+#ifdef ECHO_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
 
 namespace Echo
 {
 	// get value
 	float AnimCurve::getValue(ui32 time)
 	{
-		if (m_keys.empty())
+		Cursor cursor;
+		return getValue(time, cursor);
+	}
+
+	float AnimCurve::getValue(ui32 time, Cursor& cursor)
+	{
+		float v0, v1, ratio;
+		getSegment(time, cursor, v0, v1, ratio);
+
+		return v0 * (1.f - ratio) + v1 * ratio;
+	}
+
+	void AnimCurve::bake()
+	{
+		m_bakedTimes.clear();
+		m_bakedValues.clear();
+		m_bakedTimes.reserve(m_keys.size());
+		m_bakedValues.reserve(m_keys.size());
+		for (const auto& it : m_keys)
 		{
-			return 0.f;
+			m_bakedTimes.emplace_back(it.first);
+			m_bakedValues.emplace_back(it.second);
 		}
 
-		if (m_keys.size() == 1)
+		m_isBakeDirty = false;
+		m_isFixedRate = false;
+
+		// resample from the edit keys, lookup becomes a division
+		if (m_sampleInterval && m_type == InterpolationType::Linear && m_keys.size() > 2)
 		{
-			return m_keys.begin()->second;
+			ui32 startTime = getStartTime();
+			ui32 endTime = getEndTime();
+			ui32 sampleCount = (endTime - startTime) / m_sampleInterval + 1;
+
+			vector<ui32>::type times;
+			vector<float>::type values;
+			times.reserve(sampleCount + 1);
+			values.reserve(sampleCount + 1);
+
+			Cursor cursor;
+			for (ui32 i = 0; i < sampleCount; i++)
+			{
+				ui32 time = startTime + i * m_sampleInterval;
+				times.emplace_back(time);
+				values.emplace_back(getValue(time, cursor));
+			}
+
+			if (times.back() != endTime)
+			{
+				times.emplace_back(endTime);
+				values.emplace_back(m_keys.rbegin()->second);
+			}
+
+			m_bakedTimes.swap(times);
+			m_bakedValues.swap(values);
+			m_isFixedRate = true;
 		}
+	}
 
-		// get base key and next key
-		KeyMap::iterator curKey = m_keys.begin();
-		KeyMap::iterator nextKey = ++m_keys.begin();
-		KeyMap::iterator lastKey = --m_keys.end();
-		for ( ; nextKey !=lastKey; curKey++, nextKey++)
+	void AnimCurve::getSegment(ui32 time, Cursor& cursor, float& v0, float& v1, float& ratio)
+	{
+		if (m_isBakeDirty)
+			bake();
+
+		ratio = 0.f;
+		if (m_bakedTimes.empty())
 		{
-			if (time >= curKey->first && time < nextKey->first)
-				break;
+			v0 = v1 = 0.f;
+			return;
 		}
 
-		// calculate
-		switch (m_type)
+		if (m_bakedTimes.size() == 1)
 		{
-		case InterpolationType::Linear:
+			v0 = v1 = m_bakedValues[0];
+			return;
+		}
+
+		// find key, keys [0, lastKey) start a segment
+		i32 lastKey = i32(m_bakedTimes.size()) - 1;
+		i32 key = cursor.m_key;
+		if (m_isFixedRate)
 		{
-			float ratio = Math::Clamp(float(time - curKey->first) / float(nextKey->first - curKey->first), 0.f, 1.f);
-			return curKey->second * (1.f - ratio) + nextKey->second * ratio;
+			key = time > m_bakedTimes[0] ? i32((time - m_bakedTimes[0]) / m_sampleInterval) : 0;
 		}
-		case InterpolationType::Discrete:
+		else if (key < lastKey && time >= m_bakedTimes[key])
 		{
-			return curKey->second;
+			// monotonic playback moves a few keys at most
+			i32 steps = 0;
+			while (key < lastKey - 1 && time >= m_bakedTimes[key + 1] && steps < 4)
+			{
+				key++;
+				steps++;
+			}
+
+			if (steps == 4 && time >= m_bakedTimes[key + 1])
+				key = i32(std::upper_bound(m_bakedTimes.begin(), m_bakedTimes.end(), time) - m_bakedTimes.begin()) - 1;
 		}
-		break;
-		default:
+		else
 		{
-			EchoLogError("AnimCure::Discrete not support yet");
-			return 0.f;
+			key = i32(std::upper_bound(m_bakedTimes.begin(), m_bakedTimes.end(), time) - m_bakedTimes.begin()) - 1;
 		}
-		break;
+
+		key = Math::Clamp(key, 0, lastKey - 1);
+		cursor.m_key = key;
+
+		// calculate
+		ui32 time0 = m_bakedTimes[key];
+		ui32 time1 = m_bakedTimes[key + 1];
+		v0 = m_bakedValues[key];
+		v1 = m_bakedValues[key + 1];
+		switch (m_type)
+		{
+		case InterpolationType::Linear:
+			ratio = time > time0 ? Math::Clamp(float(time - time0) / float(time1 - time0), 0.f, 1.f) : 0.f;
+			break;
+		case InterpolationType::Discrete:
+			ratio = time >= time1 ? 1.f : 0.f;
+			break;
+		default:
+			EchoLogError("AnimCurve interpolation type not support yet");
+			v0 = v1 = 0.f;
+			break;
+		}
+	}
+
+	void AnimCurve::sample(AnimCurve* const* curves, Cursor* cursors, i32 count, ui32 time, float* values)
+	{
+		// find segments one curve by one, blend four curves at once
+		for (i32 base = 0; base < count; base += 4)
+		{
+			alignas(16) float v0[4] = { 0.f, 0.f, 0.f, 0.f };
+			alignas(16) float v1[4] = { 0.f, 0.f, 0.f, 0.f };
+			alignas(16) float ratio[4] = { 0.f, 0.f, 0.f, 0.f };
+			alignas(16) float result[4];
+
+			i32 num = std::min<i32>(4, count - base);
+			for (i32 i = 0; i < num; i++)
+				curves[base + i]->getSegment(time, cursors[base + i], v0[i], v1[i], ratio[i]);
+
+#ifdef ECHO_SIMD_SSE
+			__m128 r = _mm_load_ps(ratio);
+			__m128 a = _mm_mul_ps(_mm_load_ps(v0), _mm_sub_ps(_mm_set1_ps(1.f), r));
+			_mm_store_ps(result, _mm_add_ps(a, _mm_mul_ps(_mm_load_ps(v1), r)));
+#else
+			for (i32 i = 0; i < 4; i++)
+				result[i] = v0[i] * (1.f - ratio[i]) + v1[i] * ratio[i];
+#endif
+
+			for (i32 i = 0; i < num; i++)
+				values[base + i] = result[i];
 		}
 	}
 
@@ -61,6 +177,7 @@ namespace Echo
 			}
 
 			it->second = value;
+			m_isBakeDirty = true;
 		}
 	}
 
@@ -8,21 +8,27 @@ namespace Echo
 	{
 		typedef map<ui32, float>::type KeyMap;
 
+		// cached key of a player, monotonic playback finds the next key in O(1)
+		struct Cursor
+		{
+			i32		m_key = 0;
+		};
+
 		String					m_name;
 		enum class InterpolationType
 		{
 			Linear,
 			Discrete,
 		}		m_type = InterpolationType::Linear;
-		KeyMap	m_keys;
+		KeyMap	m_keys;							// edit keys, modify by methods so the baked arrays stay in sync
 
 		AnimCurve() {}
 
 		// set type
-		void setType(InterpolationType type) { m_type = type;}
+		void setType(InterpolationType type) { m_type = type; m_isBakeDirty = true; }
 
 		// add key
-		void addKey(ui32 time, float value) { m_keys[time] = value; }
+		void addKey(ui32 time, float value) { m_keys[time] = value; m_isBakeDirty = true; }
 
 		// set key value
 		void setValue(ui32 time, float value) { addKey(time, value); }
@@ -33,6 +39,7 @@ namespace Echo
 
 		// get value
 		float getValue(ui32 time);
+		float getValue(ui32 time, Cursor& cursor);
 		float getValueByKeyIdx(i32 index);
 
 		// get key time by idx
@@ -43,7 +50,29 @@ namespace Echo
 		ui32 getStartTime();
 		ui32 getEndTime();
 
+		// resample linear curves at a fixed interval (ms) when baking, 0 keeps the edit keys
+		void setSampleInterval(ui32 interval) { m_sampleInterval = interval; m_isBakeDirty = true; }
+		ui32 getSampleInterval() const { return m_sampleInterval; }
+
+		// bake keys into sorted arrays
+		void bake();
+
 		// optimize
 		float optimize();
+
+	public:
+		// sample curves at the same time, cursors has one per curve
+		static void sample(AnimCurve* const* curves, Cursor* cursors, i32 count, ui32 time, float* values);
+
+	private:
+		// segment holding time, value = v0 * (1 - ratio) + v1 * ratio
+		void getSegment(ui32 time, Cursor& cursor, float& v0, float& v1, float& ratio);
+
+	private:
+		vector<ui32>::type		m_bakedTimes;
+		vector<float>::type		m_bakedValues;
+		ui32					m_sampleInterval = 0;
+		bool					m_isFixedRate = false;
+		bool					m_isBakeDirty = true;
 	};
-}
\ No newline at end of file
+}
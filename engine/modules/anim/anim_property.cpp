@@ -34,6 +34,8 @@ namespace Echo
 		{
 			m_curves.emplace_back(EchoNew(AnimCurve));
 		}
+
+		m_cursors.resize(curveCount);
 	}
     
     AnimPropertyCurve::~AnimPropertyCurve()
@@ -80,6 +82,11 @@ namespace Echo
 		m_curves[curveIdx]->addKey(time, value);
 	}
 
+	void AnimPropertyCurve::sampleCurves(ui32 time, float* values)
+	{
+		AnimCurve::sample(m_curves.data(), m_cursors.data(), i32(m_curves.size()), time, values);
+	}
+
 	AnimPropertyFloat::AnimPropertyFloat()
 		: AnimPropertyCurve(Type::Float, 1)
 	{}
@@ -92,8 +99,7 @@ namespace Echo
 
 	void AnimPropertyFloat::updateToTime(ui32 time, ui32 deltaTime)
 	{
-		for (size_t i = 0; i < m_curves.size(); i++)
-			m_value = m_curves[i]->getValue(time);
+		sampleCurves(time, &m_value);
 	}
 
 	AnimPropertyVec3::AnimPropertyVec3()
@@ -108,8 +114,7 @@ namespace Echo
 
 	void AnimPropertyVec3::updateToTime(ui32 time, ui32 deltaTime)
 	{
-		for (int i = 0; i < int(m_curves.size()); i++)
-			m_value[i] = m_curves[i]->getValue(time);
+		sampleCurves(time, &m_value.x);
 	}
 
 	AnimPropertyVec4::AnimPropertyVec4() 
@@ -124,8 +129,7 @@ namespace Echo
 
 	void AnimPropertyVec4::updateToTime(ui32 time, ui32 deltaTime)
 	{
-		for (int i = 0; i < int(m_curves.size()); i++)
-			m_value[i] = m_curves[i]->getValue(time);
+		sampleCurves(time, &m_value.x);
 	}
 
 	void AnimPropertyBool::addKey(ui32 time, bool value)
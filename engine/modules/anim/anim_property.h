@@ -51,7 +51,8 @@ namespace Echo
 
 	struct AnimPropertyCurve : public AnimProperty
 	{
-		vector<AnimCurve*>::type m_curves;
+		vector<AnimCurve*>::type			m_curves;
+		vector<AnimCurve::Cursor>::type		m_cursors;		// playback cursor of each curve
 
 		AnimPropertyCurve(Type type, i32 curveCount);
         virtual ~AnimPropertyCurve();
@@ -73,6 +74,9 @@ namespace Echo
 
 		// add key
 		void addKeyToCurve(int curveIdx, ui32 time, float value);
+
+		// sample all curves to values
+		void sampleCurves(ui32 time, float* values);
 	};
 
 	struct AnimPropertyFloat : public AnimPropertyCurve
@@ -50,6 +50,7 @@ namespace Echo
 			m_animations.addOption(clip->m_name);
 
 			m_isAnimDataDirty = true;
+			m_isBindingDirty = true;
 		}
 	}
 
@@ -88,6 +89,7 @@ namespace Echo
 				m_animations.removeOption(animName);
 
 				m_isAnimDataDirty = true;
+				m_isBindingDirty = true;
 
 				break;
 			}
@@ -100,6 +102,7 @@ namespace Echo
 		m_animations.m_options[idx] = newName;
 
 		m_isAnimDataDirty = true;
+		m_isBindingDirty = true;
 	}
 
 	void Timeline::updateInternal(float elapsedTime)
@@ -222,6 +225,7 @@ namespace Echo
 		// clear
 		EchoSafeDeleteContainer(m_clips, AnimClip);
 		m_animData = data;
+		m_isBindingDirty = true;
 
 		// parse clips
 		pugi::xml_document doc; 
@@ -339,6 +343,7 @@ namespace Echo
 			clip->m_objects.emplace_back(animNode);
 
 			m_isAnimDataDirty = true;
+			m_isBindingDirty = true;
 		}
 	}
 
@@ -382,6 +387,7 @@ namespace Echo
 					{
 						animObject->addProperty(propertyName, propertyType);
 						m_isAnimDataDirty = true;
+						m_isBindingDirty = true;
 
 						return true;
 					}
@@ -426,6 +432,7 @@ namespace Echo
 
 		// dirty flag
 		m_isAnimDataDirty = true;
+		m_isBindingDirty = true;
 	}
 
 	void Timeline::setKey(const String& animName, const String& objectPath, const String& propertyName, int curveIdx, int keyIdx, float value)
@@ -455,51 +462,127 @@ namespace Echo
 		}
 	}
 
+	Echo::Node* Timeline::getBindRoot(i32 levels)
+	{
+		Echo::Node* root = this;
+		while (root->getParent() && (levels < 0 || levels-- > 0))
+			root = root->getParent();
+
+		return root;
+	}
+
+	void Timeline::bindClip(AnimClip* clip)
+	{
+		m_bindings.clear();
+		m_boundRootLevels = 0;
+
+		for (AnimObject* animNode : clip->m_objects)
+		{
+			const ObjectUserData& objUserData = any_cast<ObjectUserData>(animNode->m_userData);
+
+			// every "../" may climb a level, absolute paths start at the tree root
+			const String& path = objUserData.m_path;
+			if (!path.empty() && path[0] == '/')
+			{
+				m_boundRootLevels = -1;
+			}
+			else if (m_boundRootLevels >= 0)
+			{
+				i32 levels = 0;
+				for (size_t pos = path.find("../"); pos != String::npos; pos = path.find("../", pos + 3))
+					levels++;
+
+				m_boundRootLevels = std::max<i32>(m_boundRootLevels, levels);
+			}
+
+			for (AnimProperty* property : animNode->m_properties)
+			{
+				AnimProperty::Type type = property->getType();
+				if (type != AnimProperty::Type::Bool && type != AnimProperty::Type::Vector3 && type != AnimProperty::Type::String)
+					continue;
+
+				const Echo::StringArray propertyChain = StringUtil::Split(property->m_name);
+				Echo::Object* object = getLastObject(objUserData.m_path.c_str(), propertyChain);
+				if (object)
+				{
+					PropertyBinding binding;
+					binding.m_property = property;
+					binding.m_object = object;
+					binding.m_objectId = object->getId();
+					binding.m_isChainObject = propertyChain.size() > 1;
+					binding.m_propertyName = propertyChain.back();
+					binding.m_info = Class::getProperty(object, binding.m_propertyName);
+					binding.m_variableType = binding.m_info ? binding.m_info->m_type : Variant::Type::Unknown;
+
+					// dynamic property infos belong to the object and may be rebuilt
+					if (binding.m_info && binding.m_info->m_infoType != PropertyInfo::Static)
+						binding.m_info = nullptr;
+
+					m_bindings.emplace_back(binding);
+				}
+			}
+		}
+
+		m_boundClip = clip;
+		m_boundRoot = getBindRoot(m_boundRootLevels);
+		m_boundTreeVersion = m_boundRoot->getTreeVersion();
+		m_isBindingDirty = false;
+	}
+
+	void Timeline::applyBinding(const PropertyBinding& binding, const Variant& value)
+	{
+		if (binding.m_info)
+			binding.m_info->setPropertyValue(binding.m_object, binding.m_propertyName, value);
+		else
+			Class::setPropertyValue(binding.m_object, binding.m_propertyName, value);
+	}
+
 	void Timeline::extractClipData(AnimClip* clip)
 	{
 		if (clip)
 		{
-			for (AnimObject* animNode : clip->m_objects)
+			// only changes under the node the paths resolve from can break bindings
+			Echo::Node* boundRoot = getBindRoot(m_boundRootLevels);
+			if (m_isBindingDirty || m_boundClip != clip || m_boundRoot != boundRoot || m_boundTreeVersion != boundRoot->getTreeVersion())
+				bindClip(clip);
+
+			for (const PropertyBinding& binding : m_bindings)
 			{
-				const ObjectUserData& objUserData = any_cast<ObjectUserData>(animNode->m_userData);
-				for (AnimProperty* property : animNode->m_properties)
+				if (binding.m_isChainObject && Object::getById(binding.m_objectId) != binding.m_object)
+				{
+					m_isBindingDirty = true;
+					continue;
+				}
+
+				switch (binding.m_property->getType())
+				{
+				case AnimProperty::Type::Bool:
+				{
+					AnimPropertyBool* boolProperty = ECHO_DOWN_CAST<AnimPropertyBool*>(binding.m_property);
+					if (boolProperty->isActive())
+						applyBinding(binding, boolProperty->getValue());
+				}
+				break;
+				case AnimProperty::Type::Vector3:
+				{
+					applyBinding(binding, ((AnimPropertyVec3*)binding.m_property)->getValue());
+				}
+				break;
+				case AnimProperty::Type::String:
 				{
-					const Echo::StringArray propertyChain = StringUtil::Split(property->m_name);
-					Echo::Object* node = getLastObject(objUserData.m_path.c_str(), propertyChain);
-					if (node)
+					if (binding.m_variableType == Variant::Type::String)
 					{
-						switch (property->getType())
-						{
-						case AnimProperty::Type::Bool:
-						{
-							AnimPropertyBool* boolProperty = ECHO_DOWN_CAST<AnimPropertyBool*>(property);
-							if (boolProperty->isActive())
-								Class::setPropertyValue(node, propertyChain.back(), boolProperty->getValue());
-						}
-						break;
-						case AnimProperty::Type::Vector3:
-						{
-							Class::setPropertyValue(node, propertyChain.back(), ((AnimPropertyVec3*)property)->getValue());
-						}
-						break;
-						case AnimProperty::Type::String:
-						{
-							Variant::Type vType = getAnimPropertyVariableType(objUserData.m_path.c_str(), propertyChain);
-							if (vType == Variant::Type::String)
-							{
-								Class::setPropertyValue(node, propertyChain.back(), ((AnimPropertyString*)property)->getValue());
-							}
-							else if (vType == Variant::Type::ResourcePath)
-							{
-								ResourcePath resPath = ((AnimPropertyString*)property)->getValue();
-								Class::setPropertyValue(node, propertyChain.back(), resPath);
-							}
-						}
-						break;
-						default: break;
-						}
+						applyBinding(binding, ((AnimPropertyString*)binding.m_property)->getValue());
+					}
+					else if (binding.m_variableType == Variant::Type::ResourcePath)
+					{
+						ResourcePath resPath = ((AnimPropertyString*)binding.m_property)->getValue();
+						applyBinding(binding, resPath);
 					}
 				}
+				break;
+				default: break;
+				}
 			}
 		}
 	}
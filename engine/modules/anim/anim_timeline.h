@@ -37,6 +37,18 @@ namespace Echo
 			{}
 		};
 
+		// property track resolved to its object, bound once and reused every frame
+		struct PropertyBinding
+		{
+			AnimProperty*	m_property = nullptr;
+			Object*			m_object = nullptr;
+			i32				m_objectId = 0;
+			bool			m_isChainObject = false;						// reached through a property chain, may die without a tree change
+			PropertyInfo*	m_info = nullptr;								// static property info, dynamic ones are looked up by name
+			String			m_propertyName;
+			Variant::Type	m_variableType = Variant::Type::Unknown;
+		};
+
 	public:
 		Timeline();
 		virtual ~Timeline();
@@ -123,6 +135,16 @@ namespace Echo
 		// get last object
 		Object* getLastObject(const String& objectPath, const StringArray& propertyChain);
 
+	private:
+		// bind clip properties to objects
+		void bindClip(AnimClip* clip);
+
+		// node all bound paths are resolved under, levels above this timeline, negative for the tree root
+		Echo::Node* getBindRoot(i32 levels);
+
+		// set property value by binding
+		void applyBinding(const PropertyBinding& binding, const Variant& value);
+
 	private:
 		PlayState				m_playState;
 		float					m_timeScale = 1.f;
@@ -130,5 +152,11 @@ namespace Echo
 		Base64String			m_animData;
 		bool					m_isAnimDataDirty = false;
 		StringOption			m_animations = StringOption("");
+		vector<PropertyBinding>::type	m_bindings;
+		AnimClip*				m_boundClip = nullptr;
+		Echo::Node*				m_boundRoot = nullptr;
+		i32						m_boundRootLevels = 0;
+		ui32					m_boundTreeVersion = 0;
+		bool					m_isBindingDirty = true;
 	};
 }
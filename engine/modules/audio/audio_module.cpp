@@ -11,7 +11,8 @@ namespace Echo
 
 	AudioModule::AudioModule()
 	{
-
+		// listener follows the 3d camera
+		setUpdateAccess(Access_Nodes, Access_Audio, false);
 	}
 
 	AudioModule::~AudioModule()
@@ -34,6 +34,9 @@ namespace Echo
         // contact listener
         m_contactListener = EchoNew(Box2DContactListener);
         m_b2World->SetContactListener(m_contactListener);
+
+        // contact signals call into scripts, so access stays exclusive
+        setUpdatePhase(UpdatePhase::Physics);
 	}
 
 	Box2DModule::~Box2DModule()
@@ -1,10 +1,12 @@
 #include "effect_module.h"
 #include "sprite.h"
+#include "sprite_batcher.h"
 #include "particle_system.h"
 #include "trail.h"
 #include "editor/sprite_editor.h"
 #include "editor/particle_system_editor.h"
 #include "editor/trail_editor.h"
+#include "engine/core/thread/JobSystem.h"
 
 namespace Echo
 {
@@ -35,4 +37,30 @@ namespace Echo
         CLASS_REGISTER_EDITOR(ParticleSystem, ParticleSystemEditor)
 		CLASS_REGISTER_EDITOR(Trail, TrailEditor)
 	}
+
+	void EffectModule::addParticleSystem(ParticleSystem* particleSystem)
+	{
+		m_particleSystems.emplace_back(particleSystem);
+	}
+
+	void EffectModule::removeParticleSystem(ParticleSystem* particleSystem)
+	{
+		m_particleSystems.erase(std::remove(m_particleSystems.begin(), m_particleSystems.end(), particleSystem), m_particleSystems.end());
+	}
+
+	void EffectModule::lateUpdate(float elapsedTime)
+	{
+		// systems are independent, each simulates and writes its own vertices on a job
+		JobSystem::instance()->parallelFor(ui32(m_particleSystems.size()), 1, [this](ui32 begin, ui32 end, ui32 threadIdx)
+		{
+			for (ui32 i = begin; i < end; i++)
+				m_particleSystems[i]->simulate();
+		});
+
+		// gpu buffers are only touched from the main thread
+		for (ParticleSystem* particleSystem : m_particleSystems)
+			particleSystem->submit();
+
+		SpriteBatcher::instance()->flush();
+	}
 }
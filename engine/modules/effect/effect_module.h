@@ -4,6 +4,7 @@
 
 namespace Echo
 {
+	class ParticleSystem;
 	class EffectModule : public Module
 	{
 		ECHO_SINGLETON_CLASS(EffectModule, Module)
@@ -16,5 +17,15 @@ namespace Echo
 
 		// register all types of the module
 		virtual void registerTypes() override;
+
+		// particle systems simulated each frame
+		void addParticleSystem(ParticleSystem* particleSystem);
+		void removeParticleSystem(ParticleSystem* particleSystem);
+
+		// simulate particle systems in parallel and upload their vertices, then draw the sprite batches
+		virtual void lateUpdate(float elapsedTime) override;
+
+	private:
+		vector<ParticleSystem*>::type	m_particleSystems;
 	};
 }
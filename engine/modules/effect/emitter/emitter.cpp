@@ -0,0 +1,70 @@
+#include "emitter.h"
+
+namespace Echo
+{
+    Emitter::Emitter()
+    {
+    }
+
+    Emitter::~Emitter()
+    {
+    }
+
+    float Emitter::random(float min, float max)
+    {
+        // xorshift32
+        m_seed ^= m_seed << 13;
+        m_seed ^= m_seed >> 17;
+        m_seed ^= m_seed << 5;
+
+        return min + (max - min) * float(m_seed >> 8) / float(1 << 24);
+    }
+
+    void Emitter::emit(ParticleData& data, float elapsedTime)
+    {
+        m_pending += m_rate * elapsedTime;
+
+        ui32 count = ui32(m_pending);
+        m_pending -= float(count);
+        if (count)
+        {
+            ui32 begin = data.spawn(count);
+            initialize(data, begin, data.getCount());
+        }
+    }
+
+    void Emitter::initialize(ParticleData& data, ui32 begin, ui32 end)
+    {
+        // a frame around direction to spread in
+        Vector3 side = std::abs(m_direction.y) < 0.99f ? m_direction.cross(Vector3::UNIT_Y) : m_direction.cross(Vector3::UNIT_X);
+        side.normalize();
+        Vector3 up = side.cross(m_direction);
+
+        float* vx = data.getStream(ParticleData::VelocityX);
+        float* vy = data.getStream(ParticleData::VelocityY);
+        float* vz = data.getStream(ParticleData::VelocityZ);
+        float* sizes = data.getStream(ParticleData::Size);
+        float* lifes = data.getStream(ParticleData::Life);
+        float* r = data.getStream(ParticleData::ColorR);
+        float* g = data.getStream(ParticleData::ColorG);
+        float* b = data.getStream(ParticleData::ColorB);
+        float* a = data.getStream(ParticleData::ColorA);
+        for (ui32 i = begin; i < end; i++)
+        {
+            float angle = random(0.f, m_spread);
+            float turn = random(0.f, Math::PI_2);
+            Vector3 direction = m_direction * std::cos(angle) + (side * std::cos(turn) + up * std::sin(turn)) * std::sin(angle);
+            Vector3 velocity = direction * random(m_minSpeed, m_maxSpeed);
+
+            vx[i] = velocity.x;
+            vy[i] = velocity.y;
+            vz[i] = velocity.z;
+            sizes[i] = random(m_minSize, m_maxSize);
+            lifes[i] = random(m_minLife, m_maxLife);
+            r[i] = m_color.r;
+            g[i] = m_color.g;
+            b[i] = m_color.b;
+            a[i] = m_color.a;
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../particle/particle.h"
+
+namespace Echo
+{
+    // Spawns particles at a rate and gives them their start attributes. Particles leave
+    // along direction, spread up to the spread angle around it.
+    class Emitter
+    {
+    public:
+        Emitter();
+        virtual ~Emitter();
+
+        // particles per second
+        float getRate() const { return m_rate; }
+        void setRate(float rate) { m_rate = std::max<float>(rate, 0.f); }
+
+        // life range (seconds)
+        void setLife(float minLife, float maxLife) { m_minLife = minLife; m_maxLife = maxLife; }
+
+        // speed range
+        void setSpeed(float minSpeed, float maxSpeed) { m_minSpeed = minSpeed; m_maxSpeed = maxSpeed; }
+
+        // size range
+        void setSize(float minSize, float maxSize) { m_minSize = minSize; m_maxSize = maxSize; }
+
+        // direction
+        void setDirection(const Vector3& direction) { m_direction = direction; m_direction.normalize(); }
+
+        // spread angle (radians)
+        void setSpread(float spread) { m_spread = spread; }
+
+        // start color
+        void setColor(const Color& color) { m_color = color; }
+
+        // spawn the particles due in elapsedTime
+        void emit(ParticleData& data, float elapsedTime);
+
+    protected:
+        // start attributes of particles [begin, end)
+        virtual void initialize(ParticleData& data, ui32 begin, ui32 end);
+
+        // random in [min, max), emitters run on jobs so each one keeps its own state
+        float random(float min, float max);
+
+    protected:
+        float       m_rate = 20.f;
+        float       m_pending = 0.f;
+        float       m_minLife = 1.f;
+        float       m_maxLife = 2.f;
+        float       m_minSpeed = 50.f;
+        float       m_maxSpeed = 100.f;
+        float       m_minSize = 16.f;
+        float       m_maxSize = 32.f;
+        Vector3     m_direction = Vector3::UNIT_Y;
+        float       m_spread = 0.5f;
+        Color       m_color = Color::WHITE;
+        ui32        m_seed = 0x9E3779B9;
+    };
+}
@@ -0,0 +1,57 @@
+#include "modifier.h"
+
+#ifdef ECHO_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace Echo
+{
+    void GravityModifier::apply(ParticleData& data, float elapsedTime)
+    {
+        ui32 padded = data.getPaddedCount();
+        for (i32 axis = 0; axis < 3; axis++)
+        {
+            float delta = m_acceleration[axis] * elapsedTime;
+            if (delta == 0.f)
+                continue;
+
+            float* velocities = data.getStream(ParticleData::Stream(ParticleData::VelocityX + axis));
+#ifdef ECHO_SIMD_SSE
+            __m128 d = _mm_set1_ps(delta);
+            for (ui32 i = 0; i < padded; i += 4)
+                _mm_storeu_ps(velocities + i, _mm_add_ps(_mm_loadu_ps(velocities + i), d));
+#else
+            for (ui32 i = 0; i < padded; i++)
+                velocities[i] += delta;
+#endif
+        }
+    }
+
+    void FadeModifier::apply(ParticleData& data, float elapsedTime)
+    {
+        float* alphas = data.getStream(ParticleData::ColorA);
+        const float* ages = data.getStream(ParticleData::Age);
+        const float* lifes = data.getStream(ParticleData::Life);
+        ui32 padded = data.getPaddedCount();
+        float range = m_endAlpha - m_startAlpha;
+
+        // padding lanes have no life, max keeps them off a division by zero
+#ifdef ECHO_SIMD_SSE
+        __m128 start = _mm_set1_ps(m_startAlpha);
+        __m128 delta = _mm_set1_ps(range);
+        __m128 minLife = _mm_set1_ps(1e-6f);
+        for (ui32 i = 0; i < padded; i += 4)
+        {
+            __m128 t = _mm_div_ps(_mm_loadu_ps(ages + i), _mm_max_ps(_mm_loadu_ps(lifes + i), minLife));
+            t = _mm_min_ps(t, _mm_set1_ps(1.f));
+            _mm_storeu_ps(alphas + i, _mm_add_ps(start, _mm_mul_ps(delta, t)));
+        }
+#else
+        for (ui32 i = 0; i < padded; i++)
+        {
+            float t = std::min<float>(ages[i] / std::max<float>(lifes[i], 1e-6f), 1.f);
+            alphas[i] = m_startAlpha + range * t;
+        }
+#endif
+    }
+}
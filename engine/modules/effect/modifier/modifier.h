@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../particle/particle.h"
+
+namespace Echo
+{
+    // A stage run over all particles of a group every tick, before they move
+    class Modifier
+    {
+    public:
+        Modifier() {}
+        virtual ~Modifier() {}
+
+        // apply
+        virtual void apply(ParticleData& data, float elapsedTime) = 0;
+    };
+
+    // Constant acceleration
+    class GravityModifier : public Modifier
+    {
+    public:
+        GravityModifier() {}
+        virtual ~GravityModifier() {}
+
+        // acceleration
+        const Vector3& getAcceleration() const { return m_acceleration; }
+        void setAcceleration(const Vector3& acceleration) { m_acceleration = acceleration; }
+
+        // apply
+        virtual void apply(ParticleData& data, float elapsedTime) override;
+
+    private:
+        Vector3     m_acceleration = Vector3(0.f, -98.f, 0.f);
+    };
+
+    // Alpha from start to end over the life of a particle
+    class FadeModifier : public Modifier
+    {
+    public:
+        FadeModifier() {}
+        virtual ~FadeModifier() {}
+
+        // alpha range
+        void setAlpha(float startAlpha, float endAlpha) { m_startAlpha = startAlpha; m_endAlpha = endAlpha; }
+
+        // apply
+        virtual void apply(ParticleData& data, float elapsedTime) override;
+
+    private:
+        float       m_startAlpha = 1.f;
+        float       m_endAlpha = 0.f;
+    };
+}
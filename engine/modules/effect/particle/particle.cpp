@@ -1,12 +1,97 @@
 #include "particle.h"
 
+#ifdef ECHO_SIMD_SSE
+#include <xmmintrin.h>
+#endif
+
 namespace Echo
 {
-    Particle::Particle()
+    ParticleData::ParticleData()
+    {
+    }
+
+    ParticleData::~ParticleData()
+    {
+    }
+
+    void ParticleData::setCapacity(ui32 capacity)
+    {
+        m_capacity = capacity;
+        m_count = std::min<ui32>(m_count, m_capacity);
+
+        ui32 padded = (m_capacity + 3) & ~3u;
+        for (vector<float>::type& stream : m_streams)
+            stream.resize(padded, 0.f);
+    }
+
+    ui32 ParticleData::spawn(ui32 count)
     {
+        ui32 first = m_count;
+        count = std::min<ui32>(count, m_capacity - m_count);
+        for (vector<float>::type& stream : m_streams)
+            std::fill(stream.begin() + first, stream.begin() + first + count, 0.f);
+
+        m_count += count;
+        return first;
+    }
+
+    void ParticleData::age(float elapsedTime)
+    {
+        float* ages = getStream(Age);
+        const float* lifes = getStream(Life);
+        ui32 padded = getPaddedCount();
+
+        // groups of four without a dead particle are the common case and skip the compaction test
+        ui32 firstDead = padded;
+#ifdef ECHO_SIMD_SSE
+        __m128 dt = _mm_set1_ps(elapsedTime);
+        for (ui32 i = 0; i < padded; i += 4)
+        {
+            __m128 a = _mm_add_ps(_mm_loadu_ps(ages + i), dt);
+            _mm_storeu_ps(ages + i, a);
+
+            if (firstDead == padded && _mm_movemask_ps(_mm_cmpge_ps(a, _mm_loadu_ps(lifes + i))))
+                firstDead = i;
+        }
+#else
+        for (ui32 i = 0; i < padded; i++)
+        {
+            ages[i] += elapsedTime;
+            if (firstDead == padded && ages[i] >= lifes[i])
+                firstDead = i & ~3u;
+        }
+#endif
+
+        for (ui32 i = firstDead; i < m_count;)
+        {
+            if (ages[i] >= lifes[i])
+            {
+                m_count--;
+                for (vector<float>::type& stream : m_streams)
+                    stream[i] = stream[m_count];
+            }
+            else
+            {
+                i++;
+            }
+        }
     }
 
-    Particle::~Particle()
+    void ParticleData::integrate(float elapsedTime)
     {
+        ui32 padded = getPaddedCount();
+        for (i32 axis = 0; axis < 3; axis++)
+        {
+            float* positions = getStream(Stream(PositionX + axis));
+            const float* velocities = getStream(Stream(VelocityX + axis));
+#ifdef ECHO_SIMD_SSE
+            __m128 dt = _mm_set1_ps(elapsedTime);
+            for (ui32 i = 0; i < padded; i += 4)
+                _mm_storeu_ps(positions + i, _mm_add_ps(_mm_loadu_ps(positions + i), _mm_mul_ps(_mm_loadu_ps(velocities + i), dt)));
+#else
+            for (ui32 i = 0; i < padded; i++)
+                positions[i] += velocities[i] * elapsedTime;
+#endif
+        }
     }
 }
@@ -4,17 +4,62 @@
 
 namespace Echo
 {
-    class Particle
+    // Particles of a group, one float stream per attribute. Streams are padded to a multiple
+    // of four so kernels step four particles at a time without a scalar tail.
+    class ParticleData
     {
     public:
-        Particle();
-        ~Particle();
-        
+        enum Stream
+        {
+            PositionX,
+            PositionY,
+            PositionZ,
+            VelocityX,
+            VelocityY,
+            VelocityZ,
+            ColorR,
+            ColorG,
+            ColorB,
+            ColorA,
+            Size,
+            Age,
+            Life,
+            StreamCount
+        };
+
+    public:
+        ParticleData();
+        ~ParticleData();
+
+        // alive particles
+        ui32 getCount() const { return m_count; }
+
+        // alive particles rounded up to four, the range kernels work on
+        ui32 getPaddedCount() const { return (m_count + 3) & ~3u; }
+
+        // max particles
+        ui32 getCapacity() const { return m_capacity; }
+        void setCapacity(ui32 capacity);
+
+        // stream
+        float* getStream(Stream stream) { return m_streams[stream].data(); }
+        const float* getStream(Stream stream) const { return m_streams[stream].data(); }
+
+        // add up to count particles at the end, returns the first new one. new particles are zero
+        ui32 spawn(ui32 count);
+
+        // age particles and remove the ones past their life, the last particle moves into each gap
+        void age(float elapsedTime);
+
+        // move particles by their velocity
+        void integrate(float elapsedTime);
+
+        // remove all particles
+        void clear() { m_count = 0; }
+
     private:
-        Vector3 m_position;
-        Vector3 m_velocity;
-        Color   m_color;
-        float   m_life;
+        ui32                    m_count = 0;
+        ui32                    m_capacity = 0;
+        vector<float>::type     m_streams[StreamCount];
     };
 }
-
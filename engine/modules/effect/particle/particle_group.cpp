@@ -8,10 +8,54 @@ namespace Echo
 
     ParticleGroup::~ParticleGroup()
     {
+        EchoSafeDeleteContainer(m_emitters, Emitter);
+        EchoSafeDeleteContainer(m_modifiers, Modifier);
     }
 
     void ParticleGroup::tick(float elapsedTime)
     {
-        
+        for (Emitter* emitter : m_emitters)
+            emitter->emit(m_data, elapsedTime);
+
+        for (Modifier* modifier : m_modifiers)
+            modifier->apply(m_data, elapsedTime);
+
+        m_data.integrate(elapsedTime);
+        m_data.age(elapsedTime);
+    }
+
+    void ParticleGroup::fillVertexData(MeshVertexData& vertexData) const
+    {
+        MeshVertexFormat define;
+        define.m_isUseVertexColor = true;
+        define.m_isUseUV = true;
+
+        ui32 count = m_data.getCount();
+        vertexData.set(define, count * 4);
+
+        const MeshVertexFormat& format = vertexData.getFormat();
+        const float* px = m_data.getStream(ParticleData::PositionX);
+        const float* py = m_data.getStream(ParticleData::PositionY);
+        const float* pz = m_data.getStream(ParticleData::PositionZ);
+        const float* sizes = m_data.getStream(ParticleData::Size);
+        const float* r = m_data.getStream(ParticleData::ColorR);
+        const float* g = m_data.getStream(ParticleData::ColorG);
+        const float* b = m_data.getStream(ParticleData::ColorB);
+        const float* a = m_data.getStream(ParticleData::ColorA);
+
+        static const float corners[4][2] = { { -1.f, -1.f }, { -1.f, 1.f }, { 1.f, 1.f }, { 1.f, -1.f } };
+        static const Vector2 uvs[4] = { Vector2(0.f, 1.f), Vector2(0.f, 0.f), Vector2(1.f, 0.f), Vector2(1.f, 1.f) };
+        for (ui32 i = 0; i < count; i++)
+        {
+            float half = sizes[i] * 0.5f;
+            Dword color = Color(r[i], g[i], b[i], a[i]).getABGR();
+            for (i32 j = 0; j < 4; j++)
+            {
+                Byte* vertex = vertexData.getVertice(i * 4 + j);
+                *(Vector3*)(vertex + format.m_posOffset) = Vector3(px[i] + corners[j][0] * half, py[i] + corners[j][1] * half, pz[i]);
+                *(Dword*)(vertex + format.m_colorOffset) = color;
+                *(Vector2*)(vertex + format.m_uv0Offset) = uvs[j];
+            }
+        }
     }
 }
@@ -1,20 +1,37 @@
 #pragma once
 
 #include "particle.h"
+#include "../emitter/emitter.h"
+#include "../modifier/modifier.h"
+#include "engine/core/render/base/mesh/mesh_vertex_data.h"
 
 namespace Echo
 {
+    // Particles with the emitters that spawn them and the modifiers that drive them. A tick
+    // emits, runs the modifiers, then moves, ages and kills the particles stream by stream.
     class ParticleGroup
     {
     public:
         ParticleGroup();
         ~ParticleGroup();
-        
+
+        // particles
+        ParticleData& getData() { return m_data; }
+        const ParticleData& getData() const { return m_data; }
+
+        // emitters and modifiers, the group deletes them
+        void addEmitter(Emitter* emitter) { m_emitters.emplace_back(emitter); }
+        void addModifier(Modifier* modifier) { m_modifiers.emplace_back(modifier); }
+
         // tick
         void tick(float elapsedTime);
-        
+
+        // one quad of four vertices per particle in the xy plane, with position, color and uv
+        void fillVertexData(MeshVertexData& vertexData) const;
+
     private:
-        vector<Particle>::type  m_particles;
+        ParticleData                m_data;
+        vector<Emitter*>::type      m_emitters;
+        vector<Modifier*>::type     m_modifiers;
     };
 }
-
@@ -1,4 +1,5 @@
 #include "particle_system.h"
+#include "effect_module.h"
 #include "engine/core/log/Log.h"
 #include "engine/core/scene/node_tree.h"
 #include "base/renderer.h"
@@ -10,10 +11,24 @@ namespace Echo
     ParticleSystem::ParticleSystem()
         : Render()
     {
+        m_emitter = EchoNew(Emitter);
+        m_gravity = EchoNew(GravityModifier);
+        m_group.addEmitter(m_emitter);
+        m_group.addModifier(m_gravity);
+        m_group.addModifier(EchoNew(FadeModifier));
+        m_group.getData().setCapacity(256);
+
+        setLife(m_life);
+        setSpeed(m_speed);
+        setSize(m_size);
+
+        EffectModule::instance()->addParticleSystem(this);
     }
 
     ParticleSystem::~ParticleSystem()
     {
+        EffectModule::instance()->removeParticleSystem(this);
+
         m_renderable.reset();
         m_mesh.reset();
     }
@@ -22,7 +37,25 @@ namespace Echo
     {
         CLASS_BIND_METHOD(ParticleSystem, getMaterial);
         CLASS_BIND_METHOD(ParticleSystem, setMaterial);
-
+        CLASS_BIND_METHOD(ParticleSystem, getMaxParticles);
+        CLASS_BIND_METHOD(ParticleSystem, setMaxParticles);
+        CLASS_BIND_METHOD(ParticleSystem, getRate);
+        CLASS_BIND_METHOD(ParticleSystem, setRate);
+        CLASS_BIND_METHOD(ParticleSystem, getLife);
+        CLASS_BIND_METHOD(ParticleSystem, setLife);
+        CLASS_BIND_METHOD(ParticleSystem, getSpeed);
+        CLASS_BIND_METHOD(ParticleSystem, setSpeed);
+        CLASS_BIND_METHOD(ParticleSystem, getSize);
+        CLASS_BIND_METHOD(ParticleSystem, setSize);
+        CLASS_BIND_METHOD(ParticleSystem, getGravity);
+        CLASS_BIND_METHOD(ParticleSystem, setGravity);
+
+        CLASS_REGISTER_PROPERTY(ParticleSystem, "MaxParticles", Variant::Type::Int, getMaxParticles, setMaxParticles);
+        CLASS_REGISTER_PROPERTY(ParticleSystem, "Rate", Variant::Type::Real, getRate, setRate);
+        CLASS_REGISTER_PROPERTY(ParticleSystem, "Life", Variant::Type::Vector2, getLife, setLife);
+        CLASS_REGISTER_PROPERTY(ParticleSystem, "Speed", Variant::Type::Vector2, getSpeed, setSpeed);
+        CLASS_REGISTER_PROPERTY(ParticleSystem, "Size", Variant::Type::Vector2, getSize, setSize);
+        CLASS_REGISTER_PROPERTY(ParticleSystem, "Gravity", Variant::Type::Vector3, getGravity, setGravity);
         CLASS_REGISTER_PROPERTY(ParticleSystem, "Material", Variant::Type::Object, getMaterial, setMaterial);
         CLASS_REGISTER_PROPERTY_HINT(ParticleSystem, "Material", PropertyHintType::ObjectType, "Material");
     }
@@ -34,13 +67,41 @@ namespace Echo
         m_isRenderableDirty = true;
     }
 
+    void ParticleSystem::setMaxParticles(i32 maxParticles)
+    {
+        ui32 capacity = ui32(std::max<i32>(maxParticles, 0));
+        if (capacity != m_group.getData().getCapacity())
+        {
+            m_isIndicesDirty = m_isIndicesDirty || capacity > m_group.getData().getCapacity();
+            m_group.getData().setCapacity(capacity);
+        }
+    }
+
+    void ParticleSystem::setLife(const Vector2& life)
+    {
+        m_life = life;
+        m_emitter->setLife(life.x, life.y);
+    }
+
+    void ParticleSystem::setSpeed(const Vector2& speed)
+    {
+        m_speed = speed;
+        m_emitter->setSpeed(speed.x, speed.y);
+    }
+
+    void ParticleSystem::setSize(const Vector2& size)
+    {
+        m_size = size;
+        m_emitter->setSize(size.x, size.y);
+    }
+
     void ParticleSystem::buildRenderable()
     {
         if (m_isRenderableDirty)
         {
             if (!m_material)
             {
-                StringArray macros = { "ALPHA_ADJUST" };
+                StringArray macros = { "ALPHA_ADJUST", "VERTEX_COLOR" };
                 ShaderProgramPtr shader = ShaderProgram::getDefault2D(macros);
 
                 m_material = ECHO_CREATE_RES(Material);
@@ -48,7 +109,13 @@ namespace Echo
             }
 
             // mesh
-            updateMeshBuffer();
+            if (!m_mesh)
+                m_mesh = Mesh::create(true, true);
+
+            updateIndices();
+            m_group.fillVertexData(m_mesh->getVertexData());
+            if (m_group.getData().getCount())
+                m_mesh->updateVertexs();
 
             // create render able
             m_renderable = RenderProxy::create(m_mesh, m_material, this, false);
@@ -62,40 +129,60 @@ namespace Echo
         if (isNeedRender())
             buildRenderable();
 
+        // simulated with the other systems in EffectModule::lateUpdate
+        m_pendingTime += elapsedTime;
+
         if (m_renderable)
-            m_renderable->setSubmitToRenderQueue(isNeedRender());
+            m_renderable->setSubmitToRenderQueue(isNeedRender() && m_group.getData().getCount() > 0);
     }
 
-    void ParticleSystem::updateMeshBuffer()
+    void ParticleSystem::simulate()
     {
-        if(!m_mesh)
+        if (m_pendingTime > 0.f)
         {
-            m_mesh = Mesh::create(true, true);
+            m_group.tick(m_pendingTime);
+            m_pendingTime = 0.f;
+
+            if (m_mesh)
+                m_group.fillVertexData(m_mesh->getVertexData());
         }
-        
-        if(m_mesh)
-        {
-            // indices
-            IndiceArray indices = { 0, 1, 2, 0, 2, 3 };
+    }
 
-            float hw = 64 * 0.5f;
-            float hh = 64 * 0.5f;
+    void ParticleSystem::submit()
+    {
+        if (m_mesh && m_renderable)
+        {
+            updateIndices();
 
-            // vertices
-            VertexArray vertices;
-            vertices.emplace_back(Vector3(-hw, -hh, 0.f), Vector2(0.f, 1.f));
-            vertices.emplace_back(Vector3(-hw,  hh, 0.f), Vector2(0.f, 0.f));
-            vertices.emplace_back(Vector3(hw,   hh, 0.f), Vector2(1.f, 0.f));
-            vertices.emplace_back(Vector3(hw,  -hh, 0.f), Vector2(1.f, 1.f));
+            ui32 count = m_group.getData().getCount();
+            m_mesh->setDrawIndexCount(count * 6);
+            if (count)
+            {
+                m_mesh->updateVertexs();
+                m_localAABB = m_mesh->getLocalBox();
+                m_renderable->setLocalAABB(m_localAABB);
+            }
 
-            // format
-            MeshVertexFormat define;
-            define.m_isUseUV = true;
+            m_renderable->setSubmitToRenderQueue(isNeedRender() && count > 0);
+        }
+    }
 
-            m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(Word), indices.data());
-            m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
+    void ParticleSystem::updateIndices()
+    {
+        if (m_isIndicesDirty && m_mesh)
+        {
+            // quads for the whole capacity, a frame draws only the alive ones
+            ui32 capacity = m_group.getData().getCapacity();
+            IndiceArray indices(capacity * 6);
+            for (ui32 i = 0; i < capacity; i++)
+            {
+                ui32 base = i * 4;
+                ui32 quad[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+                std::copy(quad, quad + 6, indices.begin() + i * 6);
+            }
 
-            m_localAABB = m_mesh->getLocalBox();
+            m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(ui32), indices.data());
+            m_isIndicesDirty = false;
         }
     }
 }
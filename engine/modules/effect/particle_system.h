@@ -4,6 +4,7 @@
 #include "engine/core/render/base/mesh/mesh.h"
 #include "engine/core/render/base/shader/material.h"
 #include "engine/core/render/base/proxy/render_proxy.h"
+#include "particle/particle_group.h"
 
 namespace Echo
 {
@@ -12,17 +13,7 @@ namespace Echo
         ECHO_CLASS(ParticleSystem, Render)
 
     public:
-        struct VertexFormat
-        {
-            Vector3        m_position;
-            Vector2        m_uv;
-
-            VertexFormat(const Vector3& pos, const Vector2& uv)
-                : m_position(pos), m_uv(uv)
-            {}
-        };
-        typedef vector<VertexFormat>::type    VertexArray;
-        typedef vector<Word>::type    IndiceArray;
+        typedef vector<ui32>::type    IndiceArray;
 
     public:
         ParticleSystem();
@@ -32,6 +23,37 @@ namespace Echo
         Material* getMaterial() const { return m_material; }
         void setMaterial(Object* material);
 
+        // max particles
+        i32 getMaxParticles() const { return i32(m_group.getData().getCapacity()); }
+        void setMaxParticles(i32 maxParticles);
+
+        // particles per second
+        float getRate() const { return m_emitter->getRate(); }
+        void setRate(float rate) { m_emitter->setRate(rate); }
+
+        // life range (seconds)
+        const Vector2& getLife() const { return m_life; }
+        void setLife(const Vector2& life);
+
+        // speed range
+        const Vector2& getSpeed() const { return m_speed; }
+        void setSpeed(const Vector2& speed);
+
+        // size range
+        const Vector2& getSize() const { return m_size; }
+        void setSize(const Vector2& size);
+
+        // gravity
+        const Vector3& getGravity() const { return m_gravity->getAcceleration(); }
+        void setGravity(const Vector3& gravity) { m_gravity->setAcceleration(gravity); }
+
+    public:
+        // advance particles by the time gathered since the last call and write their vertices, runs on a job
+        void simulate();
+
+        // upload the vertices written by simulate, main thread
+        void submit();
+
     protected:
         // build drawable
         void buildRenderable();
@@ -39,11 +61,19 @@ namespace Echo
         // update
         virtual void updateInternal(float elapsedTime) override;
 
-        // update vertex buffer
-        void updateMeshBuffer();
+        // indices of the quads, rebuilt when capacity grows
+        void updateIndices();
 
     private:
         bool                       m_isRenderableDirty = true;
+        bool                       m_isIndicesDirty = true;
+        float                      m_pendingTime = 0.f;
+        ParticleGroup              m_group;
+        Emitter*                   m_emitter = nullptr;
+        GravityModifier*           m_gravity = nullptr;
+        Vector2                    m_life = Vector2(1.f, 2.f);
+        Vector2                    m_speed = Vector2(50.f, 100.f);
+        Vector2                    m_size = Vector2(16.f, 32.f);
         MeshPtr                    m_mesh;                        // Geometry Data for render
         MaterialPtr                m_material;                    // Material Instance
         RenderProxyPtr             m_renderable;
@@ -1,22 +1,24 @@
 #include "sprite.h"
+#include "sprite_batcher.h"
 #include "engine/core/log/log.h"
 #include "engine/core/scene/node_tree.h"
 #include "base/renderer.h"
-#include "base/shader/shader_program.h"
 #include "engine/core/main/Engine.h"
 
 namespace Echo
 {
+	// quad versions are unique across sprites, a batch compares them to tell whether it changed
+	static ui32 g_quadVersion = 0;
+
 	Sprite::Sprite()
         : Render()
 	{
-		m_shaderDefault = ShaderProgram::getDefault2D(StringArray());
+		markQuadDirty();
 	}
 
 	Sprite::~Sprite()
 	{
-		m_renderable.reset();
-		m_mesh.reset();
+		SpriteBatcher::instance()->remove(this);
 	}
 
 	void Sprite::bindMethods()
@@ -48,6 +50,7 @@ namespace Echo
 	void Sprite::setBillobardType(const StringOption& type)
 	{
 		m_billboardType = type.toEnum(BillboardType::None);
+		markQuadDirty();
 	}
 
 	void Sprite::setWidth(float width)
@@ -55,7 +58,7 @@ namespace Echo
 		if (m_width != width)
 		{
 			m_width = width;
-			m_isRenderableDirty = true;
+			markQuadDirty();
 		}
 	}
 
@@ -64,7 +67,7 @@ namespace Echo
 		if (m_height != height)
 		{
 			m_height = height;
-			m_isRenderableDirty = true;
+			markQuadDirty();
 		}
 	}
 
@@ -73,7 +76,7 @@ namespace Echo
 		if (m_offset != offset)
 		{
 			m_offset = offset;
-			m_isRenderableDirty = true;
+			markQuadDirty();
 		}
 	}
 
@@ -81,40 +84,18 @@ namespace Echo
 	{
 		m_material = (Material*)material;
 
-		m_isRenderableDirty = true;
-	}
-
-	void Sprite::buildRenderable()
-	{
-		if (m_isRenderableDirty)
-		{
-			if (!m_material)
-			{
-				m_material = ECHO_CREATE_RES(Material);
-				m_material->setShaderPath(m_shaderDefault->getPath());
-			}
-
-			// mesh
-			updateMeshBuffer();
-
-			// create render able
-			m_renderable = RenderProxy::create(m_mesh, m_material, this, false);
-
-			m_isRenderableDirty = false;
-		}
+		markQuadDirty();
 	}
 
 	void Sprite::updateInternal(float elapsedTime)
 	{
 		if (isNeedRender())
 		{
-			updateBillboard();
+			if (m_material)
+				updateBillboard();
 
-			buildRenderable();
+			SpriteBatcher::instance()->submit(this, m_material ? m_material.ptr() : SpriteBatcher::instance()->getDefaultMaterial());
 		}
-
-		if (m_renderable)
-			m_renderable->setSubmitToRenderQueue(isNeedRender());
 	}
 
 	void Sprite::updateBillboard()
@@ -136,39 +117,53 @@ namespace Echo
 		}
 	}
 
-	void Sprite::updateMeshBuffer()
+	void Sprite::markQuadDirty()
 	{
-        if(!m_mesh)
-        {
-            if(m_width && m_height)
-                m_mesh = Mesh::create(true, true);
-        }
-        
-        if(m_mesh)
-        {
-			// indices
-			IndiceArray indices = { 0, 1, 2, 0, 2, 3 };
-
-            float hw = m_width * 0.5f;
-            float hh = m_height * 0.5f;
-
-			Vector3 offset(m_offset, 0.f);
-
-            // vertices
-            VertexArray vertices;
-            vertices.emplace_back(Vector3(-hw, -hh, 0.f) + offset, Vector2(0.f, 1.f));
-            vertices.emplace_back(Vector3(-hw,  hh, 0.f) + offset, Vector2(0.f, 0.f));
-            vertices.emplace_back(Vector3(hw,   hh, 0.f) + offset, Vector2(1.f, 0.f));
-            vertices.emplace_back(Vector3(hw,  -hh, 0.f) + offset, Vector2(1.f, 1.f));
-
-            // format
-            MeshVertexFormat define;
-            define.m_isUseUV = true;
-
-			m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(Word), indices.data());
-            m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
-
-			m_localAABB = m_mesh->getLocalBox();
-        }
+		m_isQuadDirty = true;
+
+		float hw = m_width * 0.5f;
+		float hh = m_height * 0.5f;
+		m_localAABB = AABB(m_offset.x - hw, m_offset.y - hh, 0.f, m_offset.x + hw, m_offset.y + hh, 0.f);
+	}
+
+	ui32 Sprite::getQuadVersion()
+	{
+		const Matrix4& world = getWorldMatrix();
+		if (m_isQuadDirty || m_quadWorld != world)
+		{
+			m_quadWorld = world;
+			m_quadVersion = ++g_quadVersion;
+			m_isQuadDirty = false;
+		}
+
+		return m_quadVersion;
+	}
+
+	void Sprite::buildQuad(VertexFormat* oVertices) const
+	{
+		float hw = m_width * 0.5f;
+		float hh = m_height * 0.5f;
+		const Vector2 corners[4] = { Vector2(-hw, -hh) + m_offset, Vector2(-hw, hh) + m_offset, Vector2(hw, hh) + m_offset, Vector2(hw, -hh) + m_offset };
+		const Vector2 uvs[4] = { Vector2(0.f, 1.f), Vector2(0.f, 0.f), Vector2(1.f, 0.f), Vector2(1.f, 1.f) };
+
+		// billboards of the default material keep their center and scaled corner, the shader turns them
+		bool isShaderBillboard = m_billboardType != BillboardType::None && !m_material;
+		const Vector3& scale = m_worldTransform.m_scale;
+		for (i32 i = 0; i < 4; i++)
+		{
+			VertexFormat& vertex = oVertices[i];
+			if (isShaderBillboard)
+			{
+				vertex.m_position = m_worldTransform.m_pos;
+				vertex.m_normal = Vector3(corners[i].x * scale.x, corners[i].y * scale.y, float(m_billboardType));
+			}
+			else
+			{
+				vertex.m_position = m_quadWorld.transform(Vector3(corners[i].x, corners[i].y, 0.f));
+				vertex.m_normal = Vector3::ZERO;
+			}
+
+			vertex.m_uv = uvs[i];
+		}
 	}
 }
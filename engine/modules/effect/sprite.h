@@ -1,27 +1,27 @@
 #pragma once
 
 #include "engine/core/scene/render_node.h"
-#include "engine/core/render/base/mesh/mesh.h"
 #include "engine/core/render/base/shader/material.h"
-#include "engine/core/render/base/proxy/render_proxy.h"
 
 namespace Echo
 {
+	// Sprites don't draw themselves, visible ones are gathered by SpriteBatcher every frame
 	class Sprite : public Render
 	{
 		ECHO_CLASS(Sprite, Render)
 
+		friend class SpriteBatcher;
+
+	public:
+		// billboard corners are turned to the camera by the default shader
 		struct VertexFormat
 		{
-			Vector3		m_position;
+			Vector3		m_position;		// world space, the billboard center for billboards
+			Vector3		m_normal;		// corner offset and billboard type of billboards, zero otherwise
 			Vector2		m_uv;
-
-			VertexFormat(const Vector3& pos, const Vector2& uv)
-				: m_position(pos), m_uv(uv)
-			{}
 		};
 		typedef vector<VertexFormat>::type	VertexArray;
-		typedef vector<Word>::type	IndiceArray;
+		typedef vector<ui32>::type	IndiceArray;
 
 	public:
 		enum BillboardType
@@ -56,27 +56,29 @@ namespace Echo
 		void setMaterial(Object* material);
 
 	protected:
-		// build drawable
-		void buildRenderable();
-
 		// update
 		virtual void updateInternal(float elapsedTime) override;
 
-		// update billboard
+		// update billboard, only for custom materials, the default shader turns billboards itself
 		void updateBillboard();
 
-		// update vertex buffer
-		void updateMeshBuffer();
+		// quad changed
+		void markQuadDirty();
+
+		// version of the quad, changes whenever the quad or world matrix does
+		ui32 getQuadVersion();
+
+		// four world space vertices
+		void buildQuad(VertexFormat* oVertices) const;
 
 	private:
-		bool                    m_isRenderableDirty = true;
+		bool                    m_isQuadDirty = true;
+		ui32					m_quadVersion = 0;
+		Matrix4					m_quadWorld;
 		BillboardType			m_billboardType = BillboardType::None;
 		float					m_width = 64.f;
 		float					m_height = 64.f;
 		Vector2					m_offset = Vector2::ZERO;
-		MeshPtr				    m_mesh;						// Geometry Data for render
-		ShaderProgramPtr		m_shaderDefault;
 		MaterialPtr				m_material;		            // Material Instance
-		RenderProxyPtr			m_renderable = nullptr;
 	};
 }
@@ -0,0 +1,163 @@
+#include "sprite_batcher.h"
+#include "engine/core/render/base/shader/shader_program.h"
+
+namespace Echo
+{
+	SpriteBatcher::SpriteBatcher()
+	{
+	}
+
+	SpriteBatcher::~SpriteBatcher()
+	{
+		for (Batch& batch : m_batches)
+		{
+			batch.m_proxy.reset();
+			batch.m_mesh.reset();
+			EchoSafeDelete(batch.m_node, Sprite);
+		}
+
+		m_batches.clear();
+		m_defaultMaterial.reset();
+	}
+
+	SpriteBatcher* SpriteBatcher::instance()
+	{
+		static SpriteBatcher* inst = EchoNew(SpriteBatcher);
+		return inst;
+	}
+
+	Material* SpriteBatcher::getDefaultMaterial()
+	{
+		if (!m_defaultMaterial)
+		{
+			ShaderProgramPtr shader = ShaderProgram::getDefault2D({ "BILLBOARD" });
+
+			m_defaultMaterial = ECHO_CREATE_RES(Material);
+			m_defaultMaterial->setShaderPath(shader->getPath());
+		}
+
+		return m_defaultMaterial;
+	}
+
+	void SpriteBatcher::submit(Sprite* sprite, Material* material)
+	{
+		if (material && sprite->getWidth() && sprite->getHeight())
+			m_items.push_back({ sprite, material, i32(sprite->getRenderType().getIdx()) });
+	}
+
+	void SpriteBatcher::remove(Sprite* sprite)
+	{
+		m_items.erase(std::remove_if(m_items.begin(), m_items.end(), [sprite](const Item& item) { return item.m_sprite == sprite; }), m_items.end());
+	}
+
+	void SpriteBatcher::flush()
+	{
+		// runs of consecutive items sharing material and render type, items are never reordered
+		// so sprites keep the order they were submitted in, which is the node tree order
+		m_batchCount = 0;
+		for (size_t begin = 0; begin < m_items.size();)
+		{
+			size_t end = begin + 1;
+			while (end < m_items.size() && m_items[end].m_material == m_items[begin].m_material && m_items[end].m_renderType == m_items[begin].m_renderType)
+				end++;
+
+			if (m_batchCount == m_batches.size())
+				m_batches.emplace_back();
+
+			updateBatch(m_batches[m_batchCount], m_batchCount, begin, end);
+			m_batchCount++;
+
+			begin = end;
+		}
+
+		// batches not needed this frame are kept for later frames
+		for (size_t i = m_batchCount; i < m_batches.size(); i++)
+		{
+			Batch& batch = m_batches[i];
+			if (batch.m_proxy && batch.m_proxy->isSubmitToRenderQueue())
+				batch.m_proxy->setSubmitToRenderQueue(false);
+
+			batch.m_contents.clear();
+		}
+
+		m_items.clear();
+	}
+
+	void SpriteBatcher::updateBatch(Batch& batch, ui32 order, size_t begin, size_t end)
+	{
+		const Item& first = m_items[begin];
+
+		m_contents.clear();
+		for (size_t i = begin; i < end; i++)
+			m_contents.push_back({ m_items[i].m_sprite, m_items[i].m_sprite->getQuadVersion() });
+
+		if (!batch.m_node)
+		{
+			batch.m_node = EchoNew(Sprite);
+			batch.m_mesh = Mesh::create(true, true);
+		}
+
+		if (i32(batch.m_node->getRenderType().getIdx()) != first.m_renderType)
+			batch.m_node->setRenderType(first.m_sprite->getRenderType());
+
+		if (batch.m_material != first.m_material || batch.m_contents != m_contents || !batch.m_proxy)
+		{
+			ui32 quadCount = ui32(end - begin);
+			m_vertices.resize(quadCount * 4);
+			for (size_t i = begin; i < end; i++)
+				m_items[i].m_sprite->buildQuad(&m_vertices[(i - begin) * 4]);
+
+			// billboard corners reach at most their length around the center
+			AABB& aabb = batch.m_node->m_localAABB;
+			aabb.reset();
+			for (const Sprite::VertexFormat& vertex : m_vertices)
+			{
+				float radius = Vector2(vertex.m_normal.x, vertex.m_normal.y).len();
+				aabb.addPoint(vertex.m_position - Vector3(radius, radius, radius));
+				aabb.addPoint(vertex.m_position + Vector3(radius, radius, radius));
+			}
+
+			// indices only change with capacity, draws are limited to the quads in use
+			if (quadCount > batch.m_quadCapacity)
+			{
+				batch.m_quadCapacity = std::max<ui32>(quadCount, batch.m_quadCapacity * 2);
+				m_indices.resize(batch.m_quadCapacity * 6);
+				for (ui32 i = 0; i < batch.m_quadCapacity; i++)
+				{
+					ui32 base = i * 4;
+					ui32 quad[6] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+					std::copy(quad, quad + 6, m_indices.begin() + i * 6);
+				}
+
+				batch.m_mesh->updateIndices(ui32(m_indices.size()), sizeof(ui32), m_indices.data());
+			}
+
+			MeshVertexFormat define;
+			define.m_isUseNormal = true;
+			define.m_isUseUV = true;
+
+			batch.m_mesh->setDrawIndexCount(quadCount * 6);
+			batch.m_mesh->updateVertexs(define, ui32(m_vertices.size()), (const Byte*)m_vertices.data());
+
+			if (!batch.m_proxy)
+				batch.m_proxy = RenderProxy::create(batch.m_mesh, first.m_material, batch.m_node, false);
+			else if (batch.m_material != first.m_material)
+				batch.m_proxy->setMaterial(first.m_material);
+
+			batch.m_material = first.m_material;
+			batch.m_contents.swap(m_contents);
+
+			// refresh bounds in the proxy bvh
+			if (batch.m_proxy)
+				batch.m_proxy->setSubmitToRenderQueue(true);
+		}
+		else if (!batch.m_proxy->isSubmitToRenderQueue())
+		{
+			batch.m_proxy->setSubmitToRenderQueue(true);
+		}
+
+		// batches share the identity world position, order keeps them in submit order
+		if (batch.m_proxy)
+			batch.m_proxy->setOrder(order);
+	}
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "engine/core/render/base/mesh/mesh.h"
+#include "engine/core/render/base/shader/material.h"
+#include "engine/core/render/base/proxy/render_proxy.h"
+#include "sprite.h"
+
+namespace Echo
+{
+	// Collects the visible sprites every frame and draws consecutive ones sharing material and
+	// render type with one draw call, batches keep the order sprites were submitted in. Billboards
+	// of the default material are turned to the camera by its vertex shader, so a batch is only
+	// uploaded again when one of its sprites changed.
+	class SpriteBatcher
+	{
+	public:
+		~SpriteBatcher();
+
+		// instance
+		static SpriteBatcher* instance();
+
+		// submit a sprite for this frame
+		void submit(Sprite* sprite, Material* material);
+
+		// forget a sprite that is destroyed
+		void remove(Sprite* sprite);
+
+		// build and draw batches of the sprites submitted this frame
+		void flush();
+
+		// material of sprites without one, shared so they batch
+		Material* getDefaultMaterial();
+
+		// draw calls of last flush
+		ui32 getBatchCount() const { return m_batchCount; }
+
+	private:
+		SpriteBatcher();
+
+		// a submit
+		struct Item
+		{
+			Sprite*		m_sprite;
+			Material*	m_material;
+			i32			m_renderType;
+		};
+
+		// sprite and quad version, tells whether a batch's content changed
+		struct Content
+		{
+			Sprite*		m_sprite;
+			ui32		m_version;
+
+			bool operator == (const Content& other) const { return m_sprite == other.m_sprite && m_version == other.m_version; }
+		};
+
+		// draws a run of items
+		struct Batch
+		{
+			Sprite*					m_node = nullptr;		// not in the node tree, identity world matrix
+			MeshPtr					m_mesh;
+			RenderProxyPtr			m_proxy;
+			Material*				m_material = nullptr;
+			ui32					m_quadCapacity = 0;
+			vector<Content>::type	m_contents;
+		};
+
+	private:
+		// update a batch by items [begin, end)
+		void updateBatch(Batch& batch, ui32 order, size_t begin, size_t end);
+
+	private:
+		vector<Item>::type			m_items;
+		vector<Batch>::type			m_batches;
+		vector<Content>::type		m_contents;
+		Sprite::VertexArray			m_vertices;
+		Sprite::IndiceArray			m_indices;
+		ui32						m_batchCount = 0;
+		MaterialPtr					m_defaultMaterial;
+	};
+}
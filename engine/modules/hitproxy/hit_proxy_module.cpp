@@ -1,6 +1,8 @@
 #include "hit_proxy_module.h"
 #include "hit_proxy.h"
 #include "hit_proxy_obb.h"
+#include "engine/core/scene/node_tree.h"
+#include "engine/core/render/base/renderer.h"
 
 namespace Echo
 {
@@ -23,6 +25,7 @@ namespace Echo
 
 	void HitProxyModule::bindMethods()
 	{
+		CLASS_BIND_METHOD(HitProxyModule, pick);
 	}
 
 	void HitProxyModule::registerTypes()
@@ -30,4 +33,30 @@ namespace Echo
 		Class::registerType<HitProxy>();
 		Class::registerType<HitProxyOBB>();
 	}
+
+	Render* HitProxyModule::pick(const Vector2& screenPos, bool is2d)
+	{
+		Render* result = nullptr;
+		pickBatch(&screenPos, 1, is2d, &result);
+
+		return result;
+	}
+
+	void HitProxyModule::pickBatch(const Vector2* screenPositions, ui32 count, bool is2d, Render** results)
+	{
+		std::fill(results, results + count, nullptr);
+
+		Camera* camera = is2d ? NodeTree::instance()->get2dCamera() : NodeTree::instance()->get3dCamera();
+		if (camera && count)
+		{
+			m_rays.resize(count);
+			for (ui32 i = 0; i < count; i++)
+				camera->getCameraRay(m_rays[i], screenPositions[i]);
+
+			m_hitProxies.resize(count);
+			Renderer::instance()->rayCastRenderProxies(is2d ? RenderProxy::RenderType2D : RenderProxy::RenderType3D, m_rays.data(), count, camera->getFar() - camera->getNear(), m_hitProxies.data());
+			for (ui32 i = 0; i < count; i++)
+				results[i] = m_hitProxies[i] ? m_hitProxies[i]->getNode() : nullptr;
+		}
+	}
 }
@@ -2,6 +2,8 @@
 
 #include "engine/core/main/module.h"
 #include "engine/core/render/base/texture/texture.h"
+#include "engine/core/scene/render_node.h"
+#include "engine/core/render/base/proxy/render_proxy.h"
 
 namespace Echo
 {
@@ -18,7 +20,15 @@ namespace Echo
 
 		// register all types of the module
 		virtual void registerTypes() override;  
+
+		// nearest render node whose bounds are under the screen position
+		Render* pick(const Vector2& screenPos, bool is2d);
+
+		// pick for many screen positions at once, rays are cast in packets against the packed bvh
+		void pickBatch(const Vector2* screenPositions, ui32 count, bool is2d, Render** results);
         
     protected:
+		vector<Ray>::type			m_rays;
+		vector<RenderProxy*>::type	m_hitProxies;
 	};
 }
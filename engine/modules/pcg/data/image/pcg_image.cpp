@@ -12,25 +12,46 @@ namespace Echo
 
 	}
 
-	void PCGImage::set(i32 width, i32 height)
+	void PCGImage::set(i32 width, i32 height, i32 channels)
 	{
-		m_width = width;
-		m_height = height;
-		m_colors.resize(m_width * m_height, Color::BLACK);
+		m_width = std::max<i32>(width, 0);
+		m_height = std::max<i32>(height, 0);
+		m_tilesX = (m_width + TileSize - 1) / TileSize;
+		m_tilesY = (m_height + TileSize - 1) / TileSize;
+
+		m_planes.resize(std::max<i32>(channels, 1));
+		for (vector<float>::type& plane : m_planes)
+			plane.assign(size_t(getTileCount()) * TilePixels, 0.f);
 	}
 
-	void PCGImage::setValue(i32 x, i32 y, const Color& color)
+	void PCGImage::setValue(i32 x, i32 y, float value, i32 channel)
 	{
-		if (x >= 0 && x < m_width && y >= 0 && y < m_height)
+		if (x >= 0 && x < m_width && y >= 0 && y < m_height && channel < getChannels())
 		{
-			i32 index = y * m_width + x;
-			m_colors[index] = color;
+			m_planes[channel][getOffset(x, y)] = value;
 		}
 	}
 
-	const Color& PCGImage::getValue(i32 x, i32 y) const
+	float PCGImage::getValue(i32 x, i32 y, i32 channel) const
 	{ 
-		i32 index = y * m_width + x;
-		return m_colors[index];
+		return m_planes[channel][getOffset(x, y)];
+	}
+
+	void PCGImage::getRows(i32 channel, vector<float>::type& oValues) const
+	{
+		oValues.resize(size_t(m_width) * m_height);
+
+		// a tile row at a time, each copies a run of the tile
+		const float* plane = getPlane(channel);
+		for (i32 y = 0; y < m_height; y++)
+		{
+			for (i32 tileX = 0; tileX < m_tilesX; tileX++)
+			{
+				i32 x = tileX * TileSize;
+				i32 count = std::min<i32>(TileSize, m_width - x);
+				const float* src = plane + getOffset(x, y);
+				std::copy(src, src + count, oValues.data() + size_t(y) * m_width + x);
+			}
+		}
 	}
-}
+}
\ No newline at end of file
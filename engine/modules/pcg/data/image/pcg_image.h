@@ -5,8 +5,16 @@
 
 namespace Echo
 {
+	// Image of float planes, one plane per channel, a heightfield needs only one.
+	// Planes are split into TileSize x TileSize tiles, pixels of a tile are row major
+	// and contiguous, so kernels stream tile after tile and jobs work on whole tiles.
 	class PCGImage : public PCGData
 	{
+	public:
+		// pixels along a tile edge
+		static const i32 TileSize = 64;
+		static const i32 TilePixels = TileSize * TileSize;
+
 	public:
 		PCGImage();
 		~PCGImage();
@@ -14,12 +22,12 @@ namespace Echo
 		// Type
 		virtual String getType() { return "Image"; }
 
-		// Set
-		void set(i32 width, i32 height);
+		// Set, all pixels are zero
+		void set(i32 width, i32 height, i32 channels = 1);
 
 		// Value
-		const Color& getValue(i32 x, i32 y) const;
-		void setValue(i32 x, i32 y, const Color& color);
+		float getValue(i32 x, i32 y, i32 channel = 0) const;
+		void setValue(i32 x, i32 y, float value, i32 channel = 0);
 
 		// Width
 		i32 getWidth() const { return m_width; }
@@ -30,14 +38,34 @@ namespace Echo
 		// Depth
 		i32 getDepth() const { return m_depth; }
 
-		// Data
-		const vector<Color>::type& getColors() const { return m_colors; }
+		// Channels
+		i32 getChannels() const { return i32(m_planes.size()); }
+
+		// Tiles
+		i32 getTilesX() const { return m_tilesX; }
+		i32 getTilesY() const { return m_tilesY; }
+		i32 getTileCount() const { return m_tilesX * m_tilesY; }
+
+		// same size and channels, planes line up pixel by pixel
+		bool isSameLayout(const PCGImage& other) const { return m_width == other.m_width && m_height == other.m_height && getChannels() == other.getChannels(); }
+
+		// Offset of a pixel in its plane
+		i32 getOffset(i32 x, i32 y) const { return ((y / TileSize) * m_tilesX + x / TileSize) * TilePixels + (y % TileSize) * TileSize + x % TileSize; }
+
+		// Plane, getTileCount() * TilePixels values, border tiles are padded past the image edges
+		float* getPlane(i32 channel) { return m_planes[channel].data(); }
+		const float* getPlane(i32 channel) const { return m_planes[channel].data(); }
+
+		// row major copy of a channel
+		void getRows(i32 channel, vector<float>::type& oValues) const;
 
 	protected:
-		i32					m_width = 0;
-		i32					m_height = 0;
-		i32					m_depth = 1;
-		vector<Color>::type	m_colors;
+		i32								m_width = 0;
+		i32								m_height = 0;
+		i32								m_depth = 1;
+		i32								m_tilesX = 0;
+		i32								m_tilesY = 0;
+		vector<vector<float>::type>::type	m_planes;
 	};
 	typedef ResRef<PCGImage> PCGImagePtr;
-}
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "pcg_image_kernel.h"
+#include "engine/core/thread/JobSystem.h"
+#include <cmath>
+
+#ifdef ECHO_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
+
+namespace Echo
+{
+	struct PCGAddOp
+	{
+		static float apply(float a, float b) { return a + b; }
+#ifdef ECHO_SIMD_SSE
+		static __m128 apply(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+#endif
+	};
+
+	struct PCGSubtractOp
+	{
+		static float apply(float a, float b) { return a - b; }
+#ifdef ECHO_SIMD_SSE
+		static __m128 apply(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+#endif
+	};
+
+	struct PCGMultiplyOp
+	{
+		static float apply(float a, float b) { return a * b; }
+#ifdef ECHO_SIMD_SSE
+		static __m128 apply(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+#endif
+	};
+
+	template<typename T>
+	static void combineTile(const float* a, const float* b, float* out)
+	{
+		i32 i = 0;
+#ifdef ECHO_SIMD_SSE
+		for (; i < PCGImage::TilePixels; i += 4)
+			_mm_storeu_ps(out + i, T::apply(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+#endif
+		for (; i < PCGImage::TilePixels; i++)
+			out[i] = T::apply(a[i], b[i]);
+	}
+
+	template<typename T>
+	static void combineImages(const PCGImage& a, const PCGImage& b, PCGImage& out)
+	{
+		PCGImageKernel::forEachTile(out, [&a, &b, &out](i32 tileIdx)
+		{
+			size_t offset = size_t(tileIdx) * PCGImage::TilePixels;
+			for (i32 channel = 0; channel < out.getChannels(); channel++)
+			{
+				// channels b doesn't have repeat its first
+				const float* planeB = b.getPlane(channel < b.getChannels() ? channel : 0);
+				combineTile<T>(a.getPlane(channel) + offset, planeB + offset, out.getPlane(channel) + offset);
+			}
+		});
+	}
+
+	void PCGImageKernel::combine(Op op, const PCGImage& a, const PCGImage& b, PCGImage& out)
+	{
+		// b is brought to the size of a, missing channels repeat its first
+		PCGImage resampled;
+		const PCGImage* other = &b;
+		if (b.getWidth() != a.getWidth() || b.getHeight() != a.getHeight())
+		{
+			resample(b, a.getWidth(), a.getHeight(), resampled);
+			other = &resampled;
+		}
+
+		out.set(a.getWidth(), a.getHeight(), a.getChannels());
+		switch (op)
+		{
+		case Op::Add:		combineImages<PCGAddOp>(a, *other, out);		break;
+		case Op::Subtract:	combineImages<PCGSubtractOp>(a, *other, out);	break;
+		case Op::Multiply:	combineImages<PCGMultiplyOp>(a, *other, out);	break;
+		default:																break;
+		}
+	}
+
+	void PCGImageKernel::scaleBias(const PCGImage& a, float scale, float bias, PCGImage& out)
+	{
+		out.set(a.getWidth(), a.getHeight(), a.getChannels());
+		forEachTile(out, [&a, &out, scale, bias](i32 tileIdx)
+		{
+			size_t offset = size_t(tileIdx) * PCGImage::TilePixels;
+			for (i32 channel = 0; channel < out.getChannels(); channel++)
+			{
+				const float* src = a.getPlane(channel) + offset;
+				float* dst = out.getPlane(channel) + offset;
+
+				i32 i = 0;
+#ifdef ECHO_SIMD_SSE
+				__m128 s = _mm_set1_ps(scale);
+				__m128 t = _mm_set1_ps(bias);
+				for (; i < PCGImage::TilePixels; i += 4)
+					_mm_storeu_ps(dst + i, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(src + i), s), t));
+#endif
+				for (; i < PCGImage::TilePixels; i++)
+					dst[i] = src[i] * scale + bias;
+			}
+		});
+	}
+
+	void PCGImageKernel::resample(const PCGImage& src, i32 width, i32 height, PCGImage& out)
+	{
+		out.set(width, height, src.getChannels());
+		if (!src.getWidth() || !src.getHeight())
+			return;
+
+		// source offsets and weights of every column, the same for all rows
+		struct Tap
+		{
+			i32		m_x0;
+			i32		m_x1;
+			float	m_weight;
+		};
+		vector<Tap>::type columns(width);
+		float ratioX = float(src.getWidth()) / float(std::max<i32>(width, 1));
+		for (i32 x = 0; x < width; x++)
+		{
+			float fx = Math::Clamp((x + 0.5f) * ratioX - 0.5f, 0.f, float(src.getWidth() - 1));
+			columns[x].m_x0 = i32(fx);
+			columns[x].m_x1 = std::min<i32>(columns[x].m_x0 + 1, src.getWidth() - 1);
+			columns[x].m_weight = fx - columns[x].m_x0;
+		}
+
+		float ratioY = float(src.getHeight()) / float(std::max<i32>(height, 1));
+		forEachTile(out, [&src, &out, &columns, ratioY](i32 tileIdx)
+		{
+			i32 beginX = (tileIdx % out.getTilesX()) * PCGImage::TileSize;
+			i32 beginY = (tileIdx / out.getTilesX()) * PCGImage::TileSize;
+			i32 endX = std::min<i32>(beginX + PCGImage::TileSize, out.getWidth());
+			i32 endY = std::min<i32>(beginY + PCGImage::TileSize, out.getHeight());
+			for (i32 channel = 0; channel < out.getChannels(); channel++)
+			{
+				const float* plane = src.getPlane(channel);
+				float* dst = out.getPlane(channel);
+				for (i32 y = beginY; y < endY; y++)
+				{
+					float fy = Math::Clamp((y + 0.5f) * ratioY - 0.5f, 0.f, float(src.getHeight() - 1));
+					i32 y0 = i32(fy);
+					i32 y1 = std::min<i32>(y0 + 1, src.getHeight() - 1);
+					float wy = fy - y0;
+
+					float* row = dst + out.getOffset(beginX, y);
+					for (i32 x = beginX; x < endX; x++)
+					{
+						const Tap& tap = columns[x];
+						float top = plane[src.getOffset(tap.m_x0, y0)] * (1.f - tap.m_weight) + plane[src.getOffset(tap.m_x1, y0)] * tap.m_weight;
+						float bottom = plane[src.getOffset(tap.m_x0, y1)] * (1.f - tap.m_weight) + plane[src.getOffset(tap.m_x1, y1)] * tap.m_weight;
+						row[x - beginX] = top * (1.f - wy) + bottom * wy;
+					}
+				}
+			}
+		});
+	}
+
+	void PCGImageKernel::forEachTile(const PCGImage& image, const std::function<void(i32 tileIdx)>& func)
+	{
+		JobSystem::instance()->parallelFor(ui32(image.getTileCount()), 1, [&func](ui32 begin, ui32 end, ui32 threadIdx)
+		{
+			for (ui32 tileIdx = begin; tileIdx < end; tileIdx++)
+				func(i32(tileIdx));
+		});
+	}
+}
\ No newline at end of file
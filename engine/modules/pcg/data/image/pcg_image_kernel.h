@@ -0,0 +1,34 @@
+#pragma once
+
+#include <functional>
+#include "pcg_image.h"
+
+namespace Echo
+{
+	// Image kernels. Work is split by tiles over the job system, and a tile is
+	// processed four pixels at a time when SSE is available.
+	class PCGImageKernel
+	{
+	public:
+		// per pixel operation
+		enum class Op
+		{
+			Add,
+			Subtract,
+			Multiply,
+		};
+
+	public:
+		// out = a op b, b is resampled when it has another size, a one channel b applies to every channel of a
+		static void combine(Op op, const PCGImage& a, const PCGImage& b, PCGImage& out);
+
+		// out = a * scale + bias
+		static void scaleBias(const PCGImage& a, float scale, float bias, PCGImage& out);
+
+		// bilinear resample src into width x height
+		static void resample(const PCGImage& src, i32 width, i32 height, PCGImage& out);
+
+		// run func(tileIdx) for every tile of image on the job system
+		static void forEachTile(const PCGImage& image, const std::function<void(i32 tileIdx)>& func);
+	};
+}
\ No newline at end of file
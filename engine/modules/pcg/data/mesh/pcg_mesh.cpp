@@ -1,82 +1,93 @@
 #include "pcg_mesh.h"
-#include "pcg_vertex.h"
+#include <cstring>
 
 namespace Echo
 {
-	void PCGMesh::clear()
+	PCGMesh::PCGMesh()
 	{
-		m_vertexIdx = 0;
-		EchoSafeDeleteContainer(m_vertices, PCGVertex);
 
-		m_primitiveIdx = 0;
-		EchoSafeDeleteContainer(m_primitives, PCGPrimitive);
 	}
 
-	PCGVertex* PCGMesh::addVertex()
+	PCGMesh::~PCGMesh()
 	{
-		m_vertexIdx++;
-
-		PCGVertex* point = EchoNew(PCGVertex);
-		point->m_id = m_vertexIdx++;
-		m_vertices.push_back(point);
 
-		return point;
 	}
 
-	PCGPrimitive* PCGMesh::addPrimitive()
+	void PCGMesh::clear()
 	{
-		m_primitiveIdx++;
+		PCGPointCloud::clear();
 
-		PCGPrimitive* prim = EchoNew(PCGPrimitive(m_primitiveIdx++));
-		m_primitives.push_back(prim);
+		m_indices.clear();
+	}
 
-		return prim;
+	void PCGMesh::addTriangle(ui32 a, ui32 b, ui32 c)
+	{
+		m_indices.push_back(a);
+		m_indices.push_back(b);
+		m_indices.push_back(c);
 	}
 
-	MeshPtr PCGMesh::buildMesh()
+	void PCGMesh::addTriangles(const ui32* indices, ui32 triangleCount, ui32 offset)
 	{
-		// Vertex Format
-		struct VertexFormat
+		size_t begin = m_indices.size();
+		m_indices.insert(m_indices.end(), indices, indices + triangleCount * 3);
+		if (offset)
 		{
-			Vector3        m_position;
-			Vector3        m_normal;
-			Vector2        m_uv;
-		};
+			for (size_t i = begin; i < m_indices.size(); i++)
+				m_indices[i] += offset;
+		}
+	}
 
-		typedef vector<VertexFormat>::type  VertexArray;
-		typedef vector<ui32>::type          IndiceArray;
+	void PCGMesh::append(const PCGMesh& other)
+	{
+		ui32 offset = ui32(getPointCount());
+		PCGPointCloud::append(other);
 
-		VertexArray    vertices;
-		IndiceArray    indices;
+		addTriangles(other.m_indices.data(), other.getTriangleCount(), offset);
+	}
 
+	void PCGMesh::fillVertexData(MeshVertexData& vertexData) const
+	{
 		MeshVertexFormat define;
-		define.m_isUseNormal = true;
-		define.m_isUseUV = true;
+		define.m_isUseNormal = hasNormals();
+		define.m_isUseUV = hasUvs();
+
+		ui32 count = ui32(m_positions.size());
+		vertexData.set(define, count);
 
-		for (PCGPrimitive* primitive : m_primitives)
+		// one pass per attribute, each writes its slot of every vertex
+		const MeshVertexFormat& format = vertexData.getFormat();
+		Byte* vertices = vertexData.getVertices();
+		auto scatter = [vertices, count, &format](const void* values, ui32 valueSize, ui32 offset)
 		{
-			for (PCGVertex* point : primitive->getVertices())
-			{
-				indices.push_back(vertices.size());
+			const Byte* src = (const Byte*)values;
+			for (ui32 i = 0; i < count; i++)
+				std::memcpy(vertices + i * format.m_stride + offset, src + i * valueSize, valueSize);
+		};
 
-				VertexFormat vertex;
-				vertex.m_position = point->m_position;
-				vertex.m_normal   =	point->m_normal;
-				vertex.m_uv		  = point->m_uv;
+		if (count)
+		{
+			scatter(m_positions.data(), sizeof(Vector3), format.m_posOffset);
+			if (define.m_isUseNormal)
+				scatter(m_normals.data(), sizeof(Vector3), format.m_normalOffset);
 
-				vertices.push_back(vertex);
-			}
+			if (define.m_isUseUV)
+				scatter(m_uvs.data(), sizeof(Vector2), format.m_uv0Offset);
 		}
+	}
 
-		if (!indices.empty() && !vertices.empty())
-		{
-			MeshPtr mesh = Mesh::create(true, true);
-			mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(ui32), indices.data());
-			mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
+	MeshPtr PCGMesh::buildMesh() const
+	{
+		if (m_indices.empty() || m_positions.empty())
+			return nullptr;
 
-			return mesh;
-		}
+		// vertices are written straight into the mesh, no intermediate array
+		MeshPtr mesh = Mesh::create(true, true);
+		mesh->updateIndices(static_cast<ui32>(m_indices.size()), sizeof(ui32), m_indices.data());
+
+		fillVertexData(mesh->getVertexData());
+		mesh->updateVertexs();
 
-		return nullptr;
+		return mesh;
 	}
-}
\ No newline at end of file
+}
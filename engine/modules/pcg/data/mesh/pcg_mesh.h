@@ -1,33 +1,44 @@
 #pragma once
 
-#include "pcg_vertex.h"
-#include "pcg_primitive.h"
+#include "engine/modules/pcg/data/pointcloud/pcg_point_cloud.h"
 #include "engine/core/render/base/mesh/mesh.h"
 
 namespace Echo
 {
-	class PCGMesh : public Object
+	// Triangle mesh, points are the attribute arrays of the point cloud and
+	// every primitive is three point indices
+	class PCGMesh : public PCGPointCloud
 	{
 	public:
-		PCGMesh() {}
-		~PCGMesh() {}
+		PCGMesh();
+		virtual ~PCGMesh();
 
-		// add point
-		PCGVertex* addVertex();
+		// Type
+		virtual String getType() override { return "Mesh"; }
 
-		// add primitives
-		PCGPrimitive* addPrimitive();
+		// add triangles by point indices, offset is added to every index
+		void addTriangle(ui32 a, ui32 b, ui32 c);
+		void addTriangles(const ui32* indices, ui32 triangleCount, ui32 offset = 0);
+
+		// triangles
+		ui32 getTriangleCount() const { return ui32(m_indices.size() / 3); }
+		vector<ui32>::type& getIndices() { return m_indices; }
+		const vector<ui32>::type& getIndices() const { return m_indices; }
+
+		// append points and triangles of other
+		void append(const PCGMesh& other);
+
+		// interleave the point attributes into vertex data, in place
+		void fillVertexData(MeshVertexData& vertexData) const;
 
 		// mesh
-		MeshPtr buildMesh();
+		MeshPtr buildMesh() const;
 
 		// clear
-		void clear();
+		virtual void clear() override;
 
 	private:
-		i32							m_vertexIdx = 0;
-		vector<PCGVertex*>::type	m_vertices;
-		i32							m_primitiveIdx = 0;
-		vector<PCGPrimitive*>::type	m_primitives;
+		vector<ui32>::type		m_indices;
 	};
-}
\ No newline at end of file
+	typedef ResRef<PCGMesh> PCGMeshPtr;
+}
@@ -0,0 +1,128 @@
+#include "pcg_point_cloud.h"
+
+namespace Echo
+{
+	PCGPointCloud::PCGPointCloud()
+	{
+
+	}
+
+	PCGPointCloud::~PCGPointCloud()
+	{
+
+	}
+
+	i32 PCGPointCloud::addPoints(i32 count)
+	{
+		i32 first = getPointCount();
+		size_t size = size_t(first + std::max<i32>(count, 0));
+
+		m_positions.resize(size, Vector3::ZERO);
+		if (!m_normals.empty())
+			m_normals.resize(size, Vector3::ZERO);
+
+		if (!m_uvs.empty())
+			m_uvs.resize(size, Vector2::ZERO);
+
+		for (auto& it : m_attributes)
+			it.second.resize(size, 0.f);
+
+		return first;
+	}
+
+	vector<Vector3>::type& PCGPointCloud::getNormals()
+	{
+		m_normals.resize(m_positions.size(), Vector3::ZERO);
+		return m_normals;
+	}
+
+	vector<Vector2>::type& PCGPointCloud::getUvs()
+	{
+		m_uvs.resize(m_positions.size(), Vector2::ZERO);
+		return m_uvs;
+	}
+
+	vector<float>::type& PCGPointCloud::getAttribute(const String& name)
+	{
+		vector<float>::type& values = m_attributes[name];
+		values.resize(m_positions.size(), 0.f);
+		return values;
+	}
+
+	const vector<float>::type* PCGPointCloud::findAttribute(const String& name) const
+	{
+		auto it = m_attributes.find(name);
+		return it != m_attributes.end() ? &it->second : nullptr;
+	}
+
+	void PCGPointCloud::append(const PCGPointCloud& other)
+	{
+		size_t count = m_positions.size();
+		size_t otherCount = other.m_positions.size();
+		if (!otherCount)
+			return;
+
+		// an attribute present on either side exists on both before the arrays are joined
+		auto appendArray = [count, otherCount](auto& dst, const auto& src, bool isUsed)
+		{
+			if (!isUsed && src.empty())
+				return;
+
+			dst.resize(count);
+			if (src.empty())
+				dst.resize(count + otherCount);
+			else
+				dst.insert(dst.end(), src.begin(), src.end());
+		};
+
+		appendArray(m_normals, other.m_normals, !m_normals.empty());
+		appendArray(m_uvs, other.m_uvs, !m_uvs.empty());
+		for (auto& it : m_attributes)
+		{
+			const vector<float>::type* src = other.findAttribute(it.first);
+			appendArray(it.second, src ? *src : vector<float>::type(), true);
+		}
+
+		for (const auto& it : other.m_attributes)
+		{
+			if (!m_attributes.count(it.first))
+			{
+				vector<float>::type& values = m_attributes[it.first];
+				values.resize(count, 0.f);
+				values.insert(values.end(), it.second.begin(), it.second.end());
+			}
+		}
+
+		m_positions.insert(m_positions.end(), other.m_positions.begin(), other.m_positions.end());
+	}
+
+	void PCGPointCloud::transform(const Matrix4& matrix, i32 begin, i32 end)
+	{
+		end = end < 0 ? getPointCount() : std::min<i32>(end, getPointCount());
+
+		for (i32 i = begin; i < end; i++)
+			m_positions[i] = matrix.transform(m_positions[i]);
+
+		// normals go by the inverse transpose, so they stay perpendicular under non uniform scale
+		if (!m_normals.empty())
+		{
+			Matrix4 normalMatrix = matrix;
+			normalMatrix.noTranslate();
+			normalMatrix.detInverse();
+			normalMatrix.transpose();
+			for (i32 i = begin; i < end; i++)
+			{
+				m_normals[i] = normalMatrix.transformNormal(m_normals[i]);
+				m_normals[i].normalize();
+			}
+		}
+	}
+
+	void PCGPointCloud::clear()
+	{
+		m_positions.clear();
+		m_normals.clear();
+		m_uvs.clear();
+		m_attributes.clear();
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "engine/core/math/Math.h"
+#include "engine/modules/pcg/data/pcg_data.h"
+
+namespace Echo
+{
+	// Points stored Houdini style, one contiguous array per attribute instead of one struct per point.
+	// Positions always exist, normals, uvs and named float attributes exist once added and then
+	// hold one value per point. Operations work on whole arrays, so they scale to millions of points.
+	// https://www.tokeru.com/cgwiki/index.php?title=Points_and_Verts_and_Prims
+	class PCGPointCloud : public PCGData
+	{
+	public:
+		PCGPointCloud();
+		virtual ~PCGPointCloud();
+
+		// Type
+		virtual String getType() override { return "PointCloud"; }
+
+		// point count
+		i32 getPointCount() const { return i32(m_positions.size()); }
+
+		// add points, returns the index of the first one. attributes of new points are zero
+		i32 addPoints(i32 count);
+
+		// positions
+		vector<Vector3>::type& getPositions() { return m_positions; }
+		const vector<Vector3>::type& getPositions() const { return m_positions; }
+
+		// normals, added on first non const access
+		bool hasNormals() const { return !m_normals.empty(); }
+		vector<Vector3>::type& getNormals();
+		const vector<Vector3>::type& getNormals() const { return m_normals; }
+
+		// uvs, added on first non const access
+		bool hasUvs() const { return !m_uvs.empty(); }
+		vector<Vector2>::type& getUvs();
+		const vector<Vector2>::type& getUvs() const { return m_uvs; }
+
+		// named float attributes, added on first non const access
+		vector<float>::type& getAttribute(const String& name);
+		const vector<float>::type* findAttribute(const String& name) const;
+
+		// append all points of other, attributes only one side has are zero on the other
+		void append(const PCGPointCloud& other);
+
+		// transform positions and normals of [begin, end), end -1 is the last point
+		void transform(const Matrix4& matrix, i32 begin = 0, i32 end = -1);
+
+		// clear
+		virtual void clear();
+
+	protected:
+		vector<Vector3>::type					m_positions;
+		vector<Vector3>::type					m_normals;
+		vector<Vector2>::type					m_uvs;
+		map<String, vector<float>::type>::type	m_attributes;
+	};
+	typedef ResRef<PCGPointCloud> PCGPointCloudPtr;
+}
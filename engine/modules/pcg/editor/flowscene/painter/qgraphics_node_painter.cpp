@@ -49,6 +49,12 @@ namespace Procedural
 			QRectF textRect = m_text->sceneBoundingRect();
 			m_text->setPos((m_width - textRect.width()) * 0.5f - halfWidth, (m_height - textRect.height()) * 0.5f - halfHeight);
 
+			// time of the last run, below the node
+			m_runTimeText = m_graphicsScene->addSimpleText("");
+			m_runTimeText->setBrush(QBrush(m_style.m_fontColorFaded));
+			m_runTimeText->setParentItem(m_rect);
+			m_runTimeText->setPos(-halfWidth, halfHeight + 2.f);
+
 			buildInputConnectPoints();
 			buildOutputConnectPoints();
 		}
@@ -76,6 +82,7 @@ namespace Procedural
 		m_rect = nullptr;
 		m_rectFinal = nullptr;
 		m_text = nullptr;
+		m_runTimeText = nullptr;
 	}
 
 	void PCGNodePainter::buildInputConnectPoints()
@@ -156,6 +163,9 @@ namespace Procedural
 
 			if (m_text)
 				m_text->setText(m_pcgNode->getName().c_str());
+
+			if (m_runTimeText && m_pcgNode->getVersion())
+				m_runTimeText->setText(Echo::StringUtil::Format("%.2f ms", m_pcgNode->getRunTime() / 1000.f).c_str());
 		}
 
 		updateInputConnectPoints();
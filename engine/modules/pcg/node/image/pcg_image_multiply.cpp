@@ -0,0 +1,35 @@
+#include "pcg_image_multiply.h"
+#include "engine/modules/pcg/data/image/pcg_image_kernel.h"
+
+namespace Echo
+{
+	PCGImageMultiply::PCGImageMultiply()
+	{
+		m_inputs.push_back(EchoNew(PCGConnectPoint(this, "Image")));
+		m_inputs.push_back(EchoNew(PCGConnectPoint(this, "Image")));
+
+		m_resultImage = new PCGImage;
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, m_resultImage.ptr())));
+	}
+
+	PCGImageMultiply::~PCGImageMultiply()
+	{
+
+	}
+
+	void PCGImageMultiply::bindMethods()
+	{
+	}
+
+	void PCGImageMultiply::run()
+	{
+		PCGImage* a = dynamic_cast<PCGImage*>(m_inputs[0]->getData().ptr());
+		PCGImage* b = dynamic_cast<PCGImage*>(m_inputs[1]->getData().ptr());
+		if (a && b)
+			PCGImageKernel::combine(PCGImageKernel::Op::Multiply, *a, *b, *m_resultImage);
+		else
+			m_resultImage->set(0, 0);
+
+		m_dirtyFlag = false;
+	}
+}
\ No newline at end of file
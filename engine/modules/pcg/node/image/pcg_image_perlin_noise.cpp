@@ -1,5 +1,11 @@
 #include "pcg_image_perlin_noise.h"
 #include "engine/modules/pcg/data/image/pcg_image.h"
+#include "engine/modules/pcg/data/image/pcg_image_kernel.h"
+#include <cmath>
+
+#ifdef ECHO_SIMD_SSE
+	#include <xmmintrin.h>
+#endif
 
 namespace Echo
 {
@@ -76,25 +82,107 @@ namespace Echo
 		{
 			m_resultImage->set(m_width, m_height);
 
-			for (i32 x = 0; x < m_width; x++)
+			if (m_gridSize > 0.f)
 			{
-				for (i32 y = 0; y < m_height; y++)
-				{
-					float grayScale = perlin((x + m_offset.x) / m_gridSize, (y + m_offset.y) / m_gridSize);
+				buildLattice();
 
-					// Apply amplitude
-					grayScale = Math::Clamp(grayScale * m_amplitude, -1.f, 1.f);
+				// tiles are independent, each job fills its own
+				PCGImageKernel::forEachTile(*m_resultImage, [this](i32 tileIdx) { noiseTile(tileIdx); });
+			}
 
-					// Mapping from (-1, 1) to (0, 1)
-					grayScale = (grayScale + 1.f) * 0.5f;
+			m_dirtyFlag = false;
+		}
+	}
+
+	void PCGImagePerlinNoise::buildLattice()
+	{
+		// gradients of all lattice points the image covers, instead of four evaluations per pixel
+		m_latticeX = i32(std::floor(m_offset.x / m_gridSize));
+		m_latticeY = i32(std::floor(m_offset.y / m_gridSize));
+		m_latticeWidth = i32(std::floor((m_width - 1 + m_offset.x) / m_gridSize)) - m_latticeX + 2;
+		i32 latticeHeight = i32(std::floor((m_height - 1 + m_offset.y) / m_gridSize)) - m_latticeY + 2;
+
+		m_latticeGradients.resize(size_t(m_latticeWidth) * latticeHeight);
+		for (i32 j = 0; j < latticeHeight; j++)
+		{
+			for (i32 i = 0; i < m_latticeWidth; i++)
+				m_latticeGradients[j * m_latticeWidth + i] = randomGradient(m_latticeX + i, m_latticeY + j);
+		}
+	}
 
-					// Change image's value
-					assert(grayScale >= 0.f && grayScale <= 1.f);
-					m_resultImage->setValue(x, y, Color(grayScale, grayScale, grayScale, grayScale));
+	void PCGImagePerlinNoise::noiseTile(i32 tileIdx)
+	{
+		i32 beginX = (tileIdx % m_resultImage->getTilesX()) * PCGImage::TileSize;
+		i32 beginY = (tileIdx / m_resultImage->getTilesX()) * PCGImage::TileSize;
+		i32 endY = std::min<i32>(beginY + PCGImage::TileSize, m_height);
+		float* tile = m_resultImage->getPlane(0) + size_t(tileIdx) * PCGImage::TilePixels;
+
+		for (i32 y = beginY; y < endY; y++)
+		{
+			float fy = (y + m_offset.y) / m_gridSize;
+			i32 cellY = i32(std::floor(fy)) - m_latticeY;
+			float dy = fy - std::floor(fy);
+			float* row = tile + (y - beginY) * PCGImage::TileSize;
+
+			// four pixels at a time, lattice gradients are gathered per pixel and blended together.
+			// pixels past the right edge are padding, they repeat the last column
+			for (i32 i = 0; i < PCGImage::TileSize; i += 4)
+			{
+				alignas(16) float dx[4], gx00[4], gy00[4], gx10[4], gy10[4], gx01[4], gy01[4], gx11[4], gy11[4];
+				for (i32 k = 0; k < 4; k++)
+				{
+					float fx = (std::min<i32>(beginX + i + k, m_width - 1) + m_offset.x) / m_gridSize;
+					i32 cellX = i32(std::floor(fx)) - m_latticeX;
+					dx[k] = fx - std::floor(fx);
+
+					const Vector2* g = &m_latticeGradients[cellY * m_latticeWidth + cellX];
+					gx00[k] = g[0].x;
+					gy00[k] = g[0].y;
+					gx10[k] = g[1].x;
+					gy10[k] = g[1].y;
+					gx01[k] = g[m_latticeWidth].x;
+					gy01[k] = g[m_latticeWidth].y;
+					gx11[k] = g[m_latticeWidth + 1].x;
+					gy11[k] = g[m_latticeWidth + 1].y;
 				}
-			}
 
-			m_dirtyFlag = false;
+#ifdef ECHO_SIMD_SSE
+				__m128 one = _mm_set1_ps(1.f);
+				__m128 x0 = _mm_load_ps(dx);
+				__m128 x1 = _mm_sub_ps(x0, one);
+				__m128 y0 = _mm_set1_ps(dy);
+				__m128 y1 = _mm_set1_ps(dy - 1.f);
+				__m128 n00 = _mm_add_ps(_mm_mul_ps(x0, _mm_load_ps(gx00)), _mm_mul_ps(y0, _mm_load_ps(gy00)));
+				__m128 n10 = _mm_add_ps(_mm_mul_ps(x1, _mm_load_ps(gx10)), _mm_mul_ps(y0, _mm_load_ps(gy10)));
+				__m128 n01 = _mm_add_ps(_mm_mul_ps(x0, _mm_load_ps(gx01)), _mm_mul_ps(y1, _mm_load_ps(gy01)));
+				__m128 n11 = _mm_add_ps(_mm_mul_ps(x1, _mm_load_ps(gx11)), _mm_mul_ps(y1, _mm_load_ps(gy11)));
+
+				// s curve 6t^5 - 15t^4 + 10t^3
+				__m128 sx = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(x0, x0), x0), _mm_add_ps(_mm_mul_ps(x0, _mm_sub_ps(_mm_mul_ps(x0, _mm_set1_ps(6.f)), _mm_set1_ps(15.f))), _mm_set1_ps(10.f)));
+				__m128 sy = _mm_set1_ps(sCurveInterpolate(dy));
+				__m128 ix0 = _mm_add_ps(n00, _mm_mul_ps(sx, _mm_sub_ps(n10, n00)));
+				__m128 ix1 = _mm_add_ps(n01, _mm_mul_ps(sx, _mm_sub_ps(n11, n01)));
+				__m128 value = _mm_add_ps(ix0, _mm_mul_ps(sy, _mm_sub_ps(ix1, ix0)));
+
+				// amplitude, then from (-1, 1) to (0, 1)
+				value = _mm_min_ps(_mm_max_ps(_mm_mul_ps(value, _mm_set1_ps(m_amplitude)), _mm_set1_ps(-1.f)), one);
+				_mm_storeu_ps(row + i, _mm_mul_ps(_mm_add_ps(value, one), _mm_set1_ps(0.5f)));
+#else
+				for (i32 k = 0; k < 4; k++)
+				{
+					float n00 = dx[k] * gx00[k] + dy * gy00[k];
+					float n10 = (dx[k] - 1.f) * gx10[k] + dy * gy10[k];
+					float n01 = dx[k] * gx01[k] + (dy - 1.f) * gy01[k];
+					float n11 = (dx[k] - 1.f) * gx11[k] + (dy - 1.f) * gy11[k];
+					float sx = sCurveInterpolate(dx[k]);
+					float sy = sCurveInterpolate(dy);
+					float ix0 = n00 + sx * (n10 - n00);
+					float ix1 = n01 + sx * (n11 - n01);
+					float value = Math::Clamp((ix0 + sy * (ix1 - ix0)) * m_amplitude, -1.f, 1.f);
+					row[i + k] = (value + 1.f) * 0.5f;
+				}
+#endif
+			}
 		}
 	}
 
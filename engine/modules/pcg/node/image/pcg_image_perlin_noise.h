@@ -58,6 +58,13 @@ namespace Echo
 		// Interpolate between a0 and a1
 		float sCurveInterpolate(float t);
 
+	private:
+		// gradients of the lattice points covered by the image
+		void buildLattice();
+
+		// noise of a tile of the result image
+		void noiseTile(i32 tileIdx);
+
 	protected:
 		i32				m_width = 128;
 		i32				m_height = 128;
@@ -65,5 +72,9 @@ namespace Echo
 		float			m_gridSize = 32.f;
 		Vector2			m_offset = Vector2::ZERO;
 		PCGImagePtr		m_resultImage;
+		i32				m_latticeX = 0;
+		i32				m_latticeY = 0;
+		i32				m_latticeWidth = 0;
+		vector<Vector2>::type m_latticeGradients;
 	};
 }
@@ -83,9 +83,10 @@ namespace Echo
 					vector<ui8>::type pixels(image->getWidth() * image->getHeight());
 
 					i32 idx = 0;
-					for (const Color& color : image->getColors())
+					for (i32 y = 0; y < image->getHeight(); y++)
 					{
-						pixels[idx++] = color.r * 255.99f;
+						for (i32 x = 0; x < image->getWidth(); x++)
+							pixels[idx++] = Math::Clamp(image->getValue(x, y), 0.f, 1.f) * 255.99f;
 					}
 
 					i32 pixelBytes = PixelUtil::GetPixelBytes(PixelFormat::PF_R8_UINT);
@@ -133,8 +134,7 @@ namespace Echo
 
 							for (i32 x = 0; x < image->getWidth(); x++)
 							{
-								const Color& color = image->getValue(x, y);
-								ui16 finalValue = ui16(Math::Clamp(color.r * 65535.f, 0.f, 65535.f));
+								ui16 finalValue = ui16(Math::Clamp(image->getValue(x, y) * 65535.f, 0.f, 65535.f));
 								row[x] = finalValue;
 							}
 						}
@@ -0,0 +1,58 @@
+#include "pcg_image_scale.h"
+#include "engine/modules/pcg/data/image/pcg_image_kernel.h"
+
+namespace Echo
+{
+	PCGImageScale::PCGImageScale()
+	{
+		m_inputs.push_back(EchoNew(PCGConnectPoint(this, "Image")));
+
+		m_resultImage = new PCGImage;
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, m_resultImage.ptr())));
+	}
+
+	PCGImageScale::~PCGImageScale()
+	{
+
+	}
+
+	void PCGImageScale::bindMethods()
+	{
+		CLASS_BIND_METHOD(PCGImageScale, getWidth);
+		CLASS_BIND_METHOD(PCGImageScale, setWidth);
+		CLASS_BIND_METHOD(PCGImageScale, getHeight);
+		CLASS_BIND_METHOD(PCGImageScale, setHeight);
+
+		CLASS_REGISTER_PROPERTY(PCGImageScale, "Width", Variant::Type::Int, getWidth, setWidth);
+		CLASS_REGISTER_PROPERTY(PCGImageScale, "Height", Variant::Type::Int, getHeight, setHeight);
+	}
+
+	void PCGImageScale::setWidth(i32 width)
+	{
+		if (m_width != width)
+		{
+			m_width = width;
+			m_dirtyFlag = true;
+		}
+	}
+
+	void PCGImageScale::setHeight(i32 height)
+	{
+		if (m_height != height)
+		{
+			m_height = height;
+			m_dirtyFlag = true;
+		}
+	}
+
+	void PCGImageScale::run()
+	{
+		PCGImage* image = dynamic_cast<PCGImage*>(m_inputs[0]->getData().ptr());
+		if (image)
+			PCGImageKernel::resample(*image, m_width, m_height, *m_resultImage);
+		else
+			m_resultImage->set(0, 0);
+
+		m_dirtyFlag = false;
+	}
+}
\ No newline at end of file
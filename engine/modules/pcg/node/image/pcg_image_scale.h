@@ -0,0 +1,39 @@
+#pragma once
+
+#include "engine/modules/pcg/node/pcg_node.h"
+#include "engine/modules/pcg/data/image/pcg_image.h"
+
+namespace Echo
+{
+	// Resample an image to a new size, bilinear
+	class PCGImageScale : public PCGNode
+	{
+		ECHO_CLASS(PCGImageScale, PCGNode);
+
+	public:
+		PCGImageScale();
+		virtual ~PCGImageScale();
+
+		// catergory
+		virtual String getCategory() const override { return "Image"; }
+
+		// width
+		i32 getWidth() const { return m_width; }
+		void setWidth(i32 width);
+
+		// height
+		i32 getHeight() const { return m_height; }
+		void setHeight(i32 height);
+
+		// get result
+		PCGImagePtr getResultImage() { return m_resultImage; }
+
+		// Run
+		virtual void run() override;
+
+	protected:
+		i32				m_width = 256;
+		i32				m_height = 256;
+		PCGImagePtr		m_resultImage;
+	};
+}
\ No newline at end of file
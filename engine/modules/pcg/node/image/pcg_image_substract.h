@@ -0,0 +1,29 @@
+#pragma once
+
+#include "engine/modules/pcg/node/pcg_node.h"
+#include "engine/modules/pcg/data/image/pcg_image.h"
+
+namespace Echo
+{
+	// A - B per pixel, B is resampled to the size of A
+	class PCGImageSubstract : public PCGNode
+	{
+		ECHO_CLASS(PCGImageSubstract, PCGNode);
+
+	public:
+		PCGImageSubstract();
+		virtual ~PCGImageSubstract();
+
+		// catergory
+		virtual String getCategory() const override { return "Image"; }
+
+		// get result
+		PCGImagePtr getResultImage() { return m_resultImage; }
+
+		// Run
+		virtual void run() override;
+
+	protected:
+		PCGImagePtr		m_resultImage;
+	};
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "pcg_image_voronoi.h"
 #include "engine/modules/pcg/data/image/pcg_image.h"
+#include "engine/core/thread/JobSystem.h"
 
 namespace Echo
 {
@@ -52,23 +53,27 @@ namespace Echo
 			// step 1
 			generateSites();
 
-			for (i32 x = 0; x < m_width; x++)
+			// sites are only read from here on, rows are filled by jobs
+			JobSystem::instance()->parallelFor(ui32(Math::Max(m_height, 0)), 16, [this](ui32 begin, ui32 end, ui32 threadIdx)
 			{
-				for (i32 y = 0; y < m_height; y++)
+				for (i32 y = i32(begin); y < i32(end); y++)
 				{
-					float grayScale = voronoi(x, y);
+					for (i32 x = 0; x < m_width; x++)
+					{
+						float grayScale = voronoi(float(x), float(y));
 
-					// Apply amplitude
-					grayScale = Math::Clamp(grayScale, -1.f, 1.f);
+						// Apply amplitude
+						grayScale = Math::Clamp(grayScale, -1.f, 1.f);
 
-					// Mapping from (-1, 1) to (0, 1)
-					grayScale = (grayScale + 1.f) * 0.5f;
+						// Mapping from (-1, 1) to (0, 1)
+						grayScale = (grayScale + 1.f) * 0.5f;
 
-					// Change image's value
-					assert(grayScale >= 0.f && grayScale <= 1.f);
-					m_resultImage->setValue(x, y, Color(grayScale, grayScale, grayScale, grayScale));
+						// Change image's value
+						assert(grayScale >= 0.f && grayScale <= 1.f);
+						m_resultImage->setValue(x, y, grayScale);
+					}
 				}
-			}
+			});
 
 			m_dirtyFlag = false;
 		}
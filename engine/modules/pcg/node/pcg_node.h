@@ -11,6 +11,8 @@ namespace Echo
 	{
 		ECHO_CLASS(PCGNode, Object);
 
+		friend class PCGFlowGraph;
+
 	public:
 		PCGNode();
 		virtual ~PCGNode();
@@ -43,9 +45,18 @@ namespace Echo
 		// check
 		bool check() { return true; }
 
+		// may run on a job thread next to other nodes, false for nodes touching the scene
+		virtual bool isThreadSafe() const { return true; }
+
 		// calculate
 		virtual void run();
 
+		// bumped every time the node runs, downstream nodes rerun when it changes
+		ui32 getVersion() const { return m_version; }
+
+		// microseconds the last run took
+		ui32 getRunTime() const { return m_runTime; }
+
 	protected:
 		String								m_name;
 		PCGFlowGraph*						m_graph = nullptr;
@@ -53,6 +64,9 @@ namespace Echo
 		std::vector<PCGConnectPoint*>		m_outputs;
 		bool								m_dirtyFlag = true;
 		Vector2								m_position;
+		ui32								m_version = 0;
+		size_t								m_inputHash = 0;
+		ui32								m_runTime = 0;
 	};
 
 	LUA_PUSH_VALUE(PCGNode)
@@ -5,7 +5,8 @@ namespace Echo
 {
 	PCGBox::PCGBox()
 	{
-
+		m_mesh = EchoNew(PCGMesh);
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, m_mesh.ptr())));
 	}
 
 	PCGBox::~PCGBox()
@@ -27,71 +28,56 @@ namespace Echo
 		m_dirtyFlag = true;
 	}
 
-	//void PCGBox::play(PCGData& data)
-	//{
-	//	for (i32 i = 0; i < 3; i++)
-	//	{
-	//		addPlane(data, i, false);
-	//		addPlane(data, i, true);
-	//	}
-
-	//	m_dirtyFlag = false;
-	//}
-
-	//void PCGBox::addPlane(PCGData& data, i32 axis, bool negative)
-	//{
-	//	Vector3 normal = Vector3::ZERO;
-	//	normal[axis] = negative ? -1.f : 1.f;
-
-	//	Vector2 uvs[4] =
-	//	{
-	//		{-1.f, 1.f},
-	//		{ 1.f, 1.f},
-	//		{ 1.f, -1.f},
-	//		{-1.f, -1.f}
-	//	};
-
-	//	Vector3 positions[4];
-	//	for (i32 i = 0; i < 4; i++)
-	//	{
-	//		positions[i][axis] = negative ? -1.f : 1.f;
-
-	//		i32 k = 0;
-	//		for (i32 j = 0; j < 3; j++)
-	//		{
-	//			if (j != axis)
-	//			{
-	//				positions[i][j] = uvs[i][k];
-	//				k++;
-	//			}
-	//		}
-	//	}
-
-	//	vector<PGPoint*>::type points;
-	//	for (int i = 0; i < 4; ++i)
-	//	{
-	//		PGPoint* point = data.addPoint();
-
-	//		point->m_position = positions[i] * m_size * 0.5f;
-	//		point->m_normal = normal;
-	//		point->m_uv = (uvs[i] + Vector2(1.f, 1.f)) * 0.5f;
-
-	//		points.push_back(point);
-	//	}
-
-	//	PCGPrimitive* prim0 = data.addPrimitive();
-	//	prim0->addPoint(points[0]);
-	//	prim0->addPoint(points[1]);
-	//	prim0->addPoint(points[2]);
-
-	//	PCGPrimitive* prim1 = data.addPrimitive();
-	//	prim1->addPoint(points[0]);
-	//	prim1->addPoint(points[2]);
-	//	prim1->addPoint(points[3]);
-	//}
+	void PCGBox::addPlane(PCGMesh& mesh, i32 axis, bool negative)
+	{
+		Vector3 normal = Vector3::ZERO;
+		normal[axis] = negative ? -1.f : 1.f;
+
+		Vector2 uvs[4] =
+		{
+			{-1.f, 1.f},
+			{ 1.f, 1.f},
+			{ 1.f, -1.f},
+			{-1.f, -1.f}
+		};
+
+		i32 first = mesh.addPoints(4);
+		vector<Vector3>::type& positions = mesh.getPositions();
+		vector<Vector3>::type& normals = mesh.getNormals();
+		vector<Vector2>::type& texCoords = mesh.getUvs();
+		for (i32 i = 0; i < 4; i++)
+		{
+			Vector3 position;
+			position[axis] = negative ? -1.f : 1.f;
+
+			i32 k = 0;
+			for (i32 j = 0; j < 3; j++)
+			{
+				if (j != axis)
+				{
+					position[j] = uvs[i][k];
+					k++;
+				}
+			}
+
+			positions[first + i] = position * m_size * 0.5f;
+			normals[first + i] = normal;
+			texCoords[first + i] = (uvs[i] + Vector2(1.f, 1.f)) * 0.5f;
+		}
+
+		ui32 indices[6] = { 0, 1, 2, 0, 2, 3 };
+		mesh.addTriangles(indices, 2, ui32(first));
+	}
 
 	void PCGBox::run()
 	{
-
+		m_mesh->clear();
+		for (i32 i = 0; i < 3; i++)
+		{
+			addPlane(*m_mesh, i, false);
+			addPlane(*m_mesh, i, true);
+		}
+
+		m_dirtyFlag = false;
 	}
 }
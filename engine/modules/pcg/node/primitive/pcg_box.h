@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/modules/pcg/node/pcg_node.h"
+#include "engine/modules/pcg/data/mesh/pcg_mesh.h"
 
 namespace Echo
 {
@@ -19,14 +20,18 @@ namespace Echo
 		void setSize(const Vector3& size);
 		const Vector3& getSize() const { return m_size; }
 
+		// get result
+		PCGMeshPtr getResultMesh() { return m_mesh; }
+
 		// calculate
 		virtual void run() override;
 
 	private:
 		// add plane
-		void addPlane(PCGData& data, i32 axis, bool negative);
+		void addPlane(PCGMesh& mesh, i32 axis, bool negative);
 
 	protected:
 		Vector3		m_size = Vector3::ONE;
+		PCGMeshPtr	m_mesh;
 	};
 }
@@ -4,7 +4,8 @@ namespace Echo
 {
 	PCGGrid::PCGGrid()
 	{
-
+		m_mesh = EchoNew(PCGMesh);
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, m_mesh.ptr())));
 	}
 
 	PCGGrid::~PCGGrid()
@@ -35,54 +36,45 @@ namespace Echo
 		m_dirtyFlag = true;
 	}
 
-	//void PCGGrid::play()
-	//{
-		//vector<PCGPoint*>::type points;
-
-		//if (m_columns > 0 && m_rows > 0)
-		//{
-		//	Vector3 basePosition(-0.5f * (m_rows - 1), 0.f, -0.5f * (m_columns - 1));
-
-		//	// vertex buffer
-		//	for (i32 row = 0; row < m_rows; row++)
-		//	{
-		//		for (i32 column = 0; column < m_columns; column++)
-		//		{
-		//			PGPoint* point = data.addPoint();
-
-		//			point->m_position = Vector3(row, 0.f, column) + basePosition;
-		//			point->m_uv = Vector2(row / (m_rows - 1), column / (m_columns - 1));
-		//			point->m_normal = Vector3::UNIT_Y;
-
-		//			points.emplace_back(point);
-		//		}
-		//	}
-
-		//	// index buffer
-		//	i32 rowLength = m_rows - 1;
-		//	i32 columnLength = m_columns - 1;
-		//	for (i32 row = 0; row < rowLength; row++)
-		//	{
-		//		for (i32 column = 0; column < columnLength; column++)
-		//		{
-		//			i32 indexLeftTop = row * m_columns + column;
-		//			i32 indexRightTop = indexLeftTop + 1;
-		//			i32 indexLeftBottom = indexLeftTop + m_columns;
-		//			i32 indexRightBottom = indexRightTop + m_columns;
-
-		//			PCGPrimitive* prim0 = data.addPrimitive();
-		//			prim0->addPoint(points[indexLeftTop]);
-		//			prim0->addPoint(points[indexRightBottom]);
-		//			prim0->addPoint(points[indexRightTop]);
-
-		//			PCGPrimitive* prim1 = data.addPrimitive();
-		//			prim1->addPoint(points[indexLeftTop]);
-		//			prim1->addPoint(points[indexLeftBottom]);
-		//			prim1->addPoint(points[indexRightBottom]);
-		//		}
-		//	}
-		//}
-
-		//m_dirtyFlag = false;
-	//}
+	void PCGGrid::run()
+	{
+		m_mesh->clear();
+		m_mesh->addPoints(m_rows * m_columns);
+
+		// attribute arrays are filled one after another
+		vector<Vector3>::type& positions = m_mesh->getPositions();
+		vector<Vector2>::type& uvs = m_mesh->getUvs();
+		Vector3 basePosition(-0.5f * (m_rows - 1), 0.f, -0.5f * (m_columns - 1));
+		for (i32 row = 0; row < m_rows; row++)
+		{
+			for (i32 column = 0; column < m_columns; column++)
+			{
+				i32 index = row * m_columns + column;
+				positions[index] = Vector3(float(row), 0.f, float(column)) + basePosition;
+				uvs[index] = Vector2(float(row) / (m_rows - 1), float(column) / (m_columns - 1));
+			}
+		}
+
+		vector<Vector3>::type& normals = m_mesh->getNormals();
+		std::fill(normals.begin(), normals.end(), Vector3::UNIT_Y);
+
+		// index buffer
+		vector<ui32>::type& indices = m_mesh->getIndices();
+		indices.reserve((m_rows - 1) * (m_columns - 1) * 6);
+		for (i32 row = 0; row < m_rows - 1; row++)
+		{
+			for (i32 column = 0; column < m_columns - 1; column++)
+			{
+				ui32 indexLeftTop = row * m_columns + column;
+				ui32 indexRightTop = indexLeftTop + 1;
+				ui32 indexLeftBottom = indexLeftTop + m_columns;
+				ui32 indexRightBottom = indexRightTop + m_columns;
+
+				ui32 quad[6] = { indexLeftTop, indexRightBottom, indexRightTop, indexLeftTop, indexLeftBottom, indexRightBottom };
+				indices.insert(indices.end(), quad, quad + 6);
+			}
+		}
+
+		m_dirtyFlag = false;
+	}
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/modules/pcg/node/pcg_node.h"
+#include "engine/modules/pcg/data/mesh/pcg_mesh.h"
 
 namespace Echo
 {
@@ -20,11 +21,18 @@ namespace Echo
 		i32 getColumns() const { return m_columns; }
 		void setColumns(i32 columns);
 
+		// catergory
+		virtual String getCategory() const override { return "Primitive"; }
+
+		// get result
+		PCGMeshPtr getResultMesh() { return m_mesh; }
+
 		// calculate
 		virtual void run() override;
 
 	protected:
-		i32		m_rows = 11;
-		i32		m_columns = 11;
+		i32			m_rows = 11;
+		i32			m_columns = 11;
+		PCGMeshPtr	m_mesh;
 	};
 }
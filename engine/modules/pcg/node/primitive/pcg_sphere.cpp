@@ -5,7 +5,8 @@ namespace Echo
 {
 	PCGSphere::PCGSphere()
 	{
-
+		m_mesh = EchoNew(PCGMesh);
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, m_mesh.ptr())));
 	}
 
 	PCGSphere::~PCGSphere()
@@ -27,83 +28,62 @@ namespace Echo
 		m_dirtyFlag = true;
 	}
 
-	//void PCGSphere::play(PCGData& data)
-	//{
-	//	float x, y, z, xz;                              // vertex position
-	//	float nx, ny, nz, lengthInv = 1.0f / m_radius;    // vertex normal
-	//	float s, t;                                     // vertex texCoord
-
-	//	float sectorStep = 2 * Math::PI / m_sectorCount;
-	//	float stackStep = Math::PI / m_stackCount;
-	//	float sectorAngle, stackAngle;
-
-	//	vector<PGPoint*>::type points;
-	//	for (int i = 0; i <= m_stackCount; ++i)
-	//	{
-	//		stackAngle = Math::PI / 2 - i * stackStep;        // starting from pi/2 to -pi/2
-	//		xz = m_radius * cosf(stackAngle);             // r * cos(u)
-	//		y = m_radius * sinf(stackAngle);              // r * sin(u)
-
-	//		// add (sectorCount+1) vertices per stack
-	//		// the first and last vertices have same position and normal, but different tex coords
-	//		for (int j = 0; j <= m_sectorCount; ++j)
-	//		{
-	//			sectorAngle = j * sectorStep;           // starting from 0 to 2pi
-
-	//			PGPoint* point = data.addPoint();
-
-	//			// vertex position (x, y, z)
-	//			x = xz * cosf(sectorAngle);             // r * cos(u) * cos(v)
-	//			z = xz * sinf(sectorAngle);             // r * cos(u) * sin(v)
-	//			point->m_position = Vector3(x, y, z);
-
-	//			// normalized vertex normal (nx, ny, nz)
-	//			nx = x * lengthInv;
-	//			ny = y * lengthInv;
-	//			nz = z * lengthInv;
-	//			point->m_normal = Vector3(nx, ny, nz);
-
-	//			// vertex texture coordinate (s, t) range between [0, 1]
-	//			s = (float)j / m_sectorCount;
-	//			t = (float)i / m_stackCount;
-	//			point->m_uv = Vector2(s, t);
-
-	//			points.push_back(point);
-	//		}
-	//	}
-
-	//	// indices
-	//	//  k1--k1+1
-	//	//  |  / |
-	//	//  | /  |
-	//	//  k2--k2+1
-	//	unsigned int k1, k2;
-	//	for (int i = 0; i < m_stackCount; ++i)
-	//	{
-	//		k1 = i * (m_sectorCount + 1);     // beginning of current stack
-	//		k2 = k1 + m_sectorCount + 1;      // beginning of next stack
-
-	//		for (int j = 0; j < m_sectorCount; ++j, ++k1, ++k2)
-	//		{
-	//			// 2 triangles per sector excluding 1st and last stacks
-	//			if (i != 0)
-	//			{
-	//				PCGPrimitive* prim= data.addPrimitive();
-	//				prim->addPoint(points[k1]);
-	//				prim->addPoint(points[k2]);
-	//				prim->addPoint(points[k1+1]);
-	//			}
-
-	//			if (i != (m_stackCount - 1))
-	//			{
-	//				PCGPrimitive* prim = data.addPrimitive();
-	//				prim->addPoint(points[k1+1]);
-	//				prim->addPoint(points[k2]);
-	//				prim->addPoint(points[k2 + 1]);
-	//			}
-	//		}
-	//	}
-
-	//	m_dirtyFlag = false;
-	//}
+	void PCGSphere::run()
+	{
+		m_mesh->clear();
+		m_mesh->addPoints((m_stackCount + 1) * (m_sectorCount + 1));
+
+		vector<Vector3>::type& positions = m_mesh->getPositions();
+		vector<Vector3>::type& normals = m_mesh->getNormals();
+		vector<Vector2>::type& uvs = m_mesh->getUvs();
+
+		float sectorStep = 2 * Math::PI / m_sectorCount;
+		float stackStep = Math::PI / m_stackCount;
+		float lengthInv = 1.0f / m_radius;
+		for (i32 i = 0; i <= m_stackCount; ++i)
+		{
+			float stackAngle = Math::PI / 2 - i * stackStep;		// starting from pi/2 to -pi/2
+			float xz = m_radius * cosf(stackAngle);				// r * cos(u)
+			float y = m_radius * sinf(stackAngle);				// r * sin(u)
+
+			// add (sectorCount+1) vertices per stack
+			// the first and last vertices have same position and normal, but different tex coords
+			for (i32 j = 0; j <= m_sectorCount; ++j)
+			{
+				float sectorAngle = j * sectorStep;				// starting from 0 to 2pi
+				i32 index = i * (m_sectorCount + 1) + j;
+
+				// vertex position (x, y, z)
+				Vector3 position(xz * cosf(sectorAngle), y, xz * sinf(sectorAngle));
+				positions[index] = position;
+				normals[index] = position * lengthInv;
+
+				// vertex texture coordinate (s, t) range between [0, 1]
+				uvs[index] = Vector2((float)j / m_sectorCount, (float)i / m_stackCount);
+			}
+		}
+
+		// indices
+		//  k1--k1+1
+		//  |  / |
+		//  | /  |
+		//  k2--k2+1
+		for (i32 i = 0; i < m_stackCount; ++i)
+		{
+			ui32 k1 = i * (m_sectorCount + 1);		// beginning of current stack
+			ui32 k2 = k1 + m_sectorCount + 1;		// beginning of next stack
+
+			for (i32 j = 0; j < m_sectorCount; ++j, ++k1, ++k2)
+			{
+				// 2 triangles per sector excluding 1st and last stacks
+				if (i != 0)
+					m_mesh->addTriangle(k1, k2, k1 + 1);
+
+				if (i != (m_stackCount - 1))
+					m_mesh->addTriangle(k1 + 1, k2, k2 + 1);
+			}
+		}
+
+		m_dirtyFlag = false;
+	}
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/modules/pcg/node/pcg_node.h"
+#include "engine/modules/pcg/data/mesh/pcg_mesh.h"
 
 namespace Echo
 {
@@ -24,17 +25,24 @@ namespace Echo
 		PCGSphere();
 		virtual ~PCGSphere();
 
+		// catergory
+		virtual String getCategory() const override { return "Primitive"; }
+
 		// readius
 		void setRadius(float radius);
 		float getRadius() const { return m_radius; }
 
+		// get result
+		PCGMeshPtr getResultMesh() { return m_mesh; }
+
 		// calculate
-		//virtual void play(PCGData& data) override;
+		virtual void run() override;
 
 	protected:
-		Type	m_type = Type::Uv;
-		float	m_radius = 1.f;
-		i32		m_stackCount = 50;
-		i32		m_sectorCount = 50;
+		Type		m_type = Type::Uv;
+		float		m_radius = 1.f;
+		i32			m_stackCount = 50;
+		i32			m_sectorCount = 50;
+		PCGMeshPtr	m_mesh;
 	};
 }
@@ -45,12 +45,7 @@ namespace Echo
 					if (image)
 					{
 						vector<float>::type heightData;
-						heightData.reserve(image->getColors().size());
-
-						for (const Color& color : image->getColors())
-						{
-							heightData.push_back(color.r);
-						}
+						image->getRows(0, heightData);
 
 						terrain->setHeight(0, 0, image->getWidth(), image->getHeight(), heightData);
 					}
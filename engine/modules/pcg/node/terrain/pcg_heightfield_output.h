@@ -23,6 +23,9 @@ namespace Echo
 		bool isAutoCreate() const { return m_autoCreate; }
 		void setAutoCreate(bool autoCreate) { m_autoCreate = autoCreate; }
 
+		// Writes to the terrain node, runs on the main thread
+		virtual bool isThreadSafe() const override { return false; }
+
 		// Run
 		virtual void run() override;
 
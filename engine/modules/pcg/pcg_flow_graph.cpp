@@ -4,7 +4,9 @@
 #include "engine/core/log/log.h"
 #include "engine/core/main/Engine.h"
 #include "engine/core/scene/node_tree.h"
+#include "engine/core/thread/JobSystem.h"
 #include <queue>
+#include <chrono>
 #include <thirdparty/pugixml/pugixml.hpp>
 #include <thirdparty/pugixml/pugiconfig.hpp>
 #include <thirdparty/pugixml/pugixml_ext.hpp>
@@ -38,6 +40,7 @@ namespace Echo
 		EchoSafeDeleteContainer(m_connects, PCGConnect);
 
 		m_nodeOutput = nullptr;
+		m_isWavesDirty = true;
 	}
 
 	void PCGFlowGraph::addNode(PCGNode* node)
@@ -51,6 +54,8 @@ namespace Echo
 
 			if (!m_nodeOutput)
 				m_nodeOutput = node;
+
+			m_isWavesDirty = true;
 		}
 	}
 
@@ -61,6 +66,8 @@ namespace Echo
 		if (node == m_nodeOutput)
 			m_nodeOutput = nullptr;
 
+		m_isWavesDirty = true;
+
 		EchoSafeDelete(node, PCGNode);
 	}
 
@@ -70,6 +77,8 @@ namespace Echo
 
 		connect->getFrom()->addConnect(connect);
 		connect->getTo()->addConnect(connect);
+
+		m_isWavesDirty = true;
 	}
 
 	PCGConnect* PCGFlowGraph::addConnect(const String& fromNode, i32 fromIdx, const String& toNode, i32 toIdx)
@@ -101,6 +110,8 @@ namespace Echo
 	{
 		m_connects.erase(std::remove(m_connects.begin(), m_connects.end(), connect), m_connects.end());
 
+		m_isWavesDirty = true;
+
 		EchoSafeDelete(connect, PCGConnect);
 	}
 
@@ -129,25 +140,140 @@ namespace Echo
 
 	void PCGFlowGraph::run()
 	{
-		if (m_nodeOutput)
+		if (!m_nodeOutput)
+			return;
+
+		if (m_isWavesDirty)
 		{
-			runNode(m_nodeOutput);
+			buildWaves();
+			m_isWavesDirty = false;
+		}
+
+		set<PCGNode*>::type required;
+		collectRequiredNodes(m_nodeOutput, required);
+
+		for (const vector<PCGNode*>::type& wave : m_waves)
+		{
+			// clean nodes keep their results while their inputs stay the same
+			vector<PCGNode*>::type pending;
+			for (PCGNode* node : wave)
+			{
+				if (required.count(node) && node->check())
+				{
+					size_t inputHash = calcInputHash(node);
+					if (node->isDirty() || inputHash != node->m_inputHash)
+					{
+						node->m_inputHash = inputHash;
+						node->m_dirtyFlag = true;
+						pending.emplace_back(node);
+					}
+				}
+			}
+
+			// nodes of a wave don't depend on each other, thread safe ones run as jobs
+			bool isParallel = pending.size() > 1;
+			JobCounter counter;
+			for (PCGNode* node : pending)
+			{
+				if (isParallel && node->isThreadSafe())
+					JobSystem::instance()->run([node]() { runNode(node); }, &counter);
+			}
+
+			for (PCGNode* node : pending)
+			{
+				if (!isParallel || !node->isThreadSafe())
+					runNode(node);
+			}
+
+			JobSystem::instance()->wait(counter);
 		}
 	}
 
-	void PCGFlowGraph::runNode(PCGNode* node)
+	void PCGFlowGraph::buildWaves()
 	{
-		for (PCGConnectPoint* input : node->getDependentInputs())
+		m_waves.clear();
+
+		// every connect counts here, so the order holds whichever inputs a node depends on when run
+		map<PCGNode*, i32>::type pendingInputs;
+		map<PCGNode*, vector<PCGNode*>::type>::type downstreams;
+		for (PCGNode* node : m_nodes)
+			pendingInputs[node] = 0;
+
+		for (PCGConnect* connect : m_connects)
 		{
-			PCGConnectPoint* from = input->getDependEndPoint();
-			if (from)
+			if (connect->getFrom() && connect->getTo())
 			{
-				runNode(from->getOwner());
+				pendingInputs[connect->getTo()->getOwner()]++;
+				downstreams[connect->getFrom()->getOwner()].emplace_back(connect->getTo()->getOwner());
 			}
 		}
 
-		if (node->check())
-			node->run();
+		vector<PCGNode*>::type wave;
+		for (PCGNode* node : m_nodes)
+		{
+			if (!pendingInputs[node])
+				wave.emplace_back(node);
+		}
+
+		size_t sortedCount = 0;
+		while (!wave.empty())
+		{
+			vector<PCGNode*>::type nextWave;
+			for (PCGNode* node : wave)
+			{
+				for (PCGNode* downstream : downstreams[node])
+				{
+					if (--pendingInputs[downstream] == 0)
+						nextWave.emplace_back(downstream);
+				}
+			}
+
+			sortedCount += wave.size();
+			m_waves.emplace_back(wave);
+			wave.swap(nextWave);
+		}
+
+		if (sortedCount < m_nodes.size())
+			EchoLogError("PCGFlowGraph [%s] has a cycle, nodes on it never run", getName().c_str());
+	}
+
+	void PCGFlowGraph::collectRequiredNodes(PCGNode* node, set<PCGNode*>::type& required)
+	{
+		if (required.insert(node).second)
+		{
+			for (PCGConnectPoint* input : node->getDependentInputs())
+			{
+				PCGConnectPoint* from = input->getDependEndPoint();
+				if (from)
+					collectRequiredNodes(from->getOwner(), required);
+			}
+		}
+	}
+
+	size_t PCGFlowGraph::calcInputHash(PCGNode* node)
+	{
+		size_t hash = 0;
+		auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+		for (PCGConnectPoint* input : node->getDependentInputs())
+		{
+			PCGConnectPoint* from = input->getDependEndPoint();
+			combine(std::hash<PCGConnectPoint*>()(from));
+			combine(from ? from->getOwner()->getVersion() : 0);
+		}
+
+		return hash;
+	}
+
+	void PCGFlowGraph::runNode(PCGNode* node)
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		node->run();
+		node->m_dirtyFlag = false;
+		node->m_version++;
+
+		node->m_runTime = ui32(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
 	}
 
 	bool PCGFlowGraph::isNodeExist(PCGNode* node)
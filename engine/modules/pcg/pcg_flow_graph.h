@@ -57,13 +57,24 @@ namespace Echo
 		void makeNameUnique(PCGNode* node);
 
 	private:
+		// sort nodes into waves, a node only depends on nodes of earlier waves
+		void buildWaves();
+
+		// nodes the output depends on this run
+		void collectRequiredNodes(PCGNode* node, set<PCGNode*>::type& required);
+
+		// hash of the upstream nodes and their versions
+		size_t calcInputHash(PCGNode* node);
+
 		// Run
-		void runNode(PCGNode* node);
+		static void runNode(PCGNode* node);
 
 	protected:
-		String						m_graph;
-		vector<PCGNode*>::type		m_nodes;
-		PCGNode*					m_nodeOutput = nullptr;
-		std::vector<PCGConnect*>	m_connects;
+		String									m_graph;
+		vector<PCGNode*>::type					m_nodes;
+		PCGNode*								m_nodeOutput = nullptr;
+		std::vector<PCGConnect*>				m_connects;
+		bool									m_isWavesDirty = true;
+		vector<vector<PCGNode*>::type>::type	m_waves;
 	};
 }
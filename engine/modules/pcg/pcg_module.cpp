@@ -1,9 +1,14 @@
 #include "pcg_module.h"
 #include "pcg_flow_graph.h"
 #include "node/primitive/pcg_box.h"
+#include "node/primitive/pcg_grid.h"
+#include "node/primitive/pcg_sphere.h"
 #include "node/image/pcg_image_perlin_noise.h"
 #include "node/image/pcg_image_voronoi.h"
 #include "node/image/pcg_image_save.h"
+#include "node/image/pcg_image_multiply.h"
+#include "node/image/pcg_image_substract.h"
+#include "node/image/pcg_image_scale.h"
 #include "node/terrain/pcg_heightfield_output.h"
 #include "editor/pcg_flow_graph_editor.h"
 
@@ -33,10 +38,15 @@ namespace Echo
 
 		Class::registerType<PCGNode>();
 		Class::registerType<PCGBox>();
+		Class::registerType<PCGGrid>();
+		Class::registerType<PCGSphere>();
 
 		Class::registerType<PCGImagePerlinNoise>();
 		Class::registerType<PCGImageVoronoi>();
 		Class::registerType<PCGImageSave>();
+		Class::registerType<PCGImageMultiply>();
+		Class::registerType<PCGImageSubstract>();
+		Class::registerType<PCGImageScale>();
 
 		Class::registerType<PCGHeightfieldOutput>();
 
@@ -37,6 +37,10 @@ namespace Echo
 
 	PhysxModule::PhysxModule()
 	{
+		// simulation runs before nodes sync their transforms from physx bodies
+		setUpdatePhase(UpdatePhase::Physics);
+		setUpdateAccess(Access_Physics3D, Access_Physics3D, false);
+
 		if (initPhysx())
 		{
 			physx::PxSceneDesc pxDesc(m_pxPhysics->getTolerancesScale());
@@ -192,8 +196,16 @@ namespace Echo
 
 				m_accumulator -= m_stepLength;
 			}
+		}
+	}
+
+	void PhysxModule::lateUpdate(float elapsedTime)
+	{
+		if (m_pxScene)
+		{
+			bool isGame = Engine::instance()->getConfig().m_isGame;
 
-			// draw debug data
+			// draw debug data, gizmos create render proxies so this stays off the workers
 			const StringOption& debugDrawOption = PhysxModule::instance()->getDebugDrawOption();
 			if (debugDrawOption.getIdx() == 3 || (debugDrawOption.getIdx() == 1 && !isGame) || (debugDrawOption.getIdx() == 2 && isGame))
 			{
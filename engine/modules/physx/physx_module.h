@@ -28,6 +28,9 @@ namespace Echo
 		// update physx world
 		virtual void update(float elapsedTime) override;
 
+		// debug draw, on the main thread
+		virtual void lateUpdate(float elapsedTime) override;
+
 		// get pxPhysics
 		physx::PxPhysics* getPxPhysics() { return m_pxPhysics; }
 
@@ -12,6 +12,9 @@ namespace Echo
 		m_rvoSimulator = EchoNew(RVO::RVOSimulator);
 		m_rvoSimulator->setTimeStep(0.1f);
 		m_rvoSimulator->setAgentDefaults(15.0f, 10, 10.0f, 5.0f, 2.0f, 2.0f);
+
+		// crowd simulation, agents sync with nodes in their own update
+		setUpdateAccess(Access_Navigation, Access_Navigation, false);
 	}
 
 	RvoModule::~RvoModule()
@@ -61,7 +64,11 @@ namespace Echo
 
 			m_accumulator -= stepLength;
 		}
+	}
 
+	void RvoModule::lateUpdate(float elapsedTime)
+	{
+		// gizmos create render proxies, so debug draw stays on the main thread
 		if ((m_debugDrawOption == DebugDrawOption::All) || 
 			(m_debugDrawOption == DebugDrawOption::Editor && !IsGame) || 
 			(m_debugDrawOption == DebugDrawOption::Game && IsGame))
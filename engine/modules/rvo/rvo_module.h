@@ -33,6 +33,9 @@ namespace Echo
 		// Update physx world
 		virtual void update(float elapsedTime) override;
 
+		// Debug draw, on the main thread
+		virtual void lateUpdate(float elapsedTime) override;
+
 	public:
 		// Rvo simulator
 		RVO::RVOSimulator* getRvoSimulator() { return m_rvoSimulator; }
@@ -4,10 +4,19 @@
 #include "base/renderer.h"
 #include "base/shader/shader_program.h"
 #include "engine/core/main/Engine.h"
+#include "engine/core/util/PathUtil.h"
+#include "engine/core/io/memory_reader.h"
 #include "engine/modules/ui/font/font_library.h"
+#include <thirdparty/pugixml/pugixml.hpp>
 
 namespace Echo
 {
+    // chunk meshes built a frame, the rest wait for later frames
+    static const i32 MaxTileBuildsPerFrame = 4;
+
+    // frames unused chunks are kept before their meshes are released
+    static const ui32 TileKeepFrames = 120;
+
     Terrain::Terrain()
     {
         setRenderType("3d");
@@ -16,6 +25,8 @@ namespace Echo
     Terrain::~Terrain()
     {
         clear();
+        EchoSafeDelete(m_heightmapImage, Image);
+        EchoSafeDeleteContainer(m_layerImages, Image);
     }
     
     void Terrain::bindMethods()
@@ -28,12 +39,16 @@ namespace Echo
 		CLASS_BIND_METHOD(Terrain, setHeightRange);
 		CLASS_BIND_METHOD(Terrain, getGridSpacing);
 		CLASS_BIND_METHOD(Terrain, setGridSpacing);
+		CLASS_BIND_METHOD(Terrain, getLodFactor);
+		CLASS_BIND_METHOD(Terrain, setLodFactor);
+        CLASS_BIND_METHOD(Terrain, saveTiles);
         CLASS_BIND_METHOD(Terrain, getMaterial);
         CLASS_BIND_METHOD(Terrain, setMaterial);
         
         CLASS_REGISTER_PROPERTY(Terrain, "Data", Variant::Type::ResourcePath, getDataPath, setDataPath);
 		CLASS_REGISTER_PROPERTY(Terrain, "HeightRange", Variant::Type::Real, getHeightRange, setHeightRange);
 		CLASS_REGISTER_PROPERTY(Terrain, "GridSpacing", Variant::Type::Int, getGridSpacing, setGridSpacing);
+		CLASS_REGISTER_PROPERTY(Terrain, "LodFactor", Variant::Type::Real, getLodFactor, setLodFactor);
         CLASS_REGISTER_PROPERTY(Terrain, "Material", Variant::Type::Object, getMaterial, setMaterial);
         CLASS_REGISTER_PROPERTY_HINT(Terrain, "Material", PropertyHintType::ObjectType, "Material");
     }
@@ -45,6 +60,26 @@ namespace Echo
 
         if (m_dataPath.setPath(path.getPath()))
         {
+            // tiles are streamed as the camera needs them, the heightmap isn't loaded at all
+            m_isTiled = false;
+            String tilesPath = m_dataPath.getPath() + "tiles/tiles.xml";
+            if (IO::instance()->isExist(tilesPath))
+            {
+                MemoryReader reader(tilesPath);
+                pugi::xml_document doc;
+                if (reader.getSize() && doc.load_buffer(reader.getData<char*>(), reader.getSize()))
+                {
+                    pugi::xml_node root = doc.child("tiles");
+                    m_rows = root.attribute("rows").as_int();
+                    m_columns = root.attribute("columns").as_int();
+                    m_levels = root.attribute("levels").as_int();
+                    m_heightData.clear();
+                    m_isTiled = true;
+                    m_isRenderableDirty = true;
+                    return;
+                }
+            }
+
             String heightmapPath = m_dataPath.getPath() + "heightmap.png";
             if (IO::instance()->isExist(heightmapPath))
             {
@@ -89,6 +124,7 @@ namespace Echo
         m_rows = width;
         m_columns = height;
         m_heightData = heightData;
+        m_isTiled = false;
 
         m_isRenderableDirty = true;
     }
@@ -107,6 +143,11 @@ namespace Echo
         m_isRenderableDirty = true;
 	}
 
+	void Terrain::setLodFactor(float lodFactor)
+	{
+		m_lodFactor = Math::Max(lodFactor, 0.f);
+	}
+
     void Terrain::setMaterial( Object* material)
     {
         m_material = (Material*)material;
@@ -116,7 +157,7 @@ namespace Echo
     
     void Terrain::buildRenderable()
     {
-        if (m_isRenderableDirty && m_columns > 0 && m_rows > 0)
+        if (m_isRenderableDirty && m_columns > 1 && m_rows > 1)
         {
             clearRenderable();
             
@@ -129,12 +170,16 @@ namespace Echo
                 m_material = ECHO_CREATE_RES(Material);
                 m_material->setShaderPath(shader->getPath());
             }
-            
-            // mesh
-			updateMeshBuffer();
-            
-			// create renderable
-            m_renderable = RenderProxy::create(m_mesh, m_material, this, true);
+
+            // levels until one chunk covers the terrain, tiled data knows its own
+            if (!m_isTiled)
+            {
+                i32 quads = Math::Max(m_rows, m_columns) - 1;
+                for (m_levels = 0; (TerrainTile::ChunkQuads << m_levels) < quads; m_levels++);
+            }
+
+            m_root = EchoNew(TerrainTile(this, m_levels, 0, 0));
+            m_localAABB = m_root->getLocalAABB();
             
             m_isRenderableDirty = false;
         }
@@ -145,75 +190,172 @@ namespace Echo
         if (isNeedRender())
             buildRenderable();
 
-        if (m_renderable)
-            m_renderable->setSubmitToRenderQueue(isNeedRender());
-    }
-    
-    void Terrain::buildMeshData(VertexArray& oVertices, IndiceArray& oIndices)
-    {
-        if(m_columns>0 && m_rows>0)
+        vector<TerrainTile*>::type lastVisibleTiles;
+        lastVisibleTiles.swap(m_visibleTiles);
+
+        if (isNeedRender())
         {
-            // vertex buffer
-			for (i32 row = 0; row < m_rows; row++)
+            Camera* camera = NodeTree::instance()->get3dCamera();
+            if (m_root && camera)
             {
-				for (i32 column = 0; column < m_columns; column++)
+                Matrix4 worldToLocal = getWorldMatrix();
+                worldToLocal.detInverse();
+                Vector3 cameraPosition = worldToLocal.transform(camera->getPosition());
+
+                // the root is always built, it draws while finer chunks load
+                m_frame++;
+                i32 buildBudget = MaxTileBuildsPerFrame;
+                i32 rootBudget = 1;
+                if (m_root->prepare(rootBudget))
                 {
-                    VertexFormat vert;
-                    vert.m_position = Vector3(row * m_gridSpacing, getHeight(row, column), column * m_gridSpacing);
-                    vert.m_color = 0xFFFFFFFF;
-                    vert.m_normal = getNormal(row, column);
-                    vert.m_uv = Vector2(row, column);
-                    vert.m_layerIndices = Color(0, 1, 2, 3).getABGR();
-
-                    float weight = Math::IntervalRandom(0.f, 1.f);
-                    vert.m_layerWeights = Vector4(getWeight(row, column, 0), getWeight(row, column, 1), getWeight(row, column, 2), getWeight(row, column, 3));
-                    oVertices.emplace_back(vert);
+                    selectTiles(m_root, cameraPosition, buildBudget);
+                    m_localAABB = m_root->getLocalAABB();
                 }
             }
-            
-            // index buffer
-			i32 rowLength = m_rows - 1;
-			i32 columnLength = m_columns - 1;
-			for (i32 row = 0; row < rowLength; row++)
-			{
-				for (i32 column = 0; column < columnLength; column++)
+        }
+
+        for (TerrainTile* tile : lastVisibleTiles)
+        {
+            if (std::find(m_visibleTiles.begin(), m_visibleTiles.end(), tile) == m_visibleTiles.end())
+                tile->setVisible(false);
+        }
+    }
+
+    void Terrain::selectTiles(TerrainTile* tile, const Vector3& cameraPosition, i32& buildBudget)
+    {
+        tile->m_lastUsedFrame = m_frame;
+
+        // distance to the chunk bounds against the split range of its level
+        const AABB& aabb = tile->getLocalAABB();
+        Vector3 nearest(Math::Clamp(cameraPosition.x, aabb.vMin.x, aabb.vMax.x), Math::Clamp(cameraPosition.y, aabb.vMin.y, aabb.vMax.y), Math::Clamp(cameraPosition.z, aabb.vMin.z, aabb.vMax.z));
+        float splitRange = m_lodFactor * TerrainTile::ChunkQuads * tile->getStride() * m_gridSpacing;
+
+        // split only when every child is ready, so the area never has a hole
+        bool isSplit = false;
+        if (tile->getLevel() > 0 && (nearest - cameraPosition).len() < splitRange)
+        {
+            isSplit = true;
+            for (i32 i = 0; i < 4; i++)
+            {
+                TerrainTile* child = tile->getChild(i);
+                if (child)
                 {
-                    i32 indexLeftTop = row * m_columns + column;
-                    i32 indexRightTop = indexLeftTop + 1;
-                    i32 indexLeftBottom = indexLeftTop + m_columns;
-                    i32 indexRightBottom = indexRightTop + m_columns;
-                    
-                    oIndices.emplace_back(indexLeftTop);
-                    oIndices.emplace_back(indexRightBottom);
-                    oIndices.emplace_back(indexRightTop);
-                    oIndices.emplace_back(indexLeftTop);
-                    oIndices.emplace_back(indexLeftBottom);
-                    oIndices.emplace_back(indexRightBottom);
+                    child->m_lastUsedFrame = m_frame;
+                    if (!child->prepare(buildBudget))
+                        isSplit = false;
                 }
             }
         }
+
+        if (isSplit)
+        {
+            for (i32 i = 0; i < 4; i++)
+            {
+                TerrainTile* child = tile->getChild(i);
+                if (child)
+                    selectTiles(child, cameraPosition, buildBudget);
+            }
+        }
+        else
+        {
+            tile->setVisible(true);
+            m_visibleTiles.emplace_back(tile);
+
+            // finer chunks stay a while, a camera moving back and forth doesn't reload them
+            if (m_frame > TileKeepFrames)
+                tile->releaseChildren(m_frame - TileKeepFrames);
+        }
     }
-    
-    void Terrain::updateMeshBuffer()
+
+    String Terrain::getTilePath(const char* prefix, i32 level, i32 x, i32 z) const
     {
-		// create mesh
-		if (!m_mesh) m_mesh = Mesh::create(true, true);
+        return m_dataPath.getPath() + StringUtil::Format("tiles/%s_%d_%d_%d.png", prefix, level, x, z);
+    }
 
-		// update data
-        VertexArray    vertices;
-        IndiceArray    indices;
-        buildMeshData(vertices, indices);
-        
-        MeshVertexFormat define;
-        define.m_isUseNormal = true;
-        define.m_isUseVertexColor = true;
-        define.m_isUseUV = true;
-        define.m_isUseBlendingData = true;
-        
-        m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(ui32), indices.data());
-        m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
+    bool Terrain::isTileInside(i32 level, i32 x, i32 z) const
+    {
+        i32 size = TerrainTile::ChunkQuads << level;
+        return x >= 0 && z >= 0 && x * size < m_rows - 1 && z * size < m_columns - 1;
+    }
+
+    void Terrain::sampleTile(i32 level, i32 x, i32 z, TerrainTile::Data& data)
+    {
+        i32 stride = 1 << level;
+        i32 sampleX = x * TerrainTile::ChunkQuads * stride;
+        i32 sampleZ = z * TerrainTile::ChunkQuads * stride;
+        for (i32 i = -1; i <= TerrainTile::ChunkQuads + 1; i++)
+        {
+            for (i32 j = -1; j <= TerrainTile::ChunkQuads + 1; j++)
+            {
+                // samples past the edge repeat it, same layout as getHeight
+                i32 sx = Math::Clamp(sampleX + i * stride, 0, m_rows - 1);
+                i32 sz = Math::Clamp(sampleZ + j * stride, 0, m_columns - 1);
+                i32 offset = sz * m_rows + sx;
+                i32 index = (i + 1) * TerrainTile::TileSamples + j + 1;
+
+                data.m_heights[index] = offset < i32(m_heightData.size()) ? m_heightData[offset] : 0.5f;
+                data.m_weights[index] = Vector4(getWeight(sx, sz, 0), getWeight(sx, sz, 1), getWeight(sx, sz, 2), getWeight(sx, sz, 3));
+            }
+        }
+    }
+
+    bool Terrain::saveTiles()
+    {
+        if (m_isTiled || m_rows < 2 || m_columns < 2 || m_dataPath.isEmpty())
+            return false;
+
+        String tilesDir = IO::instance()->convertResPathToFullPath(m_dataPath.getPath() + "tiles/");
+        PathUtil::CreateDir(tilesDir);
+
+        i32 levels = 0;
+        for (i32 quads = Math::Max(m_rows, m_columns) - 1; (TerrainTile::ChunkQuads << levels) < quads; levels++);
+
+        TerrainTile::Data data;
+        data.m_heights.resize(TerrainTile::TileSamples * TerrainTile::TileSamples);
+        data.m_weights.resize(TerrainTile::TileSamples * TerrainTile::TileSamples);
+        vector<Dword>::type heightPixels(data.m_heights.size());
+        vector<Dword>::type weightPixels(data.m_weights.size());
+        for (i32 level = 0; level <= levels; level++)
+        {
+            for (i32 x = 0; isTileInside(level, x, 0); x++)
+            {
+                for (i32 z = 0; isTileInside(level, x, z); z++)
+                {
+                    sampleTile(level, x, z, data);
+
+                    // image x is terrain x, heights keep 16 bits in red and green
+                    for (i32 i = 0; i < TerrainTile::TileSamples; i++)
+                    {
+                        for (i32 j = 0; j < TerrainTile::TileSamples; j++)
+                        {
+                            i32 index = i * TerrainTile::TileSamples + j;
+                            ui32 height = ui32(Math::Clamp(data.m_heights[index], 0.f, 1.f) * 65535.f + 0.5f);
+                            const Vector4& weight = data.m_weights[index];
+
+                            heightPixels[j * TerrainTile::TileSamples + i] = Color((height >> 8) / 255.f, (height & 0xFF) / 255.f, 0.f, 1.f).getABGR();
+                            weightPixels[j * TerrainTile::TileSamples + i] = Color(weight.x, weight.y, weight.z, weight.w).getABGR();
+                        }
+                    }
+
+                    Image heightImage((Byte*)heightPixels.data(), TerrainTile::TileSamples, TerrainTile::TileSamples, 1, PF_RGBA8_UNORM);
+                    Image weightImage((Byte*)weightPixels.data(), TerrainTile::TileSamples, TerrainTile::TileSamples, 1, PF_RGBA8_UNORM);
+                    if (!heightImage.saveToFile(IO::instance()->convertResPathToFullPath(getTilePath("height", level, x, z)), IF_PNG) ||
+                        !weightImage.saveToFile(IO::instance()->convertResPathToFullPath(getTilePath("weight", level, x, z)), IF_PNG))
+                    {
+                        EchoLogError("Terrain save tiles to [%s] failed", tilesDir.c_str());
+                        return false;
+                    }
+                }
+            }
+        }
+
+        pugi::xml_document doc;
+        pugi::xml_node root = doc.append_child("tiles");
+        root.append_attribute("rows").set_value(m_rows);
+        root.append_attribute("columns").set_value(m_columns);
+        root.append_attribute("levels").set_value(levels);
 
-        m_localAABB = m_mesh->getLocalBox();
+        return doc.save_file((tilesDir + "tiles.xml").c_str(), "\t", 1U, pugi::encoding_utf8);
     }
     
     void Terrain::clear()
@@ -223,8 +365,8 @@ namespace Echo
     
     void Terrain::clearRenderable()
     {
-        m_renderable.reset();
-        m_mesh.reset();
+        m_visibleTiles.clear();
+        EchoSafeDelete(m_root, TerrainTile);
     }
     
     float Terrain::getHeight(i32 x, i32 z)
@@ -49,6 +49,10 @@ namespace Echo
 		// grid spacing
 		i32 getGridSpacing() const { return m_gridSpacing; }
 		void setGridSpacing(i32 gridSpacing);
+
+		// a chunk splits into four when the camera is closer than this many chunk sizes
+		float getLodFactor() const { return m_lodFactor; }
+		void setLodFactor(float lodFactor);
         
         // material
         Material* getMaterial() const { return m_material; }
@@ -62,20 +66,33 @@ namespace Echo
 
         // get weight
         float getWeight(i32 x, i32 z, i32 index);
+
+    public:
+        // streamed from "tiles/" of the data path instead of held in memory
+        bool isTiled() const { return m_isTiled; }
+
+        // tile file of a chunk
+        String getTilePath(const char* prefix, i32 level, i32 x, i32 z) const;
+
+        // is a chunk over the terrain
+        bool isTileInside(i32 level, i32 x, i32 z) const;
+
+        // samples of a chunk from the heights in memory
+        void sampleTile(i32 level, i32 x, i32 z, TerrainTile::Data& data);
+
+        // write the chunks of every level as tiles to the data path, so the terrain is streamed
+        bool saveTiles();
         
     protected:
-        // build drawable
+        // build quadtree
         void buildRenderable();
         void clearRenderable();
         
         // update
         virtual void updateInternal(float elapsedTime) override;
-        
-        // update vertex buffer
-        void updateMeshBuffer();
-        
-        // build mesh data by drawables data
-        void buildMeshData(VertexArray& oVertices, IndiceArray& oIndices);
+
+        // choose chunks to draw, finer ones closer to the camera
+        void selectTiles(TerrainTile* tile, const Vector3& cameraPosition, i32& buildBudget);
         
         // clear
         void clear();
@@ -87,12 +104,15 @@ namespace Echo
         vector<Image*>::type    m_layerImages;
 		float					m_heightRange = 256.f;
 		i32						m_gridSpacing = 1;
-        MeshPtr                 m_mesh;
+		float					m_lodFactor = 2.f;
         MaterialPtr             m_material;
-        RenderProxyPtr          m_renderable = nullptr;
         i32                     m_columns = 0;
         i32                     m_rows = 0;
         vector<float>::type     m_heightData;
-		//TerrainTiles			m_tiles;
+        bool                    m_isTiled = false;
+        i32                     m_levels = 0;
+        TerrainTile*            m_root = nullptr;
+        vector<TerrainTile*>::type m_visibleTiles;
+        ui32                    m_frame = 0;
     };
 }
@@ -1,15 +1,259 @@
 #include "terrain.h"
 #include "terrain_tile.h"
+#include "engine/core/io/memory_reader.h"
+#include "engine/core/thread/JobSystem.h"
+#include "engine/core/util/Buffer.h"
 
 namespace Echo
 {
-	TerrainTile::TerrainTile()
+	// decode a tile image, heights are 16 bit in red (high) and green (low)
+	static bool loadTileImage(const String& path, bool isHeight, TerrainTile::Data& data)
 	{
+		MemoryReader reader(path);
+		if (!reader.getSize())
+			return false;
 
+		Image* image = Image::createFromMemory(Buffer(reader.getSize(), reader.getData<ui8*>(), false), Image::GetImageFormat(path));
+		if (!image)
+			return false;
+
+		bool result = false;
+		if (image->getWidth() == TerrainTile::TileSamples && image->getHeight() == TerrainTile::TileSamples)
+		{
+			vector<Color>::type colors = image->getColors();
+			for (i32 i = 0; i < TerrainTile::TileSamples; i++)
+			{
+				for (i32 j = 0; j < TerrainTile::TileSamples; j++)
+				{
+					const Color& color = colors[j * TerrainTile::TileSamples + i];
+					if (isHeight)
+						data.m_heights[i * TerrainTile::TileSamples + j] = (std::round(color.r * 255.f) * 256.f + std::round(color.g * 255.f)) / 65535.f;
+					else
+						data.m_weights[i * TerrainTile::TileSamples + j] = Vector4(color.r, color.g, color.b, color.a);
+				}
+			}
+
+			result = true;
+		}
+
+		EchoSafeDelete(image, Image);
+		return result;
+	}
+
+	TerrainTile::TerrainTile(Terrain* terrain, i32 level, i32 x, i32 z)
+		: m_terrain(terrain)
+		, m_level(level)
+		, m_x(x)
+		, m_z(z)
+	{
+		// the whole area and height range, until samples tell better
+		float size = float(ChunkQuads * getStride() * m_terrain->getGridSpacing());
+		float range = m_terrain->getHeightRange();
+		m_localAABB = AABB(m_x * size, -range, m_z * size, (m_x + 1) * size, range, (m_z + 1) * size);
 	}
 
 	TerrainTile::~TerrainTile()
 	{
+		for (TerrainTile*& child : m_children)
+			EchoSafeDelete(child, TerrainTile);
+
+		m_proxy.reset();
+		m_mesh.reset();
+	}
+
+	TerrainTile* TerrainTile::getChild(i32 index)
+	{
+		if (m_level > 0 && !m_children[index])
+		{
+			i32 x = m_x * 2 + (index & 1);
+			i32 z = m_z * 2 + (index >> 1);
+			if (m_terrain->isTileInside(m_level - 1, x, z))
+				m_children[index] = EchoNew(TerrainTile(m_terrain, m_level - 1, x, z));
+		}
+
+		return m_children[index];
+	}
+
+	void TerrainTile::releaseChildren(ui32 frame)
+	{
+		for (TerrainTile*& child : m_children)
+		{
+			if (child && child->m_lastUsedFrame < frame)
+				EchoSafeDelete(child, TerrainTile);
+		}
+	}
+
+	bool TerrainTile::prepare(i32& buildBudget)
+	{
+		if (m_state == State::Unloaded)
+		{
+			m_data = std::make_shared<Data>();
+			m_data->m_heights.assign(TileSamples * TileSamples, 0.f);
+			m_data->m_weights.assign(TileSamples * TileSamples, Vector4::ZERO);
+
+			if (m_terrain->isTiled())
+			{
+				// streamed tiles are read and decoded by a job, the data outlives this tile if it goes first
+				DataPtr data = m_data;
+				String heightPath = m_terrain->getTilePath("height", m_level, m_x, m_z);
+				String weightPath = m_terrain->getTilePath("weight", m_level, m_x, m_z);
+				JobSystem::instance()->runBackground([data, heightPath, weightPath]()
+				{
+					data->m_isValid = loadTileImage(heightPath, true, *data);
+					if (data->m_isValid)
+						loadTileImage(weightPath, false, *data);
+
+					data->m_isDone = true;
+				});
+
+				m_state = State::Loading;
+			}
+			else
+			{
+				m_terrain->sampleTile(m_level, m_x, m_z, *m_data);
+				m_state = State::Loaded;
+			}
+		}
+
+		if (m_state == State::Loading && m_data->m_isDone)
+			m_state = m_data->m_isValid ? State::Loaded : State::Failed;
+
+		if (m_state == State::Loaded && buildBudget > 0)
+		{
+			buildMesh();
+			buildBudget--;
+
+			// samples aren't needed once they are in the mesh
+			m_data.reset();
+			m_state = State::Ready;
+		}
+
+		return m_state == State::Ready;
+	}
+
+	void TerrainTile::buildMesh()
+	{
+		const vector<float>::type& heights = m_data->m_heights;
+		i32 stride = getStride();
+		float spacing = float(m_terrain->getGridSpacing());
+		float range = m_terrain->getHeightRange();
+		i32 sampleX = m_x * ChunkQuads * stride;
+		i32 sampleZ = m_z * ChunkQuads * stride;
+		i32 maxSampleX = m_terrain->getRows() - 1;
+		i32 maxSampleZ = m_terrain->getColumns() - 1;
+
+		auto toHeight = [range](float sample) { return (sample * 2.f - 1.f) * range; };
+
+		// grid vertices, samples past the terrain edge collapse onto it
+		Terrain::VertexArray vertices;
+		Terrain::IndiceArray indices;
+		vertices.reserve((ChunkQuads + 1) * (ChunkQuads + 5));
+		for (i32 i = 0; i <= ChunkQuads; i++)
+		{
+			for (i32 j = 0; j <= ChunkQuads; j++)
+			{
+				i32 x = Math::Min(sampleX + i * stride, maxSampleX);
+				i32 z = Math::Min(sampleZ + j * stride, maxSampleZ);
+				float h0 = toHeight(getSample(heights, i, j));
+				float hxm = toHeight(getSample(heights, i - 1, j));
+				float hxp = toHeight(getSample(heights, i + 1, j));
+				float hzm = toHeight(getSample(heights, i, j - 1));
+				float hzp = toHeight(getSample(heights, i, j + 1));
+
+				Terrain::VertexFormat vert;
+				vert.m_position = Vector3(x * spacing, h0, z * spacing);
+				vert.m_normal = Vector3(hxm - hxp, 2.f * stride * spacing, hzm - hzp);
+				vert.m_normal.normalize();
+				vert.m_color = 0xFFFFFFFF;
+				vert.m_uv = Vector2(float(x), float(z));
+				vert.m_layerIndices = Color(0, 1, 2, 3).getABGR();
+				vert.m_layerWeights = m_data->m_weights[(i + 1) * TileSamples + j + 1];
+				vertices.emplace_back(vert);
+			}
+		}
+
+		for (i32 i = 0; i < ChunkQuads; i++)
+		{
+			for (i32 j = 0; j < ChunkQuads; j++)
+			{
+				ui32 indexLeftTop = i * (ChunkQuads + 1) + j;
+				ui32 indexRightTop = indexLeftTop + 1;
+				ui32 indexLeftBottom = indexLeftTop + ChunkQuads + 1;
+				ui32 indexRightBottom = indexRightTop + ChunkQuads + 1;
+
+				indices.emplace_back(indexLeftTop);
+				indices.emplace_back(indexRightBottom);
+				indices.emplace_back(indexRightTop);
+				indices.emplace_back(indexLeftTop);
+				indices.emplace_back(indexLeftBottom);
+				indices.emplace_back(indexRightBottom);
+			}
+		}
+
+		// skirts hide the cracks to neighbors of other levels, deep enough for the chunk's own relief
+		float minHeight = Math::MAX_REAL;
+		float maxHeight = -Math::MAX_REAL;
+		for (const Terrain::VertexFormat& vert : vertices)
+		{
+			minHeight = Math::Min(minHeight, vert.m_position.y);
+			maxHeight = Math::Max(maxHeight, vert.m_position.y);
+		}
 
+		float skirtDepth = maxHeight - minHeight + stride * spacing;
+		for (i32 edge = 0; edge < 4; edge++)
+		{
+			ui32 skirtBegin = ui32(vertices.size());
+			for (i32 k = 0; k <= ChunkQuads; k++)
+			{
+				i32 i = edge == 0 ? 0 : (edge == 1 ? ChunkQuads : k);
+				i32 j = edge == 2 ? 0 : (edge == 3 ? ChunkQuads : k);
+
+				Terrain::VertexFormat vert = vertices[i * (ChunkQuads + 1) + j];
+				vert.m_position.y -= skirtDepth;
+				vertices.emplace_back(vert);
+			}
+
+			// both windings, a skirt is seen from either side
+			for (i32 k = 0; k < ChunkQuads; k++)
+			{
+				i32 i0 = edge == 0 ? 0 : (edge == 1 ? ChunkQuads : k);
+				i32 j0 = edge == 2 ? 0 : (edge == 3 ? ChunkQuads : k);
+				i32 i1 = edge < 2 ? i0 : i0 + 1;
+				i32 j1 = edge < 2 ? j0 + 1 : j0;
+
+				ui32 top0 = i0 * (ChunkQuads + 1) + j0;
+				ui32 top1 = i1 * (ChunkQuads + 1) + j1;
+				ui32 bottom0 = skirtBegin + k;
+				ui32 bottom1 = skirtBegin + k + 1;
+
+				ui32 quad[12] = { top0, bottom0, bottom1, top0, bottom1, top1, top0, bottom1, bottom0, top0, top1, bottom1 };
+				indices.insert(indices.end(), quad, quad + 12);
+			}
+		}
+
+		m_localAABB.reset();
+		for (const Terrain::VertexFormat& vert : vertices)
+			m_localAABB.addPoint(vert.m_position);
+
+		MeshVertexFormat define;
+		define.m_isUseNormal = true;
+		define.m_isUseVertexColor = true;
+		define.m_isUseUV = true;
+		define.m_isUseBlendingData = true;
+
+		m_mesh = Mesh::create(true, true);
+		m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(ui32), indices.data());
+		m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
+
+		m_proxy = RenderProxy::create(m_mesh, m_terrain->getMaterial(), m_terrain, true);
+		if (m_proxy)
+			m_proxy->setLocalAABB(m_localAABB);
+	}
+
+	void TerrainTile::setVisible(bool visible)
+	{
+		m_isVisible = visible;
+		if (m_proxy)
+			m_proxy->setSubmitToRenderQueue(visible);
 	}
 }
@@ -1,16 +1,103 @@
 #pragma once
 
+#include <memory>
+#include <atomic>
+#include "engine/core/render/base/mesh/mesh.h"
+#include "engine/core/render/base/proxy/render_proxy.h"
+
 namespace Echo
 {
 	class Terrain;
+
+	// A chunk of the terrain quadtree. Every chunk draws a grid of ChunkQuads x ChunkQuads quads,
+	// a chunk of the next level covers the area of four with every second sample. Height and
+	// layer weights of a chunk are loaded on demand and released when the chunk goes unused.
     class TerrainTile
     {
     public:
-		TerrainTile();
+		// quads along a chunk edge
+		static const i32 ChunkQuads = 32;
+
+		// samples along a tile edge, one sample apron on each side for normals
+		static const i32 TileSamples = ChunkQuads + 3;
+
+		// state
+		enum class State
+		{
+			Unloaded,
+			Loading,
+			Loaded,
+			Ready,
+			Failed,
+		};
+
+		// samples of a tile, filled by a job when streamed from disk
+		struct Data
+		{
+			std::atomic<bool>		m_isDone;
+			bool					m_isValid = false;
+			vector<float>::type		m_heights;		// [0, 1], TileSamples x TileSamples, x major
+			vector<Vector4>::type	m_weights;
+
+			Data() : m_isDone(false) {}
+		};
+		typedef std::shared_ptr<Data> DataPtr;
+
+    public:
+		TerrainTile(Terrain* terrain, i32 level, i32 x, i32 z);
 		~TerrainTile();
 
+		// level, 0 is full resolution
+		i32 getLevel() const { return m_level; }
+
+		// chunk coordinates in its level
+		i32 getX() const { return m_x; }
+		i32 getZ() const { return m_z; }
+
+		// samples between neighbor vertices
+		i32 getStride() const { return 1 << m_level; }
+
+		// state
+		State getState() const { return m_state; }
+		bool isReady() const { return m_state == State::Ready; }
+
+		// bounds in terrain space, of the whole chunk area until loaded
+		const AABB& getLocalAABB() const { return m_localAABB; }
+
+		// child, created on first use, nullptr when it lies outside the terrain
+		TerrainTile* getChild(i32 index);
+
+		// release children not used since frame
+		void releaseChildren(ui32 frame);
+
+		// load data and build the mesh, a mesh build consumes budget. returns true when ready
+		bool prepare(i32& buildBudget);
+
+		// submit to render queue or not
+		void setVisible(bool visible);
+		bool isVisible() const { return m_isVisible; }
+
+	public:
+		ui32					m_lastUsedFrame = 0;
+
+	private:
+		// build mesh by samples
+		void buildMesh();
+
+		// height sample of the tile grid, apron at -1 and ChunkQuads + 1
+		float getSample(const vector<float>::type& heights, i32 i, i32 j) const { return heights[(i + 1) * TileSamples + j + 1]; }
+
 	private:
-		//Terrain*	m_terrain;
+		Terrain*				m_terrain = nullptr;
+		i32						m_level = 0;
+		i32						m_x = 0;
+		i32						m_z = 0;
+		State					m_state = State::Unloaded;
+		DataPtr					m_data;
+		AABB					m_localAABB;
+		MeshPtr					m_mesh;
+		RenderProxyPtr			m_proxy;
+		bool					m_isVisible = false;
+		TerrainTile*			m_children[4] = { nullptr, nullptr, nullptr, nullptr };
     };
-	typedef map<String, TerrainTile*> TerrainTiles;
 }
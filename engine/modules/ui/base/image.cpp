@@ -15,7 +15,6 @@ namespace Echo
     
     UiImage::~UiImage()
     {
-        clear();
     }
     
     void UiImage::bindMethods()
@@ -48,7 +47,7 @@ namespace Echo
         {
             m_width = width;
             
-            clearRenderable();
+            markGeometryDirty();
         }
     }
     
@@ -58,7 +57,7 @@ namespace Echo
         {
             m_height = height;
             
-            clearRenderable();
+            markGeometryDirty();
         }
     }
 
@@ -68,7 +67,7 @@ namespace Echo
         {
             m_anchor = anchor;
 
-            clearRenderable();
+            markGeometryDirty();
         }
     }
 
@@ -76,7 +75,7 @@ namespace Echo
     {
         if (m_textureRes.setPath(path.getPath()))
         {
-            clearRenderable();
+            markGeometryDirty();
         }
     }
 
@@ -86,7 +85,7 @@ namespace Echo
         {
             m_color = color;
 
-            clearRenderable();
+            markGeometryDirty();
         }
     }
 
@@ -95,57 +94,55 @@ namespace Echo
         if (m_material != material)
         {
             m_material = (Material*)material;
-            clearRenderable();
+            markGeometryDirty();
         }    
     }
     
-    void UiImage::buildRenderable()
+    Material* UiImage::prepareMaterial()
     {
-        clearRenderable();
-                     
-        // Material
-        if(!m_material)
+        // a custom material is this image's own
+        if (m_material)
         {
-            const ResourcePath& defaultShader = UiModule::instance()->getUiImageDefaultShader();
+            if (!m_textureRes.getPath().empty() && m_material->isUniformExist("SrcTexture"))
+                m_material->setUniformTexture("SrcTexture", m_textureRes.getPath());
 
-            m_material = ECHO_CREATE_RES(Material);
-            m_material->setShaderPath(defaultShader);
+            if (m_material->isUniformExist("SrcColor"))
+                m_material->setUniformValue("SrcColor", &m_color);
+
+            return m_material;
         }
 
-        if (!m_textureRes.getPath().empty() && m_material && m_material->isUniformExist("SrcTexture"))
-            m_material->setUniformTexture("SrcTexture", m_textureRes.getPath());
+        // the tint is in the vertices, images of a texture share the material whatever their color
+        const ResourcePath& defaultShader = UiModule::instance()->getUiImageDefaultShader();
+        String key = StringUtil::Format("UiImage|%s|%s", m_textureRes.getPath().c_str(), defaultShader.getPath().c_str());
+        return UiBatcher::instance()->getMaterial(key, [this, &defaultShader]()
+        {
+            Material* material = ECHO_CREATE_RES(Material);
+            material->setShaderPath(defaultShader);
 
-        if (m_material && m_material->isUniformExist("SrcColor"))
-            m_material->setUniformValue("SrcColor", &m_color);
-            
-        // Mesh
-        Ui::VertexArray vertices;
-        Ui::IndiceArray indices;
-        buildMeshData(vertices, indices);
-            
-        MeshVertexFormat define;
-        define.m_isUseUV = true;
-            
-        m_mesh = Mesh::create(true, true);
-        m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(Word), indices.data());
-        m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
-            
-        m_renderable = RenderProxy::create(m_mesh, m_material, this, false);
+            if (!m_textureRes.getPath().empty() && material->isUniformExist("SrcTexture"))
+                material->setUniformTexture("SrcTexture", m_textureRes.getPath());
+
+            return material;
+        });
     }
-    
+
     void UiImage::updateInternal(float elapsedTime)
     {
         if (isNeedRender())
-        {
-            if (!m_renderable)
-                buildRenderable();
-        }
+            submitGeometry();
+    }
 
-        if (m_renderable)
-            m_renderable->setSubmitToRenderQueue(isNeedRender());
+    void UiImage::buildGeometry(UiBatchParts& parts)
+    {
+        UiBatchPart part;
+        part.m_material = prepareMaterial();
+        buildMeshData(part.m_vertices, part.m_indices, m_material ? Color::WHITE : m_color);
+
+        parts.emplace_back(part);
     }
     
-    void UiImage::buildMeshData(Ui::VertexArray& oVertices, Ui::IndiceArray& oIndices)
+    void UiImage::buildMeshData(Ui::VertexArray& oVertices, Ui::IndiceArray& oIndices, const Color& color)
     {    
         float hw = m_width * 0.5f;
         float hh = m_height * 0.5f;
@@ -153,10 +150,10 @@ namespace Echo
         Vector3 offset = Vector3(m_anchor.x, m_anchor.y, 0.0);
         
         // vertices
-        oVertices.emplace_back(Vector3(-hw, -hh, 0.f) + offset, Vector2(0.f, 1.f));
-        oVertices.emplace_back(Vector3(-hw,  hh, 0.f) + offset, Vector2(0.f, 0.f));
-        oVertices.emplace_back(Vector3(hw,   hh, 0.f) + offset, Vector2(1.f, 0.f));
-        oVertices.emplace_back(Vector3(hw,  -hh, 0.f) + offset, Vector2(1.f, 1.f));
+        oVertices.emplace_back(Vector3(-hw, -hh, 0.f) + offset, Vector2(0.f, 1.f), color);
+        oVertices.emplace_back(Vector3(-hw,  hh, 0.f) + offset, Vector2(0.f, 0.f), color);
+        oVertices.emplace_back(Vector3(hw,   hh, 0.f) + offset, Vector2(1.f, 0.f), color);
+        oVertices.emplace_back(Vector3(hw,  -hh, 0.f) + offset, Vector2(1.f, 1.f), color);
         
         // calc aabb
         m_localAABB.reset();
@@ -171,29 +168,4 @@ namespace Echo
         oIndices.emplace_back(2);
         oIndices.emplace_back(3);
     }
-    
-    void UiImage::updateMeshBuffer()
-    {
-        Ui::VertexArray    vertices;
-        Ui::IndiceArray    indices;
-        buildMeshData(vertices, indices);
-        
-        MeshVertexFormat define;
-        define.m_isUseUV = true;
-        
-        m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(Word), indices.data());
-        m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
-    }
-    
-    void UiImage::clear()
-    {
-        clearRenderable();
-    }
-    
-    void UiImage::clearRenderable()
-    {
-        m_renderable.reset();
-        m_mesh.reset();
-		m_material.reset();
-    }
 }
@@ -41,29 +41,23 @@ namespace Echo
         void setMaterial(Object* material);
 
     protected:
-        // build drawable
-        void buildRenderable();
-        
         // update
         virtual void updateInternal(float elapsedTime) override;
         
-        // update vertex buffer
-        void updateMeshBuffer();
+        // build geometry, drawn by the ui batcher
+        virtual void buildGeometry(UiBatchParts& parts) override;
+
+        // material drawn with, images of the same texture share the default one. a custom
+        // material gets the color as SrcColor, the default one reads it from the vertices
+        Material* prepareMaterial();
         
         // build mesh data by drawables data
-        void buildMeshData(Ui::VertexArray& oVertices, Ui::IndiceArray& oIndices);
-        
-        // clear
-        void clear();
-        void clearRenderable();
+        void buildMeshData(Ui::VertexArray& oVertices, Ui::IndiceArray& oIndices, const Color& color);
         
     private:
         ResourcePath            m_textureRes = ResourcePath("", ".png|.rt");
         Color                   m_color = Color::WHITE;
-        MeshPtr                 m_mesh;
         MaterialPtr             m_material;
-        RenderProxyPtr          m_renderable;
-        Matrix4                 m_matWVP;
         i32                     m_width = 128;
         i32                     m_height = 128;
         Vector2                 m_anchor = Vector2::ZERO;
@@ -7,6 +7,9 @@
 
 namespace Echo
 {
+	// unique across nodes, so a new node at a freed address never looks unchanged to the batcher
+	static ui32 g_uiBatchVersion = 0;
+
 	UiRender::UiRender()
 	{
 		setRenderType("ui");
@@ -35,4 +38,35 @@ namespace Echo
 
 		return nullptr;
 	}
+
+	void UiRender::submitGeometry()
+	{
+		bool isChanged = false;
+		if (m_isGeometryDirty)
+		{
+			m_batchParts.clear();
+			buildGeometry(m_batchParts);
+
+			m_isGeometryDirty = false;
+			isChanged = true;
+		}
+
+		const Matrix4& worldMatrix = getWorldMatrix();
+		if (isChanged || m_batchWorldMatrix != worldMatrix)
+		{
+			for (UiBatchPart& part : m_batchParts)
+			{
+				part.m_worldVertices.clear();
+				part.m_worldVertices.reserve(part.m_vertices.size());
+				for (const Ui::VertexFormat& vert : part.m_vertices)
+					part.m_worldVertices.emplace_back(worldMatrix.transform(vert.m_position), vert.m_uv, vert.m_color);
+			}
+
+			m_batchWorldMatrix = worldMatrix;
+			m_batchVersion = ++g_uiBatchVersion;
+		}
+
+		for (UiBatchPart& part : m_batchParts)
+			UiBatcher::instance()->submit(this, part.m_material, m_batchVersion, part.m_worldVertices, part.m_indices);
+	}
 }
@@ -5,6 +5,7 @@
 #include "engine/core/render/base/shader/material.h"
 #include "engine/core/render/base/proxy/render_proxy.h"
 #include "../render/vertex_format.h"
+#include "../render/ui_batcher.h"
 
 namespace Echo
 {
@@ -12,6 +13,8 @@ namespace Echo
 	{
 		ECHO_VIRTUAL_CLASS(UiRender, Render)
 
+		friend class UiBatcher;
+
 	public:
 		UiRender();
 		virtual ~UiRender();
@@ -24,7 +27,20 @@ namespace Echo
 		// get global uniforms
 		virtual void* getGlobalUniformValue(const String& name) override;
 
+		// geometry changed, rebuilt before it's submitted next
+		void markGeometryDirty() { m_isGeometryDirty = true; }
+
+		// build local geometry and aabb, a part per material
+		virtual void buildGeometry(UiBatchParts& parts) {}
+
+		// submit geometry to the ui batcher, it's only rebuilt or transformed when changed
+		void submitGeometry();
+
 	protected:
 		float					m_alpha = 1.f;
+		bool					m_isGeometryDirty = true;
+		UiBatchParts			m_batchParts;
+		Matrix4					m_batchWorldMatrix;
+		ui32					m_batchVersion = 0;
 	};
 }
@@ -5,14 +5,12 @@
 #include "base/shader/shader_program.h"
 #include "engine/core/main/Engine.h"
 #include "engine/modules/ui/font/font_library.h"
+#include "engine/modules/ui/font/font_sdf.h"
 
 namespace Echo
 {
     UiText::UiText()
     : UiRender()
-	, m_mesh(nullptr)
-    , m_material(nullptr)
-    , m_renderable(nullptr)
     , m_width(0)
     , m_height(0)
     {
@@ -20,7 +18,6 @@ namespace Echo
     
     UiText::~UiText()
     {
-        clear();
     }
     
     void UiText::bindMethods()
@@ -35,25 +32,43 @@ namespace Echo
         CLASS_BIND_METHOD(UiText, setWidth);
         CLASS_BIND_METHOD(UiText, getHeight);
         CLASS_BIND_METHOD(UiText, setHeight);
+        CLASS_BIND_METHOD(UiText, isSdf);
+        CLASS_BIND_METHOD(UiText, setSdf);
+        CLASS_BIND_METHOD(UiText, getColor);
+        CLASS_BIND_METHOD(UiText, setColor);
+        CLASS_BIND_METHOD(UiText, getOutline);
+        CLASS_BIND_METHOD(UiText, setOutline);
+        CLASS_BIND_METHOD(UiText, getOutlineColor);
+        CLASS_BIND_METHOD(UiText, setOutlineColor);
+        CLASS_BIND_METHOD(UiText, getGlow);
+        CLASS_BIND_METHOD(UiText, setGlow);
+        CLASS_BIND_METHOD(UiText, getGlowColor);
+        CLASS_BIND_METHOD(UiText, setGlowColor);
         
         CLASS_REGISTER_PROPERTY(UiText, "Width", Variant::Type::Int, getWidth, setWidth);
         CLASS_REGISTER_PROPERTY(UiText, "Height", Variant::Type::Int, getHeight, setHeight);
         CLASS_REGISTER_PROPERTY(UiText, "Text", Variant::Type::String, getText, setText);
         CLASS_REGISTER_PROPERTY(UiText, "Font", Variant::Type::ResourcePath, getFont, setFont);
 		CLASS_REGISTER_PROPERTY(UiText, "FontSize", Variant::Type::Int, getFontSize, setFontSize);
+        CLASS_REGISTER_PROPERTY(UiText, "Sdf", Variant::Type::Bool, isSdf, setSdf);
+        CLASS_REGISTER_PROPERTY(UiText, "Color", Variant::Type::Color, getColor, setColor);
+        CLASS_REGISTER_PROPERTY(UiText, "Outline", Variant::Type::Real, getOutline, setOutline);
+        CLASS_REGISTER_PROPERTY(UiText, "OutlineColor", Variant::Type::Color, getOutlineColor, setOutlineColor);
+        CLASS_REGISTER_PROPERTY(UiText, "Glow", Variant::Type::Real, getGlow, setGlow);
+        CLASS_REGISTER_PROPERTY(UiText, "GlowColor", Variant::Type::Color, getGlowColor, setGlowColor);
     }
     
     void UiText::setText(const String& text)
     {
         m_text = StringUtil::MBS2WCS(text);
-		updateMeshBuffer();
+		markGeometryDirty();
     }
     
     void UiText::setFont(const ResourcePath& path)
     {
         if (m_fontRes.setPath(path.getPath()))
         {
-			updateMeshBuffer();
+			markGeometryDirty();
         }
     }
 
@@ -62,7 +77,7 @@ namespace Echo
 		m_fontSize = fontSize;
 		if (m_fontSize > 0)
 		{
-			updateMeshBuffer();
+			markGeometryDirty();
 		}
 	}
     
@@ -72,7 +87,7 @@ namespace Echo
         {
             m_width = width;
             
-			updateMeshBuffer();
+			markGeometryDirty();
         }
     }
     
@@ -82,46 +97,122 @@ namespace Echo
         {
             m_height = height;
             
-            updateMeshBuffer();
+            markGeometryDirty();
         }
     }
-    
-    void UiText::buildRenderable()
+
+    void UiText::setSdf(bool isSdf)
     {
-        if (!m_text.empty() && !m_fontRes.isEmpty())
+        if (m_isSdf != isSdf)
         {
-            clearRenderable();
-            
-            StringArray macros = {"ALPHA_ADJUST"};
-            m_shader = ShaderProgram::getDefault2D(macros);
-            
-            // material
-            m_material = EchoNew(Material(StringUtil::Format("UiTextMaterial_%d", getId())));
-            m_material->setShaderPath(m_shader->getPath());
-            
-            // mesh
-            Ui::VertexArray vertices;
-            Ui::IndiceArray indices;
-            buildMeshData(vertices, indices);
-            
-            MeshVertexFormat define;
-            define.m_isUseUV = true;
-            
-            m_mesh = Mesh::create(true, true);
-            m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(Word), indices.data());
-            m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
-            
-            m_renderable = RenderProxy::create(m_mesh, m_material, this, false);
+            m_isSdf = isSdf;
+
+            markGeometryDirty();
+        }
+    }
+
+    void UiText::setColor(const Color& color)
+    {
+        if (m_color != color)
+        {
+            m_color = color;
+
+            markGeometryDirty();
+        }
+    }
+
+    void UiText::setOutline(float outline)
+    {
+        if (m_outline != outline)
+        {
+            m_outline = outline;
+
+            markGeometryDirty();
+        }
+    }
+
+    void UiText::setOutlineColor(const Color& color)
+    {
+        if (m_outlineColor != color)
+        {
+            m_outlineColor = color;
+
+            markGeometryDirty();
+        }
+    }
+
+    void UiText::setGlow(float glow)
+    {
+        if (m_glow != glow)
+        {
+            m_glow = glow;
+
+            markGeometryDirty();
+        }
+    }
+
+    void UiText::setGlowColor(const Color& color)
+    {
+        if (m_glowColor != color)
+        {
+            m_glowColor = color;
+
+            markGeometryDirty();
         }
     }
     
+    Material* UiText::getMaterial(Texture* fontTexture)
+    {
+        return UiBatcher::instance()->getMaterial(StringUtil::Format("UiText|%d", fontTexture->getId()), [fontTexture]()
+        {
+            StringArray macros = { "ALPHA_ADJUST", "VERTEX_COLOR" };
+            ShaderProgramPtr shader = ShaderProgram::getDefault2D(macros);
+
+            Material* material = EchoNew(Material(StringUtil::Format("UiTextMaterial_%d", fontTexture->getId())));
+            material->setShaderPath(shader->getPath());
+            material->setUniformTexture("BaseColor", fontTexture);
+
+            return material;
+        });
+    }
+
+    Material* UiText::getSdfMaterial(Texture* fontTexture)
+    {
+        // widths in pixels of this font size to distance field units, the field ends Spread reference pixels away
+        float pixelUnits = FontSdf::getUnitsPerPixel(FontSdf::Spread) * FontSdf::ReferenceSize / Math::Max<float>(m_fontSize, 1.f);
+        float outlineEdge = Math::Max<float>(0.5f - m_outline * pixelUnits, 0.f);
+        float glowEdge = Math::Max<float>(outlineEdge - m_glow * pixelUnits, 0.f);
+        Color glowColor = m_glow > 0.f ? m_glowColor : Color(0.f, 0.f, 0.f, 0.f);
+
+        String key = StringUtil::Format("UiTextSdf|%d|%f %f %f %f|%f %f %f %f|%f %f", fontTexture->getId(),
+            m_outlineColor.r, m_outlineColor.g, m_outlineColor.b, m_outlineColor.a,
+            glowColor.r, glowColor.g, glowColor.b, glowColor.a,
+            outlineEdge, glowEdge);
+        return UiBatcher::instance()->getMaterial(key, [&]()
+        {
+            StringArray macros = { "ALPHA_ADJUST", "SDF", "VERTEX_COLOR" };
+            ShaderProgramPtr shader = ShaderProgram::getDefault2D(macros);
+
+            Material* material = EchoNew(Material(StringUtil::Format("UiTextSdfMaterial_%d", fontTexture->getId())));
+            material->setShaderPath(shader->getPath());
+            material->setUniformTexture("BaseColor", fontTexture);
+
+            Vector4 edges(outlineEdge, glowEdge, 0.f, 0.f);
+            material->setUniformValue("SdfOutlineColor", &m_outlineColor);
+            material->setUniformValue("SdfGlowColor", &glowColor);
+            material->setUniformValue("SdfEdges", &edges);
+
+            return material;
+        });
+    }
+
     void UiText::updateInternal(float elapsedTime)
     {
-        if (m_renderable)
-            m_renderable->setSubmitToRenderQueue(isNeedRender());
+        if (isNeedRender())
+            submitGeometry();
     }
     
-    void UiText::buildMeshData(Ui::VertexArray& oVertices, Ui::IndiceArray& oIndices)
+    void UiText::buildGeometry(UiBatchParts& parts)
     {
         if(!m_text.empty() && !m_fontRes.isEmpty())
         {
@@ -129,7 +220,7 @@ namespace Echo
             m_height = m_fontSize;
             for(wchar_t glyphCode : m_text)
             {
-                FontGlyph* fontGlyph = FontLibrary::instance()->getFontGlyph( glyphCode, m_fontRes, m_fontSize);
+                FontGlyph* fontGlyph = m_isSdf ? FontLibrary::instance()->getSdfGlyph(glyphCode, m_fontRes) : FontLibrary::instance()->getFontGlyph( glyphCode, m_fontRes, m_fontSize);
                 if(fontGlyph)
                 {
 					Vector4 uv = fontGlyph->getUV();
@@ -138,21 +229,45 @@ namespace Echo
 					float uvRight = uv.x + uv.z;
 					float uvBottom = uv.y + uv.w;
 
-                    float glyphWidth = fontGlyph->getWidth();
-                    float glyphHeight = fontGlyph->getHeight();
-                    float fontSize = m_fontSize / glyphHeight * glyphWidth;
+                    // padding of distance field cells lies outside the advance
+                    float padding = float(fontGlyph->m_padding);
+                    float glyphWidth = fontGlyph->getWidth() - padding * 2.f;
+                    float glyphHeight = fontGlyph->getHeight() - padding * 2.f;
+                    float scale = m_fontSize / glyphHeight;
+                    float fontSize = scale * glyphWidth;
+
+					float left = m_width - padding * scale;
+					float right = m_width + fontSize + padding * scale;
+					float top = m_height + padding * scale;
+					float bottom = -padding * scale;
+
+					// glyphs of a font texture go to the same part
+					Texture* fontTexture = fontGlyph->m_texture->getTexture();
+					Material* material = m_isSdf ? getSdfMaterial(fontTexture) : getMaterial(fontTexture);
+
+					UiBatchPart* part = nullptr;
+					for (UiBatchPart& existPart : parts)
+					{
+						if (existPart.m_material == material)
+							part = &existPart;
+					}
+
+					if (!part)
+					{
+						parts.emplace_back();
+						part = &parts.back();
+						part->m_material = material;
+					}
 
-					float left = m_width;
-					float right = left + fontSize;
-					float top = m_height;
-					float bottom = 0;
+					Ui::VertexArray& oVertices = part->m_vertices;
+					Ui::IndiceArray& oIndices = part->m_indices;
 
 					// vertices
 					Word vertBase = oVertices.size();
-					oVertices.emplace_back(Vector3(left, top, 0.f), Vector2(uvLeft, uvTop));
-					oVertices.emplace_back(Vector3(left, bottom, 0.f), Vector2(uvLeft, uvBottom));
-					oVertices.emplace_back(Vector3(right, bottom, 0.f), Vector2(uvRight, uvBottom));
-					oVertices.emplace_back(Vector3(right, top, 0.f), Vector2(uvRight, uvTop));
+					oVertices.emplace_back(Vector3(left, top, 0.f), Vector2(uvLeft, uvTop), m_color);
+					oVertices.emplace_back(Vector3(left, bottom, 0.f), Vector2(uvLeft, uvBottom), m_color);
+					oVertices.emplace_back(Vector3(right, bottom, 0.f), Vector2(uvRight, uvBottom), m_color);
+					oVertices.emplace_back(Vector3(right, top, 0.f), Vector2(uvRight, uvTop), m_color);
 
 					// indices
 					oIndices.emplace_back(vertBase + 0);
@@ -162,8 +277,6 @@ namespace Echo
 					oIndices.emplace_back(vertBase + 2);
 					oIndices.emplace_back(vertBase + 3);
 
-                    m_material->setUniformTexture("BaseColor", fontGlyph->m_texture->getTexture());
-
                     m_width += fontSize;
                 }
                 else
@@ -175,39 +288,10 @@ namespace Echo
           
         // Calculate aabb
         m_localAABB.reset();
-        for (Ui::VertexFormat& vert : oVertices)
-            m_localAABB.addPoint(vert.m_position);
-    }
-    
-    void UiText::updateMeshBuffer()
-    {
-		if (!m_mesh)
-		{
-			buildRenderable();
-		}
-
-		if (m_mesh)
-		{
-			Ui::VertexArray    vertices;
-			Ui::IndiceArray    indices;
-			buildMeshData(vertices, indices);
-
-			MeshVertexFormat define;
-			define.m_isUseUV = true;
-
-			m_mesh->updateIndices(static_cast<ui32>(indices.size()), sizeof(Word), indices.data());
-			m_mesh->updateVertexs(define, static_cast<ui32>(vertices.size()), (const Byte*)vertices.data());
-		}
-    }
-    
-    void UiText::clear()
-    {
-        clearRenderable();
-    }
-    
-    void UiText::clearRenderable()
-    {
-        m_renderable.reset();
-        m_mesh.reset();
+        for (UiBatchPart& part : parts)
+        {
+            for (Ui::VertexFormat& vert : part.m_vertices)
+                m_localAABB.addPoint(vert.m_position);
+        }
     }
 }
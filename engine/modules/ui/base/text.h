@@ -35,34 +35,55 @@ namespace Echo
         // width
         i32 getHeight() const { return m_height; }
         void setHeight(i32 height);
+
+        // draw from distance field glyphs, shared by all font sizes
+        bool isSdf() const { return m_isSdf; }
+        void setSdf(bool isSdf);
+
+        // color, distance field mode only
+        const Color& getColor() const { return m_color; }
+        void setColor(const Color& color);
+
+        // outline width in pixels, distance field mode only
+        float getOutline() const { return m_outline; }
+        void setOutline(float outline);
+
+        // outline color
+        const Color& getOutlineColor() const { return m_outlineColor; }
+        void setOutlineColor(const Color& color);
+
+        // glow width in pixels, outside the outline, distance field mode only
+        float getGlow() const { return m_glow; }
+        void setGlow(float glow);
+
+        // glow color
+        const Color& getGlowColor() const { return m_glowColor; }
+        void setGlowColor(const Color& color);
         
     protected:
-        // build drawable
-        void buildRenderable();
-        
         // update
         virtual void updateInternal(float elapsedTime) override;
         
-        // update vertex buffer
-        void updateMeshBuffer();
-        
-        // build mesh data by drawable data
-        void buildMeshData(Ui::VertexArray& oVertices, Ui::IndiceArray& oIndices);
-        
-        // clear
-        void clear();
-        void clearRenderable();
+        // build geometry, a part per font texture, drawn by the ui batcher
+        virtual void buildGeometry(UiBatchParts& parts) override;
+
+        // material of a font texture, shared by all texts
+        Material* getMaterial(Texture* fontTexture);
+
+        // material of a distance field atlas, shared by texts of the same outline and glow, the fill color is in the vertices
+        Material* getSdfMaterial(Texture* fontTexture);
         
     private:
         WString                 m_text;
         ResourcePath            m_fontRes = ResourcePath("", ".ttf");
 		i32						m_fontSize = 24;
-        MeshPtr                 m_mesh;            // Geometry Data for render
-        ShaderProgramPtr        m_shader;
-        MaterialPtr             m_material;        // Material Instance
-        RenderProxyPtr          m_renderable;
-        Matrix4                 m_matWVP;
         i32                     m_width;
         i32                     m_height;
+        bool                    m_isSdf = false;
+        Color                   m_color = Color::WHITE;
+        float                   m_outline = 0.f;
+        Color                   m_outlineColor = Color::BLACK;
+        float                   m_glow = 0.f;
+        Color                   m_glowColor = Color(0.f, 0.f, 0.f, 0.f);
     };
 }
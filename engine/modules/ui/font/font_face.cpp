@@ -1,7 +1,10 @@
 #include "font_face.h"
+#include "font_sdf.h"
 #include "engine/core/log/Log.h"
 
 #define DEFAULT_FONT_TEXTURE_SIZE	1024
+#define SDF_FILE_MAGIC              0x46445345      // "ESDF"
+#define SDF_FILE_VERSION            1
 
 namespace Echo
 {
@@ -25,9 +28,14 @@ namespace Echo
     
     FontFace::~FontFace()
     {
+        if (m_face)
+            FT_Done_Face(m_face);
+
         EchoSafeDelete(m_memory, MemoryReader);
         EchoSafeDeleteContainer(m_fontTextures, FontTexture);
         EchoSafeDeleteMap(m_glyphs, FontGlyph);
+        EchoSafeDeleteContainer(m_sdfTextures, FontTexture);
+        EchoSafeDeleteMap(m_sdfGlyphs, FontGlyph);
     }
     
     FontGlyph* FontFace::getGlyph(i32 charCode, i32 fontSize)
@@ -141,4 +149,169 @@ namespace Echo
 
 		return fontGlyph;
 	}
+
+    FontGlyph* FontFace::getSdfGlyph(i32 charCode)
+    {
+        auto it = m_sdfGlyphs.find(charCode);
+        if (it != m_sdfGlyphs.end())
+            return it->second;
+
+        i32 width = 0;
+        i32 height = 0;
+        vector<ui8>::type distances;
+        if (!renderSdfGlyph(charCode, distances, width, height))
+            return nullptr;
+
+        return insertSdfGlyph(charCode, distances.data(), width, height, true);
+    }
+
+    bool FontFace::renderSdfGlyph(i32 charCode, vector<ui8>::type& oDistances, i32& oWidth, i32& oHeight)
+    {
+        if (!m_face)
+            return false;
+
+        i32 glyphIndex = FT_Get_Char_Index(m_face, charCode);
+        if (FT_Set_Pixel_Sizes(m_face, FontSdf::ReferenceSize, FontSdf::ReferenceSize))
+            return false;
+
+        if (FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_DEFAULT))
+            return false;
+
+        if (FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL))
+            return false;
+
+        // same cell as bitmap glyphs, plus the spread on every side
+        FT_Bitmap* bitmap = &m_face->glyph->bitmap;
+        i32 cellWidth = Math::Max<i32>(0, bitmap->width * 1.3f);
+        i32 cellHeight = Math::Max<i32>(FontSdf::ReferenceSize, bitmap->rows);
+        oWidth = cellWidth + FontSdf::Spread * 2;
+        oHeight = cellHeight + FontSdf::Spread * 2;
+
+        vector<ui8>::type coverage(oWidth * oHeight, 0);
+        i32 wOffset = (oWidth - i32(bitmap->width)) / 2;
+        i32 hOffset = (oHeight - i32(bitmap->rows)) / 2;
+        i32 pitch = std::abs(bitmap->pitch);
+        for (i32 h = 0; h < i32(bitmap->rows); h++)
+            std::memcpy(coverage.data() + (h + hOffset) * oWidth + wOffset, bitmap->buffer + h * pitch, bitmap->width);
+
+        oDistances.resize(coverage.size());
+        FontSdf::generate(coverage.data(), oWidth, oHeight, FontSdf::Spread, oDistances.data());
+
+        return true;
+    }
+
+    FontGlyph* FontFace::insertSdfGlyph(i32 charCode, const ui8* distances, i32 width, i32 height, bool isRefreshTexture)
+    {
+        FontTexture* texture = nullptr;
+        i32 nodeIndex = -1;
+        for (FontTexture* sdfTexture : m_sdfTextures)
+        {
+            nodeIndex = sdfTexture->insert(distances, width, height);
+            if (nodeIndex != -1)
+            {
+                texture = sdfTexture;
+                break;
+            }
+        }
+
+        if (!texture)
+        {
+            texture = EchoNew(FontTexture(DEFAULT_FONT_TEXTURE_SIZE, DEFAULT_FONT_TEXTURE_SIZE, PF_R8_UNORM));
+            m_sdfTextures.emplace_back(texture);
+            nodeIndex = texture->insert(distances, width, height);
+            if (nodeIndex == -1)
+                return nullptr;
+        }
+
+        if (isRefreshTexture)
+            texture->refreshTexture();
+
+        FontGlyph* fontGlyph = EchoNew(FontGlyph);
+        fontGlyph->m_texture = texture;
+        fontGlyph->m_nodeIndex = nodeIndex;
+        fontGlyph->m_padding = FontSdf::Spread;
+        m_sdfGlyphs[charCode] = fontGlyph;
+
+        return fontGlyph;
+    }
+
+    bool FontFace::bakeSdfGlyphs(const WString& charCodes, const String& savePath)
+    {
+        // header, then charCode, width, height and distances of every glyph
+        vector<i32>::type header = { SDF_FILE_MAGIC, SDF_FILE_VERSION, FontSdf::ReferenceSize, FontSdf::Spread, 0 };
+        vector<ui8>::type data;
+        vector<ui8>::type distances;
+        set<i32>::type baked;
+        for (wchar_t charCode : charCodes)
+        {
+            i32 width = 0;
+            i32 height = 0;
+            if (!baked.insert(charCode).second || !renderSdfGlyph(charCode, distances, width, height))
+                continue;
+
+            i32 glyphHeader[3] = { i32(charCode), width, height };
+            data.insert(data.end(), (const ui8*)glyphHeader, (const ui8*)glyphHeader + sizeof(glyphHeader));
+            data.insert(data.end(), distances.begin(), distances.end());
+            header[4]++;
+        }
+
+        FILE* file = fopen(savePath.c_str(), "wb");
+        if (!file)
+        {
+            EchoLogError("FontFace::bakeSdfGlyphs can't write file [%s]", savePath.c_str());
+            return false;
+        }
+
+        fwrite(header.data(), sizeof(i32), header.size(), file);
+        fwrite(data.data(), 1, data.size(), file);
+        fclose(file);
+
+        return true;
+    }
+
+    bool FontFace::loadSdfGlyphs(const String& path)
+    {
+        MemoryReader reader(path);
+        const ui8* data = reader.getData<const ui8*>();
+        const ui8* end = data + reader.getSize();
+
+        i32 header[5] = { 0 };
+        if (reader.getSize() < sizeof(header))
+            return false;
+
+        std::memcpy(header, data, sizeof(header));
+        data += sizeof(header);
+
+        // glyphs baked with another reference size or spread would be drawn at the wrong scale
+        if (header[0] != SDF_FILE_MAGIC || header[1] != SDF_FILE_VERSION || header[2] != FontSdf::ReferenceSize || header[3] != FontSdf::Spread)
+        {
+            EchoLogError("FontFace::loadSdfGlyphs [%s] is out of date, bake it again", path.c_str());
+            return false;
+        }
+
+        for (i32 i = 0; i < header[4]; i++)
+        {
+            i32 glyphHeader[3];
+            if (data + sizeof(glyphHeader) > end)
+                return false;
+
+            std::memcpy(glyphHeader, data, sizeof(glyphHeader));
+            data += sizeof(glyphHeader);
+
+            size_t size = size_t(glyphHeader[1]) * glyphHeader[2];
+            if (glyphHeader[1] < 0 || glyphHeader[2] < 0 || data + size > end)
+                return false;
+
+            if (!m_sdfGlyphs.count(glyphHeader[0]))
+                insertSdfGlyph(glyphHeader[0], data, glyphHeader[1], glyphHeader[2], false);
+
+            data += size;
+        }
+
+        // one upload per atlas instead of one per glyph
+        for (FontTexture* texture : m_sdfTextures)
+            texture->refreshTexture();
+
+        return true;
+    }
 }
@@ -20,6 +20,13 @@ namespace Echo
         
         // get glyph
         FontGlyph* getGlyph(i32 charCode, i32 fontSize);
+
+        // get distance field glyph, shared by all font sizes
+        FontGlyph* getSdfGlyph(i32 charCode);
+
+        // distance field glyphs of a char set baked ahead of time, loading them skips rasterization
+        bool bakeSdfGlyphs(const WString& charCodes, const String& savePath);
+        bool loadSdfGlyphs(const String& path);
         
     private:
         // load glyph
@@ -31,12 +38,20 @@ namespace Echo
 
 		// new glyph
 		FontGlyph* newGlyph(i32 charCode, FontTexture* texture, i32 nodeIndex);
+
+        // rasterize at the reference size and convert to a distance field
+        bool renderSdfGlyph(i32 charCode, vector<ui8>::type& oDistances, i32& oWidth, i32& oHeight);
+
+        // pack a distance field glyph to the single channel atlas
+        FontGlyph* insertSdfGlyph(i32 charCode, const ui8* distances, i32 width, i32 height, bool isRefreshTexture);
         
     private:
         String						m_file;
 		MemoryReader*				m_memory = nullptr;
-        FT_Face						m_face;
+        FT_Face						m_face = nullptr;
 		map<i32, FontGlyph*>::type	m_glyphs;
         vector<FontTexture*>::type  m_fontTextures;
+        map<i32, FontGlyph*>::type  m_sdfGlyphs;
+        vector<FontTexture*>::type  m_sdfTextures;
     };
 }
@@ -8,6 +8,7 @@ namespace Echo
     {
 		FontTexture*	m_texture = nullptr;
 		i32				m_nodeIndex = 0;
+		i32				m_padding = 0;		// empty pixels around the glyph cell, distance fields reach into them
 
 		FontGlyph();
 		~FontGlyph();
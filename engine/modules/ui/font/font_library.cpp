@@ -1,5 +1,6 @@
 #include "font_library.h"
 #include "engine/core/log/Log.h"
+#include "engine/core/util/PathUtil.h"
 
 namespace Echo
 {
@@ -33,6 +34,17 @@ namespace Echo
         
         return nullptr;
     }
+
+    FontGlyph* FontLibrary::getSdfGlyph(i32 charCode, const ResourcePath& fontPath)
+    {
+        FontFace* fontFace = loadFace(fontPath.getPath().c_str());
+        if (fontFace)
+        {
+            return fontFace->getSdfGlyph(charCode);
+        }
+
+        return nullptr;
+    }
     
 	FontFace* FontLibrary::loadFace(const char* filePath)
     {
@@ -47,6 +59,11 @@ namespace Echo
 		FontFace* face = EchoNew(FontFace(m_library, filePath));
 		m_fontFaces.emplace_back(face);
 
+        // glyphs baked by the build, so showing them needs no rasterization
+        String sdfPath = String(filePath) + ".sdf";
+        if (IO::instance()->isExist(sdfPath))
+            face->loadSdfGlyphs(sdfPath);
+
         return face;
     }
     
@@ -54,4 +71,26 @@ namespace Echo
     {
         return true;
     }
+
+    void FontLibrary::bakeFolder(const String& folderPath)
+    {
+        StringArray allFiles;
+        PathUtil::EnumFilesInDir(allFiles, folderPath, false, true, true);
+        for (const String& file : allFiles)
+        {
+            if (!StringUtil::EndWith(file, ".charset"))
+                continue;
+
+            String fontFile = file.substr(0, file.size() - strlen(".charset"));
+            if (!PathUtil::IsFileExist(fontFile))
+                continue;
+
+            MemoryReader reader(file);
+            if (reader.getSize())
+            {
+                FontFace face(m_library, fontFile.c_str());
+                face.bakeSdfGlyphs(StringUtil::MBS2WCS(reader.getData<const char*>()), fontFile + ".sdf");
+            }
+        }
+    }
 }
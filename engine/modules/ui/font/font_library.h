@@ -16,6 +16,13 @@ namespace Echo
         
         // get glyph
         FontGlyph* getFontGlyph(i32 charCode, const ResourcePath& fontPath, i32 fontSize);
+
+        // get distance field glyph, any font size is drawn from it
+        FontGlyph* getSdfGlyph(i32 charCode, const ResourcePath& fontPath);
+
+        // bake distance field glyphs of fonts in a folder, for "font.ttf" the chars listed in
+        // "font.ttf.charset" (utf-8, the glyph set of the locale built for) go to "font.ttf.sdf"
+        void bakeFolder(const String& folderPath);
         
     public:
         // face manager
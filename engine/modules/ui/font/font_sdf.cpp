@@ -0,0 +1,103 @@
+#include "font_sdf.h"
+#include <cmath>
+
+#define SDF_INF 1e20f
+
+namespace Echo
+{
+    void FontSdf::generate(const ui8* coverage, i32 width, i32 height, i32 spread, ui8* oDistances)
+    {
+        if (!coverage || !oDistances || width <= 0 || height <= 0)
+            return;
+
+        i32 count = width * height;
+        i32 length = std::max<i32>(width, height);
+        vector<float>::type outer(count);
+        vector<float>::type inner(count);
+        vector<float>::type f(length);
+        vector<float>::type d(length);
+        vector<float>::type z(length + 1);
+        vector<i32>::type v(length);
+
+        // anti aliased pixels start at their estimated distance to the edge, so the field keeps sub pixel precision
+        for (i32 i = 0; i < count; i++)
+        {
+            float a = coverage[i] / 255.f;
+            if (a >= 1.f)
+            {
+                outer[i] = 0.f;
+                inner[i] = SDF_INF;
+            }
+            else if (a <= 0.f)
+            {
+                outer[i] = SDF_INF;
+                inner[i] = 0.f;
+            }
+            else
+            {
+                float outside = std::max<float>(0.f, 0.5f - a);
+                float inside = std::max<float>(0.f, a - 0.5f);
+                outer[i] = outside * outside;
+                inner[i] = inside * inside;
+            }
+        }
+
+        transform2D(outer.data(), width, height, f.data(), d.data(), v.data(), z.data());
+        transform2D(inner.data(), width, height, f.data(), d.data(), v.data(), z.data());
+
+        for (i32 i = 0; i < count; i++)
+        {
+            float distance = std::sqrt(outer[i]) - std::sqrt(inner[i]);
+            float value = 128.f - distance / spread * 127.f;
+            oDistances[i] = ui8(std::min<float>(std::max<float>(std::round(value), 0.f), 255.f));
+        }
+    }
+
+    void FontSdf::transform1D(float* grid, i32 offset, i32 stride, i32 length, float* f, float* d, i32* v, float* z)
+    {
+        for (i32 q = 0; q < length; q++)
+            f[q] = grid[offset + q * stride];
+
+        // lower envelope of the parabolas rooted at every sample
+        i32 k = 0;
+        v[0] = 0;
+        z[0] = -SDF_INF;
+        z[1] = SDF_INF;
+        for (i32 q = 1; q < length; q++)
+        {
+            float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * q - 2.f * v[k]);
+            while (s <= z[k])
+            {
+                k--;
+                s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.f * q - 2.f * v[k]);
+            }
+
+            k++;
+            v[k] = q;
+            z[k] = s;
+            z[k + 1] = SDF_INF;
+        }
+
+        k = 0;
+        for (i32 q = 0; q < length; q++)
+        {
+            while (z[k + 1] < q)
+                k++;
+
+            float dq = float(q - v[k]);
+            d[q] = dq * dq + f[v[k]];
+        }
+
+        for (i32 q = 0; q < length; q++)
+            grid[offset + q * stride] = d[q];
+    }
+
+    void FontSdf::transform2D(float* grid, i32 width, i32 height, float* f, float* d, i32* v, float* z)
+    {
+        for (i32 x = 0; x < width; x++)
+            transform1D(grid, x, width, height, f, d, v, z);
+
+        for (i32 y = 0; y < height; y++)
+            transform1D(grid, y * width, 1, width, f, d, v, z);
+    }
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "engine/core/util/StringUtil.h"
+
+namespace Echo
+{
+    // Signed distance field of a glyph. A glyph is rasterized once at ReferenceSize and any
+    // font size, outline or glow is drawn from its field by the shader.
+    class FontSdf
+    {
+    public:
+        // pixel size glyphs are rasterized at
+        static const i32 ReferenceSize = 48;
+
+        // reference pixels the field reaches on each side of an edge, also the cell padding
+        static const i32 Spread = 6;
+
+    public:
+        // coverage (255 inside) to distances, 128 on the edge, larger inside, Spread pixels away is 0|255
+        static void generate(const ui8* coverage, i32 width, i32 height, i32 spread, ui8* oDistances);
+
+        // distance field units per reference pixel, 0.5 is the edge in the shader
+        static float getUnitsPerPixel(i32 spread) { return 127.f / 255.f / spread; }
+
+    private:
+        // squared distance transform of a row or column, Felzenszwalb and Huttenlocher
+        static void transform1D(float* grid, i32 offset, i32 stride, i32 length, float* f, float* d, i32* v, float* z);
+
+        // squared distance transform of a grid
+        static void transform2D(float* grid, i32 width, i32 height, float* f, float* d, i32* v, float* z);
+    };
+}
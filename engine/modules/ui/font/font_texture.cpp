@@ -20,10 +20,11 @@ namespace Echo
 		return m_child[0] == INVALID && m_child[1] == INVALID;
 	}
 
-	FontTexture::FontTexture(int width, int height)
+	FontTexture::FontTexture(int width, int height, PixelFormat format)
 		: m_width(width)
 		, m_height(height)
 		, m_textureData(NULL)
+		, m_format(format)
 	{
 		Node rootNode;
 		rootNode.m_rc = IRect(0, 0, m_width, m_height);
@@ -50,30 +51,46 @@ namespace Echo
 
 	int FontTexture::insert(Color* data, int width, int height)
 	{
-		if (!data)
+		if (!data || m_format != PF_RGBA8_UNORM)
 			return INVALID;
 
-		int nodeIdx = insert(0, data, width, height);
+		int nodeIdx = insert(0, width, height);
 
 		return overWrite(nodeIdx, data, width, height);
 	}
 
+	int FontTexture::insert(const ui8* data, int width, int height)
+	{
+		if (!data || m_format != PF_R8_UNORM)
+			return INVALID;
+
+		int nodeIdx = insert(0, width, height);
+
+		return overWrite(nodeIdx, data, width, height);
+	}
+
+	Byte* FontTexture::getTextureData()
+	{
+		if (!m_textureData)
+		{
+			size_t pixelsize = PixelUtil::GetPixelBytes(m_format);
+			m_textureData = EchoMalloc(m_width*m_height*pixelsize);
+			memset(m_textureData, 0, m_width*m_height*pixelsize);
+		}
+
+		return (Byte*)m_textureData;
+	}
+
 	int FontTexture::overWrite(int nodeIdx, Color* data, int width, int height)
 	{
 		if (nodeIdx != INVALID)
 		{
 			m_nodes[nodeIdx].m_id = nodeIdx;
-			size_t pixelsize = PixelUtil::GetPixelBytes(m_format);
 
 			// copy pixels over from texture to pNode->m_rc part of texture
-			if (!m_textureData)
-			{
-				m_textureData = EchoMalloc(m_width*m_height*pixelsize);
-				memset(m_textureData, 0, m_width*m_height*pixelsize);
-			}
 			const IRect& rc = m_nodes[nodeIdx].m_rc;
 
-			Dword* pDestData = (Dword*)m_textureData;
+			Dword* pDestData = (Dword*)getTextureData();
 			for (int h = 0; h < height; h++)
 			{
 				for (int w = 0; w < width; w++)
@@ -91,6 +108,24 @@ namespace Echo
 		return INVALID;
 	}
 
+	int FontTexture::overWrite(int nodeIdx, const ui8* data, int width, int height)
+	{
+		if (nodeIdx != INVALID)
+		{
+			m_nodes[nodeIdx].m_id = nodeIdx;
+
+			// rows are copied at once, one byte a pixel
+			const IRect& rc = m_nodes[nodeIdx].m_rc;
+			Byte* pDestData = getTextureData();
+			for (int h = 0; h < height; h++)
+				std::memcpy(pDestData + (rc.top + h) * m_width + rc.left, data + h * width, width);
+
+			return nodeIdx;
+		}
+
+		return INVALID;
+	}
+
 	void FontTexture::refreshTexture()
 	{
 		size_t pixelsize = PixelUtil::GetPixelBytes(m_format);
@@ -104,7 +139,7 @@ namespace Echo
 		m_texture->updateTexture2D(m_format, Texture::TU_GPU_READ, m_width, m_height, buffer.getData(), buffer.getSize());
 	}
 
-	int FontTexture::insert(int nodeIdx, Color* data, int width, int height)
+	int FontTexture::insert(int nodeIdx, int width, int height)
 	{
 		if (nodeIdx == INVALID)
 			return INVALID;
@@ -121,12 +156,12 @@ namespace Echo
 			}
 
 			// try inserting into first child
-			int newIdx = insert(child0Idx, data, width, height);
+			int newIdx = insert(child0Idx, width, height);
 			if (newIdx != INVALID)
 				return newIdx;
 
 			// no room, insert into second
-			return insert(child1Idx, data, width, height);
+			return insert(child1Idx, width, height);
 		}
 		else
 		{
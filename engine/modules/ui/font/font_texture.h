@@ -44,14 +44,18 @@ namespace Echo
 		};
 
 	public:
-		FontTexture(int width, int height);
+		FontTexture(int width, int height, PixelFormat format = PF_RGBA8_UNORM);
 		~FontTexture();
 
 		// insert data, return node idx
 		int insert(Color* data, int width, int height);
 
+		// insert single channel data, for PF_R8_UNORM textures
+		int insert(const ui8* data, int width, int height);
+
 		// overwrite data
 		int overWrite(int nodeIdx, Color* data, int width, int height);
+		int overWrite(int nodeIdx, const ui8* data, int width, int height);
 
 		// get node viewport
 		const Vector4 getViewport(int nodeIdx) const;
@@ -63,6 +67,9 @@ namespace Echo
 		int getWidth() const { return m_width; }
 		int getHeight() const { return m_height; }
 
+		// pixel format
+		PixelFormat getFormat() const { return m_format; }
+
 		// get texture
 		Texture* getTexture() { return m_texture; }
  
@@ -71,7 +78,10 @@ namespace Echo
 
 	private:
 		// modify data
-		int insert(int nodeIdx, Color* data, int width, int height);
+		int insert(int nodeIdx, int width, int height);
+
+		// pixels, allocated on first write
+		Byte* getTextureData();
 
 	private:
 		int					m_width = 0;
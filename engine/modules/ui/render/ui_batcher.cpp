@@ -0,0 +1,164 @@
+#include "ui_batcher.h"
+#include "../base/render.h"
+#include "engine/core/log/Log.h"
+
+namespace Echo
+{
+    UiBatcher::UiBatcher()
+    {
+    }
+
+    UiBatcher::~UiBatcher()
+    {
+        for (Batch& batch : m_batches)
+        {
+            batch.m_proxy.reset();
+            batch.m_mesh.reset();
+            EchoSafeDelete(batch.m_node, UiRender);
+        }
+
+        m_batches.clear();
+        m_materials.clear();
+    }
+
+    UiBatcher* UiBatcher::instance()
+    {
+        static UiBatcher* inst = EchoNew(UiBatcher);
+        return inst;
+    }
+
+    void UiBatcher::submit(UiRender* node, Material* material, ui32 version, const Ui::VertexArray& vertices, const Ui::IndiceArray& indices)
+    {
+        if (material && !vertices.empty() && !indices.empty())
+        {
+            Item item;
+            item.m_node = node;
+            item.m_material = material;
+            item.m_alpha = node->getAlpha();
+            item.m_version = version;
+            item.m_vertexBegin = ui32(m_vertices.size());
+            item.m_vertexCount = ui32(vertices.size());
+            item.m_indexBegin = ui32(m_indices.size());
+            item.m_indexCount = ui32(indices.size());
+            m_items.emplace_back(item);
+
+            m_vertices.insert(m_vertices.end(), vertices.begin(), vertices.end());
+            m_indices.insert(m_indices.end(), indices.begin(), indices.end());
+        }
+    }
+
+    void UiBatcher::flush()
+    {
+        // runs of items sharing material and alpha, a run ends before it outgrows 16 bit indices
+        m_batchCount = 0;
+        for (size_t begin = 0; begin < m_items.size();)
+        {
+            const Item& first = m_items[begin];
+            ui32 vertexCount = first.m_vertexCount;
+
+            size_t end = begin + 1;
+            while (end < m_items.size() && m_items[end].m_material == first.m_material && m_items[end].m_alpha == first.m_alpha && vertexCount + m_items[end].m_vertexCount <= 0xFFFF)
+            {
+                vertexCount += m_items[end].m_vertexCount;
+                end++;
+            }
+
+            if (m_batchCount == m_batches.size())
+                m_batches.emplace_back();
+
+            updateBatch(m_batches[m_batchCount], m_batchCount, begin, end);
+            m_batchCount++;
+
+            begin = end;
+        }
+
+        // batches not needed this frame are kept for later frames
+        for (size_t i = m_batchCount; i < m_batches.size(); i++)
+        {
+            Batch& batch = m_batches[i];
+            if (batch.m_proxy && batch.m_proxy->isSubmitToRenderQueue())
+                batch.m_proxy->setSubmitToRenderQueue(false);
+
+            batch.m_contents.clear();
+        }
+
+        m_items.clear();
+        m_vertices.clear();
+        m_indices.clear();
+    }
+
+    void UiBatcher::updateBatch(Batch& batch, ui32 order, size_t begin, size_t end)
+    {
+        const Item& first = m_items[begin];
+        const Item& last = m_items[end - 1];
+
+        m_contents.clear();
+        for (size_t i = begin; i < end; i++)
+            m_contents.push_back({ m_items[i].m_node, m_items[i].m_version });
+
+        if (!batch.m_node)
+        {
+            batch.m_node = EchoNew(UiRender);
+            batch.m_mesh = Mesh::create(true, true);
+        }
+
+        batch.m_node->setAlpha(first.m_alpha);
+
+        if (batch.m_material != first.m_material || batch.m_contents != m_contents || !batch.m_proxy)
+        {
+            // items are stored one after another, only indices need rebasing to the run
+            ui32 vertexBegin = first.m_vertexBegin;
+            ui32 vertexCount = last.m_vertexBegin + last.m_vertexCount - vertexBegin;
+            ui32 indexCount = last.m_indexBegin + last.m_indexCount - first.m_indexBegin;
+            for (size_t i = begin; i < end; i++)
+            {
+                const Item& item = m_items[i];
+                Word base = Word(item.m_vertexBegin - vertexBegin);
+                for (ui32 j = item.m_indexBegin; j < item.m_indexBegin + item.m_indexCount; j++)
+                    m_indices[j] += base;
+            }
+
+            batch.m_node->m_localAABB.reset();
+            for (ui32 i = vertexBegin; i < vertexBegin + vertexCount; i++)
+                batch.m_node->m_localAABB.addPoint(m_vertices[i].m_position);
+
+            MeshVertexFormat define;
+            define.m_isUseVertexColor = true;
+            define.m_isUseUV = true;
+
+            batch.m_mesh->updateIndices(indexCount, sizeof(Word), m_indices.data() + first.m_indexBegin);
+            batch.m_mesh->updateVertexs(define, vertexCount, (const Byte*)(m_vertices.data() + vertexBegin));
+
+            if (!batch.m_proxy)
+                batch.m_proxy = RenderProxy::create(batch.m_mesh, first.m_material, batch.m_node, false);
+            else if (batch.m_material != first.m_material)
+                batch.m_proxy->setMaterial(first.m_material);
+
+            batch.m_material = first.m_material;
+            batch.m_contents.swap(m_contents);
+
+            // refresh bounds in the proxy bvh
+            if (batch.m_proxy)
+                batch.m_proxy->setSubmitToRenderQueue(true);
+        }
+        else if (!batch.m_proxy->isSubmitToRenderQueue())
+        {
+            batch.m_proxy->setSubmitToRenderQueue(true);
+        }
+
+        if (batch.m_proxy)
+            batch.m_proxy->setOrder(order);
+    }
+
+    Material* UiBatcher::getMaterial(const String& key, const std::function<Material*()>& create)
+    {
+        auto it = m_materials.find(key);
+        if (it != m_materials.end())
+            return it->second;
+
+        Material* material = create();
+        m_materials[key] = material;
+
+        return material;
+    }
+}
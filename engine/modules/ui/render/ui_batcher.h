@@ -0,0 +1,94 @@
+#pragma once
+
+#include <functional>
+#include "engine/core/render/base/mesh/mesh.h"
+#include "engine/core/render/base/shader/material.h"
+#include "engine/core/render/base/proxy/render_proxy.h"
+#include "vertex_format.h"
+
+namespace Echo
+{
+    class UiRender;
+
+    // Geometry of a ui node drawn with one material
+    struct UiBatchPart
+    {
+        MaterialPtr         m_material;
+        Ui::VertexArray     m_vertices;             // local space
+        Ui::IndiceArray     m_indices;
+        Ui::VertexArray     m_worldVertices;        // transformed when vertices or world matrix changed
+    };
+    typedef vector<UiBatchPart>::type UiBatchParts;
+
+    // Collects the geometry of visible ui nodes every frame and draws runs sharing material
+    // and alpha with one draw call. Runs keep the order nodes were submitted in, which is the
+    // node tree order, and a run's buffers are only uploaded again when one of its nodes changed.
+    class UiBatcher
+    {
+    public:
+        ~UiBatcher();
+
+        // instance
+        static UiBatcher* instance();
+
+        // submit world space geometry for this frame, version changes whenever the geometry does
+        void submit(UiRender* node, Material* material, ui32 version, const Ui::VertexArray& vertices, const Ui::IndiceArray& indices);
+
+        // build and draw batches of the geometry submitted this frame
+        void flush();
+
+        // shared material, created on first use
+        Material* getMaterial(const String& key, const std::function<Material*()>& create);
+
+        // draw calls of last flush
+        ui32 getBatchCount() const { return m_batchCount; }
+
+    private:
+        UiBatcher();
+
+        // a submit
+        struct Item
+        {
+            UiRender*   m_node;
+            Material*   m_material;
+            float       m_alpha;
+            ui32        m_version;
+            ui32        m_vertexBegin;
+            ui32        m_vertexCount;
+            ui32        m_indexBegin;
+            ui32        m_indexCount;
+        };
+
+        // node and version, tells whether a batch's content changed
+        struct Content
+        {
+            UiRender*   m_node;
+            ui32        m_version;
+
+            bool operator == (const Content& other) const { return m_node == other.m_node && m_version == other.m_version; }
+        };
+
+        // draws a run of items
+        struct Batch
+        {
+            UiRender*                   m_node = nullptr;       // not in the node tree, identity world matrix
+            MeshPtr                     m_mesh;
+            RenderProxyPtr              m_proxy;
+            Material*                   m_material = nullptr;
+            vector<Content>::type       m_contents;
+        };
+
+    private:
+        // update a batch by items [begin, end)
+        void updateBatch(Batch& batch, ui32 order, size_t begin, size_t end);
+
+    private:
+        vector<Item>::type              m_items;
+        Ui::VertexArray                 m_vertices;
+        Ui::IndiceArray                 m_indices;
+        vector<Batch>::type             m_batches;
+        vector<Content>::type           m_contents;
+        ui32                            m_batchCount = 0;
+        map<String, MaterialPtr>::type  m_materials;
+    };
+}
@@ -3,14 +3,15 @@
 namespace Echo {
 namespace Ui {
     
-    // Vertex Format
+    // Vertex Format, color is the tint so nodes of different colors share materials
     struct VertexFormat
     {
         Vector3        m_position;
+        Dword          m_color;
         Vector2        m_uv;
         
-        VertexFormat(const Vector3& pos, const Vector2& uv)
-        : m_position(pos), m_uv(uv)
+        VertexFormat(const Vector3& pos, const Vector2& uv, Dword color = 0xFFFFFFFF)
+        : m_position(pos), m_color(color), m_uv(uv)
         {}
     };
     typedef vector<VertexFormat>::type  VertexArray;
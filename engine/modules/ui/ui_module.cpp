@@ -14,6 +14,7 @@
 #include "base/text.h"
 #include "base/image.h"
 #include "font/font_library.h"
+#include "render/ui_batcher.h"
 #include "editor/text_editor.h"
 #include "editor/image_editor.h"
 #include "editor/event_region_rect_editor.h"
@@ -30,6 +31,7 @@ namespace Echo
 	{
 		EchoSafeDeleteInstance(UiEventProcessor);
         EchoSafeDeleteInstance(FontLibrary);
+		EchoSafeDeleteInstance(UiBatcher);
 	}
 
 	UiModule* UiModule::instance()
@@ -68,4 +70,9 @@ namespace Echo
 		CLASS_REGISTER_EDITOR(UiImage, UiImageEditor)
         CLASS_REGISTER_EDITOR(UiEventRegionRect, UiEventRegionRectEditor)
 	}
+
+	void UiModule::lateUpdate(float elapsedTime)
+	{
+		UiBatcher::instance()->flush();
+	}
 }
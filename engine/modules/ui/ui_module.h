@@ -17,6 +17,9 @@ namespace Echo
 
 		// register all types of the module
 		virtual void registerTypes() override;
+
+		// draw the ui batches of this frame
+		virtual void lateUpdate(float elapsedTime) override;
 	
 		// UiImage default material
 		void setUiImageDefaultShader(const ResourcePath& path) { m_uiImageDefaultShader.setPath(path.getPath()); }
@@ -10,7 +10,7 @@ namespace Echo
 
 	VideoModule::VideoModule()
 	{
-
+		setUpdateAccess(Access_None, Access_None, false);
 	}
 
 	VideoModule::~VideoModule()
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <engine/modules/anim/anim_curve.h>
+
+namespace Echo
+{
+	static void buildCurve(AnimCurve& curve, ui32 keyCount)
+	{
+		for (ui32 i = 0; i < keyCount; i++)
+			curve.addKey(i * 100, float(i % 7) - float(i % 3) * 0.5f);
+	}
+
+	static float referenceValue(const AnimCurve& curve, ui32 time)
+	{
+		auto next = curve.m_keys.upper_bound(time);
+		if (next == curve.m_keys.begin())
+			return next->second;
+
+		if (next == curve.m_keys.end())
+			return curve.m_keys.rbegin()->second;
+
+		auto cur = std::prev(next);
+		if (curve.m_type == AnimCurve::InterpolationType::Discrete)
+			return cur->second;
+
+		float ratio = float(time - cur->first) / float(next->first - cur->first);
+		return cur->second * (1.f - ratio) + next->second * ratio;
+	}
+
+	TEST(AnimCurve, CursorMatchesSearch)
+	{
+		AnimCurve curve;
+		buildCurve(curve, 64);
+
+		AnimCurve::Cursor cursor;
+		for (ui32 time = 0; time < 7000; time += 17)
+			EXPECT_NEAR(curve.getValue(time, cursor), referenceValue(curve, time), 1e-5f);
+
+		// loop back to start, then jump far ahead
+		EXPECT_NEAR(curve.getValue(30, cursor), referenceValue(curve, 30), 1e-5f);
+		EXPECT_NEAR(curve.getValue(5050, cursor), referenceValue(curve, 5050), 1e-5f);
+
+		curve.setType(AnimCurve::InterpolationType::Discrete);
+		for (ui32 time = 0; time < 7000; time += 23)
+			EXPECT_EQ(curve.getValue(time, cursor), referenceValue(curve, time));
+	}
+
+	TEST(AnimCurve, FixedRate)
+	{
+		AnimCurve curve;
+		buildCurve(curve, 32);
+		curve.setSampleInterval(50);
+
+		AnimCurve::Cursor cursor;
+		for (ui32 time = 0; time < 3300; time += 13)
+			EXPECT_NEAR(curve.getValue(time, cursor), referenceValue(curve, time), 1e-4f);
+	}
+
+	TEST(AnimCurve, BatchSample)
+	{
+		const i32 count = 7;
+		AnimCurve curves[count];
+		AnimCurve* curvePtrs[count];
+		AnimCurve::Cursor cursors[count];
+		for (i32 i = 0; i < count; i++)
+		{
+			buildCurve(curves[i], 10 + i * 3);
+			curvePtrs[i] = &curves[i];
+		}
+
+		float values[count];
+		for (ui32 time = 0; time < 3500; time += 31)
+		{
+			AnimCurve::sample(curvePtrs, cursors, count, time, values);
+			for (i32 i = 0; i < count; i++)
+				EXPECT_NEAR(values[i], referenceValue(curves[i], time), 1e-5f);
+		}
+	}
+}
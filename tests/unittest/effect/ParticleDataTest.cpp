@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <engine/modules/effect/modifier/modifier.h>
+
+using namespace Echo;
+
+// particles with ids in ColorR, living 1, 2, 3 ... seconds
+static void spawnParticles(ParticleData& data, ui32 count)
+{
+	ui32 first = data.spawn(count);
+	for (ui32 i = first; i < data.getCount(); i++)
+	{
+		data.getStream(ParticleData::ColorR)[i] = float(i);
+		data.getStream(ParticleData::Life)[i] = float(i + 1);
+		data.getStream(ParticleData::VelocityX)[i] = 2.f;
+	}
+}
+
+TEST(ParticleData, SpawnClampsToCapacity)
+{
+	ParticleData data;
+	data.setCapacity(10);
+	spawnParticles(data, 7);
+	EXPECT_EQ(data.getPaddedCount(), 8u);
+
+	EXPECT_EQ(data.spawn(7), 7u);
+	EXPECT_EQ(data.getCount(), 10u);
+}
+
+TEST(ParticleData, AgeKillsBySwap)
+{
+	ParticleData data;
+	data.setCapacity(9);
+	spawnParticles(data, 9);
+
+	// particles 0 and 1 die, the last two take their places
+	data.age(2.f);
+	ASSERT_EQ(data.getCount(), 7u);
+	EXPECT_EQ(data.getStream(ParticleData::ColorR)[0], 8.f);
+	EXPECT_EQ(data.getStream(ParticleData::ColorR)[1], 7.f);
+	EXPECT_EQ(data.getStream(ParticleData::Age)[6], 2.f);
+
+	data.age(100.f);
+	EXPECT_EQ(data.getCount(), 0u);
+}
+
+TEST(ParticleData, Modifiers)
+{
+	ParticleData data;
+	data.setCapacity(6);
+	spawnParticles(data, 6);
+
+	GravityModifier gravity;
+	gravity.setAcceleration(Vector3(0.f, -10.f, 0.f));
+	gravity.apply(data, 0.5f);
+	data.integrate(0.5f);
+	EXPECT_FLOAT_EQ(data.getStream(ParticleData::PositionX)[5], 1.f);
+	EXPECT_FLOAT_EQ(data.getStream(ParticleData::PositionY)[5], -2.5f);
+
+	FadeModifier fade;
+	data.age(0.5f);
+	fade.apply(data, 0.5f);
+	EXPECT_FLOAT_EQ(data.getStream(ParticleData::ColorA)[0], 0.5f);
+	EXPECT_FLOAT_EQ(data.getStream(ParticleData::ColorA)[3], 0.875f);
+}
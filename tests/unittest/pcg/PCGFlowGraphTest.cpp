@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <engine/modules/pcg/pcg_flow_graph.h>
+#include <engine/modules/pcg/connect/pcg_connect.h>
+#include <atomic>
+
+using namespace Echo;
+
+static std::atomic<i32> g_sharedDataDeletes(0);
+
+// data shared by every branch of the diamond
+class PCGSharedData : public PCGData
+{
+public:
+	virtual ~PCGSharedData() { g_sharedDataDeletes++; }
+};
+
+class PCGSourceNode : public PCGNode
+{
+public:
+	PCGSourceNode()
+	{
+		m_data = new PCGSharedData;
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, m_data)));
+	}
+
+	PCGDataPtr	m_data;
+};
+
+// copies the upstream ref many times, like nodes reading their inputs do
+class PCGBranchNode : public PCGNode
+{
+public:
+	PCGBranchNode()
+	{
+		m_inputs.push_back(EchoNew(PCGConnectPoint(this, "UnKnown")));
+		m_outputs.push_back(EchoNew(PCGConnectPoint(this, PCGDataPtr(new PCGData))));
+	}
+
+	// rerun next time the graph runs
+	void markDirty() { m_dirtyFlag = true; }
+
+	virtual void run() override
+	{
+		for (i32 i = 0; i < 20000; i++)
+		{
+			PCGDataPtr data = m_inputs[0]->getData();
+			m_isValid = m_isValid && data.ptr();
+		}
+
+		m_dirtyFlag = false;
+	}
+
+	bool	m_isValid = true;
+};
+
+class PCGSinkNode : public PCGNode
+{
+public:
+	PCGSinkNode(i32 inputCount)
+	{
+		for (i32 i = 0; i < inputCount; i++)
+			m_inputs.push_back(EchoNew(PCGConnectPoint(this, "UnKnown")));
+	}
+};
+
+TEST(PCGFlowGraph, ParallelDiamondSharesInput)
+{
+	const i32 branchCount = 8;
+	g_sharedDataDeletes = 0;
+
+	PCGFlowGraph* graph = EchoNew(PCGFlowGraph);
+	PCGSourceNode* source = EchoNew(PCGSourceNode);
+	PCGSinkNode* sink = EchoNew(PCGSinkNode(branchCount));
+	graph->addNode(source);
+	graph->addNode(sink);
+
+	vector<PCGBranchNode*>::type branches;
+	for (i32 i = 0; i < branchCount; i++)
+	{
+		PCGBranchNode* branch = EchoNew(PCGBranchNode);
+		ASSERT_TRUE(branch->isThreadSafe());
+		graph->addNode(branch);
+		graph->addConnect(EchoNew(PCGConnect(source->getOutputs()[0], branch->getInputs()[0])));
+		graph->addConnect(EchoNew(PCGConnect(branch->getOutputs()[0], sink->getInputs()[i])));
+		branches.emplace_back(branch);
+	}
+
+	graph->setAsOutput(sink);
+	for (i32 i = 0; i < 4; i++)
+	{
+		for (PCGBranchNode* branch : branches)
+			branch->markDirty();
+
+		graph->run();
+	}
+
+	for (PCGBranchNode* branch : branches)
+	{
+		EXPECT_TRUE(branch->m_isValid);
+		EXPECT_EQ(branch->getVersion(), 4u);
+	}
+
+	// the source and its output point hold the only refs left
+	EXPECT_EQ(g_sharedDataDeletes.load(), 0);
+	source->m_data = nullptr;
+	source->getOutputs()[0]->setData(nullptr);
+	EXPECT_EQ(g_sharedDataDeletes.load(), 1);
+
+	graph->reset();
+	EchoSafeDelete(graph, PCGFlowGraph);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <engine/modules/pcg/data/image/pcg_image_kernel.h>
+
+using namespace Echo;
+
+// sizes that leave partial tiles on the right and bottom
+static void fillImage(PCGImage& image, i32 width, i32 height, i32 channels, float scale)
+{
+	image.set(width, height, channels);
+	for (i32 c = 0; c < channels; c++)
+	{
+		for (i32 y = 0; y < height; y++)
+		{
+			for (i32 x = 0; x < width; x++)
+				image.setValue(x, y, (x + y * 3 + c * 7) * scale, c);
+		}
+	}
+}
+
+TEST(PCGImage, TiledAddressing)
+{
+	PCGImage image;
+	fillImage(image, 150, 70, 2, 1.f);
+
+	EXPECT_EQ(image.getTilesX(), 3);
+	EXPECT_EQ(image.getTilesY(), 2);
+	EXPECT_EQ(image.getValue(149, 69, 1), 149.f + 69.f * 3.f + 7.f);
+
+	vector<float>::type rows;
+	image.getRows(0, rows);
+	ASSERT_EQ(rows.size(), size_t(150 * 70));
+	for (i32 y = 0; y < 70; y++)
+	{
+		for (i32 x = 0; x < 150; x++)
+			ASSERT_EQ(rows[y * 150 + x], float(x + y * 3));
+	}
+}
+
+TEST(PCGImage, Combine)
+{
+	PCGImage a, b, out;
+	fillImage(a, 130, 65, 2, 0.5f);
+	fillImage(b, 130, 65, 1, 0.25f);
+
+	PCGImageKernel::combine(PCGImageKernel::Op::Subtract, a, b, out);
+	ASSERT_TRUE(out.isSameLayout(a));
+	for (i32 c = 0; c < 2; c++)
+	{
+		for (i32 y = 0; y < 65; y++)
+		{
+			for (i32 x = 0; x < 130; x++)
+				ASSERT_FLOAT_EQ(out.getValue(x, y, c), a.getValue(x, y, c) - b.getValue(x, y));
+		}
+	}
+
+	PCGImageKernel::combine(PCGImageKernel::Op::Multiply, a, b, out);
+	EXPECT_FLOAT_EQ(out.getValue(129, 64, 1), a.getValue(129, 64, 1) * b.getValue(129, 64));
+
+	PCGImageKernel::scaleBias(a, 2.f, 1.f, out);
+	EXPECT_FLOAT_EQ(out.getValue(100, 50, 0), a.getValue(100, 50, 0) * 2.f + 1.f);
+}
+
+TEST(PCGImage, CombineFewerChannels)
+{
+	// b has more than one channel but fewer than a, the missing one repeats its first
+	PCGImage a, b, out;
+	fillImage(a, 130, 65, 3, 0.5f);
+	fillImage(b, 130, 65, 2, 0.25f);
+
+	PCGImageKernel::combine(PCGImageKernel::Op::Add, a, b, out);
+	ASSERT_TRUE(out.isSameLayout(a));
+	for (i32 y = 0; y < 65; y++)
+	{
+		for (i32 x = 0; x < 130; x++)
+		{
+			ASSERT_FLOAT_EQ(out.getValue(x, y, 0), a.getValue(x, y, 0) + b.getValue(x, y, 0));
+			ASSERT_FLOAT_EQ(out.getValue(x, y, 1), a.getValue(x, y, 1) + b.getValue(x, y, 1));
+			ASSERT_FLOAT_EQ(out.getValue(x, y, 2), a.getValue(x, y, 2) + b.getValue(x, y, 0));
+		}
+	}
+}
+
+TEST(PCGImage, Resample)
+{
+	PCGImage src, out;
+	fillImage(src, 100, 100, 1, 1.f);
+
+	// same size is a copy, a linear ramp stays linear at half size
+	PCGImageKernel::resample(src, 100, 100, out);
+	EXPECT_FLOAT_EQ(out.getValue(77, 33), src.getValue(77, 33));
+
+	PCGImageKernel::resample(src, 50, 50, out);
+	EXPECT_EQ(out.getWidth(), 50);
+	EXPECT_NEAR(out.getValue(10, 20), 20.5f + 40.5f * 3.f, 1e-3f);
+
+	// a smaller b is stretched over a
+	PCGImage a, b, sum;
+	fillImage(a, 100, 100, 1, 0.f);
+	fillImage(b, 50, 50, 1, 1.f);
+	PCGImageKernel::combine(PCGImageKernel::Op::Add, a, b, sum);
+	EXPECT_EQ(sum.getWidth(), 100);
+	EXPECT_NEAR(sum.getValue(99, 99), 49.f + 49.f * 3.f, 1e-3f);
+}
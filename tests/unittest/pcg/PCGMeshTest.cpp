@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <engine/modules/pcg/data/mesh/pcg_mesh.h>
+
+using namespace Echo;
+
+// a unit quad of two triangles in the xz plane
+static void buildQuad(PCGMesh& mesh, float x)
+{
+	i32 first = mesh.addPoints(4);
+	vector<Vector3>::type& positions = mesh.getPositions();
+	positions[first + 0] = Vector3(x, 0.f, 0.f);
+	positions[first + 1] = Vector3(x + 1.f, 0.f, 0.f);
+	positions[first + 2] = Vector3(x + 1.f, 0.f, 1.f);
+	positions[first + 3] = Vector3(x, 0.f, 1.f);
+
+	ui32 indices[6] = { 0, 1, 2, 0, 2, 3 };
+	mesh.addTriangles(indices, 2, ui32(first));
+}
+
+TEST(PCGMesh, AppendMergesAttributes)
+{
+	PCGMesh a, b;
+	buildQuad(a, 0.f);
+	buildQuad(b, 2.f);
+	b.getUvs()[3] = Vector2(0.5f, 0.25f);
+	b.getAttribute("height")[1] = 3.f;
+
+	a.append(b);
+	EXPECT_EQ(a.getPointCount(), 8);
+	EXPECT_EQ(a.getTriangleCount(), 4u);
+	EXPECT_EQ(a.getIndices()[6], 4u);
+	EXPECT_EQ(a.getIndices()[11], 7u);
+
+	// attributes only b had are zero for the points of a
+	ASSERT_TRUE(a.hasUvs());
+	EXPECT_EQ(a.getUvs()[3], Vector2::ZERO);
+	EXPECT_EQ(a.getUvs()[7], Vector2(0.5f, 0.25f));
+
+	const vector<float>::type* height = a.findAttribute("height");
+	ASSERT_NE(height, nullptr);
+	ASSERT_EQ(height->size(), size_t(8));
+	EXPECT_EQ((*height)[1], 0.f);
+	EXPECT_EQ((*height)[5], 3.f);
+	EXPECT_FALSE(a.hasNormals());
+}
+
+TEST(PCGMesh, Transform)
+{
+	PCGMesh mesh;
+	buildQuad(mesh, 0.f);
+	buildQuad(mesh, 0.f);
+	Vector3 tilted(1.f, 1.f, 0.f);
+	tilted.normalize();
+	for (Vector3& normal : mesh.getNormals())
+		normal = tilted;
+
+	// only the second quad moves, scaled on x so normals need the inverse transpose
+	Matrix4 matrix;
+	matrix.scaleReplace(2.f, 1.f, 1.f);
+	matrix.translate(Vector3(0.f, 5.f, 0.f));
+	mesh.transform(matrix, 4);
+
+	EXPECT_EQ(mesh.getPositions()[1], Vector3(1.f, 0.f, 0.f));
+	EXPECT_EQ(mesh.getPositions()[5], Vector3(2.f, 5.f, 0.f));
+
+	// (1, 1, 0) by the inverse transpose scale (0.5, 1, 1) is (0.5, 1, 0), normalized
+	Vector3 expected(0.5f, 1.f, 0.f);
+	expected.normalize();
+	EXPECT_NEAR(mesh.getNormals()[5].x, expected.x, 1e-5f);
+	EXPECT_NEAR(mesh.getNormals()[5].y, expected.y, 1e-5f);
+	EXPECT_NEAR(mesh.getNormals()[5].z, 0.f, 1e-5f);
+
+	// the first quad keeps its normal
+	EXPECT_NEAR(mesh.getNormals()[1].x, tilted.x, 1e-5f);
+	EXPECT_NEAR(mesh.getNormals()[1].y, tilted.y, 1e-5f);
+}
+
+TEST(PCGMesh, FillVertexData)
+{
+	PCGMesh mesh;
+	buildQuad(mesh, 1.f);
+	mesh.getUvs()[2] = Vector2(1.f, 1.f);
+
+	MeshVertexData vertexData;
+	mesh.fillVertexData(vertexData);
+	ASSERT_EQ(vertexData.getVertexCount(), 4u);
+	EXPECT_FALSE(vertexData.isVertexUsage(VS_NORMAL));
+	EXPECT_TRUE(vertexData.isVertexUsage(VS_TEXCOORD0));
+	EXPECT_EQ(vertexData.getPosition(2), Vector3(2.f, 0.f, 1.f));
+	EXPECT_EQ(vertexData.getUV0(2), Vector2(1.f, 1.f));
+}
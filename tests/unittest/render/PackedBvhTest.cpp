@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <engine/core/render/base/scene/bvh_packed.h>
+
+using namespace Echo;
+
+static float randomFloat(float min, float max)
+{
+	return min + (max - min) * (rand() / float(RAND_MAX));
+}
+
+static vector<i32>::type buildRandomBvh(Bvh& bvh, i32 count)
+{
+	vector<i32>::type proxyIds;
+
+	srand(7);
+	for (i32 i = 0; i < count; i++)
+	{
+		Vector3 center(randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f));
+		Vector3 extent(randomFloat(0.1f, 3.f), randomFloat(0.1f, 3.f), randomFloat(0.1f, 3.f));
+		proxyIds.emplace_back(bvh.createProxy(AABB(center - extent, center + extent), i));
+	}
+
+	return proxyIds;
+}
+
+static vector<i32>::type queryDynamic(const Bvh& bvh, const AABB& aabb)
+{
+	BvhCbDefault cb;
+	bvh.query(&cb, aabb);
+
+	vector<i32>::type result;
+	for (i32 nodeId : cb.getQueryResults())
+		result.emplace_back(bvh.getUserData(nodeId));
+
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+// collects every leaf the segment passes, never clips the ray
+class BvhRayCastCollector : public BvhCbDefault
+{
+public:
+	virtual float rayCastCallback(i32 nodeId) override { m_rayCastResults.emplace_back(nodeId); return -1.f; }
+};
+
+TEST(PackedBvh, AABBQueryMatchesDynamicTree)
+{
+	Bvh bvh;
+	buildRandomBvh(bvh, 2000);
+
+	PackedBvh packed;
+	packed.build(bvh);
+
+	for (i32 i = 0; i < 50; i++)
+	{
+		Vector3 center(randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f));
+		AABB aabb(center - Vector3(20.f, 20.f, 20.f), center + Vector3(20.f, 20.f, 20.f));
+
+		vector<i32>::type expected = queryDynamic(bvh, aabb);
+
+		// first call only counts, second one fills
+		vector<i32>::type result;
+		ui32 count = packed.query(aabb, nullptr, 0);
+		result.resize(count);
+		EXPECT_EQ(packed.query(aabb, result.data(), count), count);
+
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(result, expected);
+	}
+}
+
+TEST(PackedBvh, FrustumQueryMatchesDynamicTree)
+{
+	Bvh bvh;
+	buildRandomBvh(bvh, 2000);
+
+	PackedBvh packed;
+	packed.build(bvh);
+
+	Frustum frustum;
+	frustum.setPerspective(Math::PI_DIV2, 1280.f, 720.f, 0.1f, 150.f);
+	frustum.build(Vector3(0.f, 0.f, -120.f), Vector3(0.f, 0.f, 1.f), Vector3(0.f, 1.f, 0.f));
+
+	BvhCbDefault cb;
+	bvh.query(&cb, frustum);
+
+	vector<i32>::type expected;
+	for (i32 nodeId : cb.getQueryResults())
+		expected.emplace_back(bvh.getUserData(nodeId));
+
+	vector<i32>::type result(4096);
+	result.resize(packed.query(PackedFrustum(frustum), result.data(), ui32(result.size())));
+
+	std::sort(expected.begin(), expected.end());
+	std::sort(result.begin(), result.end());
+	EXPECT_FALSE(result.empty());
+	EXPECT_EQ(result, expected);
+}
+
+TEST(PackedBvh, RefitMovedProxies)
+{
+	Bvh bvh;
+	vector<i32>::type proxyIds = buildRandomBvh(bvh, 500);
+
+	PackedBvh packed;
+	packed.build(bvh);
+
+	// move a few proxies far enough to be re-inserted, the packed copy only refits
+	srand(11);
+	for (size_t i = 0; i < proxyIds.size(); i += 7)
+	{
+		Vector3 center(randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f));
+		bvh.moveProxy(proxyIds[i], AABB(center - Vector3(1.f, 1.f, 1.f), center + Vector3(1.f, 1.f, 1.f)), Vector3::ZERO);
+	}
+
+	ui32 topologyVersion = bvh.getTopologyVersion();
+	EXPECT_FALSE(bvh.getMovedProxies().empty());
+	packed.build(bvh);
+	bvh.clearMovedProxies();
+	EXPECT_EQ(bvh.getTopologyVersion(), topologyVersion);
+
+	// moving everything several times overflows the list, every leaf is refit
+	for (i32 pass = 0; pass < 3; pass++)
+	{
+		for (i32 proxyId : proxyIds)
+		{
+			Vector3 center(randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f));
+			bvh.moveProxy(proxyId, AABB(center - Vector3(1.f, 1.f, 1.f), center + Vector3(1.f, 1.f, 1.f)), Vector3::ZERO);
+		}
+	}
+
+	EXPECT_TRUE(bvh.isMovedProxiesOverflow());
+	packed.build(bvh);
+	bvh.clearMovedProxies();
+
+	for (i32 i = 0; i < 50; i++)
+	{
+		Vector3 center(randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f));
+		AABB aabb(center - Vector3(20.f, 20.f, 20.f), center + Vector3(20.f, 20.f, 20.f));
+
+		vector<i32>::type result(1024);
+		result.resize(packed.query(aabb, result.data(), ui32(result.size())));
+
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(result, queryDynamic(bvh, aabb));
+	}
+}
+
+TEST(PackedBvh, RayCastMatchesDynamicTree)
+{
+	Bvh bvh;
+	buildRandomBvh(bvh, 2000);
+
+	PackedBvh packed;
+	packed.build(bvh);
+
+	// odd count leaves a partly filled last packet
+	const float maxDistance = 150.f;
+	vector<Ray>::type rays;
+	srand(13);
+	for (i32 i = 0; i < 37; i++)
+	{
+		Vector3 origin(randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f), randomFloat(-100.f, 100.f));
+		Vector3 dir(randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f), randomFloat(-1.f, 1.f));
+		dir.normalize();
+		rays.emplace_back(origin, dir);
+	}
+
+	// first call only counts, second one fills
+	vector<PackedBvhRayHit>::type hits(packed.rayCast(rays.data(), ui32(rays.size()), maxDistance, nullptr, 0));
+	EXPECT_EQ(packed.rayCast(rays.data(), ui32(rays.size()), maxDistance, hits.data(), ui32(hits.size())), ui32(hits.size()));
+
+	size_t totalHits = 0;
+	for (ui32 rayIdx = 0; rayIdx < rays.size(); rayIdx++)
+	{
+		const Ray& ray = rays[rayIdx];
+		BvhRayCastCollector cb;
+		bvh.rayCast(&cb, ray.m_origin, ray.m_origin + ray.m_dir * maxDistance);
+
+		vector<i32>::type expected;
+		for (i32 nodeId : cb.getRayCastResults())
+			expected.emplace_back(bvh.getUserData(nodeId));
+
+		vector<i32>::type result;
+		for (const PackedBvhRayHit& hit : hits)
+		{
+			if (hit.rayIdx == rayIdx)
+			{
+				EXPECT_GE(hit.distance, 0.f);
+				EXPECT_LE(hit.distance, maxDistance);
+				result.emplace_back(hit.userData);
+			}
+		}
+
+		std::sort(expected.begin(), expected.end());
+		std::sort(result.begin(), result.end());
+		EXPECT_EQ(result, expected);
+		totalHits += result.size();
+	}
+
+	EXPECT_GT(totalHits, size_t(0));
+}
@@ -0,0 +1,236 @@
+#include <cstdio>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <engine/core/scene/node.h>
+#include <engine/core/base/object_cooker.h>
+#include <engine/core/base/signal.h>
+#include <engine/core/base/channel.h>
+#include <engine/core/util/PathUtil.h>
+
+namespace Echo
+{
+	// a property of every value type the cooker stores
+	class CookerTestNode : public Node
+	{
+		ECHO_CLASS(CookerTestNode, Node)
+
+	public:
+		bool getBool() const { return m_bool; }
+		void setBool(bool value) { m_bool = value; }
+
+		i32 getInt() const { return m_int; }
+		void setInt(i32 value) { m_int = value; }
+
+		Real getReal() const { return m_real; }
+		void setReal(Real value) { m_real = value; }
+
+		const Vector2& getVector2() const { return m_vector2; }
+		void setVector2(const Vector2& value) { m_vector2 = value; }
+
+		const Vector3& getVector3() const { return m_vector3; }
+		void setVector3(const Vector3& value) { m_vector3 = value; }
+
+		const Vector4& getVector4() const { return m_vector4; }
+		void setVector4(const Vector4& value) { m_vector4 = value; }
+
+		const Quaternion& getQuaternion() const { return m_quaternion; }
+		void setQuaternion(const Quaternion& value) { m_quaternion = value; }
+
+		const Color& getColor() const { return m_color; }
+		void setColor(const Color& value) { m_color = value; }
+
+		const String& getText() const { return m_text; }
+		void setText(const String& value) { m_text = value; }
+
+		const ResourcePath& getPathValue() const { return m_path; }
+		void setPathValue(const ResourcePath& value) { m_path = value; }
+
+		const StringOption& getOption() const { return m_option; }
+		void setOption(const StringOption& value) { m_option.setValue(value.getValue()); }
+
+	public:
+		DECLARE_SIGNAL(Signal0, onTest)
+
+	private:
+		bool			m_bool = false;
+		i32				m_int = 0;
+		Real			m_real = 0.f;
+		Vector2			m_vector2 = Vector2::ZERO;
+		Vector3			m_vector3 = Vector3::ZERO;
+		Vector4			m_vector4 = Vector4::ZERO;
+		Quaternion		m_quaternion = Quaternion::IDENTITY;
+		Color			m_color = Color::WHITE;
+		String			m_text;
+		ResourcePath	m_path = ResourcePath("", ".png");
+		StringOption	m_option = StringOption("a", { "a", "b", "c" });
+	};
+
+	void CookerTestNode::bindMethods()
+	{
+		CLASS_BIND_METHOD(CookerTestNode, getBool);
+		CLASS_BIND_METHOD(CookerTestNode, setBool);
+		CLASS_BIND_METHOD(CookerTestNode, getInt);
+		CLASS_BIND_METHOD(CookerTestNode, setInt);
+		CLASS_BIND_METHOD(CookerTestNode, getReal);
+		CLASS_BIND_METHOD(CookerTestNode, setReal);
+		CLASS_BIND_METHOD(CookerTestNode, getVector2);
+		CLASS_BIND_METHOD(CookerTestNode, setVector2);
+		CLASS_BIND_METHOD(CookerTestNode, getVector3);
+		CLASS_BIND_METHOD(CookerTestNode, setVector3);
+		CLASS_BIND_METHOD(CookerTestNode, getVector4);
+		CLASS_BIND_METHOD(CookerTestNode, setVector4);
+		CLASS_BIND_METHOD(CookerTestNode, getQuaternion);
+		CLASS_BIND_METHOD(CookerTestNode, setQuaternion);
+		CLASS_BIND_METHOD(CookerTestNode, getColor);
+		CLASS_BIND_METHOD(CookerTestNode, setColor);
+		CLASS_BIND_METHOD(CookerTestNode, getText);
+		CLASS_BIND_METHOD(CookerTestNode, setText);
+		CLASS_BIND_METHOD(CookerTestNode, getPathValue);
+		CLASS_BIND_METHOD(CookerTestNode, setPathValue);
+		CLASS_BIND_METHOD(CookerTestNode, getOption);
+		CLASS_BIND_METHOD(CookerTestNode, setOption);
+
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Bool", Variant::Type::Bool, getBool, setBool);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Int", Variant::Type::Int, getInt, setInt);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Real", Variant::Type::Real, getReal, setReal);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Vector2", Variant::Type::Vector2, getVector2, setVector2);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Vector3", Variant::Type::Vector3, getVector3, setVector3);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Vector4", Variant::Type::Vector4, getVector4, setVector4);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Quaternion", Variant::Type::Quaternion, getQuaternion, setQuaternion);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Color", Variant::Type::Color, getColor, setColor);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Text", Variant::Type::String, getText, setText);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "PathValue", Variant::Type::ResourcePath, getPathValue, setPathValue);
+		CLASS_REGISTER_PROPERTY(CookerTestNode, "Option", Variant::Type::StringOption, getOption, setOption);
+
+		CLASS_REGISTER_SIGNAL(CookerTestNode, onTest);
+	}
+}
+
+using namespace Echo;
+
+static String writeTempFile(const char* name, const String& content)
+{
+	String path = (std::filesystem::temp_directory_path() / name).string();
+	PathUtil::FormatPath(path, false);
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (file)
+	{
+		fwrite(content.data(), 1, content.size(), file);
+		fclose(file);
+	}
+
+	return path;
+}
+
+static void expectSameObject(Object* a, Object* b)
+{
+	ASSERT_TRUE(a && b);
+	ASSERT_EQ(a->getClassName(), b->getClassName());
+
+	PropertyInfos propertys;
+	Class::getPropertys(a->getClassName(), a, propertys, PropertyInfo::Static | PropertyInfo::Dynamic, true);
+	for (PropertyInfo* prop : propertys)
+	{
+		Variant valueA;
+		Variant valueB;
+		EXPECT_TRUE(Class::getPropertyValue(a, prop->m_name, valueA));
+		EXPECT_TRUE(Class::getPropertyValue(b, prop->m_name, valueB));
+		EXPECT_EQ(valueA.toString(), valueB.toString()) << a->getClassName() << "." << prop->m_name;
+	}
+
+	ChannelsPtr channelsA = a->getChannels();
+	ChannelsPtr channelsB = b->getChannels();
+	ASSERT_EQ(channelsA ? channelsA->size() : 0, channelsB ? channelsB->size() : 0);
+	for (size_t i = 0; channelsA && i < channelsA->size(); i++)
+	{
+		EXPECT_EQ((*channelsA)[i]->getName(), (*channelsB)[i]->getName());
+		EXPECT_EQ((*channelsA)[i]->getExpression(), (*channelsB)[i]->getExpression());
+	}
+
+	Signal* signalA = Class::getSignal(a, "onTest");
+	Signal* signalB = Class::getSignal(b, "onTest");
+	ASSERT_EQ(signalA != nullptr, signalB != nullptr);
+	if (signalA)
+	{
+		ASSERT_EQ(signalA->isHaveConnects(), signalB->isHaveConnects());
+		if (signalA->isHaveConnects())
+		{
+			ASSERT_EQ(signalA->getConnects()->size(), signalB->getConnects()->size());
+			for (size_t i = 0; i < signalA->getConnects()->size(); i++)
+			{
+				ConnectLuaMethod* connectA = dynamic_cast<ConnectLuaMethod*>((*signalA->getConnects())[i]);
+				ConnectLuaMethod* connectB = dynamic_cast<ConnectLuaMethod*>((*signalB->getConnects())[i]);
+				ASSERT_TRUE(connectA && connectB);
+				EXPECT_EQ(connectA->m_targetPath, connectB->m_targetPath);
+				EXPECT_EQ(connectA->m_functionName, connectB->m_functionName);
+			}
+		}
+	}
+}
+
+static void expectSameTree(Node* a, Node* b)
+{
+	expectSameObject(a, b);
+	EXPECT_EQ(a->isLink(), b->isLink());
+	EXPECT_EQ(a->getPath(), b->getPath());
+
+	ASSERT_EQ(a->getChildNum(), b->getChildNum());
+	for (ui32 i = 0; i < a->getChildNum(); i++)
+		expectSameTree(a->getChildByIndex(i), b->getChildByIndex(i));
+}
+
+TEST(ObjectCooker, CookedTreeMatchesXml)
+{
+	Class::registerType<Object>();
+	Class::registerType<Node>();
+	Class::registerType<CookerTestNode>();
+
+	String linkPath = writeTempFile("echo_cooker_link.scene",
+		"<?xml version=\"1.0\"?>\n"
+		"<node name=\"LinkRoot\" class=\"CookerTestNode\" Int=\"5\" Text=\"linked\">\n"
+		"	<node name=\"Linked\" class=\"CookerTestNode\" Vector3=\"4 5 6\" />\n"
+		"</node>\n");
+
+	String scene =
+		"<?xml version=\"1.0\"?>\n"
+		"<node name=\"Root\" class=\"CookerTestNode\" Bool=\"true\" Int=\"-7\" Real=\"2.5\" Vector2=\"1 2\" Vector3=\"1 2 3\" Vector4=\"1 2 3 4\""
+		" Quaternion=\"0 0.7071068 0 0.7071068\" Color=\"0.25 0.5 0.75 1\" Text=\"hello\" PathValue=\"Res://image.png\" Option=\"b\">\n"
+		"	<signal name=\"onTest\">\n"
+		"		<connect target=\"Child\" method=\"onRootTest\" />\n"
+		"	</signal>\n"
+		"	<channel name=\"Real\" expression=\"ch('Child/Real')\" />\n"
+		"	<node name=\"Child\" class=\"CookerTestNode\" Real=\"-1.5\" Option=\"c\" />\n"
+		"	<node name=\"Link\" path=\"" + linkPath + "\" Int=\"42\" />\n"
+		"</node>\n";
+	String scenePath = writeTempFile("echo_cooker_scene.scene", scene);
+
+	ByteArray cooked;
+	ASSERT_TRUE(ObjectCooker::cook(scene.data(), scene.size(), cooked));
+	ASSERT_TRUE(ObjectCooker::isCooked(cooked.data(), cooked.size()));
+
+	Node* xmlTree = Node::load(scenePath.c_str());
+	Node* cookedTree = ObjectCooker::instanceNodeTree(cooked.data(), cooked.size());
+	ASSERT_TRUE(xmlTree && cookedTree);
+
+	expectSameTree(xmlTree, cookedTree);
+
+	// values reached the nodes, not only the same defaults on both sides
+	CookerTestNode* root = ECHO_DOWN_CAST<CookerTestNode*>(cookedTree);
+	EXPECT_TRUE(root->getBool());
+	EXPECT_EQ(root->getInt(), -7);
+	EXPECT_EQ(root->getOption().getValue(), "b");
+
+	// link override applied on top of the linked document
+	CookerTestNode* link = ECHO_DOWN_CAST<CookerTestNode*>(cookedTree->getNode("Link"));
+	ASSERT_TRUE(link);
+	EXPECT_EQ(link->getInt(), 42);
+	EXPECT_EQ(link->getText(), "linked");
+	EXPECT_EQ(link->getChildNum(), 1u);
+
+	xmlTree->queueFree();
+	cookedTree->queueFree();
+
+	std::remove(scenePath.c_str());
+	std::remove(linkPath.c_str());
+}
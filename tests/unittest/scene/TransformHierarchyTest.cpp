@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <engine/core/scene/node.h>
+#include <engine/core/scene/transform_hierarchy.h>
+
+using namespace Echo;
+
+static void expectTranslation(const Matrix4& mat, const Vector3& pos)
+{
+	EXPECT_FLOAT_EQ(mat.m30, pos.x);
+	EXPECT_FLOAT_EQ(mat.m31, pos.y);
+	EXPECT_FLOAT_EQ(mat.m32, pos.z);
+}
+
+TEST(TransformHierarchy, ChildSeesParentMoveBeforeUpdate)
+{
+	TransformHierarchy hierarchy;
+	hierarchy.setEnable(true);
+
+	Node root;
+	Node parent;
+	Node child;
+	root.addChild(&parent);
+	parent.addChild(&child);
+	child.setLocalPosition(Vector3(0.f, 0.f, 1.f));
+	hierarchy.update(&root);
+	expectTranslation(child.getWorldMatrix(), Vector3(0.f, 0.f, 1.f));
+
+	// only the parent is flagged, the child composes on demand
+	parent.setLocalPosition(Vector3(2.f, 0.f, 0.f));
+	expectTranslation(child.getWorldMatrix(), Vector3(2.f, 0.f, 1.f));
+	expectTranslation(parent.getWorldMatrix(), Vector3(2.f, 0.f, 0.f));
+
+	// a second move in the same frame is seen as well
+	parent.setLocalPosition(Vector3(3.f, 0.f, 0.f));
+	expectTranslation(child.getWorldMatrix(), Vector3(3.f, 0.f, 1.f));
+
+	// hierarchy update writes the same result back
+	hierarchy.update(&root);
+	EXPECT_FALSE(hierarchy.isDirty());
+	expectTranslation(child.getWorldMatrix(), Vector3(3.f, 0.f, 1.f));
+
+	child.remove();
+	parent.remove();
+	hierarchy.setEnable(false);
+}
+
+TEST(TransformHierarchy, OnDemandChainKeepsMatricesInSync)
+{
+	TransformHierarchy hierarchy;
+	hierarchy.setEnable(true);
+
+	Node root;
+	Node parent;
+	Node child;
+	Node sibling;
+	root.addChild(&parent);
+	parent.addChild(&child);
+	parent.addChild(&sibling);
+	child.setLocalPosition(Vector3(0.f, 0.f, 1.f));
+	sibling.setLocalPosition(Vector3(0.f, 1.f, 0.f));
+	hierarchy.update(&root);
+
+	// renderables keep the matrix address, composing the child refreshes the parent's matrix too
+	const Matrix4& parentMatrix = parent.getWorldMatrix();
+	parent.setLocalPosition(Vector3(2.f, 0.f, 0.f));
+	expectTranslation(child.getWorldMatrix(), Vector3(2.f, 0.f, 1.f));
+	expectTranslation(parentMatrix, Vector3(2.f, 0.f, 0.f));
+	expectTranslation(sibling.getWorldMatrix(), Vector3(2.f, 1.f, 0.f));
+
+	// moving the sibling recomposes its own chain only, the others keep their results
+	sibling.setLocalPosition(Vector3(0.f, 3.f, 0.f));
+	expectTranslation(sibling.getWorldMatrix(), Vector3(2.f, 3.f, 0.f));
+	expectTranslation(child.getWorldMatrix(), Vector3(2.f, 0.f, 1.f));
+	expectTranslation(root.getWorldMatrix(), Vector3(0.f, 0.f, 0.f));
+
+	hierarchy.update(&root);
+	expectTranslation(sibling.getWorldMatrix(), Vector3(2.f, 3.f, 0.f));
+	expectTranslation(parentMatrix, Vector3(2.f, 0.f, 0.f));
+
+	sibling.remove();
+	child.remove();
+	parent.remove();
+	hierarchy.setEnable(false);
+}
@@ -0,0 +1,87 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <engine/core/thread/JobSystem.h>
+
+using namespace Echo;
+
+TEST(JobSystem, ParallelForCoversRange)
+{
+	const ui32 count = 10000;
+	std::vector<std::atomic<ui32>> visits(count);
+	for (std::atomic<ui32>& visit : visits)
+		visit = 0;
+
+	JobSystem::instance()->parallelFor(count, 64, [&](ui32 begin, ui32 end, ui32 threadIdx)
+	{
+		EXPECT_LT(threadIdx, JobSystem::instance()->getThreadCount());
+		for (ui32 i = begin; i < end; i++)
+			visits[i]++;
+	});
+
+	// every index is visited exactly once
+	for (std::atomic<ui32>& visit : visits)
+		EXPECT_EQ(visit, 1);
+}
+
+// inner loops are split into jobs too, their waits run other jobs instead of blocking
+TEST(JobSystem, NestedParallelForCoversRange)
+{
+	std::atomic<ui32> total(0);
+	JobSystem::instance()->parallelFor(8, 1, [&](ui32 begin, ui32 end, ui32 threadIdx)
+	{
+		for (ui32 i = begin; i < end; i++)
+		{
+			JobSystem::instance()->parallelFor(100, 10, [&](ui32 innerBegin, ui32 innerEnd, ui32 innerThreadIdx)
+			{
+				EXPECT_LT(innerThreadIdx, JobSystem::instance()->getThreadCount());
+				total += innerEnd - innerBegin;
+			});
+		}
+	});
+
+	EXPECT_EQ(total, 800);
+}
+
+TEST(JobSystem, DependentJobsRunAfterCounter)
+{
+	JobSystem* jobSystem = JobSystem::instance();
+
+	std::atomic<ui32> first(0);
+	std::atomic<ui32> secondSawFirst(0);
+
+	JobCounter firstJobs;
+	JobCounter secondJobs;
+	for (ui32 i = 0; i < 64; i++)
+		jobSystem->run([&]() { first++; }, &firstJobs);
+
+	// held back until every job of the first group finished
+	for (ui32 i = 0; i < 16; i++)
+		jobSystem->run([&]() { if (first == 64) secondSawFirst++; }, &secondJobs, firstJobs);
+
+	jobSystem->wait(secondJobs);
+	EXPECT_TRUE(firstJobs.isDone());
+	EXPECT_EQ(secondSawFirst, 16);
+}
+
+TEST(JobSystem, WaitSkipsBackgroundJobs)
+{
+	JobSystem* jobSystem = JobSystem::instance();
+
+	std::atomic<ui32> backgroundThreadIdx(~0u);
+	jobSystem->runBackground([&]() { backgroundThreadIdx = jobSystem->getThreadIdx(); });
+
+	std::atomic<ui32> count(0);
+	JobCounter jobs;
+	for (ui32 i = 0; i < 64; i++)
+		jobSystem->run([&]() { count++; }, &jobs);
+
+	jobSystem->wait(jobs);
+	EXPECT_EQ(count, 64);
+
+	// only idle workers take background jobs, without workers it ran inline
+	while (backgroundThreadIdx == ~0u)
+		std::this_thread::yield();
+
+	if (jobSystem->getThreadCount() > 1)
+		EXPECT_NE(backgroundThreadIdx, 0u);
+}
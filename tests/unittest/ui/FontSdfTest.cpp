@@ -0,0 +1,96 @@
+#include <cmath>
+#include <gtest/gtest.h>
+#include <engine/modules/ui/font/font_sdf.h>
+
+using namespace Echo;
+
+// a filled disc, anti aliased by 4x4 supersampling
+static vector<ui8>::type buildDisc(i32 size, float radius)
+{
+	vector<ui8>::type coverage(size * size, 0);
+	float center = size * 0.5f;
+	for (i32 y = 0; y < size; y++)
+	{
+		for (i32 x = 0; x < size; x++)
+		{
+			i32 inside = 0;
+			for (i32 sy = 0; sy < 4; sy++)
+			{
+				for (i32 sx = 0; sx < 4; sx++)
+				{
+					float dx = x + (sx + 0.5f) / 4.f - center;
+					float dy = y + (sy + 0.5f) / 4.f - center;
+					inside += dx * dx + dy * dy <= radius * radius ? 1 : 0;
+				}
+			}
+
+			coverage[y * size + x] = ui8(inside * 255 / 16);
+		}
+	}
+
+	return coverage;
+}
+
+TEST(FontSdf, SignAndClamp)
+{
+	const i32 size = 64;
+	vector<ui8>::type coverage = buildDisc(size, 16.f);
+	vector<ui8>::type distances(coverage.size());
+	FontSdf::generate(coverage.data(), size, size, 6, distances.data());
+
+	// center is deep inside, corners far outside
+	EXPECT_EQ(255, distances[(size / 2) * size + size / 2]);
+	EXPECT_EQ(0, distances[0]);
+	EXPECT_EQ(0, distances[size * size - 1]);
+}
+
+TEST(FontSdf, DistanceMatchesDisc)
+{
+	const i32 size = 64;
+	const i32 spread = 8;
+	const float radius = 16.f;
+	vector<ui8>::type coverage = buildDisc(size, radius);
+	vector<ui8>::type distances(coverage.size());
+	FontSdf::generate(coverage.data(), size, size, spread, distances.data());
+
+	// within the spread, decoded distance is close to the analytic distance to the circle
+	float center = size * 0.5f;
+	for (i32 y = 0; y < size; y++)
+	{
+		for (i32 x = 0; x < size; x++)
+		{
+			float dx = x + 0.5f - center;
+			float dy = y + 0.5f - center;
+			float expected = std::sqrt(dx * dx + dy * dy) - radius;
+			if (std::abs(expected) < spread - 1.f)
+			{
+				float decoded = (128.f - distances[y * size + x]) / 127.f * spread;
+				EXPECT_NEAR(expected, decoded, 1.f) << "x " << x << " y " << y;
+			}
+		}
+	}
+}
+
+TEST(FontSdf, EdgeIsHalf)
+{
+	// a vertical edge through the middle of a pixel column
+	const i32 width = 16;
+	const i32 height = 4;
+	vector<ui8>::type coverage(width * height, 0);
+	for (i32 y = 0; y < height; y++)
+	{
+		for (i32 x = 0; x < width / 2; x++)
+			coverage[y * width + x] = 255;
+
+		coverage[y * width + width / 2] = 128;
+	}
+
+	vector<ui8>::type distances(coverage.size());
+	FontSdf::generate(coverage.data(), width, height, 4, distances.data());
+	for (i32 y = 0; y < height; y++)
+	{
+		EXPECT_NEAR(128, distances[y * width + width / 2], 1);
+		EXPECT_GT(distances[y * width + width / 2 - 1], distances[y * width + width / 2]);
+		EXPECT_LT(distances[y * width + width / 2 + 1], distances[y * width + width / 2]);
+	}
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <engine/core/util/handle_table.h>
+
+using namespace Echo;
+
+TEST(HandleTable, AddGetRemove)
+{
+	int a = 1, b = 2, c = 3;
+
+	HandleTable<int> table;
+	HandleTable<int>::Handle ha = table.add(&a);
+	HandleTable<int>::Handle hb = table.add(&b);
+	HandleTable<int>::Handle hc = table.add(&c);
+
+	EXPECT_NE(ha, HandleTable<int>::InvalidHandle);
+	EXPECT_EQ(table.get(ha), &a);
+	EXPECT_EQ(table.get(hb), &b);
+	EXPECT_EQ(table.get(hc), &c);
+	EXPECT_EQ(table.size(), 3);
+
+	// removed handle becomes stale, dense array stays packed
+	EXPECT_TRUE(table.remove(ha));
+	EXPECT_FALSE(table.remove(ha));
+	EXPECT_EQ(table.get(ha), nullptr);
+	EXPECT_EQ(table.size(), 2);
+	EXPECT_EQ(table.get(hb), &b);
+	EXPECT_EQ(table.get(hc), &c);
+
+	// slot is reused with a new generation
+	int d = 4;
+	HandleTable<int>::Handle hd = table.add(&d);
+	EXPECT_NE(hd, ha);
+	EXPECT_EQ(hd & HandleTable<int>::IndexMask, ha & HandleTable<int>::IndexMask);
+	EXPECT_EQ(table.get(ha), nullptr);
+	EXPECT_EQ(table.get(hd), &d);
+
+	int sum = 0;
+	for (int* value : table.getObjects())
+		sum += *value;
+
+	EXPECT_EQ(sum, 2 + 3 + 4);
+}